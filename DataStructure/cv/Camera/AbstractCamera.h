@@ -55,7 +55,20 @@ public:
 
     virtual const Eigen::Matrix3d K(int level = 0) const { return  Eigen::Matrix3d::Identity(3,3); }
     virtual const Eigen::Matrix3d K_inv(int level = 0) const { return  Eigen::Matrix3d::Identity(3,3);}
+
+    /// rectified image from a raw one, a camera without lens distortion hands the image through
+    virtual void undistortImage(const cv::Mat& raw, cv::Mat& rectified) const { rectified = raw; }
+
+    /// fixed point remap tables from a rectified pixel to the raw image (CV_16SC2 pixel, CV_16UC1 fraction),
+    /// empty if the image needs no rectification
+    virtual const cv::Mat& undistortMap1() const { return emptyMap(); }
+    virtual const cv::Mat& undistortMap2() const { return emptyMap(); }
 protected:
+    static const cv::Mat& emptyMap() {
+        static const cv::Mat empty;
+        return empty;
+    }
+
     int width_;   // TODO cannot be const because of omni-camera model
     int height_;
 };
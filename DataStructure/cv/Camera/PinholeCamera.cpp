@@ -12,8 +12,6 @@ PinholeCamera::PinholeCamera(double width, double height,
                              double cx, double cy,
                              double d0, double d1, double d2, double d3, double d4) :
         AbstractCamera(width, height),distortion_(false),
-        undist_map1_(height_, width_, CV_16SC2),
-        undist_map2_(height_, width_, CV_16SC2),
         use_optimization_(false) {
     d_[0] = d0; d_[1] = d1; d_[2] = d2; d_[3] = d3; d_[4] = d4;
 
@@ -27,9 +25,7 @@ PinholeCamera::PinholeCamera(double width, double height,
         cvK_[i] = (cv::Mat_<double>(3, 3) << fx_[i], 0.0, cx_[i], 0.0, fy_[i], cy_[i], 0.0, 0.0, 1.0);
     }
 
-
-    cv::initUndistortRectifyMap(cvK_[0], cvD_, cv::Mat_<double>::eye(3,3), cvK_[0],
-                                cv::Size(width_, height_), CV_16SC2, undist_map1_, undist_map2_);
+    initUnistortionMap();
     for (int var = 0; var < IMG_LEVEL; ++var) {
         K_[var] << fx_[var], 0.0, cx_[var], 0.0, fy_[var], cy_[var], 0.0, 0.0, 1.0;
         K_inv_[var] = K_[var].inverse();
@@ -39,6 +35,17 @@ PinholeCamera::PinholeCamera(double width, double height,
 
 PinholeCamera::~PinholeCamera() {}
 
+void PinholeCamera::initUnistortionMap() {
+    undist_map1_.release();
+    undist_map2_.release();
+    if(d_[0] == 0.0 && d_[1] == 0.0 && d_[2] == 0.0 && d_[3] == 0.0 && d_[4] == 0.0)
+        return;
+
+    // the same tables cv::undistort builds for every call, so the rectified images don't change
+    cv::initUndistortRectifyMap(cvK_[0], cvD_, cv::Mat_<double>::eye(3,3), cvK_[0],
+                                cv::Size(width_, height_), CV_16SC2, undist_map1_, undist_map2_);
+}
+
 Vector3d PinholeCamera::cam2world(const double& u, const double& v) const {
     Vector3d xyz;
     if(!distortion_) {
@@ -49,8 +56,8 @@ Vector3d PinholeCamera::cam2world(const double& u, const double& v) const {
 
     else {
         cv::Point2d uv(u,v), px;
-        const cv::Mat src_pt(1, 1, CV_32FC2, &uv.x);
-        cv::Mat dst_pt(1, 1, CV_32FC2, &px.x);
+        const cv::Mat src_pt(1, 1, CV_64FC2, &uv.x);
+        cv::Mat dst_pt(1, 1, CV_64FC2, &px.x);
         cv::undistortPoints(src_pt, dst_pt, cvK_[0], cvD_);
         xyz[0] = px.x;
         xyz[1] = px.y;
@@ -122,8 +129,8 @@ Vector2d PinholeCamera::world2camUV(const Vector2d& uv) const {
     return px;
 }
 
-void PinholeCamera::undistortImage(const cv::Mat& raw, cv::Mat& rectified) {
-    if(distortion_)
+void PinholeCamera::undistortImage(const cv::Mat& raw, cv::Mat& rectified) const {
+    if(!undist_map1_.empty())
         cv::remap(raw, rectified, undist_map1_, undist_map2_, CV_INTER_LINEAR);
     else
         rectified = raw.clone();
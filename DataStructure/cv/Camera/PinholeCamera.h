@@ -17,6 +17,7 @@ public:
                   double d0=0.0, double d1=0.0, double d2=0.0, double d3=0.0, double d4=0.0);
 
     ~PinholeCamera();
+    /// builds the remap tables once, the images are rectified through them afterwards
     void initUnistortionMap();
 
     virtual Eigen::Vector3d cam2world(const double& x, const double& y) const;
@@ -47,7 +48,9 @@ public:
     virtual double cx(int level) const { return cx_[level]; }
     virtual double cy(int level) const { return cy_[level]; }
     virtual double d(int i) const { return d_[i]; }
-    void undistortImage(const cv::Mat& raw, cv::Mat& rectified);
+    virtual void undistortImage(const cv::Mat& raw, cv::Mat& rectified) const;
+    virtual const cv::Mat& undistortMap1() const { return undist_map1_; }
+    virtual const cv::Mat& undistortMap2() const { return undist_map2_; }
 
 private:
     double fx_[IMG_LEVEL];
@@ -57,7 +60,7 @@ private:
     bool distortion_;             //!< is it pure pinhole model or has it radial distortion?
     double d_[5];                 //!< distortion parameters, see http://docs.opencv.org/modules/calib3d/doc/camera_calibration_and_3d_reconstruction.html
     cv::Mat cvK_[IMG_LEVEL], cvD_;
-    cv::Mat undist_map1_, undist_map2_;
+    cv::Mat undist_map1_, undist_map2_;  //!< CV_16SC2 + CV_16UC1, empty if all coefficients are zero
     bool use_optimization_;
     Eigen::Matrix3d K_[IMG_LEVEL];
     Eigen::Matrix3d K_inv_[IMG_LEVEL];
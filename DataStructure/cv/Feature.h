@@ -7,6 +7,8 @@
 #include <atomic>
 
 #include "cvFrame.h"
+#include "Point.h"
+#include "util/PoolAllocator.h"
 
 class Point;
 
@@ -37,7 +39,7 @@ struct Feature
         level(_level),
         grad(_grad)
     {
-        point = std::make_shared<Point>( _frame->getPose().inverse() * f);
+        point = makePoint( _frame->getPose().inverse() * f);
         isBAed = false;
 	    isProjected = true;
     }
@@ -50,7 +52,7 @@ struct Feature
         level(_level),
         grad(1.0,0.0)
     {
-        point = std::make_shared<Point>( _frame->getPose().inverse() * f);
+        point = makePoint( _frame->getPose().inverse() * f);
         isBAed = false;
 	    isProjected = true;
     }
@@ -63,7 +65,7 @@ struct Feature
         level(_level),
         grad(1.0,0.0)
     {
-        point = std::make_shared<Point>( _frame->getPose().inverse() * f);
+        point = makePoint( _frame->getPose().inverse() * f);
         isBAed = false;
 	    isProjected = true;
     }
@@ -91,5 +93,11 @@ struct Feature
     {isBAed = false; isProjected = true;}
 };
 
+/// the feature and its reference count in one pooled block
+template<typename... Args>
+inline std::shared_ptr<Feature> makeFeature(Args&&... args) {
+    return std::allocate_shared<Feature>(PoolAllocator<Feature>(), std::forward<Args>(args)...);
+}
+
 
 #endif // FEATURE_H
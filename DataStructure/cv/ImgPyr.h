@@ -0,0 +1,77 @@
+#ifndef SIMPLE_VIO_IMGPYR_H
+#define SIMPLE_VIO_IMGPYR_H
+
+#include <array>
+#include <vector>
+#include <cstdint>
+#include <Eigen/Core>
+
+#include "util/setting.h"
+
+/// pyramid planes are stored in Q8 fixed point: value = raw / PYR_ONE.
+/// averaging 2x2 blocks of 8-bit pixels stays exact down to level 4 (1/256 step).
+#define PYR_FRAC_BITS       8
+#define PYR_ONE             (1 << PYR_FRAC_BITS)
+#define PYR_STRIDE_ALIGN    16                      //!< row stride is a multiple of 16 elements (32 bytes)
+
+/// one pyramid level, every channel in its own plane sharing the same stride.
+/// a spare zero row is kept at the bottom so that bilinear lookups on the last row stay in bounds,
+/// and PYR_STRIDE_ALIGN more elements at the end so that 32-bit gathers of the last pixel do too.
+struct ImgLevel {
+public:
+    typedef std::vector<uint16_t, Eigen::aligned_allocator<uint16_t>>   Intensity_t;    //!< Q8 intensity
+    typedef std::vector<int16_t,  Eigen::aligned_allocator<int16_t>>    Grad_t;         //!< Q8 central difference
+    typedef std::vector<uint16_t, Eigen::aligned_allocator<uint16_t>>   GradNorm_t;     //!< Q8 gradient norm
+
+public:
+    ImgLevel() : width(0), height(0), stride(0) {}
+
+    void resize(int w, int h) {
+        setSize(w, h);
+        allocIntensity();
+        allocGradient();
+    }
+
+    //! only the geometry, planes are allocated when a channel is materialised
+    void setSize(int w, int h) {
+        width  = w;
+        height = h;
+        stride = (w + PYR_STRIDE_ALIGN - 1) / PYR_STRIDE_ALIGN * PYR_STRIDE_ALIGN;
+    }
+
+    void allocIntensity() {
+        intensity.assign(planeSize(), 0);
+    }
+
+    void allocGradient() {
+        const size_t n = planeSize();
+        gradX.assign(n, 0);
+        gradY.assign(n, 0);
+        gradNorm.assign(n, 0);
+    }
+
+    size_t bytes() const {
+        return intensity.size() * sizeof(Intensity_t::value_type)
+               + (gradX.size() + gradY.size()) * sizeof(Grad_t::value_type)
+               + gradNorm.size() * sizeof(GradNorm_t::value_type);
+    }
+
+    size_t planeSize() const { return size_t(stride) * (height + 1) + PYR_STRIDE_ALIGN; }
+
+    const uint16_t* row(int v) const { return intensity.data() + v * stride; }
+    uint16_t*       row(int v)       { return intensity.data() + v * stride; }
+
+public:
+    int             width;
+    int             height;
+    int             stride;         //!< elements per row, padded to PYR_STRIDE_ALIGN
+
+    Intensity_t     intensity;
+    Grad_t          gradX;
+    Grad_t          gradY;
+    GradNorm_t      gradNorm;
+};
+
+typedef std::array<ImgLevel, IMG_LEVEL> ImgPyr_t;
+
+#endif //SIMPLE_VIO_IMGPYR_H
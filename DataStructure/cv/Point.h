@@ -10,6 +10,8 @@
 
 
 #include "util/util.h"
+#include "util/PoolAllocator.h"
+#include "DataStructure/cv/PointStore.h"
 
 class Feature;
 class cvFrame;
@@ -26,26 +28,61 @@ public:
         TYPE_GOOD
     };
 
-    static int                             point_counter_;           //!< Counts the number of created points. Used to set the unique id.
+    static std::atomic<int>                point_counter_;           //!< Counts the number of created points. Used to set the unique id.
     int                                    id_;                      //!< Unique ID of the point.
-    Eigen::Vector3d                        pos_;                     //!< 3d pos of the point in the world coordinate frame.
-    boost::shared_mutex                    pos_mutex;
-    double                                 normal_information_;      //!< Inverse covariance.
-    boost::shared_mutex                    infoMutex;
-    std::list<std::shared_ptr<Feature>>    obs_;                     //!< References to keyframes which observe the point.
+    const PointStore::Handle               handle_;                  //!< Slot in PointStore, the estimate and the counters below live there.
+    typedef std::list<std::weak_ptr<Feature>, PoolAllocator<std::weak_ptr<Feature>>> observations_t;
+
+    observations_t                         obs_;                     //!< Features observing the point, weak so the point doesn't keep them alive.
     boost::shared_mutex                    obsMutex;
-    std::atomic_int                        last_projected_kf_id_;    //!< Flag for the reprojection: don't reproject a pt twice.
+    std::atomic_int&                       last_projected_kf_id_;    //!< Flag for the reprojection: don't reproject a pt twice.
     PointType                              type_;                    //!< Quality of the point.
-    std::atomic<int>                       n_failed_reproj_;         //!< Number of failed reprojections. Used to assess the quality of the point.
-    std::atomic<int>                       n_succeeded_reproj_;      //!< Number of succeeded  reprojections. Used to assess the quality of the point.
+    std::atomic<int>&                      n_failed_reproj_;         //!< Number of failed reprojections. Used to assess the quality of the point.
+    std::atomic<int>&                      n_succeeded_reproj_;      //!< Number of succeeded  reprojections. Used to assess the quality of the point.
 
     Point(const Eigen::Vector3d& pos);
     Point(const Eigen::Vector3d& pos, std::shared_ptr<Feature>& ftr);
     ~Point();
 
-    double getDepthInformation();
-    double updateDepth(double depth, double information);
+    PointStore::Handle handle() const { return handle_; }
+
+    /// 3d pos of the point in the world coordinate frame
+    Eigen::Vector3d getPos() const {
+        return PointStore::instance().position(handle_);
+    }
+    /// inverse covariance of the depth
+    double getDepthInformation() const {
+        return PointStore::instance().information(handle_);
+    }
+    /// both from the same write
+    void getEstimate(Eigen::Vector3d &pos, double &information) const {
+        PointStore::instance().estimate(handle_, pos, information);
+    }
 
+    /// the position and the number of writes it is the result of
+    Eigen::Vector3d getPos(unsigned &version) const {
+        return PointStore::instance().position(handle_, version);
+    }
+
+    void setPos(const Eigen::Vector3d &pos) {
+        PointStore::instance().setPosition(handle_, pos);
+    }
+    /// only if nothing wrote the point since getPos returned version, false if the position is stale
+    bool setPos(const Eigen::Vector3d &pos, unsigned version) {
+        return PointStore::instance().setPosition(handle_, pos, version);
+    }
+    void setDepthInformation(double information) {
+        PointStore::instance().setInformation(handle_, information);
+    }
+    double updateDepth(double depth, double information) {
+        return PointStore::instance().updateDepth(handle_, depth, information);
+    }
 };
 
+/// the point and its reference count in one pooled block
+template<typename... Args>
+inline std::shared_ptr<Point> makePoint(Args&&... args) {
+    return std::allocate_shared<Point>(PoolAllocator<Point>(), std::forward<Args>(args)...);
+}
+
 #endif // POINT_H
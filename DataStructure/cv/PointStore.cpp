@@ -0,0 +1,123 @@
+#include "DataStructure/cv/PointStore.h"
+
+#include <new>
+
+using namespace Eigen;
+
+PointStore& PointStore::instance() {
+    static PointStore* store = new PointStore;
+    return *store;
+}
+
+PointStore::PointStore() : blockNum_(0), used_(0), free_(InvalidHandle) {
+    for(size_t i = 0; i < MaxBlocks; ++i)
+        blocks_[i].store(nullptr, std::memory_order_relaxed);
+}
+
+PointStore::Handle PointStore::allocate(const Vector3d &pos, double information) {
+    Handle h = pop();
+    if(h == InvalidHandle)
+        h = grow();
+    Block* b = block(h);
+    const Handle i = h & IndexMask;
+    const Estimate e = {{pos[0], pos[1], pos[2]}, information};
+    b->estimate[i].store(e);
+    b->succeeded[i].store(0, std::memory_order_relaxed);
+    b->failed[i].store(0, std::memory_order_relaxed);
+    b->lastProjectedKf[i].store(-1, std::memory_order_relaxed);
+    used_++;
+    return h;
+}
+
+void PointStore::release(Handle h) {
+    push(h, h);
+    used_--;
+}
+
+void PointStore::gather(const Handle *h, size_t n, Vector3d *pos, double *information) const {
+    for(size_t k = 0; k < n; ++k) {
+        const Estimate e = estimate(h[k]).load();
+        pos[k] = Vector3d(e.pos[0], e.pos[1], e.pos[2]);
+        if(information)
+            information[k] = e.information;
+    }
+}
+
+void PointStore::setPosition(Handle h, const Vector3d &pos) {
+    estimate(h).update([&](Estimate &e) {
+        e.pos[0] = pos[0];
+        e.pos[1] = pos[1];
+        e.pos[2] = pos[2];
+    });
+}
+
+bool PointStore::setPosition(Handle h, const Vector3d &pos, unsigned version) {
+    return estimate(h).updateIf(version, [&](Estimate &e) {
+        e.pos[0] = pos[0];
+        e.pos[1] = pos[1];
+        e.pos[2] = pos[2];
+    });
+}
+
+void PointStore::setInformation(Handle h, double information) {
+    estimate(h).update([&](Estimate &e) {
+        e.information = information;
+    });
+}
+
+// one write, a reader never sees the new information with the old depth
+double PointStore::updateDepth(Handle h, double depth, double information) {
+    double depthNew = 1.0;
+    estimate(h).update([&](Estimate &e) {
+        depthNew = (e.information + depth / e.pos[2] * information) / (e.information + information);
+        e.information += information;
+        for(int i = 0; i < 3; ++i)
+            e.pos[i] *= depthNew;
+    });
+    return depthNew;
+}
+
+// a popped handle may be released and pushed again before the CAS, the tag changes with every push and pop
+PointStore::Handle PointStore::pop() {
+    uint64_t head = free_.load(std::memory_order_acquire);
+    for(;;) {
+        const Handle h = Handle(head);
+        if(h == InvalidHandle)
+            return InvalidHandle;
+        const Handle next = block(h)->next[h & IndexMask].load(std::memory_order_relaxed);
+        const uint64_t newHead = (((head >> 32) + 1) << 32) | next;
+        if(free_.compare_exchange_weak(head, newHead, std::memory_order_acquire, std::memory_order_acquire))
+            return h;
+    }
+}
+
+// first..last are linked already
+void PointStore::push(Handle first, Handle last) {
+    std::atomic<Handle> &link = block(last)->next[last & IndexMask];
+    uint64_t head = free_.load(std::memory_order_relaxed);
+    uint64_t newHead;
+    do {
+        link.store(Handle(head), std::memory_order_relaxed);
+        newHead = (((head >> 32) + 1) << 32) | first;
+    } while(!free_.compare_exchange_weak(head, newHead, std::memory_order_release, std::memory_order_relaxed));
+}
+
+// one thread adds a block, the others retry the free list it fills
+PointStore::Handle PointStore::grow() {
+    std::lock_guard<std::mutex> lock(growMutex_);
+    Handle h = pop();
+    if(h != InvalidHandle)
+        return h;
+    const size_t n = blockNum_.load(std::memory_order_relaxed);
+    if(n == MaxBlocks)
+        throw std::bad_alloc();
+    Block* b = new Block();
+    const Handle base = Handle(n) << BlockBits;
+    for(Handle i = 1; i + 1 < BlockSize; ++i)
+        b->next[i].store(base + i + 1, std::memory_order_relaxed);
+    blocks_[n].store(b, std::memory_order_release);
+    blockNum_.store(n + 1, std::memory_order_release);
+    // the caller gets the first handle, the rest goes on the free list
+    push(base + 1, base + BlockSize - 1);
+    return base;
+}
@@ -0,0 +1,108 @@
+#ifndef SIMPLE_VIO_POINTSTORE_H
+#define SIMPLE_VIO_POINTSTORE_H
+
+#include <mutex>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+
+#include <Eigen/Dense>
+
+#include "util/SeqLock.h"
+
+/// the numeric state of every point, its position with the depth information and its reprojection
+/// counters, one array per field addressed by a 32-bit handle. a Point owns a handle for its lifetime,
+/// the tracker, the triangulater and the BA gather the handles of a frame once and then run over the arrays
+/// instead of chasing a shared_ptr per feature.
+/// the arrays live in blocks which are never moved or freed, so a reader needs no lock while another thread
+/// adds a block, and a released handle goes on a lock-free free list to be handed out again.
+class PointStore {
+public:
+    typedef uint32_t Handle;
+    static const Handle InvalidHandle = 0xffffffffu;
+
+    /// never destroyed, points may still be released from static destructors
+    static PointStore& instance();
+
+    /// a handle with the position, the depth information and counters set to their initial values
+    Handle allocate(const Eigen::Vector3d &pos, double information);
+    void release(Handle h);
+
+    Eigen::Vector3d position(Handle h) const {
+        const Estimate e = estimate(h).load();
+        return Eigen::Vector3d(e.pos[0], e.pos[1], e.pos[2]);
+    }
+    /// the position and the number of writes it is the result of, the count keeps going when a handle is reused
+    Eigen::Vector3d position(Handle h, unsigned &version) const {
+        const Estimate e = estimate(h).load(version);
+        return Eigen::Vector3d(e.pos[0], e.pos[1], e.pos[2]);
+    }
+    double information(Handle h) const {
+        return estimate(h).load().information;
+    }
+    /// position and information from the same write
+    void estimate(Handle h, Eigen::Vector3d &pos, double &information) const {
+        const Estimate e = estimate(h).load();
+        pos = Eigen::Vector3d(e.pos[0], e.pos[1], e.pos[2]);
+        information = e.information;
+    }
+
+    /// positions and, if information isn't nullptr, the depth information of n handles
+    void gather(const Handle *h, size_t n, Eigen::Vector3d *pos, double *information = nullptr) const;
+
+    void setPosition(Handle h, const Eigen::Vector3d &pos);
+    /// only if nothing wrote the point since position returned version, false if the position is stale
+    bool setPosition(Handle h, const Eigen::Vector3d &pos, unsigned version);
+    void setInformation(Handle h, double information);
+    /// fuses a depth measurement in one write, returns the scale applied to the position
+    double updateDepth(Handle h, double depth, double information);
+
+    std::atomic<int>& succeeded(Handle h)       { return block(h)->succeeded[h & IndexMask]; }
+    std::atomic<int>& failed(Handle h)          { return block(h)->failed[h & IndexMask]; }
+    std::atomic<int>& lastProjectedKf(Handle h) { return block(h)->lastProjectedKf[h & IndexMask]; }
+
+    /// handles backed by blocks so far and handles handed out now
+    size_t capacity() const { return blockNum_.load() * BlockSize; }
+    size_t used() const     { return used_.load(); }
+
+private:
+    struct Estimate {
+        double pos[3];
+        double information;                     //!< inverse covariance of the depth
+    };
+
+    static const int    BlockBits = 12;
+    static const Handle BlockSize = 1u << BlockBits;
+    static const Handle IndexMask = BlockSize - 1;
+    static const size_t MaxBlocks = 1u << 12;   //!< 16M points
+
+    struct Block {
+        SeqLock<Estimate>   estimate[BlockSize];        //!< written by BA and depth fusion, read lock-free by tracking
+        std::atomic<int>    succeeded[BlockSize];
+        std::atomic<int>    failed[BlockSize];
+        std::atomic<int>    lastProjectedKf[BlockSize];
+        std::atomic<Handle> next[BlockSize];            //!< free list link
+    };
+
+    PointStore();
+
+    Block* block(Handle h) const {
+        return blocks_[h >> BlockBits].load(std::memory_order_acquire);
+    }
+    const SeqLock<Estimate>& estimate(Handle h) const { return block(h)->estimate[h & IndexMask]; }
+    SeqLock<Estimate>& estimate(Handle h)             { return block(h)->estimate[h & IndexMask]; }
+
+    Handle pop();
+    void push(Handle first, Handle last);
+    Handle grow();
+
+private:
+    std::atomic<Block*>   blocks_[MaxBlocks];
+    std::atomic<size_t>   blockNum_;
+    std::atomic<size_t>   used_;
+    std::atomic<uint64_t> free_;                //!< tag << 32 | first free handle, the tag keeps a stale CAS from succeeding
+    std::mutex            growMutex_;
+};
+
+
+#endif //SIMPLE_VIO_POINTSTORE_H
@@ -0,0 +1,294 @@
+#include <cmath>
+
+#include "PyramidKernel.h"
+
+namespace pyramid {
+
+    typedef void (*LoadRow_t)(const uint8_t* src, uint16_t* dst, int n);
+    typedef void (*DownRow_t)(const uint16_t* src0, const uint16_t* src1, uint16_t* dst, int n);
+    typedef void (*GradRow_t)(const uint16_t* I, int stride, int16_t* gx, int16_t* gy, uint16_t* gn, int n);
+
+    struct Kernels {
+        LoadRow_t load;
+        DownRow_t down;
+        GradRow_t grad;
+    };
+
+    /////////////////////////////////////////// scalar ///////////////////////////////////////////
+
+    static void loadRowScalar(const uint8_t* src, uint16_t* dst, int n) {
+        for(int q = 0; q < n; ++q)
+            dst[q] = uint16_t(src[q] << PYR_FRAC_BITS);
+    }
+
+    static void downRowScalar(const uint16_t* src0, const uint16_t* src1, uint16_t* dst, int n) {
+        for(int q = 0; q < n; ++q)
+            dst[q] = uint16_t((src0[2 * q] + src0[2 * q + 1] + src1[2 * q] + src1[2 * q + 1]) >> 2);
+    }
+
+    //! gradients of pixels [begin, n - 1) of one row, the border columns stay zero
+    static inline void gradRange(const uint16_t* I, int stride, int16_t* gx, int16_t* gy, uint16_t* gn,
+                                 int begin, int n) {
+        for(int q = begin; q < n - 1; ++q) {
+            const int dx = (int(I[q + 1]) - int(I[q - 1])) >> 1;
+            const int dy = (int(I[q + stride]) - int(I[q - stride])) >> 1;
+            gx[q] = int16_t(dx);
+            gy[q] = int16_t(dy);
+            gn[q] = uint16_t(std::sqrt(float(dx * dx + dy * dy)) + 0.5f);
+        }
+    }
+
+    static void gradRowScalar(const uint16_t* I, int stride, int16_t* gx, int16_t* gy, uint16_t* gn, int n) {
+        gradRange(I, stride, gx, gy, gn, 1, n);
+    }
+
+    // OpenCV's INTER_BITS, the fraction bits of each coordinate in the remap tables
+    static const int RemapBits = 5;
+    static const int RemapOne  = 1 << RemapBits;
+
+    static inline int rawPixel(const uint8_t* pic, int width, int height, int step, int x, int y) {
+        return x >= 0 && y >= 0 && x < width && y < height ? pic[y * step + x] : 0;
+    }
+
+    //! a gather per pixel, the SIMD sets have nothing to win here so there is only this one
+    static void remapRow(const uint8_t* pic, int width, int height, int step,
+                         const int16_t* xy, const uint16_t* frac, uint16_t* dst, int n) {
+        for(int q = 0; q < n; ++q) {
+            const int x = xy[2 * q], y = xy[2 * q + 1];
+            const int fx = frac[q] & (RemapOne - 1), fy = frac[q] >> RemapBits;
+            int a, b, c, d;
+            if(x >= 0 && y >= 0 && x + 1 < width && y + 1 < height) {
+                const uint8_t* p = pic + y * step + x;
+                a = p[0]; b = p[1]; c = p[step]; d = p[step + 1];
+            }
+            else {
+                a = rawPixel(pic, width, height, step, x, y);
+                b = rawPixel(pic, width, height, step, x + 1, y);
+                c = rawPixel(pic, width, height, step, x, y + 1);
+                d = rawPixel(pic, width, height, step, x + 1, y + 1);
+            }
+            // 2 * RemapBits fraction bits, rounded to the PYR_FRAC_BITS of the level
+            const int v = (RemapOne - fy) * ((RemapOne - fx) * a + fx * b) + fy * ((RemapOne - fx) * c + fx * d);
+            const int shift = 2 * RemapBits - PYR_FRAC_BITS;
+            dst[q] = uint16_t((v + (1 << (shift - 1))) >> shift);
+        }
+    }
+
+#if SIMPLE_VIO_X86_SIMD
+    //////////////////////////////////////////// SSE4 ////////////////////////////////////////////
+    // (r - l) >> 1 needs 17 bits; avg(r, ~l) = ((r - l) >> 1) + 0x8000 stays in 16 bits and is exact.
+
+    SIMD_TARGET_SSE4 static void loadRowSSE4(const uint8_t* src, uint16_t* dst, int n) {
+        const __m128i zero = _mm_setzero_si128();
+        int q = 0;
+        for(; q + 16 <= n; q += 16) {
+            __m128i x = _mm_loadu_si128((const __m128i*)(src + q));
+            _mm_storeu_si128((__m128i*)(dst + q),     _mm_unpacklo_epi8(zero, x));
+            _mm_storeu_si128((__m128i*)(dst + q + 8), _mm_unpackhi_epi8(zero, x));
+        }
+        loadRowScalar(src + q, dst + q, n - q);
+    }
+
+    SIMD_TARGET_SSE4 static inline __m128i down4SSE4(const uint16_t* src0, const uint16_t* src1) {
+        const __m128i bias = _mm_set1_epi16(short(0x8000));
+        const __m128i ones = _mm_set1_epi16(1);
+        // biased to signed so that madd sums horizontal pairs without overflow
+        __m128i a = _mm_madd_epi16(_mm_xor_si128(_mm_loadu_si128((const __m128i*)src0), bias), ones);
+        __m128i b = _mm_madd_epi16(_mm_xor_si128(_mm_loadu_si128((const __m128i*)src1), bias), ones);
+        __m128i sum = _mm_add_epi32(_mm_add_epi32(a, b), _mm_set1_epi32(4 * 0x8000));
+        return _mm_srli_epi32(sum, 2);
+    }
+
+    SIMD_TARGET_SSE4 static void downRowSSE4(const uint16_t* src0, const uint16_t* src1, uint16_t* dst, int n) {
+        int q = 0;
+        for(; q + 8 <= n; q += 8) {
+            __m128i lo = down4SSE4(src0 + 2 * q,     src1 + 2 * q);
+            __m128i hi = down4SSE4(src0 + 2 * q + 8, src1 + 2 * q + 8);
+            _mm_storeu_si128((__m128i*)(dst + q), _mm_packus_epi32(lo, hi));
+        }
+        downRowScalar(src0 + 2 * q, src1 + 2 * q, dst + q, n - q);
+    }
+
+    SIMD_TARGET_SSE4 static inline __m128i normSSE4(__m128i dx, __m128i dy) {
+        const __m128 half = _mm_set1_ps(0.5f);
+        __m128i lo = _mm_unpacklo_epi16(dx, dy);
+        __m128i hi = _mm_unpackhi_epi16(dx, dy);
+        __m128 nlo = _mm_add_ps(_mm_sqrt_ps(_mm_cvtepi32_ps(_mm_madd_epi16(lo, lo))), half);
+        __m128 nhi = _mm_add_ps(_mm_sqrt_ps(_mm_cvtepi32_ps(_mm_madd_epi16(hi, hi))), half);
+        return _mm_packus_epi32(_mm_cvttps_epi32(nlo), _mm_cvttps_epi32(nhi));
+    }
+
+    SIMD_TARGET_SSE4 static void gradRowSSE4(const uint16_t* I, int stride, int16_t* gx, int16_t* gy, uint16_t* gn, int n) {
+        const __m128i bias = _mm_set1_epi16(short(0x8000));
+        const __m128i ones = _mm_set1_epi16(-1);
+        int q = 1;
+        for(; q + 8 < n; q += 8) {
+            __m128i l = _mm_loadu_si128((const __m128i*)(I + q - 1));
+            __m128i r = _mm_loadu_si128((const __m128i*)(I + q + 1));
+            __m128i t = _mm_loadu_si128((const __m128i*)(I + q - stride));
+            __m128i b = _mm_loadu_si128((const __m128i*)(I + q + stride));
+            __m128i dx = _mm_xor_si128(_mm_avg_epu16(r, _mm_xor_si128(l, ones)), bias);
+            __m128i dy = _mm_xor_si128(_mm_avg_epu16(b, _mm_xor_si128(t, ones)), bias);
+            _mm_storeu_si128((__m128i*)(gx + q), dx);
+            _mm_storeu_si128((__m128i*)(gy + q), dy);
+            _mm_storeu_si128((__m128i*)(gn + q), normSSE4(dx, dy));
+        }
+        gradRange(I, stride, gx, gy, gn, q, n);
+    }
+
+    //////////////////////////////////////////// AVX2 ////////////////////////////////////////////
+
+    SIMD_TARGET_AVX2 static void loadRowAVX2(const uint8_t* src, uint16_t* dst, int n) {
+        int q = 0;
+        for(; q + 16 <= n; q += 16) {
+            __m256i x = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*)(src + q)));
+            _mm256_storeu_si256((__m256i*)(dst + q), _mm256_slli_epi16(x, PYR_FRAC_BITS));
+        }
+        loadRowScalar(src + q, dst + q, n - q);
+    }
+
+    SIMD_TARGET_AVX2 static inline __m256i down8AVX2(const uint16_t* src0, const uint16_t* src1) {
+        const __m256i bias = _mm256_set1_epi16(short(0x8000));
+        const __m256i ones = _mm256_set1_epi16(1);
+        __m256i a = _mm256_madd_epi16(_mm256_xor_si256(_mm256_loadu_si256((const __m256i*)src0), bias), ones);
+        __m256i b = _mm256_madd_epi16(_mm256_xor_si256(_mm256_loadu_si256((const __m256i*)src1), bias), ones);
+        __m256i sum = _mm256_add_epi32(_mm256_add_epi32(a, b), _mm256_set1_epi32(4 * 0x8000));
+        return _mm256_srli_epi32(sum, 2);
+    }
+
+    SIMD_TARGET_AVX2 static void downRowAVX2(const uint16_t* src0, const uint16_t* src1, uint16_t* dst, int n) {
+        int q = 0;
+        for(; q + 16 <= n; q += 16) {
+            __m256i lo = down8AVX2(src0 + 2 * q,      src1 + 2 * q);
+            __m256i hi = down8AVX2(src0 + 2 * q + 16, src1 + 2 * q + 16);
+            // packus works per 128-bit lane, restore the pixel order afterwards
+            __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi32(lo, hi), 0xD8);
+            _mm256_storeu_si256((__m256i*)(dst + q), packed);
+        }
+        downRowScalar(src0 + 2 * q, src1 + 2 * q, dst + q, n - q);
+    }
+
+    SIMD_TARGET_AVX2 static inline __m256i normAVX2(__m256i dx, __m256i dy) {
+        const __m256 half = _mm256_set1_ps(0.5f);
+        __m256i lo = _mm256_unpacklo_epi16(dx, dy);
+        __m256i hi = _mm256_unpackhi_epi16(dx, dy);
+        __m256 nlo = _mm256_add_ps(_mm256_sqrt_ps(_mm256_cvtepi32_ps(_mm256_madd_epi16(lo, lo))), half);
+        __m256 nhi = _mm256_add_ps(_mm256_sqrt_ps(_mm256_cvtepi32_ps(_mm256_madd_epi16(hi, hi))), half);
+        // unpack and pack are both in-lane, so the pixel order comes out right
+        return _mm256_packus_epi32(_mm256_cvttps_epi32(nlo), _mm256_cvttps_epi32(nhi));
+    }
+
+    SIMD_TARGET_AVX2 static void gradRowAVX2(const uint16_t* I, int stride, int16_t* gx, int16_t* gy, uint16_t* gn, int n) {
+        const __m256i bias = _mm256_set1_epi16(short(0x8000));
+        const __m256i ones = _mm256_set1_epi16(-1);
+        int q = 1;
+        for(; q + 16 < n; q += 16) {
+            __m256i l = _mm256_loadu_si256((const __m256i*)(I + q - 1));
+            __m256i r = _mm256_loadu_si256((const __m256i*)(I + q + 1));
+            __m256i t = _mm256_loadu_si256((const __m256i*)(I + q - stride));
+            __m256i b = _mm256_loadu_si256((const __m256i*)(I + q + stride));
+            __m256i dx = _mm256_xor_si256(_mm256_avg_epu16(r, _mm256_xor_si256(l, ones)), bias);
+            __m256i dy = _mm256_xor_si256(_mm256_avg_epu16(b, _mm256_xor_si256(t, ones)), bias);
+            _mm256_storeu_si256((__m256i*)(gx + q), dx);
+            _mm256_storeu_si256((__m256i*)(gy + q), dy);
+            _mm256_storeu_si256((__m256i*)(gn + q), normAVX2(dx, dy));
+        }
+        gradRange(I, stride, gx, gy, gn, q, n);
+    }
+#endif
+
+    static Kernels kernelsOf(simd::InstructionSet set) {
+#if SIMPLE_VIO_X86_SIMD
+        if(set == simd::AVX2) {
+            Kernels k = {loadRowAVX2, downRowAVX2, gradRowAVX2};
+            return k;
+        }
+        if(set == simd::SSE4) {
+            Kernels k = {loadRowSSE4, downRowSSE4, gradRowSSE4};
+            return k;
+        }
+#endif
+        Kernels k = {loadRowScalar, downRowScalar, gradRowScalar};
+        return k;
+    }
+
+    static simd::InstructionSet instructionSet = simd::detect();
+    static Kernels kernels = kernelsOf(instructionSet);
+
+    void setInstructionSet(simd::InstructionSet set) {
+        instructionSet = set > simd::detect() ? simd::detect() : set;
+        kernels = kernelsOf(instructionSet);
+    }
+
+    simd::InstructionSet getInstructionSet() {
+        return instructionSet;
+    }
+
+    //! gradients of row p - 1 only need rows p - 2 .. p, so they are computed right behind the intensity rows
+    static inline void gradBehind(ImgLevel& dst, int p, const Kernels& k) {
+        if(p < 2)
+            return;
+        const int offset = (p - 1) * dst.stride;
+        k.grad(dst.intensity.data() + offset, dst.stride,
+               dst.gradX.data() + offset, dst.gradY.data() + offset, dst.gradNorm.data() + offset, dst.width);
+    }
+
+    void buildBaseLevel(const uint8_t* pic, int width, int height, int step, ImgLevel& dst) {
+        const Kernels k = kernels;
+        dst.resize(width, height);
+        for(int p = 0; p < height; ++p) {
+            k.load(pic + p * step, dst.row(p), width);
+            gradBehind(dst, p, k);
+        }
+    }
+
+    void buildLevel(const ImgLevel& src, ImgLevel& dst) {
+        const Kernels k = kernels;
+        dst.resize(src.width / 2, src.height / 2);
+        for(int p = 0; p < dst.height; ++p) {
+            k.down(src.row(2 * p), src.row(2 * p + 1), dst.row(p), dst.width);
+            gradBehind(dst, p, k);
+        }
+    }
+
+    void buildBaseLevelRemap(const uint8_t* pic, int width, int height, int step, const RemapTables& map,
+                             ImgLevel& dst) {
+        const Kernels k = kernels;
+        dst.resize(width, height);
+        for(int p = 0; p < height; ++p) {
+            remapRow(pic, width, height, step, map.xy + 2 * p * width, map.frac + p * width, dst.row(p), width);
+            gradBehind(dst, p, k);
+        }
+    }
+
+    void buildBaseIntensityRemap(const uint8_t* pic, int width, int height, int step, const RemapTables& map,
+                                 ImgLevel& dst) {
+        dst.setSize(width, height);
+        dst.allocIntensity();
+        for(int p = 0; p < height; ++p)
+            remapRow(pic, width, height, step, map.xy + 2 * p * width, map.frac + p * width, dst.row(p), width);
+    }
+
+    void buildBaseIntensity(const uint8_t* pic, int width, int height, int step, ImgLevel& dst) {
+        const Kernels k = kernels;
+        dst.setSize(width, height);
+        dst.allocIntensity();
+        for(int p = 0; p < height; ++p)
+            k.load(pic + p * step, dst.row(p), width);
+    }
+
+    void buildIntensity(const ImgLevel& src, ImgLevel& dst) {
+        const Kernels k = kernels;
+        dst.setSize(src.width / 2, src.height / 2);
+        dst.allocIntensity();
+        for(int p = 0; p < dst.height; ++p)
+            k.down(src.row(2 * p), src.row(2 * p + 1), dst.row(p), dst.width);
+    }
+
+    void buildGradient(ImgLevel& img) {
+        const Kernels k = kernels;
+        img.allocGradient();
+        for(int p = 2; p < img.height; ++p)
+            gradBehind(img, p, k);
+    }
+}
@@ -0,0 +1,41 @@
+#ifndef SIMPLE_VIO_PYRAMIDKERNEL_H
+#define SIMPLE_VIO_PYRAMIDKERNEL_H
+
+#include <cstdint>
+
+#include "DataStructure/cv/ImgPyr.h"
+#include "util/simd.h"
+
+namespace pyramid {
+
+    /// force a kernel set (benchmarks and tests), an unsupported set falls back to the best available one.
+    void setInstructionSet(simd::InstructionSet set);
+    simd::InstructionSet getInstructionSet();
+
+    /// level 0 from an 8-bit image: intensity, gradients and gradient norm in one pass over the rows.
+    void buildBaseLevel(const uint8_t* pic, int width, int height, int step, ImgLevel& dst);
+
+    /// level i from level i - 1: 2x2 box downsample, gradients and gradient norm in one pass over the rows.
+    void buildLevel(const ImgLevel& src, ImgLevel& dst);
+
+    /// fixed point remap tables as cv::initUndistortRectifyMap builds them with CV_16SC2: the raw pixel of each
+    /// rectified one and a 5 + 5 bit fraction index (fy * 32 + fx), both continuous and as large as the image.
+    struct RemapTables {
+        const int16_t*  xy;
+        const uint16_t* frac;
+    };
+
+    /// level 0 rectified on the fly from a raw 8-bit image: the bilinear sample goes straight into Q8, without
+    /// the 8-bit rectified image in between. raw pixels outside the image are black, as for cv::undistort.
+    void buildBaseLevelRemap(const uint8_t* pic, int width, int height, int step, const RemapTables& map,
+                             ImgLevel& dst);
+
+    /// split passes for lazily materialised levels: intensity only, then gradients of an existing level.
+    void buildBaseIntensity(const uint8_t* pic, int width, int height, int step, ImgLevel& dst);
+    void buildBaseIntensityRemap(const uint8_t* pic, int width, int height, int step, const RemapTables& map,
+                                 ImgLevel& dst);
+    void buildIntensity(const ImgLevel& src, ImgLevel& dst);
+    void buildGradient(ImgLevel& img);
+}
+
+#endif //SIMPLE_VIO_PYRAMIDKERNEL_H
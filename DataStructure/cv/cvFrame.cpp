@@ -1,4 +1,8 @@
 #include "cvFrame.h"
+#include "PyramidKernel.h"
+#include "util/Trace.h"
+
+int cvFrame::frame_counter_ = 0;
 
 cvMeasure& cvFrame::getMeasure() {
     return cvData;
@@ -25,85 +29,81 @@ const cvFrame::Pic_t& cvFrame::getPicture() {
 }
 
 int cvFrame::getWidth(int level) {
-    return cvData.measurement.width[level];
+    return cvData.measurement.imgPyr[level].width;
 }
 
 int cvFrame::getHeight(int level) {
-    return cvData.measurement.height[level];
+    return cvData.measurement.imgPyr[level].height;
 }
 
+static const double pyrScale = 1.0 / PYR_ONE;
+
 double cvFrame::getIntensity(int u, int v, int level) {
-    if(u < 0 || v < 0 || level > IMG_LEVEL)
+    if(u < 0 || v < 0 || level >= IMG_LEVEL)
         return -1.0;
 
-    int rows = cvData.measurement.height[level];
-    int cols = cvData.measurement.width[level];
+    const ImgLevel& img = intensityLevel(level);
 
-    if(u >= cols || v >= rows)
+    if(u >= img.width || v >= img.height)
         return -1.0;
 
-    return cvData.measurement.imgPyr[level][v * cols + u][0];
+    return img.intensity[v * img.stride + u] * pyrScale;
 }
 
 double cvFrame::getIntensityBilinear(double u, double v, int level) {
-    int rows = cvData.measurement.height[level];
-    int cols = cvData.measurement.width[level];
+    const ImgLevel& img = intensityLevel(level);
 
-    if(u >= cols || v >= rows)
+    if(u < 0 || v < 0 || u >= img.width || v >= img.height)
         return -1.0;
 
-    int ui = int(std::floor(u));    int vi = int(std::floor(v));
+    int ui = int(u);    int vi = int(v);
     double ud = u - ui;        double vd = v - vi;
-//    printf("u: %lf, v: %lf\n",u,v);
-    double leftTop     = cvData.measurement.imgPyr[level][vi * cols + ui](0);
-    double rightTop    = cvData.measurement.imgPyr[level][vi * cols + ui + 1](0);
-    double leftBottom  = cvData.measurement.imgPyr[level][vi * cols + cols + ui](0);
-    double rightBottom = cvData.measurement.imgPyr[level][vi * cols + cols + ui + 1](0);
 
-    double row1 = leftTop * (1 - ud) + ud * rightTop;
-    double row2 = leftBottom * (1 - ud) + ud * rightBottom;
-//    printf("row1: %lf,row2: %lf,ud: %lf,vd: %lf; lt %lf,rt %lf,lb %lf,rb %lf\n",row1,row2,ud,vd,leftTop,rightTop,leftBottom,rightBottom);
-    return row1 * (1 - vd) + row2 * vd;
+    const uint16_t* ptr = img.intensity.data() + vi * img.stride + ui;
+    double row1 = ptr[0] * (1 - ud) + ud * ptr[1];
+    double row2 = ptr[img.stride] * (1 - ud) + ud * ptr[img.stride + 1];
+    return (row1 * (1 - vd) + row2 * vd) * pyrScale;
 }
 
 Eigen::Vector2d cvFrame::getGradBilinear(double u, double v, int level){
-    int rows = cvData.measurement.height[level];
-    int cols = cvData.measurement.width[level];
+    const ImgLevel& img = gradientLevel(level);
 
-    if(u >= cols || v >= rows)
+    if(u < 0 || v < 0 || u >= img.width || v >= img.height)
         return Eigen::Vector2d::Zero();
 
-    int ui = int(std::floor(u));    int vi = int(std::floor(v));
+    int ui = int(u);    int vi = int(v);
     double ud = u - ui;        double vd = v - vi;
 
-    const Eigen::Vector2d& leftTop     = cvData.measurement.imgPyr[level][vi * cols + ui].block<2, 1>(1, 0);
-    const Eigen::Vector2d& rightTop    = cvData.measurement.imgPyr[level][vi * cols + ui + 1].block<2, 1>(1, 0);
-    const Eigen::Vector2d& leftBottom  = cvData.measurement.imgPyr[level][vi * cols + cols + ui].block<2, 1>(1, 0);
-    const Eigen::Vector2d& rightBottom = cvData.measurement.imgPyr[level][vi * cols + cols + ui + 1].block<2, 1>(1, 0);
-
-    Eigen::Vector2d row1 = leftTop * (1 - ud) + ud * rightTop;
-    Eigen::Vector2d row2 = leftBottom * (1 - ud) + ud * rightBottom;
+    const int offset = vi * img.stride + ui;
+    const int16_t* gx = img.gradX.data() + offset;
+    const int16_t* gy = img.gradY.data() + offset;
 
-    return row1 * (1 - vd) + row2 * vd;
+    double w00 = (1 - ud) * (1 - vd);
+    double w10 = ud * (1 - vd);
+    double w01 = (1 - ud) * vd;
+    double w11 = ud * vd;
+    return Eigen::Vector2d(w00 * gx[0] + w10 * gx[1] + w01 * gx[img.stride] + w11 * gx[img.stride + 1],
+                           w00 * gy[0] + w10 * gy[1] + w01 * gy[img.stride] + w11 * gy[img.stride + 1]) * pyrScale;
 }
 
 
 bool cvFrame::getGrad(int u, int v, cvFrame::grad_t&  out, int level) {
-    if(u < 0 || v < 0 || level > IMG_LEVEL)
+    if(u < 0 || v < 0 || level >= IMG_LEVEL)
         return false;
 
-    int rows = cvData.measurement.height[level];
-    int cols = cvData.measurement.width[level];
+    const ImgLevel& img = gradientLevel(level);
 
-    if(u >= cols || v >= rows)
+    if(u >= img.width || v >= img.height)
         return false;
 
-    out =  cvData.measurement.imgPyr[level][v * cols + u].segment<2>(1);
+    out = grad_t(img.gradX[v * img.stride + u], img.gradY[v * img.stride + u]) * pyrScale;
     return true;
 }
 
-cvFrame::cvFrame(const std::shared_ptr<AbstractCamera> &cam, Pic_t &pic, okvis::Time time) {
+cvFrame::cvFrame(const std::shared_ptr<AbstractCamera> &cam, Pic_t &pic, okvis::Time time, bool rectify) {
     cam_ = cam;
+    rectify_ = rectify && !cam->undistortMap1().empty();
+    cvData.id = frame_counter_++;
     //pose_ = Sophus::SE3d::exp(Eigen::Matrix<double, 6, 1>::Zero());
     cvData.measurement.pic = pic;
     int rows = pic.rows;
@@ -113,65 +113,101 @@ cvFrame::cvFrame(const std::shared_ptr<AbstractCamera> &cam, Pic_t &pic, okvis::
     // for a point(u,v) in cell(on the l level): (u,v,l) , occupy[(4^l-1)/3 + v*2^l + u]
     memset(occupy, 0, sizeof(bool) * detectCellWidth * detectCellHeight * detectHeightGrid * detectWidthGrid);
     memset(cell, 0, sizeof(bool) * detectCellWidth * detectCellHeight);
+    // only the geometry here, the planes are built by the first access to a level
     for(int i = 0; i < IMG_LEVEL; ++i) {
         if(i != 0) {
             rows /= 2;
             cols /= 2;
         }
+        cvData.measurement.imgPyr[i].setSize(cols, rows);
+        intensityReady_[i] = false;
+        gradientReady_[i] = false;
+    }
+}
 
-        cvData.measurement.width[i]  = cols;
-        cvData.measurement.height[i] = rows;
-        cvData.measurement.imgPyr[i].assign(cvData.measurement.width[i] * cvData.measurement.height[i], Eigen::Vector3d::Zero());
-        cvData.measurement.gradNormPyr[i].assign(cvData.measurement.width[i] * cvData.measurement.height[i], 0.0);
-
-        if(i == 0) {
-            for(int p = 0; p < rows; p++) {
-                for(int q = 0; q < cols; q++) {
-                    cvData.measurement.imgPyr[i][p * cols + q][0] = double(pic.at<u_char>(p, q));
-                }
-            }
-        }
+const ImgLevel& cvFrame::intensityLevel(int level) {
+    if(!intensityReady_[level].load(std::memory_order_acquire))
+        materializeIntensity(level);
+    return cvData.measurement.imgPyr[level];
+}
 
-        else {
-            for(int p = 0; p < rows; p++) {
-                for(int q = 0; q < cols; q++)
-                    cvData.measurement.imgPyr[i][p * cols + q][0]
-                            = 0.25 * (  cvData.measurement.imgPyr[i - 1][p * cols * 4          + q * 2][0]
-                                      + cvData.measurement.imgPyr[i - 1][p * cols * 4          + q * 2 + 1][0]
-                                      + cvData.measurement.imgPyr[i - 1][p * cols * 4 + 2*cols + q * 2 + 1][0]
-                                      + cvData.measurement.imgPyr[i - 1][p * cols * 4 + 2*cols + q * 2][0]);
-            }
-        }
+const ImgLevel& cvFrame::gradientLevel(int level) {
+    if(!gradientReady_[level].load(std::memory_order_acquire))
+        materializeGradient(level);
+    return cvData.measurement.imgPyr[level];
+}
 
-        for(int p = 1; p < rows - 1; ++p) {
-            for (int q = 1; q < cols - 1; ++q) {
-                cvData.measurement.imgPyr[i][p * cols + q][1]
-                        = 0.5 * (cvData.measurement.imgPyr[i][p * cols + q + 1][0]
-                               - cvData.measurement.imgPyr[i][p * cols + q - 1][0]);
-                cvData.measurement.imgPyr[i][p * cols + q][2]
-                        = 0.5 * (cvData.measurement.imgPyr[i][p * cols + q + cols][0]
-                               - cvData.measurement.imgPyr[i][p * cols + q - cols][0]);
+void cvFrame::materializeIntensity(int level) {
+    std::call_once(intensityOnce_[level], [this, level] {
+        TRACE_SCOPE("pyramid level");
+        ImgPyr_t& pyr = cvData.measurement.imgPyr;
+        if(level == 0)
+            buildBaseLevel(false);
+        else
+            pyramid::buildIntensity(intensityLevel(level - 1), pyr[level]);
+        intensityReady_[level].store(true, std::memory_order_release);
+    });
+}
 
-                cvData.measurement.gradNormPyr[i][p * cols + q]
-                        = std::sqrt(cvData.measurement.imgPyr[i][p * cols + q][1] * cvData.measurement.imgPyr[i][p * cols + q][1]
-                                  + cvData.measurement.imgPyr[i][p * cols + q][2] * cvData.measurement.imgPyr[i][p * cols + q][2]);
+void cvFrame::materializeGradient(int level) {
+    intensityLevel(level);
+    std::call_once(gradientOnce_[level], [this, level] {
+        TRACE_SCOPE("pyramid gradient");
+        pyramid::buildGradient(cvData.measurement.imgPyr[level]);
+        gradientReady_[level].store(true, std::memory_order_release);
+    });
+}
 
-            }
-        }
+void cvFrame::preparePyramid() {
+    TRACE_SCOPE("pyramid");
+    ImgPyr_t& pyr = cvData.measurement.imgPyr;
+    for(int i = 0; i < IMG_LEVEL; ++i) {
+        if(gradientReady_[i].load(std::memory_order_acquire))
+            continue;
+
+        // an untouched level gets one fused pass, a level read lazily before only misses its gradients
+        std::call_once(intensityOnce_[i], [this, i, &pyr] {
+            if(i == 0)
+                buildBaseLevel(true);
+            else
+                pyramid::buildLevel(pyr[i - 1], pyr[i]);
+            std::call_once(gradientOnce_[i], [this, i] {
+                gradientReady_[i].store(true, std::memory_order_release);
+            });
+            intensityReady_[i].store(true, std::memory_order_release);
+        });
+        gradientLevel(i);
     }
 }
 
+void cvFrame::buildBaseLevel(bool gradients) {
+    const Pic_t& pic = cvData.measurement.pic;
+    ImgLevel& dst = cvData.measurement.imgPyr[0];
+    if(!rectify_) {
+        if(gradients)
+            pyramid::buildBaseLevel(pic.ptr<uint8_t>(0), pic.cols, pic.rows, int(pic.step[0]), dst);
+        else
+            pyramid::buildBaseIntensity(pic.ptr<uint8_t>(0), pic.cols, pic.rows, int(pic.step[0]), dst);
+        return;
+    }
+
+    const pyramid::RemapTables map = {cam_->undistortMap1().ptr<int16_t>(0), cam_->undistortMap2().ptr<uint16_t>(0)};
+    if(gradients)
+        pyramid::buildBaseLevelRemap(pic.ptr<uint8_t>(0), pic.cols, pic.rows, int(pic.step[0]), map, dst);
+    else
+        pyramid::buildBaseIntensityRemap(pic.ptr<uint8_t>(0), pic.cols, pic.rows, int(pic.step[0]), map, dst);
+}
+
 double cvFrame::getGradNorm(int u, int v, int level) {
-    if(u < 0 || v < 0 || level > IMG_LEVEL)
+    if(u < 0 || v < 0 || level >= IMG_LEVEL)
         return -1.0;
 
-    int rows = cvData.measurement.height[level];
-    int cols = cvData.measurement.width[level];
+    const ImgLevel& img = gradientLevel(level);
 
-    if(u >= cols || v >= rows)
+    if(u >= img.width || v >= img.height)
         return -1.0;
 
-    return cvData.measurement.gradNormPyr[level][v * cols + u];
+    return img.gradNorm[v * img.stride + u] * pyrScale;
 }
 
 cvFrame::~cvFrame() {
@@ -207,7 +243,7 @@ pose_t cvFrame::getPose() {
     pose_mutex.lock_shared();
     auto pose = pose_;
     pose_mutex.unlock_shared();
-    return pose_;
+    return pose;
 }
 
 void cvFrame::setPose(pose_t &pose) {
@@ -3,6 +3,8 @@
 
 #include <memory>
 #include <array>
+#include <mutex>
+#include <atomic>
 #include <sophus/se3.hpp>
 #include <opencv2/opencv.hpp>
 
@@ -10,7 +12,9 @@
 #include <boost/thread/pthread/shared_mutex.hpp>
 
 #include "util/setting.h"
+#include "util/PoolAllocator.h"
 #include "DataStructure/Measurements.h"
+#include "DataStructure/cv/ImgPyr.h"
 #include "DataStructure/cv/Camera/VIOPinholeCamera.h"
 
 static const int cellNumbel[5]=
@@ -36,18 +40,12 @@ struct cvData {
 public:
     EIGEN_MAKE_ALIGNED_OPERATOR_NEW
     typedef cv::Mat                                                  Pic_t;                  //! raw image
-    typedef std::vector<Eigen::Vector3d>                             Img_t;
-    typedef std::array<Img_t, IMG_LEVEL>                             ImgPyr_t;               //!< Image Pyramid.
-    typedef std::vector<double, Eigen::aligned_allocator<double>>    GradNorm_t;
-    typedef std::array<GradNorm_t, IMG_LEVEL>                        GradNormPyr_t;
+    typedef ImgLevel                                                 Img_t;
+    typedef ::ImgPyr_t                                               ImgPyr_t;               //!< Image Pyramid, planar Q8.
 
 public:
-    int              width[IMG_LEVEL];
-    int              height[IMG_LEVEL];
-
     Pic_t            pic;
     ImgPyr_t         imgPyr;
-    GradNormPyr_t    gradNormPyr;
 };
 
 
@@ -55,7 +53,8 @@ struct cvMeasure : public MeasurementBase<cvData> {
 public:
     typedef cvData::ImgPyr_t                        ImgPyr_t;
     typedef cvData::Pic_t                           Pic_t;
-    typedef std::list<std::shared_ptr<Feature>>     features_t;     //!< List of features in the image.
+    typedef std::list<std::shared_ptr<Feature>,
+                      PoolAllocator<std::shared_ptr<Feature>>> features_t; //!< List of features in the image, pooled nodes.
     typedef std::vector<std::shared_ptr<Feature>>   keyPoints_t;    //!< Five features and associated 3D points which are used to detect if two frames have overlapping field of view.
     typedef std::shared_ptr<AbstractCamera>         cam_t;
 
@@ -80,7 +79,9 @@ public:
     typedef Eigen::Vector2d             grad_t;
 
 public:
-    cvFrame(const std::shared_ptr<AbstractCamera>& cam, Pic_t &pic, okvis::Time time = okvis::Time());
+    /// rectify: pic is the raw image and level 0 is rectified through the camera's remap tables as it is built
+    cvFrame(const std::shared_ptr<AbstractCamera>& cam, Pic_t &pic, okvis::Time time = okvis::Time(),
+            bool rectify = false);
     ~cvFrame();
     const std::shared_ptr<Feature>& addFeature(const std::shared_ptr<Feature>& ft);
 
@@ -105,6 +106,9 @@ public:
     double getGradNorm(int u, int v, int level = 0);
     int getWidth(int level = 0);
     int getHeight(int level = 0);
+    void preparePyramid();                  //!< materialise every level with the fused kernels, before reading imgPyr directly
+    const ImgLevel& intensityLevel(int level);  //!< level with its intensity plane materialised
+    const ImgLevel& gradientLevel(int level);   //!< level with its intensity and gradient planes materialised
     cvMeasure& getMeasure();
     bool checkOccupy(int u,int v);
     void setCellTrue(int u, int v);
@@ -116,6 +120,11 @@ public:
 public:
     static int         frame_counter_;         //!< Counts the number of created frames. Used to set the unique id.
 
+private:
+    void materializeIntensity(int level);
+    void materializeGradient(int level);
+    void buildBaseLevel(bool gradients);
+
 private:
     cvMeasure           cvData;
     pose_t              pose_;                                               //!< Transform frame from world.
@@ -123,9 +132,14 @@ private:
     cov_t               Cov_;                                                //!< Covariance.
     cam_t               cam_;                                                //!< Camera model.
     bool                is_keyframe_;                                        //!< Was this frames selected as keyframe?
+    bool                rectify_;                                            //!< pic is raw, level 0 is rectified
     int                 last_published_ts_;                                  //!< Timestamp of last publishing.
     bool occupy[detectCellWidth * detectCellHeight * detectHeightGrid * detectWidthGrid];  //!< whether cell is occupy by features
     bool cell[detectCellWidth * detectCellHeight];                           //!< whether the big cell is occupied
+    std::once_flag      intensityOnce_[IMG_LEVEL];                           //!< levels are built on first access
+    std::once_flag      gradientOnce_[IMG_LEVEL];
+    std::atomic_bool    intensityReady_[IMG_LEVEL];
+    std::atomic_bool    gradientReady_[IMG_LEVEL];
 };
 
 typedef std::shared_ptr<cvFrame> cvframePtr_t;
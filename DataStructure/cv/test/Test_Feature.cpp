@@ -0,0 +1,45 @@
+#include <deque>
+#include <random>
+
+#include <opencv2/ts/ts.hpp>
+#include "../cvFrame.h"
+#include "../Feature.h"
+#include "../Point.h"
+#include "IO/camera/CameraIO.h"
+#include "util/util.h"
+
+TEST(Feature, pooled) {
+    std::string camDatafile = "../testData/mav0/cam1/data.csv";
+    std::string camParamfile ="../testData/mav0/cam1/sensor.yaml";
+    CameraIO camTest(camDatafile,camParamfile);
+    const CameraIO::pCamereParam cam = camTest.getCamera();
+    cv::Mat pic(480, 752, CV_8UC1, cv::Scalar(0));
+    std::shared_ptr<cvFrame> frame = std::make_shared<cvFrame>(cam, pic);
+
+    // a window of 10 frames of 500 features, each with its point and the point's observation
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    std::deque<cvMeasure::features_t> window;
+    std::weak_ptr<Point> firstPoint;
+    size_t warmChunks = 0;
+    TimeUse time(__FUNCTION__, __LINE__);
+    for(int n = 0; n < 100; ++n) {
+        if(n == 20)
+            warmChunks = poolChunks();
+        cvMeasure::features_t fts;
+        for(int k = 0; k < 500; ++k) {
+            std::shared_ptr<Feature> ft = makeFeature(frame, Eigen::Vector2d(uniform(rng) * 752, uniform(rng) * 480), 0);
+            ft->point->obs_.push_back(ft);
+            fts.push_back(ft);
+        }
+        if(n == 0)
+            firstPoint = fts.front()->point;
+        window.push_back(std::move(fts));
+        if(window.size() > 10)
+            window.pop_front();
+    }
+
+    // the point only holds its features weakly, nothing of the first frame is left
+    EXPECT_TRUE(firstPoint.expired());
+    EXPECT_EQ(poolChunks(), warmChunks);
+}
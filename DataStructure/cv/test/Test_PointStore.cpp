@@ -0,0 +1,102 @@
+#include <set>
+#include <thread>
+#include <vector>
+
+#include <opencv2/ts/ts.hpp>
+#include "../PointStore.h"
+#include "../Point.h"
+#include "util/util.h"
+
+// a released handle comes back with fresh counters, its write count keeps going so an old version stays stale
+TEST(PointStore, reuse) {
+    PointStore &store = PointStore::instance();
+    const PointStore::Handle h = store.allocate(Eigen::Vector3d(1, 2, 3), 5.0);
+    unsigned version;
+    EXPECT_EQ(store.position(h, version), Eigen::Vector3d(1, 2, 3));
+    EXPECT_EQ(store.information(h), 5.0);
+    EXPECT_EQ(store.lastProjectedKf(h).load(), -1);
+    store.succeeded(h)++;
+    store.failed(h) += 2;
+    store.release(h);
+
+    const PointStore::Handle g = store.allocate(Eigen::Vector3d(4, 5, 6), 1.0);
+    EXPECT_EQ(g, h);
+    EXPECT_EQ(store.succeeded(g).load(), 0);
+    EXPECT_EQ(store.failed(g).load(), 0);
+    EXPECT_FALSE(store.setPosition(g, Eigen::Vector3d::Zero(), version));
+    EXPECT_EQ(store.position(g), Eigen::Vector3d(4, 5, 6));
+
+    EXPECT_DOUBLE_EQ(store.updateDepth(g, 12.0, 1.0), 1.5);
+    Eigen::Vector3d pos;
+    double information;
+    store.estimate(g, pos, information);
+    EXPECT_EQ(pos, Eigen::Vector3d(6, 7.5, 9));
+    EXPECT_EQ(information, 2.0);
+    store.release(g);
+}
+
+// points share the arrays, a gather over their handles is what the point accessors return
+TEST(PointStore, gather) {
+    std::vector<std::shared_ptr<Point>> points;
+    std::vector<PointStore::Handle> handles;
+    for(int k = 0; k < 5000; ++k) {
+        points.push_back(makePoint(Eigen::Vector3d(k, -k, 1.0 + k)));
+        points.back()->setDepthInformation(k);
+        handles.push_back(points.back()->handle());
+    }
+    std::vector<Eigen::Vector3d> pos(handles.size());
+    std::vector<double> information(handles.size());
+    {
+        TimeUse time("gather", __LINE__);
+        PointStore::instance().gather(handles.data(), handles.size(), pos.data(), information.data());
+    }
+    for(size_t k = 0; k < points.size(); ++k) {
+        EXPECT_EQ(pos[k], points[k]->getPos());
+        EXPECT_EQ(information[k], points[k]->getDepthInformation());
+    }
+    points[7]->n_succeeded_reproj_++;
+    EXPECT_EQ(PointStore::instance().succeeded(handles[7]).load(), 1);
+}
+
+// threads create and drop points concurrently, no handle is live twice and the store stops growing
+TEST(PointStore, threads) {
+    const int threadNum = 4, rounds = 200, live = 500;
+    PointStore &store = PointStore::instance();
+    const size_t used = store.used();
+    std::vector<std::thread> threads;
+    std::vector<std::vector<std::shared_ptr<Point>>> kept(threadNum);
+    std::vector<int> wrong(threadNum, 0);
+    size_t warmCapacity = 0;
+    for(int t = 0; t < threadNum; ++t)
+        threads.push_back(std::thread([&, t] {
+            std::vector<std::shared_ptr<Point>> points;
+            for(int r = 0; r < rounds; ++r) {
+                for(int k = 0; k < live; ++k)
+                    points.push_back(makePoint(Eigen::Vector3d(t, r, k)));
+                for(int k = 0; k < live; ++k)
+                    wrong[t] += points[k]->getPos() != Eigen::Vector3d(t, r, k);
+                if(r == rounds - 1)
+                    kept[t].swap(points);
+                points.clear();
+            }
+        }));
+    for(auto &t : threads)
+        t.join();
+    warmCapacity = store.capacity();
+
+    std::set<PointStore::Handle> handles;
+    for(int t = 0; t < threadNum; ++t) {
+        EXPECT_EQ(wrong[t], 0);
+        for(const auto &p : kept[t])
+            handles.insert(p->handle());
+    }
+    EXPECT_EQ(handles.size(), size_t(threadNum * live));
+    kept.clear();
+    EXPECT_EQ(store.used(), used);
+
+    // a second run fits in what the first one left on the free list
+    std::vector<std::shared_ptr<Point>> points;
+    for(int k = 0; k < threadNum * live; ++k)
+        points.push_back(makePoint(Eigen::Vector3d::Zero()));
+    EXPECT_EQ(store.capacity(), warmCapacity);
+}
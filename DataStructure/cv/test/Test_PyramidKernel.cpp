@@ -0,0 +1,103 @@
+#include <chrono>
+#include <opencv2/ts/ts.hpp>
+
+#include "../PyramidKernel.h"
+#include "IO/camera/CameraIO.h"
+
+static bool sameLevel(const ImgLevel& a, const ImgLevel& b) {
+    return a.width == b.width && a.height == b.height
+           && a.intensity == b.intensity && a.gradX == b.gradX
+           && a.gradY == b.gradY && a.gradNorm == b.gradNorm;
+}
+
+TEST(PyramidKernel, benchmark) {
+    cv::Mat pic = cv::imread("../testData/mav0/cam0/data/1403715278762142976.png", 0);
+    GTEST_ASSERT_NE(pic.empty(), true);
+    GTEST_ASSERT_EQ(pic.type(), CV_8UC1);
+
+    const int repeat = 200;
+    const simd::InstructionSet best = simd::detect();
+    ImgPyr_t reference;
+
+    for(int set = simd::SCALAR; set <= best; ++set) {
+        pyramid::setInstructionSet(simd::InstructionSet(set));
+        ImgPyr_t pyr;
+        double levelTime[IMG_LEVEL] = {0};
+        for(int n = 0; n < repeat; ++n) {
+            for(int i = 0; i < IMG_LEVEL; ++i) {
+                std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+                if(i == 0)
+                    pyramid::buildBaseLevel(pic.ptr<uint8_t>(0), pic.cols, pic.rows, int(pic.step[0]), pyr[0]);
+                else
+                    pyramid::buildLevel(pyr[i - 1], pyr[i]);
+                levelTime[i] += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            }
+        }
+
+        printf("pyramid kernel [%s], %dx%d:\n", simd::name(pyramid::getInstructionSet()), pic.cols, pic.rows);
+        double total = 0.0;
+        for(int i = 0; i < IMG_LEVEL; ++i) {
+            printf("\tlevel %d (%dx%d): %f ms\n", i, pyr[i].width, pyr[i].height, levelTime[i] / repeat);
+            total += levelTime[i] / repeat;
+        }
+        printf("\ttotal: %f ms\n", total);
+
+        if(set == simd::SCALAR)
+            reference = pyr;
+        for(int i = 0; i < IMG_LEVEL; ++i)
+            GTEST_ASSERT_EQ(sameLevel(pyr[i], reference[i]), true);
+    }
+
+    pyramid::setInstructionSet(best);
+}
+
+TEST(PyramidKernel, remap) {
+    CameraIO camIO("../testData/mav0/cam0/data.csv", "../testData/mav0/cam0/sensor.yaml");
+    std::shared_ptr<AbstractCamera> cam = camIO.getCamera();
+    cv::Mat raw = cv::imread("../testData/mav0/cam0/data/1403715278762142976.png", 0);
+    GTEST_ASSERT_NE(raw.empty(), true);
+    GTEST_ASSERT_NE(cam->undistortMap1().empty(), true);
+
+    cv::Mat K(3, 3, CV_64FC1), distCoeffs(4, 1, CV_64FC1);
+    for(int i = 0; i < 3; ++i)
+        for(int j = 0; j < 3; ++j)
+            K.at<double>(i, j) = cam->K()(i, j);
+    for(int i = 0; i < 4; ++i)
+        distCoeffs.at<double>(i, 0) = cam->d(i);
+
+    const int repeat = 50;
+    cv::Mat undistorted, remapped;
+    ImgLevel level0, fused;
+    const pyramid::RemapTables map = {cam->undistortMap1().ptr<int16_t>(0), cam->undistortMap2().ptr<uint16_t>(0)};
+    double undistortMs = 0, remapMs = 0, separateMs = 0, fusedMs = 0;
+    for(int n = 0; n < repeat; ++n) {
+        std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+        cv::undistort(raw, undistorted, K, distCoeffs);
+        std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now();
+        cam->undistortImage(raw, remapped);
+        std::chrono::steady_clock::time_point t2 = std::chrono::steady_clock::now();
+        pyramid::buildBaseLevel(remapped.ptr<uint8_t>(0), remapped.cols, remapped.rows, int(remapped.step[0]), level0);
+        std::chrono::steady_clock::time_point t3 = std::chrono::steady_clock::now();
+        pyramid::buildBaseLevelRemap(raw.ptr<uint8_t>(0), raw.cols, raw.rows, int(raw.step[0]), map, fused);
+        std::chrono::steady_clock::time_point t4 = std::chrono::steady_clock::now();
+
+        undistortMs += std::chrono::duration<double, std::milli>(t1 - t0).count();
+        remapMs     += std::chrono::duration<double, std::milli>(t2 - t1).count();
+        separateMs  += std::chrono::duration<double, std::milli>(t3 - t1).count();
+        fusedMs     += std::chrono::duration<double, std::milli>(t4 - t3).count();
+    }
+    printf("rectification, %dx%d:\n", raw.cols, raw.rows);
+    printf("\tcv::undistort: %f ms, cached remap: %f ms\n", undistortMs / repeat, remapMs / repeat);
+    printf("\tremap + level 0: %f ms, fused: %f ms\n", separateMs / repeat, fusedMs / repeat);
+
+    // the tables are the ones cv::undistort builds for its stripes, up to the rounding of the shifted centre
+    GTEST_ASSERT_LE(cv::norm(undistorted, remapped, cv::NORM_INF), 1);
+
+    // the fused level keeps the fraction the 8-bit image rounds away, they differ by less than a grey level
+    int worst = 0;
+    for(int v = 0; v < fused.height; ++v)
+        for(int u = 0; u < fused.width; ++u)
+            worst = std::max(worst, std::abs(int(fused.row(v)[u]) - int(level0.row(v)[u])));
+    printf("\tlargest difference of level 0: %d / %d\n", worst, PYR_ONE);
+    GTEST_ASSERT_LE(worst, PYR_ONE);
+}
@@ -22,7 +22,7 @@ TEST(cvFrame, cvFrame) {
         cv::Mat img(frame->getHeight(i), frame->getWidth(i), CV_8UC1);
         for(int u = 0; u < img.cols; ++u) {
             for(int v = 0; v < img.rows; ++v) {
-                img.at<u_char>(v, u) = u_char(frame->getMeasure().measurement.imgPyr[i][v * img.cols + u](0));
+                img.at<u_char>(v, u) = u_char(frame->getIntensity(u, v, i));
             }
         }
 
@@ -37,3 +37,71 @@ TEST(cvFrame, cvFrame) {
 
 }
 
+
+TEST(cvFrame, planarPyramid) {
+    cv::Mat pic(480, 752, CV_8UC1);
+    cv::randu(pic, cv::Scalar(0), cv::Scalar(256));
+    std::shared_ptr<cvFrame> frame = std::make_shared<cvFrame>(nullptr, pic);
+    frame->preparePyramid();
+    const cvData::ImgPyr_t& pyr = frame->getMeasure().measurement.imgPyr;
+
+    size_t bytes = 0, vector3dBytes = 0;
+    for(int i = 0; i < IMG_LEVEL; ++i) {
+        bytes += pyr[i].bytes();
+        vector3dBytes += size_t(pyr[i].width) * pyr[i].height * (sizeof(Eigen::Vector3d) + sizeof(double));
+        GTEST_ASSERT_EQ(pyr[i].stride % PYR_STRIDE_ALIGN, 0);
+    }
+    printf("planar pyramid: %zu bytes, Vector3d pyramid: %zu bytes\n", bytes, vector3dBytes);
+    GTEST_ASSERT_LE(bytes * 4, vector3dBytes);
+
+    for(int i = 1; i < IMG_LEVEL; ++i) {
+        for(int v = 1; v < frame->getHeight(i) - 1; v += 7) {
+            for(int u = 1; u < frame->getWidth(i) - 1; u += 5) {
+                double mean = 0.25 * (frame->getIntensity(2 * u, 2 * v, i - 1) + frame->getIntensity(2 * u + 1, 2 * v, i - 1)
+                                    + frame->getIntensity(2 * u, 2 * v + 1, i - 1) + frame->getIntensity(2 * u + 1, 2 * v + 1, i - 1));
+                GTEST_ASSERT_EQ(frame->getIntensity(u, v, i), mean);
+
+                Eigen::Vector2d grad;
+                frame->getGrad(u, v, grad, i);
+                double gx = 0.5 * (frame->getIntensity(u + 1, v, i) - frame->getIntensity(u - 1, v, i));
+                double gy = 0.5 * (frame->getIntensity(u, v + 1, i) - frame->getIntensity(u, v - 1, i));
+                EXPECT_NEAR(grad(0), gx, 1.0 / PYR_ONE);
+                EXPECT_NEAR(grad(1), gy, 1.0 / PYR_ONE);
+                EXPECT_NEAR(frame->getGradNorm(u, v, i), grad.norm(), 1.0 / PYR_ONE);
+            }
+        }
+    }
+}
+
+TEST(cvFrame, lazyPyramid) {
+    cv::Mat pic(480, 752, CV_8UC1);
+    cv::randu(pic, cv::Scalar(0), cv::Scalar(256));
+    std::shared_ptr<cvFrame> lazy  = std::make_shared<cvFrame>(nullptr, pic);
+    std::shared_ptr<cvFrame> eager = std::make_shared<cvFrame>(nullptr, pic);
+    eager->preparePyramid();
+    const cvData::ImgPyr_t& pyr = lazy->getMeasure().measurement.imgPyr;
+
+    for(int i = 0; i < IMG_LEVEL; ++i) {
+        GTEST_ASSERT_EQ(pyr[i].bytes(), size_t(0));
+        GTEST_ASSERT_EQ(lazy->getWidth(i), eager->getWidth(i));
+        GTEST_ASSERT_EQ(lazy->getHeight(i), eager->getHeight(i));
+    }
+
+    // intensity of level 2 pulls in levels 0 and 1 but none of the gradients
+    GTEST_ASSERT_EQ(lazy->getIntensity(100, 50, 2), eager->getIntensity(100, 50, 2));
+    for(int i = 0; i < IMG_LEVEL; ++i) {
+        GTEST_ASSERT_EQ(pyr[i].intensity.empty(), i > 2);
+        GTEST_ASSERT_EQ(pyr[i].gradNorm.empty(), true);
+    }
+
+    GTEST_ASSERT_EQ(lazy->getGradNorm(40, 30, 1), eager->getGradNorm(40, 30, 1));
+    GTEST_ASSERT_EQ(pyr[1].gradNorm.empty(), false);
+
+    lazy->preparePyramid();
+    const cvData::ImgPyr_t& ref = eager->getMeasure().measurement.imgPyr;
+    for(int i = 0; i < IMG_LEVEL; ++i) {
+        GTEST_ASSERT_EQ(pyr[i].intensity == ref[i].intensity, true);
+        GTEST_ASSERT_EQ(pyr[i].gradNorm == ref[i].gradNorm, true);
+        GTEST_ASSERT_EQ(pyr[i].gradX == ref[i].gradX, true);
+    }
+}
@@ -36,9 +36,11 @@ struct IMUMeasure : public MeasurementBase<IMUData> {
     typedef std::shared_ptr<IMUMeasure>                                  IMUMeasure_Ptr;
     typedef Sophus::SE3d                                                 Transformation;
     typedef Eigen::Matrix<double, 9, 1>                                  SpeedAndBias;    ///< speed, b_g, b_a
-    typedef Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic>        covariance_t;
-    typedef Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic>        jacobian_t;
-    typedef Eigen::Matrix<double, Eigen::Dynamic, 1>                     Error_t;
+    typedef Eigen::Matrix<double, 9, 9>                                  covariance_t;    ///< phi, v, p
+    typedef Eigen::Matrix<double, 15, 3>                                 jacobian_t;      ///< dRdb_g, dvdb_a dvdb_g dpdb_a dpdb_g
+    typedef Eigen::Matrix<double, 9, 1>                                  Error_t;         ///< phi, v, p
+    typedef Eigen::Matrix<double, 27, 3>                                 errJacobian_t;   ///< IMU::Jacobian, 9 3x3 blocks
+    typedef Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic>        dynamic_t;       ///< the okvis integration's 15x15
 
     class ImuMeasureDeque : public std::deque<std::shared_ptr<IMUMeasure>> {
     public:
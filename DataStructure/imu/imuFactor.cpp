@@ -7,6 +7,8 @@ imuFactor::imuFactor(const IMUMeasure::Transformation& pose,
     deltaSpeed = speed;
     JBias = jbias;
     this->var = var;
+    // var = L * L^T  ->  var^-1 = L^-T * L^-1
+    sqrtInfo = var.llt().matrixL().solve(IMUMeasure::covariance_t::Identity());
 }
 
 void imuFactor::makeConncect(const connection_t &from, const connection_t &to) {
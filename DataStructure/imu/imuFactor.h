@@ -25,28 +25,34 @@ public:
               const FacJBias_t &jbias, const speed_t &speed, const IMUMeasure::covariance_t &var);
     bool checkConnect(const connection_t &from, const connection_t &to);
     void makeConncect(const connection_t &from, const connection_t &to);
-    const IMUMeasure::Transformation& getPoseFac() {
+    const IMUMeasure::Transformation& getPoseFac() const {
         return deltaPose;
     }
 
-    const speed_t& getSpeedFac() {
+    const speed_t& getSpeedFac() const {
         return deltaSpeed;
     }
 
-    const FacJBias_t& getJBias() {
+    const FacJBias_t& getJBias() const {
         return JBias;
     }
 
-	const IMUMeasure::covariance_t &getVar() {
+	const IMUMeasure::covariance_t &getVar() const {
 		return var;
 	}
 
+    /// S with S^T * S = var^-1, the residual weight. computed once here instead of in every evaluation
+    const IMUMeasure::covariance_t &getSqrtInfo() const {
+        return sqrtInfo;
+    }
+
 private:
     int                          id;
     IMUMeasure::Transformation   deltaPose;
     speed_t                      deltaSpeed;
     FacJBias_t                   JBias;
     IMUMeasure::covariance_t     var;
+    IMUMeasure::covariance_t     sqrtInfo;
     connection_t                 from;
     connection_t                 to;
 };
@@ -11,6 +11,8 @@ typedef IMUMeasure::SpeedAndBias    SpeedAndBias;
 typedef IMUMeasure::covariance_t    covariance_t;
 typedef IMUMeasure::jacobian_t      jacobian_t;
 typedef IMUMeasure::Error_t         Error_t;
+typedef IMUMeasure::errJacobian_t   errJacobian_t;
+typedef IMUMeasure::dynamic_t       dynamic_t;
 typedef Eigen::Vector3d             speed_t;
 typedef Eigen::Matrix<double, 6, 1> bias_t;
 
@@ -45,10 +47,22 @@ int IMU::propagation(const ImuMeasureDeque &imuMeasurements,
     return impl->propagation(imuMeasurements, imuParams, T_WS, speedAndBiases, t_start, t_end, covariance, jacobian);
 }
 
+int IMU::propagation(const ImuMeasureDeque &imuMeasurements,
+                     const ImuParameters &imuParams,
+                     Transformation &T_WS,
+                     SpeedAndBias &speedAndBiases,
+                     okvis::Time &t_start,
+                     okvis::Time &t_end,
+                     dynamic_t *covariance,
+                     dynamic_t *jacobian)
+{
+    return impl->propagation(imuMeasurements, imuParams, T_WS, speedAndBiases, t_start, t_end, covariance, jacobian);
+}
+
 int IMU::error(const pViFrame &frame_i, const pViFrame &frame_j, Error_t &err, void *info) {
     return impl->error(frame_i, frame_j, err, info);
 }
 
-int IMU::Jacobian(const Error_t &err, const pViFrame &frame_i, jacobian_t &jacobian_i, const pViFrame &frame_j, jacobian_t &jacobian_j, void *info) {
+int IMU::Jacobian(const Error_t &err, const pViFrame &frame_i, errJacobian_t &jacobian_i, const pViFrame &frame_j, errJacobian_t &jacobian_j, void *info) {
     return impl->Jacobian(err, frame_i, jacobian_i, frame_j, jacobian_j, info);
 }
@@ -28,10 +28,19 @@ public:
                     okvis::Time &t_end,
                     IMUMeasure::covariance_t* covariance,
                     IMUMeasure::jacobian_t* jacobian);
+    /// the same into dynamic matrices, sized by the integration
+    int propagation(const IMUMeasure::ImuMeasureDeque & imuMeasurements,
+                    const ImuParameters & imuParams,
+                    IMUMeasure::Transformation& T_WS,
+                    IMUMeasure::SpeedAndBias & speedAndBiases,
+                    okvis::Time &t_start,
+                    okvis::Time &t_end,
+                    IMUMeasure::dynamic_t* covariance,
+                    IMUMeasure::dynamic_t* jacobian);
 
     int repropagation();
     int error(const pViFrame& frame_i, const pViFrame& frame_j, IMUMeasure::Error_t &err/* out */, void *info = NULL);
-    int Jacobian(const IMUMeasure::Error_t& err, const pViFrame& frame_i, IMUMeasure::jacobian_t& jacobian_i, const pViFrame& frame_j, IMUMeasure::jacobian_t& jacobian_j, void *info = NULL);
+    int Jacobian(const IMUMeasure::Error_t& err, const pViFrame& frame_i, IMUMeasure::errJacobian_t& jacobian_i, const pViFrame& frame_j, IMUMeasure::errJacobian_t& jacobian_j, void *info = NULL);
 
 private:
     std::shared_ptr<IMUImpl> impl;
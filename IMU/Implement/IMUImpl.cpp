@@ -12,6 +12,22 @@ IMUImpl::~IMUImpl()
 
 }
 
+int IMUImpl::propagation(const ImuMeasureDeque &imuMeasurements, const ImuParameters &imuParams,
+                         Transformation &T_WS, SpeedAndBias &speedAndBiases,
+                         okvis::Time &t_start, okvis::Time &t_end,
+                         dynamic_t *covariance, dynamic_t *jacobian)
+{
+    covariance_t cov;
+    jacobian_t jac;
+    const int ret = propagation(imuMeasurements, imuParams, T_WS, speedAndBiases, t_start, t_end,
+                                covariance ? &cov : nullptr, jacobian ? &jac : nullptr);
+    if(covariance)
+        *covariance = cov;
+    if(jacobian)
+        *jacobian = jac;
+    return ret;
+}
+
 int IMUImpl::repropagation()
 {
     return 0;
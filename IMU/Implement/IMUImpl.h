@@ -12,6 +12,8 @@ typedef IMUMeasure::SpeedAndBias    SpeedAndBias;
 typedef IMUMeasure::covariance_t    covariance_t;
 typedef IMUMeasure::jacobian_t      jacobian_t;
 typedef IMUMeasure::Error_t         Error_t;
+typedef IMUMeasure::errJacobian_t   errJacobian_t;
+typedef IMUMeasure::dynamic_t       dynamic_t;
 typedef Eigen::Vector3d             speed_t;
 typedef Eigen::Matrix<double, 6, 1> bias_t;
 
@@ -31,10 +33,19 @@ public:
                     okvis::Time & t_end,
                     covariance_t* covariance,
                     jacobian_t* jacobian) = 0;
+    /// for callers still holding dynamic matrices, they are resized to what the integration gives
+    virtual int propagation(const ImuMeasureDeque & imuMeasurements,
+                    const ImuParameters & imuParams,
+                    Transformation& T_WS,
+                    SpeedAndBias & speedAndBiases,
+                    okvis::Time & t_start,
+                    okvis::Time & t_end,
+                    dynamic_t* covariance,
+                    dynamic_t* jacobian);
 
     virtual int error(const IMU::pViFrame& frame_i, const IMU::pViFrame& frame_j, Error_t &err/* out */, void *info) = 0;
     virtual int repropagation();
-    virtual int Jacobian(const Error_t& err, const IMU::pViFrame& frame_i, jacobian_t& jacobian_i, const IMU::pViFrame& frame_j, jacobian_t& jacobian_j, void *info) = 0;
+    virtual int Jacobian(const Error_t& err, const IMU::pViFrame& frame_i, errJacobian_t& jacobian_i, const IMU::pViFrame& frame_j, errJacobian_t& jacobian_j, void *info) = 0;
 };
 
 #endif // IMUIMPL_H
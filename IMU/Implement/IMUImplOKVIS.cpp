@@ -14,6 +14,19 @@ int IMUImplOKVIS::propagation(const ImuMeasureDeque &imuMeasurements,
                               okvis::Time &t_end,
                               covariance_t *covariance,
                               jacobian_t *jacobian) {
+    assert(!covariance && !jacobian);
+    return propagation(imuMeasurements, imuParams, T_WS, speedAndBiases, t_start, t_end,
+                       static_cast<dynamic_t*>(nullptr), static_cast<dynamic_t*>(nullptr));
+}
+
+int IMUImplOKVIS::propagation(const ImuMeasureDeque &imuMeasurements,
+                              const ImuParameters &imuParams,
+                              Transformation &T_WS,
+                              SpeedAndBias &speedAndBiases,
+                              okvis::Time &t_start,
+                              okvis::Time &t_end,
+                              dynamic_t *covariance,
+                              dynamic_t *jacobian) {
     okvis::Time& time = t_start;
     okvis::Time& end  = t_end;
 
@@ -123,7 +136,7 @@ int IMUImplOKVIS::propagation(const ImuMeasureDeque &imuMeasurements,
         dp_db_g += dt*dv_db_g + 0.25*dt*dt*(C*acc_S_x*cross + C_1*acc_S_x*cross_1);
 
         if (covariance) {
-            assert(covariance->cols() == 15 && covariance->rows() == 15);
+            covariance->resize(15, 15);
             Eigen::Matrix<double,15,15> F_delta = Eigen::Matrix<double,15,15>::Identity();
 
             F_delta.block<3,3>(0,3) = -crossMx(acc_integral*dt + 0.25*(C + C_1)*acc_S_true*dt*dt);
@@ -176,7 +189,7 @@ int IMUImplOKVIS::propagation(const ImuMeasureDeque &imuMeasurements,
     speedAndBiases.head<3>() += C_WS_0 * (acc_integral)- g_W * Delta_t;
 
     if(jacobian) {
-        assert(jacobian->cols() == 15 && jacobian->rows() == 15);
+        jacobian->resize(15, 15);
         jacobian->setIdentity();
         jacobian->block<3,3>(0,3) = -crossMx(C_WS_0*acc_doubleintegral);
         jacobian->block<3,3>(0,6) = Eigen::Matrix3d::Identity()*Delta_t;
@@ -211,7 +224,7 @@ int IMUImplOKVIS::repropagation()
 
 }
 
-int IMUImplOKVIS::Jacobian(const Error_t &err, const pViFrame &frame_i, jacobian_t &jacobian_i, const pViFrame &frame_j, jacobian_t &jacobian_j, void *info)
+int IMUImplOKVIS::Jacobian(const Error_t &err, const pViFrame &frame_i, errJacobian_t &jacobian_i, const pViFrame &frame_j, errJacobian_t &jacobian_j, void *info)
 {
     return 0;
 }
@@ -5,6 +5,7 @@
 
 
 class IMUImplOKVIS : public IMUImpl {
+    /// the state only, the 15x15 covariance and jacobian don't fit the preintegration's types
     int propagation(const ImuMeasureDeque &imuMeasurements,
                              const ImuParameters &imuParams,
                              Transformation &T_WS,
@@ -13,10 +14,19 @@ class IMUImplOKVIS : public IMUImpl {
                              okvis::Time &t_end,
                              covariance_t *covariance,
                              jacobian_t *jacobian);
+    /// covariance and jacobian 15x15: p, alpha, v, b_g, b_a
+    int propagation(const ImuMeasureDeque &imuMeasurements,
+                             const ImuParameters &imuParams,
+                             Transformation &T_WS,
+                             SpeedAndBias &speedAndBiases,
+                             okvis::Time &t_start,
+                             okvis::Time &t_end,
+                             dynamic_t *covariance,
+                             dynamic_t *jacobian);
 
     int error(const IMU::pViFrame &frame_i, const IMU::pViFrame &frame_j, Error_t &err, void *info);
     int repropagation();
-    int Jacobian(const Error_t& err, const IMU::pViFrame& frame_i, jacobian_t& jacobian_i, const IMU::pViFrame& frame_j, jacobian_t& jacobian_j, void *info);
+    int Jacobian(const Error_t& err, const IMU::pViFrame& frame_i, errJacobian_t& jacobian_i, const IMU::pViFrame& frame_j, errJacobian_t& jacobian_j, void *info);
 
 };
 
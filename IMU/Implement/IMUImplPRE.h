@@ -6,6 +6,7 @@
 class IMUImplPRE : public IMUImpl {
 public:
     IMUImplPRE();
+    using IMUImpl::propagation;
     ///< factor jacobian_t: dRdb_g, dvdb_a dvdb_g dpdb_a dpdb_g
     int propagation(const ImuMeasureDeque & imuMeasurements,
                     const ImuParameters & imuParams,
@@ -21,7 +22,7 @@ public:
      * @brief Jacobian
      * @param jacobian_t: drdphi drdb, dvdphi dvdv dvdb, dpdphi dpdv dpdp dpdb, for bias i->b_g, j->b_a
      */
-    int Jacobian(const Error_t& err, const IMU::pViFrame& frame_i, jacobian_t& jacobian_i, const IMU::pViFrame& frame_j, jacobian_t& jacobian_j, void *info);
+    int Jacobian(const Error_t& err, const IMU::pViFrame& frame_i, errJacobian_t& jacobian_i, const IMU::pViFrame& frame_j, errJacobian_t& jacobian_j, void *info);
 };
 
 #endif // IMUIMPLPRE_H
@@ -0,0 +1,147 @@
+#include "Preintegrator.h"
+#include "util/util.h"
+
+Preintegrator::Preintegrator(const ImuParameters &imuParams, const okvis::Time &start,
+                             const Eigen::Vector3d &gyrBias, const Eigen::Vector3d &accBias) : imuParams_(imuParams) {
+    reset(start, gyrBias, accBias);
+}
+
+void Preintegrator::reset(const okvis::Time &start, const Eigen::Vector3d &gyrBias, const Eigen::Vector3d &accBias) {
+    bg_ = gyrBias;
+    ba_ = accBias;
+    start_ = time_ = start;
+    hasPrev_ = false;
+    steps_ = 0;
+    R_ = Sophus::SO3d();
+    v_.setZero();
+    p_.setZero();
+    cov_.setZero();
+    J_.setZero();
+}
+
+void Preintegrator::add(const okvis::Time &t, const Eigen::Vector3d &gyr, const Eigen::Vector3d &acc) {
+    add(t, gyr, acc, t);
+}
+
+void Preintegrator::add(const okvis::Time &t, const Eigen::Vector3d &gyr, const Eigen::Vector3d &acc,
+                        const okvis::Time &end) {
+    if(!hasPrev_ || t <= time_ || end <= time_) {
+        if(t <= time_ || !hasPrev_) {
+            hasPrev_ = true;
+            prevTime_ = t;
+            prevGyr_ = gyr;
+            prevAcc_ = acc;
+        }
+        return;
+    }
+
+    Eigen::Vector3d gyr0 = prevGyr_, acc0 = prevAcc_, gyr1 = gyr, acc1 = acc;
+    okvis::Time next = t;
+    double dt = (next - time_).toSec();
+    if(end < next) {
+        const double interval = (next - prevTime_).toSec();
+        next = end;
+        dt = (next - time_).toSec();
+        const double r = (next - prevTime_).toSec() / interval;
+        gyr1 = ((1.0 - r) * gyr0 + r * gyr1).eval();
+        acc1 = ((1.0 - r) * acc0 + r * acc1).eval();
+    }
+    if(prevTime_ < time_) {
+        const double r = dt / (next - prevTime_).toSec();
+        gyr0 = (r * gyr0 + (1.0 - r) * gyr1).eval();
+        acc0 = (r * acc0 + (1.0 - r) * acc1).eval();
+    }
+
+    integrate(dt, gyr0, acc0, gyr1, acc1);
+    // cut at end, the next step starts from the interpolated rates and the same sample may come again
+    time_ = next;
+    prevTime_ = next;
+    prevGyr_ = gyr1;
+    prevAcc_ = acc1;
+}
+
+void Preintegrator::integrate(double dt, const Eigen::Vector3d &gyr0, const Eigen::Vector3d &acc0,
+                              const Eigen::Vector3d &gyr1, const Eigen::Vector3d &acc1) {
+    double sigma_g_c = imuParams_.sigma_g_c;
+    double sigma_a_c = imuParams_.sigma_a_c;
+    if(gyr0.cwiseAbs().maxCoeff() > imuParams_.g_max || gyr1.cwiseAbs().maxCoeff() > imuParams_.g_max)
+        sigma_g_c *= 100;
+    if(acc0.cwiseAbs().maxCoeff() > imuParams_.a_max || acc1.cwiseAbs().maxCoeff() > imuParams_.a_max)
+        sigma_a_c *= 100;
+
+    // the rotation step itself instead of the log of its exp, the same to rounding
+    const Eigen::Vector3d phi = (0.5*(gyr0 + gyr1) - bg_) * dt;
+    const Sophus::SO3d dR = Sophus::SO3d::exp(phi);
+    const Eigen::Matrix3d rJac = rightJacobian(phi);
+    const Eigen::Matrix3d dRinv = dR.inverse().matrix();
+    R_ = R_ * dR;
+    const Eigen::Matrix3d Rmat = R_.matrix();
+    const Eigen::Vector3d acc = 0.5*(acc0 + acc1) - ba_;
+    const Eigen::Matrix3d accHat = Sophus::SO3d::hat(acc);
+
+    // bias Jacobians before the deltas move on, the position ones need the velocity ones of the last step
+    const Eigen::Matrix3d dRdbg = dRinv * J_.block<3, 3>(0, 0) - rJac * dt;
+    const Eigen::Matrix3d dRaccdbg = Rmat * accHat * dRdbg;
+    J_.block<3, 3>(9, 0)  += J_.block<3, 3>(3, 0) * dt - 0.5 * dt * dt * Rmat;
+    J_.block<3, 3>(12, 0) += J_.block<3, 3>(6, 0) * dt - 0.5 * dt * dt * dRaccdbg;
+    J_.block<3, 3>(3, 0)  -= dt * Rmat;
+    J_.block<3, 3>(6, 0)  -= dt * dRaccdbg;
+    J_.block<3, 3>(0, 0)   = dRdbg;
+
+    const Eigen::Vector3d dv = Rmat * (acc * dt);
+    const Eigen::Vector3d dp = v_ * dt + 0.5 * Rmat * (acc) * dt * dt;
+    v_ += dv;
+    p_ += dp;
+
+    // cov = A cov A^T + B Cov_eta B^T (63) in 3x3 blocks, A and B are mostly zero and identity:
+    //     | dRinv 0    0 |       | dt rJac  0          |
+    // A = | X     I    0 |   B = | 0        dt R       |   X = -dt R acc^, Y = -dt^2/2 R acc^ (59-61)
+    //     | Y     dt I I |       | 0        dt^2/2 R   |
+    const Eigen::Matrix3d X = -dt * Rmat * accHat;
+    const Eigen::Matrix3d Y = 0.5 * dt * X;
+    Eigen::Matrix<double, 9, 9> M;                                   // A cov
+    for(int j = 0; j < 9; j += 3) {
+        const Eigen::Matrix3d C0 = cov_.block<3, 3>(0, j), C1 = cov_.block<3, 3>(3, j), C2 = cov_.block<3, 3>(6, j);
+        M.block<3, 3>(0, j) = dRinv * C0;
+        M.block<3, 3>(3, j) = X * C0 + C1;
+        M.block<3, 3>(6, j) = Y * C0 + dt * C1 + C2;
+    }
+    for(int i = 0; i < 9; i += 3) {
+        const Eigen::Matrix3d M0 = M.block<3, 3>(i, 0), M1 = M.block<3, 3>(i, 3), M2 = M.block<3, 3>(i, 6);
+        cov_.block<3, 3>(i, 0) = M0 * dRinv.transpose();
+        cov_.block<3, 3>(i, 3) = M0 * X.transpose() + M1;
+        cov_.block<3, 3>(i, 6) = M0 * Y.transpose() + dt * M1 + M2;
+    }
+
+    // R R^T = I in the accelerometer part
+    const double dt2 = dt * dt;
+    cov_.block<3, 3>(0, 0) += (sigma_g_c * dt * dt2) * rJac * rJac.transpose();
+    cov_.block<3, 3>(3, 3).diagonal().array() += sigma_a_c * dt * dt2;
+    cov_.block<3, 3>(3, 6).diagonal().array() += 0.5 * sigma_a_c * dt * dt2 * dt;
+    cov_.block<3, 3>(6, 3).diagonal().array() += 0.5 * sigma_a_c * dt * dt2 * dt;
+    cov_.block<3, 3>(6, 6).diagonal().array() += 0.25 * sigma_a_c * dt * dt2 * dt2;
+
+    ++steps_;
+}
+
+void Preintegrator::correct(const Eigen::Vector3d &gyrBias, const Eigen::Vector3d &accBias,
+                            Sophus::SO3d &R, Eigen::Vector3d &v, Eigen::Vector3d &p) const {
+    const Eigen::Vector3d dbg = gyrBias - bg_, dba = accBias - ba_;
+    R = R_ * Sophus::SO3d::exp(J_.block<3, 3>(0, 0) * dbg);
+    v = v_ + J_.block<3, 3>(3, 0) * dba + J_.block<3, 3>(6, 0) * dbg;
+    p = p_ + J_.block<3, 3>(9, 0) * dba + J_.block<3, 3>(12, 0) * dbg;
+}
+
+bool Preintegrator::nearBias(const Eigen::Vector3d &gyrBias, const Eigen::Vector3d &accBias, double threshold) const {
+    return (gyrBias - bg_).norm() < threshold && (accBias - ba_).norm() < threshold;
+}
+
+void Preintegrator::get(IMUMeasure::Transformation &T, IMUMeasure::SpeedAndBias &speedAndBias,
+                        IMUMeasure::covariance_t *covariance, IMUMeasure::jacobian_t *jacobian) const {
+    T = Sophus::SE3d(R_, p_);
+    speedAndBias.head<3>() = v_;
+    if(covariance)
+        *covariance = cov_;
+    if(jacobian)
+        *jacobian = J_;
+}
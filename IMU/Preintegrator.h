@@ -0,0 +1,81 @@
+#ifndef SIMPLE_VIO_PREINTEGRATOR_H
+#define SIMPLE_VIO_PREINTEGRATOR_H
+
+#include <Eigen/Dense>
+#include <sophus/se3.hpp>
+
+#include "DataStructure/imu/IMUMeasure.h"
+
+/// IMU preintegration between two frames which takes the samples one at a time as they arrive.
+/// delta R/v/p, their covariance and their first order bias Jacobians are carried along in fixed size
+/// matrices, a sample costs the same whatever came before and nothing is allocated.
+///
+/// the integration is the one of IMUImplPRE: mid-point rates, the rotation at the end of each step,
+/// linear interpolation of the samples at both ends of the interval.
+class Preintegrator {
+public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+    typedef IMUMeasure::covariance_t covariance_t;
+    typedef IMUMeasure::jacobian_t   jacobian_t;
+
+public:
+    /// the parameters are referenced, not copied
+    Preintegrator(const ImuParameters &imuParams, const okvis::Time &start,
+                  const Eigen::Vector3d &gyrBias, const Eigen::Vector3d &accBias);
+
+    /// starts over at start with the biases the samples are corrected by
+    void reset(const okvis::Time &start, const Eigen::Vector3d &gyrBias, const Eigen::Vector3d &accBias);
+    /// the next sample in time order, integrated from the previous one up to it. a sample at or before time()
+    /// only becomes the one the next step interpolates from
+    void add(const okvis::Time &t, const Eigen::Vector3d &gyr, const Eigen::Vector3d &acc);
+    /// the same up to end at the most, the sample is interpolated down to it
+    void add(const okvis::Time &t, const Eigen::Vector3d &gyr, const Eigen::Vector3d &acc, const okvis::Time &end);
+    void add(const IMUMeasure &m) { add(m.timeStamp, m.measurement.gyroscopes, m.measurement.acceleration); }
+
+    const okvis::Time& start() const { return start_; }
+    /// how far the samples were integrated
+    const okvis::Time& time() const { return time_; }
+    int steps() const { return steps_; }
+
+    const Sophus::SO3d&    deltaR() const { return R_; }
+    const Eigen::Vector3d& deltaV() const { return v_; }
+    const Eigen::Vector3d& deltaP() const { return p_; }
+    const covariance_t&    covariance() const { return cov_; }
+    const jacobian_t&      jacobian() const { return J_; }
+
+    /// the deltas for other biases to first order, what BA uses instead of integrating the samples again
+    void correct(const Eigen::Vector3d &gyrBias, const Eigen::Vector3d &accBias,
+                 Sophus::SO3d &R, Eigen::Vector3d &v, Eigen::Vector3d &p) const;
+    /// the linearization holds while the biases stay within about this of the integrated ones
+    bool nearBias(const Eigen::Vector3d &gyrBias, const Eigen::Vector3d &accBias, double threshold) const;
+
+    /// the outputs of IMU::propagation, covariance and jacobian may be nullptr
+    void get(IMUMeasure::Transformation &T, IMUMeasure::SpeedAndBias &speedAndBias,
+             IMUMeasure::covariance_t *covariance, IMUMeasure::jacobian_t *jacobian) const;
+
+private:
+    void integrate(double dt, const Eigen::Vector3d &gyr0, const Eigen::Vector3d &acc0,
+                   const Eigen::Vector3d &gyr1, const Eigen::Vector3d &acc1);
+
+private:
+    const ImuParameters &imuParams_;
+    Eigen::Vector3d      bg_;
+    Eigen::Vector3d      ba_;
+
+    okvis::Time          start_;
+    okvis::Time          time_;
+    bool                 hasPrev_;
+    okvis::Time          prevTime_;       //!< the last sample, interpolated from at the start of the next step
+    Eigen::Vector3d      prevGyr_;
+    Eigen::Vector3d      prevAcc_;
+    int                  steps_;
+
+    Sophus::SO3d         R_;
+    Eigen::Vector3d      v_;
+    Eigen::Vector3d      p_;
+    covariance_t         cov_;
+    jacobian_t           J_;
+};
+
+
+#endif //SIMPLE_VIO_PREINTEGRATOR_H
@@ -0,0 +1,292 @@
+#include <chrono>
+#include <cstdio>
+
+#include <opencv2/ts/ts.hpp>
+
+#include "IMU/IMU.h"
+#include "IMU/Preintegrator.h"
+#include "DataStructure/imu/imuFactor.h"
+#include "util/util.h"
+
+namespace {
+    typedef IMUMeasure::ImuMeasureDeque ImuMeasureDeque;
+
+    // the batch propagation IMUImplPRE had before the preintegrator, the reference for values and speed
+    int batchPropagation(const ImuMeasureDeque &imuMeasurements, const ImuParameters &imuParams,
+                         Sophus::SE3d &T_WS, IMUMeasure::SpeedAndBias &speedAndBiases,
+                         okvis::Time time, const okvis::Time &end,
+                         IMUMeasure::covariance_t *covariance, IMUMeasure::jacobian_t *jacobian) {
+        std::vector<double> VecDt;
+        std::vector<Sophus::SO3d, Eigen::aligned_allocator<Sophus::SO3d>>        VecRotation;
+        std::vector<Eigen::Matrix3d, Eigen::aligned_allocator<Eigen::Matrix3d>>  VecRightJac;
+        std::vector<Eigen::Vector3d, Eigen::aligned_allocator<Eigen::Vector3d>>  VecAcc;
+        const Eigen::Vector3d gbias = speedAndBiases.segment<3>(3);
+        const Eigen::Vector3d abias = speedAndBiases.segment<3>(6);
+        Sophus::SO3d D_rotation;
+        Eigen::Vector3d D_vec(0, 0, 0), D_pos(0, 0, 0);
+        bool hasStarted = false;
+        int i = 0;
+
+        for(auto it = imuMeasurements.begin(); it + 1 != imuMeasurements.end(); ++it) {
+            Eigen::Vector3d omega_S_0 = (*it)->measurement.gyroscopes;
+            Eigen::Vector3d acc_S_0 = (*it)->measurement.acceleration;
+            Eigen::Vector3d omega_S_1 = (*(it + 1))->measurement.gyroscopes;
+            Eigen::Vector3d acc_S_1 = (*(it + 1))->measurement.acceleration;
+            okvis::Time nexttime = (*(it + 1))->timeStamp;
+            double dt = (nexttime - time).toSec();
+            if (end < nexttime) {
+                double interval = (nexttime - (*it)->timeStamp).toSec();
+                nexttime = end;
+                dt = (nexttime - time).toSec();
+                const double r = dt / interval;
+                omega_S_1 = ((1.0 - r) * omega_S_0 + r * omega_S_1).eval();
+                acc_S_1 = ((1.0 - r) * acc_S_0 + r * acc_S_1).eval();
+            }
+            if (dt <= 0.0) continue;
+            VecDt.push_back(dt);
+            if (!hasStarted) {
+                hasStarted = true;
+                const double r = dt / (nexttime - (*it)->timeStamp).toSec();
+                omega_S_0 = (r * omega_S_0 + (1.0 - r) * omega_S_1).eval();
+                acc_S_0 = (r * acc_S_0 + (1.0 - r) * acc_S_1).eval();
+            }
+
+            Sophus::SO3d dR = Sophus::SO3d::exp((0.5*(omega_S_0 + omega_S_1) - gbias) * dt);
+            Eigen::Matrix<double, 3, 3> rJac = rightJacobian(dR.log());
+            VecRightJac.push_back(rJac);
+            D_rotation = D_rotation * dR;
+            VecRotation.push_back(D_rotation);
+            const Eigen::Matrix<double, 3, 3> D_rMat = D_rotation.matrix();
+            const Eigen::Vector3d acc_S_true = 0.5*(acc_S_0+acc_S_1) - abias;
+            VecAcc.push_back(acc_S_true);
+            Eigen::Vector3d dv = D_rMat * (acc_S_true * dt);
+            Eigen::Vector3d dp = D_vec * dt + 0.5 * D_rMat * (acc_S_true) * dt * dt;
+            D_vec += dv;
+            D_pos += dp;
+
+            Eigen::Matrix<double, 9, 6> B;
+            B.setZero();
+            B.block<3, 3>(0, 0) = dt * rJac;
+            B.block<3, 3>(3, 3) = dt * D_rMat;
+            B.block<3, 3>(6, 3) = 0.5 * dt * dt * D_rMat;
+            Eigen::Matrix<double, 9, 9> A;
+            A.setZero();
+            if(i != 0) {
+                A.block<3, 3>(0, 0) = dR.inverse().matrix();
+                A.block<3, 3>(3, 0) = -dt * D_rMat * Sophus::SO3d::hat(acc_S_true);
+                A.block<3, 3>(3, 3) = Eigen::Matrix<double, 3, 3>::Identity();
+                A.block<3, 3>(6, 0) = -0.5 * dt * dt * D_rMat * Sophus::SO3d::hat(acc_S_true);
+                A.block<3, 3>(6, 3) = dt * Eigen::Matrix<double, 3, 3>::Identity();
+                A.block<3, 3>(6, 6) = Eigen::Matrix<double, 3, 3>::Identity();
+            }
+            else
+                covariance->setZero();
+            Eigen::Matrix<double, 6, 6> Cov_eta;
+            Cov_eta.setZero();
+            Cov_eta.block<3, 3>(0, 0) = dt * imuParams.sigma_g_c * Eigen::Matrix<double, 3, 3>::Identity();
+            Cov_eta.block<3, 3>(3, 3) = dt * imuParams.sigma_a_c * Eigen::Matrix<double, 3, 3>::Identity();
+            *covariance = A * *covariance * A.transpose() + B * Cov_eta * B.transpose();
+
+            time = nexttime;
+            ++i;
+            if (nexttime == end)
+                break;
+        }
+
+        jacobian->setZero();
+        Sophus::SO3d R_ij = VecRotation[VecRotation.size()-1];
+        Eigen::Matrix<double, 3, 3> matR_ij = R_ij.matrix();
+        for(auto it = VecRotation.begin(); it != VecRotation.end(); ++it)
+            *it = it->inverse() * R_ij;
+        for(unsigned k = 0; k < VecRightJac.size(); ++k) {
+            jacobian->block<3, 3>(0, 0) -= VecRotation[k].inverse().matrix() * VecRightJac[k] * VecDt[k];
+            jacobian->block<3, 3>(3, 0) -= matR_ij * VecDt[k];
+            jacobian->block<3, 3>(9, 0) -= 1.5 * matR_ij * VecDt[k] * VecDt[k];
+        }
+        const Eigen::Matrix<double, 3, 3> &dR_dbg = jacobian->block<3, 3>(0, 0);
+        for(unsigned k = 0; k < VecAcc.size(); ++k) {
+            jacobian->block<3, 3>(6, 0)  -= matR_ij * Sophus::SO3d::hat(VecAcc[k]) * dR_dbg * VecDt[k];
+            jacobian->block<3, 3>(12, 0) -= 1.5 * matR_ij * Sophus::SO3d::hat(VecAcc[k]) * dR_dbg * VecDt[k] * VecDt[k];
+        }
+
+        T_WS = Sophus::SE3d(D_rotation, D_pos);
+        speedAndBiases.head<3>() = D_vec;
+        return i;
+    }
+
+    // a body shaking and turning on all axes, rate samples from t0 on
+    ImuMeasureDeque samples(const okvis::Time &t0, double rate, double seconds) {
+        ImuMeasureDeque imu;
+        const int n = int(rate * seconds) + 2;
+        for(int k = 0; k < n; ++k) {
+            const double t = k / rate;
+            const Eigen::Vector3d gyr(0.3 * sin(2.1 * t), -0.5 * cos(1.3 * t), 0.8 * sin(0.7 * t + 0.2));
+            const Eigen::Vector3d acc(1.2 * cos(3.0 * t), 0.4 * sin(2.5 * t), 9.81 + 0.6 * sin(1.9 * t));
+            imu.addImuMeasurement(0, t0 + okvis::Duration(t), acc, gyr);
+        }
+        return imu;
+    }
+
+    ImuParameters parameters() {
+        ImuParameters param;
+        param.sigma_g_c = 1.6968e-04;
+        param.sigma_a_c = 2.0e-3;
+        param.g_max = 7.8;
+        param.a_max = 176.0;
+        return param;
+    }
+
+    void integrate(Preintegrator &pre, const ImuMeasureDeque &imu, const okvis::Time &end) {
+        for(auto &m : imu)
+            pre.add(m->timeStamp, m->measurement.gyroscopes, m->measurement.acceleration, end);
+    }
+}
+
+TEST(Preintegrator, batch) {
+    const ImuParameters param = parameters();
+    const okvis::Time t0(1403636579, 758555392);
+    const ImuMeasureDeque imu = samples(t0, 200, 0.5);
+    const okvis::Time start = t0 + okvis::Duration(0.0123), end = t0 + okvis::Duration(0.4567);
+    IMUMeasure::SpeedAndBias spbs = IMUMeasure::SpeedAndBias::Zero();
+    spbs.segment<3>(3) << 0.01, -0.02, 0.005;
+    spbs.segment<3>(6) << 0.1, 0.05, -0.2;
+
+    Sophus::SE3d T;
+    IMUMeasure::covariance_t var;
+    IMUMeasure::jacobian_t jac;
+    IMUMeasure::SpeedAndBias batch = spbs;
+    const int steps = batchPropagation(imu, param, T, batch, start, end, &var, &jac);
+
+    Preintegrator pre(param, start, spbs.segment<3>(3), spbs.segment<3>(6));
+    integrate(pre, imu, end);
+    GTEST_ASSERT_EQ(pre.steps(), steps);
+    GTEST_ASSERT_EQ(pre.time(), end);
+    EXPECT_LT((pre.deltaR().matrix() - T.so3().matrix()).norm(), 1e-12);
+    EXPECT_LT((pre.deltaV() - batch.head<3>()).norm(), 1e-12);
+    EXPECT_LT((pre.deltaP() - T.translation()).norm(), 1e-12);
+    EXPECT_LT((pre.covariance() - var).norm(), 1e-12 * var.norm());
+    EXPECT_LT((pre.jacobian().block<3, 3>(0, 0) - jac.block<3, 3>(0, 0)).norm(), 1e-12);
+
+    // frame by frame as the front end feeds it, every chunk from the sample at or before the last frame.
+    // the frames fall on samples, a frame between two would split their step
+    const okvis::Time first = imu[2]->timeStamp;
+    Preintegrator whole(param, first, spbs.segment<3>(3), spbs.segment<3>(6));
+    integrate(whole, imu, end);
+    Preintegrator chunked(param, first, spbs.segment<3>(3), spbs.segment<3>(6));
+    for(okvis::Time frame = first + okvis::Duration(0.05); chunked.time() < end; frame += okvis::Duration(0.05)) {
+        const okvis::Time to = frame < end ? frame : end;
+        ImuMeasureDeque part;
+        for(size_t k = 0; k < imu.size(); ++k) {
+            if((k + 1 < imu.size() && imu[k + 1]->timeStamp <= chunked.time()) || (k && imu[k - 1]->timeStamp >= to))
+                continue;
+            part.push_back(imu[k]);
+        }
+        integrate(chunked, part, to);
+    }
+    GTEST_ASSERT_EQ(chunked.steps(), whole.steps());
+    EXPECT_LT((chunked.deltaR().matrix() - whole.deltaR().matrix()).norm(), 1e-12);
+    EXPECT_LT((chunked.deltaV() - whole.deltaV()).norm(), 1e-12);
+    EXPECT_LT((chunked.deltaP() - whole.deltaP()).norm(), 1e-12);
+    EXPECT_LT((chunked.covariance() - whole.covariance()).norm(), 1e-12 * whole.covariance().norm());
+    EXPECT_LT((chunked.jacobian() - whole.jacobian()).norm(), 1e-12);
+}
+
+TEST(Preintegrator, biasUpdate) {
+    const ImuParameters param = parameters();
+    const okvis::Time t0(1403636579, 758555392);
+    const ImuMeasureDeque imu = samples(t0, 200, 0.5);
+    const okvis::Time start = t0 + okvis::Duration(0.0123), end = t0 + okvis::Duration(0.4567);
+    const Eigen::Vector3d bg(0.01, -0.02, 0.005), ba(0.1, 0.05, -0.2);
+
+    Preintegrator pre(param, start, bg, ba);
+    integrate(pre, imu, end);
+
+    // the first order correction against integrating again, for a bias change BA would make between two runs
+    const Eigen::Vector3d dbg(2e-3, -1e-3, 1.5e-3), dba(-2e-2, 3e-2, 1e-2);
+    Preintegrator again(param, start, bg + dbg, ba + dba);
+    integrate(again, imu, end);
+    Sophus::SO3d R;
+    Eigen::Vector3d v, p;
+    pre.correct(bg + dbg, ba + dba, R, v, p);
+
+    const double errR = (again.deltaR().inverse() * R).log().norm();
+    const double errV = (again.deltaV() - v).norm(), errP = (again.deltaP() - p).norm();
+    const double movedR = (again.deltaR().inverse() * pre.deltaR()).log().norm();
+    const double movedV = (again.deltaV() - pre.deltaV()).norm(), movedP = (again.deltaP() - pre.deltaP()).norm();
+    printf("bias update error / change: R %.2e / %.2e, v %.2e / %.2e, p %.2e / %.2e\n",
+           errR, movedR, errV, movedV, errP, movedP);
+    EXPECT_LT(errR, 1e-3 * movedR);
+    EXPECT_LT(errV, 1e-2 * movedV);
+    EXPECT_LT(errP, 1e-2 * movedP);
+    EXPECT_TRUE(pre.nearBias(bg + dbg, ba + dba, 0.1));
+}
+
+// the fixed size factor as BA weights it, and the dynamic overload for callers which still size their matrices
+TEST(Preintegrator, factor) {
+    const ImuParameters param = parameters();
+    const okvis::Time t0(1403636579, 758555392);
+    const ImuMeasureDeque imu = samples(t0, 200, 0.5);
+    const okvis::Time from = t0 + okvis::Duration(0.0123);
+    okvis::Time start = from, end = t0 + okvis::Duration(0.4567);
+
+    Sophus::SE3d T;
+    IMUMeasure::SpeedAndBias spbs = IMUMeasure::SpeedAndBias::Zero();
+    IMUMeasure::covariance_t var;
+    IMUMeasure::jacobian_t jac;
+    IMU imuFix;
+    imuFix.propagation(imu, param, T, spbs, start, end, &var, &jac);
+
+    Sophus::SE3d Td;
+    IMUMeasure::SpeedAndBias spbsd = IMUMeasure::SpeedAndBias::Zero();
+    IMUMeasure::dynamic_t vard, jacd;
+    IMU imuDyn;
+    start = from;
+    imuDyn.propagation(imu, param, Td, spbsd, start, end, &vard, &jacd);
+    GTEST_ASSERT_EQ(vard.rows(), 9);
+    GTEST_ASSERT_EQ(jacd.rows(), 15);
+    EXPECT_EQ((vard - var).norm(), 0.0);
+    EXPECT_EQ((jacd - jac).norm(), 0.0);
+    EXPECT_EQ((Td.matrix() - T.matrix()).norm(), 0.0);
+
+    imuFactor factor(T, jac, spbs.head<3>(), var);
+    const IMUMeasure::covariance_t &S = factor.getSqrtInfo();
+    const IMUMeasure::covariance_t I = S.transpose() * S * var;
+    EXPECT_LT((I - IMUMeasure::covariance_t::Identity()).norm(), 1e-6);
+}
+
+// one keyframe interval of 0.5 s at the rates of the EuRoC IMU and of a fast one
+TEST(Preintegrator, benchmark) {
+    const ImuParameters param = parameters();
+    const okvis::Time t0(1403636579, 758555392);
+    const double rates[] = {200, 1000};
+    for(double rate : rates) {
+        const ImuMeasureDeque imu = samples(t0, rate, 0.5);
+        const okvis::Time start = t0, end = t0 + okvis::Duration(0.5);
+        const int runs = 2000;
+        IMUMeasure::covariance_t var;
+        IMUMeasure::jacobian_t jac;
+        Sophus::SE3d T;
+        double sink = 0;
+
+        std::chrono::steady_clock::time_point t = std::chrono::steady_clock::now();
+        for(int r = 0; r < runs; ++r) {
+            IMUMeasure::SpeedAndBias spbs = IMUMeasure::SpeedAndBias::Zero();
+            batchPropagation(imu, param, T, spbs, start, end, &var, &jac);
+            sink += spbs[0];
+        }
+        const double batchUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t).count() / runs;
+
+        t = std::chrono::steady_clock::now();
+        Preintegrator pre(param, start, Eigen::Vector3d::Zero(), Eigen::Vector3d::Zero());
+        for(int r = 0; r < runs; ++r) {
+            pre.reset(start, Eigen::Vector3d::Zero(), Eigen::Vector3d::Zero());
+            integrate(pre, imu, end);
+            sink -= pre.deltaV()[0];
+        }
+        const double incUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t).count() / runs;
+
+        printf("%4.0f Hz, %lu samples: batch %7.1f us, incremental %7.1f us (%.2f us per sample)\n",
+               rate, imu.size(), batchUs, incUs, incUs / imu.size());
+        EXPECT_LT(fabs(sink), 1e-6);
+    }
+}
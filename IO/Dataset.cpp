@@ -0,0 +1,68 @@
+#include <chrono>
+#include <future>
+#include <cstdio>
+
+#include "Dataset.h"
+
+namespace {
+    typedef std::chrono::steady_clock Clock;
+
+    double msSince(const Clock::time_point &start) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+
+    // f on its own thread, its run time into ms
+    template<typename F>
+    auto timed(F f, double &ms) -> std::future<decltype(f())> {
+        return std::async(std::launch::async, [f, &ms] {
+            const Clock::time_point start = Clock::now();
+            auto result = f();
+            ms = msSince(start);
+            return result;
+        });
+    }
+}
+
+Dataset::Dataset(const std::string &root, int cam) : imagesGood_(false), loadTime_(0), cameraTime_(0),
+                                                       imageTime_(0), imuParamTime_(0), imuLogTime_(0) {
+    const std::string base = root.empty() || root[root.size() - 1] == '/' ? root : root + "/";
+    const std::string camDir = base + "cam" + std::to_string(cam) + "/";
+    imageDirectory_ = camDir + "data/";
+
+    const Clock::time_point start = Clock::now();
+    const std::string camParamfile = camDir + "sensor.yaml", imagefile = camDir + "data.csv";
+    const std::string imuParamfile = base + "imu0/sensor.yaml", imufile = base + "imu0/data.csv";
+
+    // the imu log is by far the largest, it is started first
+    auto imuLog = timed([imufile] { return IMUIO::loadLog(imufile); }, imuLogTime_);
+    auto camera = timed([camParamfile] { return CameraIO::loadCamera(camParamfile); }, cameraTime_);
+    auto imuParam = timed([imuParamfile] { return IMUIO::loadParam(imuParamfile); }, imuParamTime_);
+    const Clock::time_point imageStart = Clock::now();
+    imagesGood_ = ImageIO::loadList(imagefile, images_);
+    imageTime_ = msSince(imageStart);
+
+    camera_ = camera.get();
+    imuParam_ = imuParam.get();
+    imuLog_ = imuLog.get();
+    loadTime_ = msSince(start);
+}
+
+bool Dataset::good() const {
+    return camera_ && imagesGood_ && !images_.empty() && imuParam_ && imuLog_ && imuLog_->good();
+}
+
+std::shared_ptr<ImageIO> Dataset::imageIO(bool undistort) const {
+    return std::make_shared<ImageIO>(images_, imageDirectory_,
+                                     undistort ? camera_ : std::shared_ptr<AbstractCamera>());
+}
+
+std::shared_ptr<IMUIO> Dataset::imuIO() const {
+    return std::make_shared<IMUIO>(imuLog_, imuParam_);
+}
+
+void Dataset::printTimes() const {
+    printf("data set load: %.2f ms\n", loadTime_);
+    printf("  camera %.2f ms, %zu images %.2f ms, imu param %.2f ms, %zu imu samples %.2f ms%s\n",
+           cameraTime_, images_.size(), imageTime_, imuParamTime_, imuLog_ ? imuLog_->size() : size_t(0), imuLogTime_,
+           imuLog_ && imuLog_->mapped() ? " (mapped)" : "");
+}
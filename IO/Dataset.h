@@ -0,0 +1,51 @@
+#ifndef SIMPLE_VIO_DATASET_H
+#define SIMPLE_VIO_DATASET_H
+
+#include <memory>
+#include <string>
+
+#include "camera/CameraIO.h"
+#include "image/ImageIO.h"
+#include "imu/IMUIO.h"
+
+/// everything a run needs from a EuRoC mav0 directory: camera, image list, imu parameters and imu log.
+/// the files are independent, they are read on one thread each.
+class Dataset {
+public:
+    /// root is the mav0 directory, cam the camera to run on (0 or 1)
+    Dataset(const std::string &root, int cam = 0);
+
+    /// every file was found and parsed
+    bool good() const;
+
+    const CameraIO::pCamereParam&  camera() const { return camera_; }
+    const ImageIOData&             images() const { return images_; }
+    const std::string&             imageDirectory() const { return imageDirectory_; }
+    const IMUIO::pImuParam&        imuParam() const { return imuParam_; }
+    const std::shared_ptr<ImuLog>& imuLog() const { return imuLog_; }
+
+    /// the readers over the loaded data
+    std::shared_ptr<ImageIO> imageIO(bool undistort = true) const;
+    std::shared_ptr<IMUIO>   imuIO() const;
+
+    /// [ms], wall time of the whole load
+    double loadTime() const { return loadTime_; }
+    void printTimes() const;
+
+private:
+    CameraIO::pCamereParam  camera_;
+    ImageIOData             images_;
+    std::string             imageDirectory_;
+    IMUIO::pImuParam        imuParam_;
+    std::shared_ptr<ImuLog> imuLog_;
+    bool                    imagesGood_;
+
+    double                  loadTime_;
+    double                  cameraTime_;
+    double                  imageTime_;
+    double                  imuParamTime_;
+    double                  imuLogTime_;
+};
+
+
+#endif //SIMPLE_VIO_DATASET_H
@@ -0,0 +1,219 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <algorithm>
+
+#include "TextLoader.h"
+#include "util/setting.h"
+
+namespace loader {
+
+    static const size_t ReadChunk    = 1 << 20;
+    static const size_t ParallelSize = 4 << 20;     //!< below this a single thread is faster than spawning more
+
+    static int workerNum(size_t work, size_t threshold) {
+        if(work < threshold)
+            return 1;
+        const int hw = int(std::thread::hardware_concurrency());
+        return std::max(1, std::min(hw, ThreadNum));
+    }
+
+    bool readFile(const std::string &path, std::vector<char> &buf) {
+        buf.clear();
+        FILE* file = fopen(path.c_str(), "rb");
+        if(!file)
+            return false;
+
+        fseek(file, 0, SEEK_END);
+        const long size = ftell(file);
+        fseek(file, 0, SEEK_SET);
+        buf.resize(size_t(std::max(0L, size)) + 1);
+
+        size_t read = 0;
+        while(read < buf.size() - 1) {
+            const size_t n = fread(buf.data() + read, 1, std::min(ReadChunk, buf.size() - 1 - read), file);
+            if(n == 0)
+                break;
+            read += n;
+        }
+        fclose(file);
+        buf.resize(read + 1);
+        buf[read] = '\0';
+        return true;
+    }
+
+    static void splitRange(const char* p, const char* end, std::vector<Line> &lines) {
+        while(p < end) {
+            const char* e = static_cast<const char*>(memchr(p, '\n', size_t(end - p)));
+            if(!e)
+                e = end;
+            const char* last = e;
+            if(last > p && last[-1] == '\r')
+                --last;
+            if(last > p && *p != '#') {
+                Line line = {p, last};
+                lines.push_back(line);
+            }
+            p = e + 1;
+        }
+    }
+
+    void splitLines(const std::vector<char> &buf, std::vector<Line> &lines) {
+        lines.clear();
+        if(buf.size() <= 1)
+            return;
+        const char* begin = buf.data();
+        const char* end = buf.data() + buf.size() - 1;
+        const int n = workerNum(size_t(end - begin), ParallelSize);
+        if(n == 1) {
+            splitRange(begin, end, lines);
+            return;
+        }
+
+        // chunk borders moved to the start of a line, every thread splits its own chunk
+        std::vector<const char*> border(n + 1, end);
+        border[0] = begin;
+        for(int k = 1; k < n; ++k) {
+            const char* p = begin + size_t(end - begin) * k / n;
+            p = std::max(p, border[k - 1]);
+            const char* e = static_cast<const char*>(memchr(p, '\n', size_t(end - p)));
+            border[k] = e ? e + 1 : end;
+        }
+
+        std::vector<std::vector<Line>> parts(n);
+        std::vector<std::thread> workers;
+        for(int k = 0; k < n; ++k)
+            workers.push_back(std::thread([&, k] { splitRange(border[k], border[k + 1], parts[k]); }));
+        for(auto &w : workers)
+            w.join();
+
+        size_t total = 0;
+        for(auto &part : parts)
+            total += part.size();
+        lines.reserve(total);
+        for(auto &part : parts)
+            lines.insert(lines.end(), part.begin(), part.end());
+    }
+
+    void parallelFor(size_t n, const std::function<void(size_t, size_t)> &f) {
+        const int workers = workerNum(n, 1 << 16);
+        if(workers == 1) {
+            f(0, n);
+            return;
+        }
+        std::vector<std::thread> threads;
+        for(int k = 0; k < workers; ++k)
+            threads.push_back(std::thread(f, n * k / workers, n * (k + 1) / workers));
+        for(auto &t : threads)
+            t.join();
+    }
+
+    const char* parseInt64(const char* p, const char* end, int64_t &value) {
+        while(p < end && (*p == ' ' || *p == '\t'))
+            ++p;
+        bool negative = false;
+        if(p < end && (*p == '-' || *p == '+'))
+            negative = *p++ == '-';
+        if(p == end || *p < '0' || *p > '9')
+            return nullptr;
+        uint64_t v = 0;
+        while(p < end && *p >= '0' && *p <= '9')
+            v = v * 10 + uint64_t(*p++ - '0');
+        value = negative ? -int64_t(v) : int64_t(v);
+        return p;
+    }
+
+    const char* parseDouble(const char* p, const char* end, double &value) {
+        // the buffers are '\0' terminated and the fields end with a separator, strtod can't run past end
+        char* next = nullptr;
+        value = strtod(p, &next);
+        if(next == p || next > end)
+            return nullptr;
+        return next;
+    }
+
+    const char* skipPast(const char* p, const char* end, char c) {
+        const char* e = static_cast<const char*>(memchr(p, c, size_t(end - p)));
+        return e ? e + 1 : nullptr;
+    }
+
+    Yaml::Yaml(const std::string &path) {
+        if(!readFile(path, buf_))
+            buf_.clear();
+    }
+
+    const char* Yaml::find(const char* key, const char* parent) const {
+        if(buf_.empty())
+            return nullptr;
+        const char* p = buf_.data();
+        const char* end = buf_.data() + buf_.size() - 1;
+        if(parent) {
+            p = find(parent, nullptr);
+            if(!p)
+                return nullptr;
+        }
+
+        const size_t len = strlen(key);
+        while(p < end) {
+            const char* q = p;
+            while(q < end && (*q == ' ' || *q == '\t'))
+                ++q;
+            if(size_t(end - q) > len && memcmp(q, key, len) == 0 && q[len] == ':')
+                return q + len + 1;
+            p = skipPast(p, end, '\n');
+            if(!p)
+                break;
+        }
+        return nullptr;
+    }
+
+    bool Yaml::scalar(const char* key, std::string &value, const char* parent) const {
+        const char* p = find(key, parent);
+        if(!p)
+            return false;
+        while(*p == ' ' || *p == '\t')
+            ++p;
+        const char* e = p;
+        while(*e && *e != '\n' && *e != '\r' && *e != '#')
+            ++e;
+        while(e > p && (e[-1] == ' ' || e[-1] == '\t'))
+            --e;
+        value.assign(p, e);
+        return true;
+    }
+
+    bool Yaml::scalar(const char* key, double &value, const char* parent) const {
+        const char* p = find(key, parent);
+        if(!p)
+            return false;
+        const char* end = buf_.data() + buf_.size() - 1;
+        const char* e = static_cast<const char*>(memchr(p, '\n', size_t(end - p)));
+        return parseDouble(p, e ? e : end, value) != nullptr;
+    }
+
+    bool Yaml::list(const char* key, std::vector<double> &values, const char* parent) const {
+        const char* p = find(key, parent);
+        if(!p)
+            return false;
+        const char* end = buf_.data() + buf_.size() - 1;
+        p = skipPast(p, end, '[');
+        const char* close = p ? static_cast<const char*>(memchr(p, ']', size_t(end - p))) : nullptr;
+        if(!close)
+            return false;
+
+        values.clear();
+        while(p < close) {
+            while(p < close && (*p == ' ' || *p == ',' || *p == '\n' || *p == '\r' || *p == '\t'))
+                ++p;
+            if(p == close)
+                break;
+            double v;
+            p = parseDouble(p, close, v);
+            if(!p)
+                return false;
+            values.push_back(v);
+        }
+        return true;
+    }
+}
@@ -0,0 +1,54 @@
+#ifndef SIMPLE_VIO_TEXTLOADER_H
+#define SIMPLE_VIO_TEXTLOADER_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <functional>
+
+/// parsing of the data set text files straight out of one buffer: no stream, no std::string per line or field.
+/// the number parsers work like std::from_chars, they return the character after the number or nullptr.
+namespace loader {
+
+    /// the file in chunks into buf, terminated by a '\0' which is not counted in the size
+    bool readFile(const std::string &path, std::vector<char> &buf);
+
+    struct Line {
+        const char* begin;
+        const char* end;        //!< the '\n' or '\r' ending the line
+    };
+
+    /// the non-empty lines not starting with '#', a big buffer is split on several threads
+    void splitLines(const std::vector<char> &buf, std::vector<Line> &lines);
+
+    /// f(first, last) over [0, n) in contiguous chunks, on several threads once n is large
+    void parallelFor(size_t n, const std::function<void(size_t, size_t)> &f);
+
+    const char* parseInt64(const char* p, const char* end, int64_t &value);
+    /// correctly rounded, the same value sscanf("%lf") gives
+    const char* parseDouble(const char* p, const char* end, double &value);
+    /// past the next c before end, nullptr if there is none
+    const char* skipPast(const char* p, const char* end, char c);
+
+    /// the few things read from the EuRoC sensor.yaml files: top-level and nested "key: value" pairs and
+    /// flow lists "[a, b, ...]" which may span lines
+    class Yaml {
+    public:
+        explicit Yaml(const std::string &path);
+
+        bool good() const { return !buf_.empty(); }
+        /// the value of key up to a comment, after the line holding parent if there is one
+        bool scalar(const char* key, std::string &value, const char* parent = nullptr) const;
+        bool scalar(const char* key, double &value, const char* parent = nullptr) const;
+        bool list(const char* key, std::vector<double> &values, const char* parent = nullptr) const;
+
+    private:
+        const char* find(const char* key, const char* parent) const;
+
+    private:
+        std::vector<char> buf_;
+    };
+}
+
+
+#endif //SIMPLE_VIO_TEXTLOADER_H
@@ -26,6 +26,9 @@ public:
 
     const pCamereParam& getCamera();
 
+    /// the pinhole camera of a EuRoC sensor.yaml, nullptr if a field is missing
+    static pCamereParam loadCamera(const std::string &cameraParamfile);
+
 /*
     pose_t          getTBS(void) {return  camParam->getTBS();}
     int             getRate(void) {return  camParam->getRate();}
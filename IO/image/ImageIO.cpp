@@ -2,109 +2,174 @@
 #include <fstream>
 #include <iostream>
 
-#include <boost/regex.hpp>
-
 #include "ImageIO.h"
+#include "../TextLoader.h"
 #include "util/util.h"
+#include "util/Trace.h"
 
 
-ImageIO::ImageIO(std::string &imagefile, std::string dataDirectory_):dataDirectory(dataDirectory_)
+ImageIO::ImageIO(std::string &imagefile, std::string dataDirectory_):dataDirectory(dataDirectory_),
+    next_(0), consumed_(0), stop_(false), stall_("image pop stall")
 {
     assert(!imagefile.empty());
-    std::string fileName;
-    std::string totalLine;
-    std::ifstream imgData_file(imagefile.c_str());
-    if(!imgData_file.good()) {
+    if(!loadList(imagefile, imageDeque)) {
         std::cerr << "camParam_file file error!" << std::endl;
         exit(-1);
     }
-
-    std::getline( imgData_file, totalLine );
-    while (!imgData_file.eof()){
-        if(totalLine[0]=='#') {
-            imgData_file>>totalLine;
-            continue;
-        }
-
-        std::size_t currentPos = -1;
-        currentPos = totalLine.find(",",0);
-        if(currentPos==std::string::npos){
-            std::cout<<"No , !!!\n\n\n";
-            break;
-        }
-
-	    std::string s = totalLine.substr(0,currentPos).c_str();
-
-        std::string nanoseconds = s.substr(s.size() - 9, 9);
-        std::string seconds = s.substr(0, s.size() - 9);
-
-        fileName = totalLine.substr(currentPos+1,totalLine.size());
-	    int sec = 0;
-	    int nsec = 0;
-	    sscanf(seconds.c_str(), "%d", &sec);
-	    sscanf(nanoseconds.c_str(), "%d", &nsec);
-	    okvis::Time timestamp(sec, nsec);
-
-        imageDeque.push_back(std::make_pair(timestamp,fileName));
-
-        imgData_file>>totalLine;
-    }
 	isUndistortion = false;
 }
 
 ImageIO::ImageIO(std::string &imagefile,
                  std::string dataDirectory_,
-                 std::shared_ptr<AbstractCamera> cam) : dataDirectory(dataDirectory_) {
+                 std::shared_ptr<AbstractCamera> cam) : dataDirectory(dataDirectory_),
+                 next_(0), consumed_(0), stop_(false), stall_("image pop stall") {
     assert(!imagefile.empty());
-	double timestamp = 0.0;
-	std::string fileName;
-	std::string totalLine;
-	std::ifstream imgData_file(imagefile.c_str());
-	if(!imgData_file.good()) {
+	if(!loadList(imagefile, imageDeque)) {
 		std::cerr << "camParam_file file error!" << std::endl;
 		exit(-1);
 	}
+	isUndistortion = true;
+	cam_ = cam;
+}
 
-	std::getline( imgData_file, totalLine );
-	while (!imgData_file.eof()){
-		if(totalLine[0]=='#') {
-			imgData_file>>totalLine;
-			continue;
-		}
+ImageIO::ImageIO(const ImageIOData &images, std::string dataDirectory_,
+                 std::shared_ptr<AbstractCamera> cam) : imageDeque(images), dataDirectory(dataDirectory_),
+                 isUndistortion(cam != nullptr), cam_(cam),
+                 next_(0), consumed_(0), stop_(false), stall_("image pop stall") {
+}
 
-		std::size_t currentPos = -1;
-		currentPos = totalLine.find(",",0);
-		if(currentPos==std::string::npos){
+bool ImageIO::loadList(const std::string &imagefile, ImageIOData &images) {
+	std::vector<char> buf;
+	if(!loader::readFile(imagefile, buf))
+		return false;
+
+	std::vector<loader::Line> lines;
+	loader::splitLines(buf, lines);
+	images.clear();
+	for(const loader::Line &line : lines) {
+		int64_t ns = 0;
+		const char* p = loader::parseInt64(line.begin, line.end, ns);
+		if(p)
+			p = loader::skipPast(p, line.end, ',');
+		if(!p) {
 			std::cout<<"No , !!!\n\n\n";
 			break;
 		}
+		images.push_back(std::make_pair(okvis::Time().fromNSec(uint64_t(ns)), std::string(p, line.end)));
+	}
+	return true;
+}
 
-        std::string s = totalLine.substr(0,currentPos);
 
-        std::string nanoseconds = s.substr(s.size() - 9, 9);
-        std::string seconds = s.substr(0, s.size() - 9);
 
-        fileName = totalLine.substr(currentPos+1,totalLine.size());
-		int sec = 0;
-		int nsec = 0;
-		sscanf(seconds.c_str(), "%d", &sec);
-		sscanf(nanoseconds.c_str(), "%d", &nsec);
-//        std::cout<<"sec = " <<sec<<", nsec = "<<nsec<<"\n";
-		okvis::Time timestamp(sec, nsec);
+ImageIO::~ImageIO() {
+	{
+		std::lock_guard<std::mutex> lock(prefetchMutex_);
+		stop_ = true;
+	}
+	spaceCond_.notify_all();
+	for(auto &worker : workers_)
+		worker.join();
+}
 
-		imageDeque.push_back(std::make_pair(timestamp,fileName));
+bool ImageIO::isEmpty() {
+	if(!ring_.empty()) {
+		std::lock_guard<std::mutex> lock(prefetchMutex_);
+		return consumed_ >= imageDeque.size();
+	}
+	return imageDeque.empty();
+}
 
-		imgData_file>>totalLine;
+void ImageIO::startPrefetch(int depth, int threadNum) {
+	assert(workers_.empty() && depth > 0 && threadNum > 0);
+	Prepared empty;
+	empty.index = 0;
+	empty.ready = false;
+	ring_.assign(depth, empty);
+	occupancy_.assign(depth + 1, 0);
+	for(int i = 0; i < threadNum; ++i)
+		workers_.push_back(std::thread(&ImageIO::prefetchLoop, this));
+}
+
+cv::Mat ImageIO::load(const std::string &name) {
+	TRACE_SCOPE("image load");
+	cv::Mat image = cv::imread(dataDirectory + name, 0);
+	if(image.empty() || !isUndistortion)
+		return image;
+	return Undistort(image, cam_);
+}
+
+// an entry is only taken once its slot is free, so the ring never holds more than depth images
+// and the slot of entry i can't be overwritten before i was popped
+void ImageIO::prefetchLoop() {
+	TRACE_THREAD("image prefetch");
+	std::unique_lock<std::mutex> lock(prefetchMutex_);
+	for(;;) {
+		spaceCond_.wait(lock, [this] {
+			return stop_ || next_ >= imageDeque.size() || next_ < consumed_ + ring_.size();
+		});
+		if(stop_ || next_ >= imageDeque.size())
+			return;
+
+		const size_t index = next_++;
+		const std::pair<okvis::Time, std::string> entry = imageDeque[index];
+		lock.unlock();
+		cv::Mat image = load(entry.second);
+		if(image.empty())
+			std::cout << dataDirectory + entry.second << " is empty!\n";
+		lock.lock();
+
+		Prepared &slot = ring_[index % ring_.size()];
+		slot.index = index;
+		slot.timestamp = entry.first;
+		slot.image = image;
+		slot.ready = true;
+		readyCond_.notify_one();
 	}
-	isUndistortion = true;
-	cam_ = cam;
-//    printf("exit ImageIO construct!\n");
 }
 
+std::pair<okvis::Time, cv::Mat> ImageIO::popPrefetched() {
+	std::unique_lock<std::mutex> lock(prefetchMutex_);
+	if(consumed_ >= imageDeque.size())
+		return std::pair<okvis::Time, cv::Mat>();
+
+	int ready = 0;
+	for(const auto &slot : ring_)
+		ready += slot.ready;
+	occupancy_[ready]++;
+
+	Prepared &slot = ring_[consumed_ % ring_.size()];
+	TRACE_GAUGE("prefetched images", ready);
+	TRACE_SCOPE("image pop");
+	const LatencyHistogram::clock_t::time_point start = LatencyHistogram::clock_t::now();
+	readyCond_.wait(lock, [&] { return slot.ready && slot.index == consumed_; });
+	stall_.add(start);
+
+	std::pair<okvis::Time, cv::Mat> data(slot.timestamp, slot.image);
+	slot.image = cv::Mat();
+	slot.ready = false;
+	consumed_++;
+	lock.unlock();
+	spaceCond_.notify_one();
+
+	if(data.second.empty())
+		return std::pair<okvis::Time, cv::Mat>();
+	return data;
+}
 
+void ImageIO::printStats() const {
+	stall_.print();
+	if(occupancy_.empty())
+		return;
+	printf("images ready at the pops (of %d):", int(ring_.size()));
+	for(size_t i = 0; i < occupancy_.size(); ++i)
+		printf(" %d:%ld", int(i), occupancy_[i]);
+	printf("\n");
+}
 
 std::string ImageIO::popName()
 {
+    assert(ring_.empty());
     std::string data;
     if(imageDeque.empty())
         return data;
@@ -116,28 +181,26 @@ std::string ImageIO::popName()
 
 cv::Mat ImageIO::popImage()
 {
+    if(!ring_.empty())
+        return popPrefetched().second;
+
     std::string data;
     if(imageDeque.empty())
         return cv::Mat();
 
     data = imageDeque.front().second;
     imageDeque.pop_front();
-    data = dataDirectory + data;
-    cv::Mat image = cv::imread(data,0);
-    if(image.empty()) {
-        std::cout<<data<<"!\n";
-        return cv::Mat();
-    }
-
-	if(!isUndistortion)
-		return image;
-
-	cv::Mat undistorionImage = Undistort(image, cam_);
-    return undistorionImage;
+    cv::Mat image = load(data);
+    if(image.empty())
+        std::cout<<dataDirectory + data<<"!\n";
+    return image;
 }
 
 std::pair<okvis::Time, cv::Mat> ImageIO::popImageAndTimestamp()
 {
+    if(!ring_.empty())
+        return popPrefetched();
+
     std::string data;
     if(imageDeque.empty())
         return std::pair<okvis::Time, cv::Mat>();
@@ -145,18 +208,12 @@ std::pair<okvis::Time, cv::Mat> ImageIO::popImageAndTimestamp()
     okvis::Time timeStamp = imageDeque.front().first;
     data = imageDeque.front().second;
     imageDeque.pop_front();
-    data = dataDirectory + data;
-    cv::Mat image = cv::imread(data,0);
+    cv::Mat image = load(data);
 
     if(image.empty()) {
-        std::cout<<data<<" is empty!\n";
+        std::cout<<dataDirectory + data<<" is empty!\n";
         return std::pair<okvis::Time, cv::Mat>();
     }
 
-
-	if(!isUndistortion)
-		return std::make_pair(timeStamp, image);
-
-    cv::Mat undistorionImage = Undistort(image, cam_);
-    return std::make_pair(timeStamp,undistorionImage);
+    return std::make_pair(timeStamp, image);
 }
@@ -2,9 +2,14 @@
 #define IMAGEIO_H
 
 #include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
 #include <string.h>
+#include <condition_variable>
 #include <opencv2/opencv.hpp>
 #include "../IOBase.h"
+#include "util/LatencyHistogram.h"
 #include "ThirdParty/okvis_time/include/Time.hpp"
 
 class AbstractCamera;
@@ -17,24 +22,57 @@ public:
     ImageIO(std::string &imagefile, std::string dataDirectory_);
 	ImageIO(std::string &imagefile, std::string dataDirectory_,
 	        std::shared_ptr<AbstractCamera> cam);
+	/// an already loaded image list, undistorted when there is a camera
+	ImageIO(const ImageIOData &images, std::string dataDirectory_,
+	        std::shared_ptr<AbstractCamera> cam = std::shared_ptr<AbstractCamera>());
 
-	~ImageIO() {}
+	~ImageIO();
 	int width();
 	int height();
     std::string popName();
     cv::Mat  popImage();
     std::pair<okvis::Time, cv::Mat> popImageAndTimestamp();
-	bool isEmpty() {
+	bool isEmpty();
 
-	}
+	/// decode and undistort up to depth images ahead on threadNum threads, the pops then hand them out
+	/// in timestamp order. popName can't be used any more once prefetching.
+	void startPrefetch(int depth, int threadNum);
+	/// stall of the pops and how many images were ready at each
+	void printStats() const;
+
+	/// the timestamps and file names of a EuRoC data.csv
+	static bool loadList(const std::string &imagefile, ImageIOData &images);
+
+private:
+	cv::Mat load(const std::string &name);
+	void prefetchLoop();
+	std::pair<okvis::Time, cv::Mat> popPrefetched();
 
 private:
+	struct Prepared {
+		size_t      index;
+		bool        ready;
+		okvis::Time timestamp;
+		cv::Mat     image;
+	};
+
     ImageIOData       imageDeque;
     std::string       dataDirectory;
 //    double            distortion_coefficients[4];
 //    double            intrinsics[4];
 	bool isUndistortion;
 	std::shared_ptr<AbstractCamera> cam_;
+
+	std::vector<Prepared>    ring_;           //!< slot index % depth, empty unless prefetching
+	std::vector<std::thread> workers_;
+	std::mutex               prefetchMutex_;
+	std::condition_variable  readyCond_;      //!< a slot got ready
+	std::condition_variable  spaceCond_;      //!< a slot got free
+	size_t                   next_;           //!< next entry of imageDeque a worker takes
+	size_t                   consumed_;       //!< next entry handed out
+	bool                     stop_;
+	LatencyHistogram         stall_;
+	std::vector<long>        occupancy_;      //!< ready images found by the pops, by count
 };
 
 
@@ -1,6 +1,9 @@
+#include <thread>
+#include <chrono>
 #include <opencv2/ts/ts.hpp>
 #include <opencv2/opencv.hpp>
 #include "../ImageIO.h"
+#include "IO/camera/CameraIO.h"
 
 
 TEST(TESTIMAGEIO,TESTIMAGEIO){
@@ -20,3 +23,34 @@ TEST(TESTIMAGEIO,TESTIMAGEIO){
     }
     std::cout<<"End of TestImageIO\n";
 }
+
+TEST(ImageIO, prefetch) {
+    std::string imageFile = "../testData/mav0/cam0/data.csv";
+    std::string dataDirectory = "../testData/mav0/cam0/data/";
+    CameraIO camIO("../testData/mav0/cam0/data.csv", "../testData/mav0/cam0/sensor.yaml");
+    std::shared_ptr<AbstractCamera> cam = camIO.getCamera();
+    ImageIO serial(imageFile, dataDirectory, cam);
+    ImageIO prefetched(imageFile, dataDirectory, cam);
+    prefetched.startPrefetch(8, 2);
+
+    // the consumer works on each frame for a while, as the front end does
+    double serialMs = 0, prefetchedMs = 0;
+    int frames = 0, mismatch = 0;
+    while(!serial.isEmpty() && frames < 300) {
+        double t0 = (double)cv::getTickCount();
+        auto a = serial.popImageAndTimestamp();
+        serialMs += ((double)cv::getTickCount() - t0) * 1000.0 / cv::getTickFrequency();
+        t0 = (double)cv::getTickCount();
+        auto b = prefetched.popImageAndTimestamp();
+        prefetchedMs += ((double)cv::getTickCount() - t0) * 1000.0 / cv::getTickFrequency();
+
+        mismatch += a.first != b.first || a.second.size() != b.second.size() ||
+                    (!a.second.empty() && cv::norm(a.second, b.second, cv::NORM_INF) != 0);
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        frames++;
+    }
+
+    printf("%d frames, time in the pops: serial %.1f ms, prefetched %.1f ms\n", frames, serialMs, prefetchedMs);
+    prefetched.printStats();
+    EXPECT_EQ(mismatch, 0);
+}
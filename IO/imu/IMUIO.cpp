@@ -3,219 +3,122 @@
 #include <fstream>
 #include <iostream>
 
-#include <boost/regex.hpp>
-
 #include "IMUIO.h"
+#include "../TextLoader.h"
 
 #include "util/util.h"
 #include "util/setting.h"
 
-void inline readData(char *buffer, const char *name, double *val) {
-    char *p = buffer;
-    p = strstr(p, name);
-
-    assert(p != NULL);
-    *val = -0.1;
-    p += strlen(name);
-    char *p1 = p;
-    while((*p1 >= '0' && *p1 <= '9') || (*p1 == '.') || (*p1 == 'e') || (*p1 == '-') || (*p1 == '+')) p1++;
-    char c = *p1;
-    *p1 = 0;
-    sscanf(p, "%le", val);
-    *p1 = c;
-}
-
-
 IMUIO::IMUIO(std::string &imufile, std::string &imuParamfile) {
     assert(!imufile.empty() && !imuParamfile.empty());
-    std::ifstream imuParam_file(imuParamfile);
-    if(!imuParam_file.good()) {
+    imuParam = loadParam(imuParamfile);
+    if(!imuParam) {
         std::cerr << "imuParam file error!" << std::endl;
         exit(-1);
     }
 
-    char imuParamBuffer[1024];
-    memset(imuParamBuffer, 0, 1024);
-
-    imuParam_file.read(imuParamBuffer, 1024);
-
-    assert(imuParamBuffer[0] != 0);
-//    boost::regex imuIDReg("^[A-Za-z]+[0-9]+");
-//    boost::cmatch IDMat;
-//    if(!boost::regex_match(imuParamBuffer, IDMat, imuIDReg)) {
-//        std::cerr << "no imu ID in imu param !" << std::endl;
-//        exit(-1);
-//    }
-//
-//    const std::string imuID = IDMat[0].str();
-
-    char c = 0;
-    int rate_hz = -1;
-    char *p = imuParamBuffer;
-    p = strstr(p, "rate_hz: ");
-    assert(p != NULL);
-    p += strlen("rate_hz: ");
-    char * p1 = p;
-    while (*p1 >= '0' && *p1 <= '9') p1++;
-    c = *p1;
-    *p1 = '\0';
-    sscanf(p, "%d", &rate_hz);
-    *p1 = c;
-
-    double gyroscope_noise_density = -0.1;
-    readData(imuParamBuffer, "gyroscope_noise_density: ", &gyroscope_noise_density);
-
-    double gyroscope_random_walk = -0.1;
-    readData(imuParamBuffer, "gyroscope_random_walk: ", &gyroscope_random_walk);
-
-    double accelerometer_noise_density = -0.1;
-    readData(imuParamBuffer, "accelerometer_noise_density: ", &accelerometer_noise_density);
-
-    double accelerometer_random_walk = -0.1;
-    readData(imuParamBuffer, "accelerometer_random_walk: ", &accelerometer_random_walk);
-
-    p = strstr(imuParamBuffer, "T_BS");
-    if(p == NULL) {
-        std::cerr << "on T_BS in imu param !\n";
+    imuLog = loadLog(imufile);
+    if(!imuLog->good()) {
+        std::cerr << "imu file error!" << std::endl;
         exit(-1);
     }
+    cursor = 0;
+}
 
-    p = strstr(p, "data: [");
-    p += strlen("data: [");
-    double T_BS[16];
-    memset(T_BS, 0, sizeof(double) * 16);
-    int T_BSCnt = 0;
-
-    p1 = p;
-
-    while(*p1 != ']') p1++;
-    c = *p1;
-    *p1 = '\0';
-    char *spt = strtok(p, ",");
-    while(spt != NULL) {
-        if((*spt >= '0' && *spt <='9') || (*spt = '.')) {
-            sscanf(spt, "%lf", T_BS + T_BSCnt);
-        }
+IMUIO::IMUIO(const std::shared_ptr<ImuLog> &log, const pImuParam &param) : imuLog(log), cursor(0), imuParam(param) {
+    assert(imuLog && imuLog->good() && imuParam);
+}
 
-        else {
-            char *pspt = spt + 1;
-            while(!((*pspt >= '0' && *pspt <='9') || (*pspt = '.'))) pspt++;
-            sscanf(pspt, "%lf", T_BS + T_BSCnt);
-        }
+IMUIO::IMUIO(const std::shared_ptr<ImuStream> &stream, const pImuParam &param) : imuStream(stream), cursor(0),
+                                                                                 imuParam(param) {
+    assert(imuStream && imuParam);
+}
 
-        T_BSCnt++;
-        spt = strtok(NULL, ",");
+IMUIO::pImuParam IMUIO::loadParam(const std::string &imuParamfile) {
+    loader::Yaml yaml(imuParamfile);
+    if(!yaml.good())
+        return pImuParam();
+
+    double rate_hz = -1;
+    double gyroscope_noise_density = -0.1, gyroscope_random_walk = -0.1;
+    double accelerometer_noise_density = -0.1, accelerometer_random_walk = -0.1;
+    std::vector<double> T_BS;
+    if(!yaml.scalar("rate_hz", rate_hz)
+       || !yaml.scalar("gyroscope_noise_density", gyroscope_noise_density)
+       || !yaml.scalar("gyroscope_random_walk", gyroscope_random_walk)
+       || !yaml.scalar("accelerometer_noise_density", accelerometer_noise_density)
+       || !yaml.scalar("accelerometer_random_walk", accelerometer_random_walk)) {
+        return pImuParam();
+    }
+    if(!yaml.list("data", T_BS, "T_BS") || T_BS.size() != 16) {
+        std::cerr << "on T_BS in imu param !\n";
+        return pImuParam();
     }
 
-    *p1 = c;
-
-    imuParam = std::make_shared<ImuParameters>();
-    imuParam->rate = rate_hz;
-    imuParam->sigma_bg  = gyroscope_random_walk;
-    imuParam->sigma_ba  = accelerometer_random_walk;
-    imuParam->sigma_a_c = accelerometer_noise_density;
-    imuParam->sigma_g_c = gyroscope_noise_density;
+    pImuParam param = std::make_shared<ImuParameters>();
+    param->rate = int(rate_hz);
+    param->sigma_bg  = gyroscope_random_walk;
+    param->sigma_ba  = accelerometer_random_walk;
+    param->sigma_a_c = accelerometer_noise_density;
+    param->sigma_g_c = gyroscope_noise_density;
 
+    // row major as in the camera yaml
     Eigen::Matrix4d mTbs;
     for(int i = 0; i < 4; ++i) {
         for(int j = 0; j < 4; ++j) {
-            mTbs(i, j) = T_BS[j * 4 + i];
+            mTbs(i, j) = T_BS[i * 4 + j];
         }
     }
 
-    Sophus::SE3d seTbs(mTbs);
-
-    imuParam->T_BS = seTbs;
-    imuParam->g = Eigen::Vector3d(0, 0, Gravity);
-
-    std::ifstream imu_file(imufile);
-    if(!imu_file.good()) {
-        std::cerr << "imu file error!" << std::endl;
-        exit(-1);
-    }
-
-    int i = -1;
-    do {
-        i++;
-        std::string line;
-        if(!std::getline(imu_file, line)) {
-            break;
-        }
-
-        if(i == 0)
-            continue;
-
-        std::stringstream stream(line);
-        std::string s;
-        std::getline(stream, s, ',');
-        std::string nanoseconds = s.substr(s.size() - 9, 9);
-        std::string seconds = s.substr(0, s.size() - 9);
-        Eigen::Vector3d gyr;
-        for (int j = 0; j < 3; ++j) {
-            std::getline(stream, s, ',');
-            sscanf(s.c_str(), "%lf", &gyr[j]);
-            //gyr[j] = std::stod(s);
-        }
-
-
-        Eigen::Vector3d acc;
-        for (int j = 0; j < 3; ++j) {
-            std::getline(stream, s, ',');
-            sscanf(s.c_str(), "%lf", &acc[j]);
-            //acc[j] = std::stod(s);
-        }
-
-        int sec = 0;
-        int nsec = 0;
-        sscanf(seconds.c_str(), "%d", &sec);
-        sscanf(nanoseconds.c_str(), "%d", &nsec);
-        okvis::Time t_imu(sec, nsec);
-        imuMeasureDeque.addImuMeasurement(0, t_imu, acc, gyr);
-    } while(true);
+    param->T_BS = Sophus::SE3d(mTbs);
+    param->g = Eigen::Vector3d(0, 0, Gravity);
+    return param;
+}
 
+std::shared_ptr<ImuLog> IMUIO::loadLog(const std::string &imufile) {
+#if ImuLogCache
+    return ImuLog::openCached(imufile);
+#else
+    return std::make_shared<ImuLog>(imufile);
+#endif
 }
 
+// a binary search each, the log itself is never consumed so the intervals may come in any order
 IMUIO::dataDeque_t IMUIO::pop(okvis::Time &start, okvis::Time &end) {
     dataDeque_t imuDeque;
-    std::shared_ptr<IMUMeasure> pImuMeasure = imuMeasureDeque.front();
-    if(pImuMeasure->measurement.timeStamp > end)
-        return imuDeque;
-
-    while(pImuMeasure->measurement.timeStamp < start){
-        imuMeasureDeque.pop_front();
-        pImuMeasure = imuMeasureDeque.front();
-    }
-
-    auto it = std::find_if(imuMeasureDeque.begin(), imuMeasureDeque.end(), [&](std::shared_ptr<IMUMeasure>& ptr) {
-            if(ptr->measurement.timeStamp >= end)
-                return true;
-	        return false;
-});
-
-    if(it != imuMeasureDeque.end())
-        it++;
-
-    int cnt= 0;
-    for(auto it_ = imuMeasureDeque.begin(); it_ != it; ++it_) {
-        imuDeque.push_back(*it_);
+    const ImuSpan span = range(start, end);
+    for(const ImuRecord &r : span) {
+        imuDeque.addImuMeasurement(0, r.time(), Eigen::Vector3d(r.acc[0], r.acc[1], r.acc[2]),
+                                   Eigen::Vector3d(r.gyr[0], r.gyr[1], r.gyr[2]));
     }
+    if(imuLog && !span.empty())
+        cursor = size_t(span.begin() - imuLog->all().begin());
+    return imuDeque;
+}
 
-    while(cnt) {
-        imuMeasureDeque.pop_front();
-        cnt--;
+ImuSpan IMUIO::range(const okvis::Time &start, const okvis::Time &end) {
+    if(imuStream) {
+        if(!imuStream->range(int64_t(start.toNSec()), int64_t(end.toNSec()), streamRecords))
+            std::cerr << "imu stream doesn't cover " << start << " - " << end << std::endl;
+        return ImuSpan(streamRecords.data(), streamRecords.data() + streamRecords.size());
     }
+    if(!imuLog)
+        return ImuSpan();
+    return imuLog->range(start, end);
+}
 
-    return imuDeque;
+void IMUIO::release(const okvis::Time &t) {
+    if(imuStream)
+        imuStream->release(int64_t(t.toNSec()));
 }
 
 IMUIO::pData_t IMUIO::pop() {
-    if(imuMeasureDeque.empty())
+    if(!imuLog || cursor >= imuLog->size())
         return pData_t();
 
-    pData_t data;
-    data = std::move(imuMeasureDeque.front());
-    imuMeasureDeque.pop_front();
-    return data;
+    const ImuRecord &r = imuLog->all()[cursor++];
+    return std::make_shared<IMUMeasure>(0, r.time(), Eigen::Vector3d(r.acc[0], r.acc[1], r.acc[2]),
+                                        Eigen::Vector3d(r.gyr[0], r.gyr[1], r.gyr[2]));
 }
 
 const IMUIO::pImuParam &IMUIO::getImuParam() {
@@ -5,6 +5,8 @@
 #include <Eigen/Geometry>
 
 #include "../IOBase.h"
+#include "ImuLog.h"
+#include "ImuStream.h"
 #include "DataStructure/imu/IMUMeasure.h"
 
 
@@ -18,13 +20,34 @@ public:
     typedef std::shared_ptr<ImuParameters>   pImuParam;
 
 public:
+    /// imufile is a EuRoC csv or a binary ImuLog
     IMUIO(std::string &imufile, std::string &imuParamfile);
+    IMUIO(const std::shared_ptr<ImuLog> &log, const pImuParam &param);
+    /// live samples, pop(start, end) waits for the sensor to get past end
+    IMUIO(const std::shared_ptr<ImuStream> &stream, const pImuParam &param);
+    /// the samples covering [start, end], see ImuLog::range
     dataDeque_t pop(okvis::Time& start, okvis::Time& end);
+    /// the next sample of the log, nothing for a stream
     pData_t pop();
+    /// the same samples as pop(start, end) as a view into the log, nothing is copied. a stream copies them into
+    /// a buffer of its own which the next call reuses, so the view holds until then
+    ImuSpan range(const okvis::Time& start, const okvis::Time& end);
+    /// nothing before t is asked for any more, a stream lets go of it
+    void release(const okvis::Time& t);
     const pImuParam& getImuParam();
+    const std::shared_ptr<ImuLog>& getLog() const { return imuLog; }
+    const std::shared_ptr<ImuStream>& getStream() const { return imuStream; }
+
+    /// the noise densities, random walks, rate and T_BS of a EuRoC imu sensor.yaml, nullptr if one is missing
+    static pImuParam loadParam(const std::string &imuParamfile);
+    /// the log behind imufile, see ImuLogCache
+    static std::shared_ptr<ImuLog> loadLog(const std::string &imufile);
 
 private:
-    dataDeque_t                     imuMeasureDeque;
+    std::shared_ptr<ImuLog>         imuLog;
+    std::shared_ptr<ImuStream>      imuStream;
+    std::vector<ImuRecord>          streamRecords;  //!< the last range() of the stream
+    size_t                          cursor;         //!< next sample of pop()
     pImuParam                       imuParam;
 };
 
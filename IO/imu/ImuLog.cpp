@@ -0,0 +1,185 @@
+#include <atomic>
+#include <cctype>
+#include <fstream>
+#include <iostream>
+#include <algorithm>
+#include <cstring>
+#include <cstdlib>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "ImuLog.h"
+#include "../TextLoader.h"
+
+static const char ImuLogMagic[8] = {'S', 'V', 'I', 'O', 'I', 'M', 'U', '\0'};
+
+static_assert(sizeof(ImuRecord) == 56, "the record is the on-disk layout");
+static_assert(sizeof(ImuLogHeader) == 64, "the records start 64 byte aligned");
+
+ImuLog::ImuLog(const std::string &file) : data_(nullptr), size_(0), map_(nullptr), mapBytes_(0) {
+    if(isBinary(file)) {
+        if(!map(file))
+            std::cerr << "imu log " << file << " is broken!" << std::endl;
+        return;
+    }
+
+    if(!parseCsv(file, owned_)) {
+        std::cerr << "imu file error!" << std::endl;
+        return;
+    }
+    data_ = owned_.data();
+    size_ = owned_.size();
+}
+
+ImuLog::~ImuLog() {
+    if(map_)
+        munmap(map_, mapBytes_);
+}
+
+bool ImuLog::map(const std::string &file) {
+    const int fd = open(file.c_str(), O_RDONLY);
+    if(fd < 0)
+        return false;
+
+    struct stat st;
+    if(fstat(fd, &st) != 0 || size_t(st.st_size) < sizeof(ImuLogHeader)) {
+        close(fd);
+        return false;
+    }
+
+    // the pages are only read in when a range touches them, so opening an hour of samples costs nothing
+    void *p = mmap(nullptr, size_t(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if(p == MAP_FAILED)
+        return false;
+
+    const ImuLogHeader *header = static_cast<const ImuLogHeader*>(p);
+    if(header->version != Version || header->recordSize != sizeof(ImuRecord)
+       || size_t(st.st_size) != sizeof(ImuLogHeader) + header->count * sizeof(ImuRecord)) {
+        munmap(p, size_t(st.st_size));
+        return false;
+    }
+
+    map_ = p;
+    mapBytes_ = size_t(st.st_size);
+    data_ = reinterpret_cast<const ImuRecord*>(header + 1);
+    size_ = size_t(header->count);
+    return true;
+}
+
+ImuSpan ImuLog::range(int64_t start, int64_t end) const {
+    const ImuRecord *first = data_, *last = data_ + size_;
+    const ImuRecord *b = std::upper_bound(first, last, start,
+                                          [](int64_t t, const ImuRecord &r) { return t < r.t; });
+    if(b != first)
+        --b;
+    const ImuRecord *e = std::lower_bound(b, last, end,
+                                          [](const ImuRecord &r, int64_t t) { return r.t < t; });
+    if(e != last)
+        ++e;
+    return ImuSpan(b, e);
+}
+
+bool ImuLog::isBinary(const std::string &file) {
+    std::ifstream in(file, std::ios::binary);
+    char magic[sizeof(ImuLogMagic)] = {0};
+    in.read(magic, sizeof(magic));
+    return in.good() && memcmp(magic, ImuLogMagic, sizeof(magic)) == 0;
+}
+
+bool ImuLog::parseCsv(const std::string &csv, std::vector<ImuRecord> &records) {
+    std::vector<char> buf;
+    if(!loader::readFile(csv, buf))
+        return false;
+
+    std::vector<loader::Line> lines;
+    loader::splitLines(buf, lines);
+    // the header, commented out in EuRoC
+    size_t first = 0;
+    if(!lines.empty() && !isdigit(static_cast<unsigned char>(*lines[0].begin)) && *lines[0].begin != '-')
+        first = 1;
+
+    records.resize(lines.size() - first);
+    std::atomic<bool> broken(false);
+    loader::parallelFor(records.size(), [&](size_t begin, size_t end) {
+        for(size_t i = begin; i < end; ++i) {
+            const loader::Line &line = lines[first + i];
+            ImuRecord &r = records[i];
+            const char* p = loader::parseInt64(line.begin, line.end, r.t);
+            for(int j = 0; j < 6 && p; ++j) {
+                p = loader::skipPast(p, line.end, ',');
+                if(p)
+                    p = loader::parseDouble(p, line.end, j < 3 ? r.gyr[j] : r.acc[j - 3]);
+            }
+            if(!p) {
+                broken = true;
+                return;
+            }
+        }
+    });
+    if(broken) {
+        records.clear();
+        return false;
+    }
+    return true;
+}
+
+bool ImuLog::isSorted(const ImuSpan &records) {
+    for(size_t i = 1; i < records.size(); ++i) {
+        if(records[i].t < records[i - 1].t)
+            return false;
+    }
+    return true;
+}
+
+bool ImuLog::write(const std::string &file, const ImuSpan &records) {
+    ImuLogHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, ImuLogMagic, sizeof(ImuLogMagic));
+    header.version = Version;
+    header.recordSize = sizeof(ImuRecord);
+    header.count = records.size();
+
+    std::ofstream out(file, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(records.begin()), records.size() * sizeof(ImuRecord));
+    return out.good();
+}
+
+long ImuLog::convert(const std::string &csv, const std::string &file) {
+    std::vector<ImuRecord> records;
+    if(!parseCsv(csv, records))
+        return -1;
+    const ImuSpan all(records.data(), records.data() + records.size());
+    if(!isSorted(all) || !write(file, all))
+        return -1;
+    return long(records.size());
+}
+
+std::shared_ptr<ImuLog> ImuLog::openCached(const std::string &csv) {
+    if(isBinary(csv))
+        return std::make_shared<ImuLog>(csv);
+
+    const std::string file = csv + ".bin";
+    struct stat csvStat, fileStat;
+    if(stat(csv.c_str(), &csvStat) == 0 && stat(file.c_str(), &fileStat) == 0
+       && fileStat.st_mtime >= csvStat.st_mtime && isBinary(file)) {
+        std::shared_ptr<ImuLog> log = std::make_shared<ImuLog>(file);
+        if(log->good())
+            return log;
+    }
+
+    std::shared_ptr<ImuLog> log = std::make_shared<ImuLog>(csv);
+    if(!log->good() || !log->size())
+        return log;
+    if(!isSorted(log->all())) {
+        std::cerr << "imu file " << csv << " is not in timestamp order, not cached!" << std::endl;
+        return log;
+    }
+    // best effort, a read-only data set is parsed every time
+    write(file, log->all());
+    return log;
+}
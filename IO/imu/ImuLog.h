@@ -0,0 +1,97 @@
+#ifndef SIMPLE_VIO_IMULOG_H
+#define SIMPLE_VIO_IMULOG_H
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+#include <boost/noncopyable.hpp>
+
+#include "ThirdParty/okvis_time/include/Time.hpp"
+
+/// one IMU sample, the fixed stride record of the binary log
+struct ImuRecord {
+    int64_t t;          //!< timestamp [ns]
+    double  gyr[3];     //!< [rad/s]
+    double  acc[3];     //!< [m/s^2]
+
+    okvis::Time time() const { return okvis::Time().fromNSec(uint64_t(t)); }
+};
+
+/// header of the binary log, the records follow 64 byte aligned in timestamp order
+struct ImuLogHeader {
+    char     magic[8];
+    uint32_t version;
+    uint32_t recordSize;
+    uint64_t count;
+    char     reserved[40];
+};
+
+/// a run of consecutive records, a view into the log which stays valid as long as the log
+class ImuSpan {
+public:
+    ImuSpan() : begin_(nullptr), end_(nullptr) {}
+    ImuSpan(const ImuRecord* begin, const ImuRecord* end) : begin_(begin), end_(end) {}
+
+    const ImuRecord* begin() const { return begin_; }
+    const ImuRecord* end() const { return end_; }
+    size_t size() const { return size_t(end_ - begin_); }
+    bool empty() const { return begin_ == end_; }
+    const ImuRecord& operator[](size_t i) const { return begin_[i]; }
+    const ImuRecord& front() const { return *begin_; }
+    const ImuRecord& back() const { return *(end_ - 1); }
+
+private:
+    const ImuRecord* begin_;
+    const ImuRecord* end_;
+};
+
+/// the samples of a whole IMU log in one array: a binary log is mapped read-only, a EuRoC csv is parsed into memory.
+class ImuLog : boost::noncopyable {
+public:
+    static const uint32_t Version = 1;
+
+public:
+    /// the format is told by the magic of the file
+    explicit ImuLog(const std::string &file);
+    ~ImuLog();
+
+    bool good() const { return data_ != nullptr; }
+    bool mapped() const { return map_ != nullptr; }
+    size_t size() const { return size_; }
+    ImuSpan all() const { return ImuSpan(data_, data_ + size_); }
+
+    /// the last sample at or before start up to the first one at or after end, both by binary search.
+    /// the interval is covered for interpolation whenever the log covers it.
+    ImuSpan range(int64_t start, int64_t end) const;
+    ImuSpan range(const okvis::Time &start, const okvis::Time &end) const {
+        return range(int64_t(start.toNSec()), int64_t(end.toNSec()));
+    }
+
+    static bool isBinary(const std::string &file);
+    /// a line which doesn't parse fails the whole file
+    static bool parseCsv(const std::string &csv, std::vector<ImuRecord> &records);
+    /// the queries rely on the timestamp order, a log with a sample out of place is never written
+    static bool isSorted(const ImuSpan &records);
+    static bool write(const std::string &file, const ImuSpan &records);
+    /// csv -> binary log, returns the number of samples written or -1
+    static long convert(const std::string &csv, const std::string &file);
+    /// maps csv + ".bin" if it is not older than the csv, otherwise parses the csv and leaves the binary log
+    /// next to it for the next start, if the csv is in timestamp order
+    static std::shared_ptr<ImuLog> openCached(const std::string &csv);
+
+private:
+    bool map(const std::string &file);
+
+private:
+    const ImuRecord*       data_;
+    size_t                 size_;
+    void*                  map_;
+    size_t                 mapBytes_;
+    std::vector<ImuRecord> owned_;
+};
+
+
+#endif //SIMPLE_VIO_IMULOG_H
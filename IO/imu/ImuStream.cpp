@@ -0,0 +1,141 @@
+#include <cstdio>
+#include <limits>
+
+#include "ImuStream.h"
+
+ImuStream::ImuStream(size_t capacity) : ingress_(capacity), pushed_(0), full_(0), closed_(false),
+                                        head_(0), size_(0), released_(std::numeric_limits<int64_t>::min()) {
+    size_t size = 2;
+    while(size < capacity)
+        size <<= 1;
+    window_.resize(size);
+    mask_ = size - 1;
+    stats_ = Stats();
+}
+
+bool ImuStream::push(const ImuRecord &r) {
+    if(!ingress_.push(r)) {
+        full_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    pushed_.fetch_add(1, std::memory_order_relaxed);
+    arrived_.notify_all();
+    return true;
+}
+
+void ImuStream::close() {
+    closed_ = true;
+    arrived_.notify_all();
+}
+
+size_t ImuStream::upper(int64_t t) const {
+    size_t first = 0, count = size_;
+    while(count > 0) {
+        const size_t half = count / 2;
+        if(at(first + half).t <= t)
+            first += half + 1, count -= half + 1;
+        else
+            count = half;
+    }
+    return first;
+}
+
+void ImuStream::insert(const ImuRecord &r) {
+    if(r.t < released_) {
+        stats_.late++;
+        return;
+    }
+    // in order is the common case, the search is only for the few a driver hands over late
+    size_t pos = size_;
+    if(size_ && r.t <= at(size_ - 1).t) {
+        pos = upper(r.t);
+        if(pos > 0 && at(pos - 1).t == r.t) {
+            stats_.duplicate++;
+            return;
+        }
+        stats_.reordered++;
+    }
+
+    if(size_ == window_.size()) {
+        stats_.overflow++;
+        if(pos == 0)
+            return;
+        head_ = (head_ + 1) & mask_;
+        size_--;
+        pos--;
+    }
+    for(size_t i = size_; i > pos; --i)
+        at(i) = at(i - 1);
+    at(pos) = r;
+    size_++;
+}
+
+void ImuStream::drain() {
+    ImuRecord r;
+    while(ingress_.pop(r))
+        insert(r);
+}
+
+bool ImuStream::range(int64_t start, int64_t end, std::vector<ImuRecord> &records, std::chrono::milliseconds timeout) {
+    const std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + timeout;
+    std::unique_lock<std::mutex> lock(mutex_);
+    drain();
+    while((!size_ || at(size_ - 1).t < end) && !closed_) {
+        const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        if(now >= deadline)
+            break;
+        arrived_.wait_for(lock, std::min<std::chrono::steady_clock::duration>(deadline - now, std::chrono::milliseconds(1)));
+        drain();
+    }
+    if(closed_)
+        drain();
+
+    records.clear();
+    if(!size_)
+        return false;
+    size_t b = upper(start);
+    if(b > 0)
+        --b;
+    size_t e = b;
+    while(e < size_ && at(e).t < end)
+        ++e;
+    if(e < size_)
+        ++e;
+    records.reserve(e - b);
+    for(size_t i = b; i < e; ++i)
+        records.push_back(at(i));
+    return at(b).t <= start && at(e - 1).t >= end;
+}
+
+void ImuStream::release(int64_t t) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    drain();
+    size_t keep = upper(t);
+    if(keep > 0)
+        --keep;
+    head_ = (head_ + keep) & mask_;
+    size_ -= keep;
+    if(t > released_)
+        released_ = size_ ? std::min(t, at(0).t) : t;
+}
+
+size_t ImuStream::size() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    drain();
+    return size_;
+}
+
+ImuStream::Stats ImuStream::stats() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    drain();
+    Stats s = stats_;
+    s.pushed = pushed_.load(std::memory_order_relaxed);
+    s.full = full_.load(std::memory_order_relaxed);
+    return s;
+}
+
+void ImuStream::printStats() {
+    const Stats s = stats();
+    printf("imu stream: %ld pushed, %ld full, %ld reordered, %ld duplicate, %ld late, %ld overflow, %lu held\n",
+           s.pushed, s.full, s.reordered, s.duplicate, s.late, s.overflow, size());
+}
@@ -0,0 +1,78 @@
+#ifndef SIMPLE_VIO_IMUSTREAM_H
+#define SIMPLE_VIO_IMUSTREAM_H
+
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <vector>
+#include <condition_variable>
+
+#include <boost/noncopyable.hpp>
+
+#include "ImuLog.h"
+#include "util/SPSCQueue.h"
+
+/// IMU samples arriving live: one sensor thread pushes, the front end queries intervals as with ImuLog::range
+/// and releases what no keyframe needs any more. memory is fixed at construction.
+///
+/// push() goes through a lock-free queue and never waits. the queries move what arrived into a window sorted
+/// by timestamp, a sample arriving out of order is inserted in place, one with a timestamp already held or
+/// already released is dropped. when the window is full the oldest sample goes.
+class ImuStream : boost::noncopyable {
+public:
+    struct Stats {
+        long pushed;
+        long full;          //!< rejected by push(), the consumers fell behind by the whole ingress
+        long reordered;     //!< arrived out of order and were inserted in place
+        long duplicate;
+        long late;          //!< older than what was released
+        long overflow;      //!< pushed out of a full window
+    };
+
+public:
+    explicit ImuStream(size_t capacity);
+
+    /// producer side
+    bool push(const ImuRecord &r);
+    /// no more samples come, waiting queries return at once
+    void close();
+
+    /// the samples covering [start, end] as ImuLog::range, waits up to timeout for one at or after end.
+    /// true when the interval is covered
+    bool range(int64_t start, int64_t end, std::vector<ImuRecord> &records,
+               std::chrono::milliseconds timeout = std::chrono::milliseconds(100));
+    /// drops everything before the last sample at or before t, later samples older than t are dropped as late
+    void release(int64_t t);
+
+    size_t size();
+    size_t capacity() const { return window_.size(); }
+    Stats stats();
+    void printStats();
+
+private:
+    void drain();
+    void insert(const ImuRecord &r);
+    const ImuRecord& at(size_t i) const { return window_[(head_ + i) & mask_]; }
+    ImuRecord& at(size_t i) { return window_[(head_ + i) & mask_]; }
+    /// first index with a timestamp above t
+    size_t upper(int64_t t) const;
+
+private:
+    SPSCQueue<ImuRecord>    ingress_;
+    std::atomic<long>       pushed_;
+    std::atomic<long>       full_;
+    std::atomic<bool>       closed_;
+    std::condition_variable arrived_;     //!< notified without the mutex, the waits poll to cover a lost wakeup
+
+    // the consumers, under mutex_
+    std::mutex              mutex_;
+    std::vector<ImuRecord>  window_;      //!< power of two ring, sorted from head_
+    size_t                  mask_;
+    size_t                  head_;
+    size_t                  size_;
+    int64_t                 released_;    //!< nothing older is taken any more
+    Stats                   stats_;
+};
+
+
+#endif //SIMPLE_VIO_IMUSTREAM_H
@@ -1,3 +1,10 @@
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <thread>
 #include <opencv2/ts/ts.hpp>
 
 #include "IO/imu/IMUIO.h"
@@ -28,5 +35,146 @@ TEST(TestImuIO, IMU_IO) {
 
 }
 
+TEST(ImuLog, binary) {
+    const std::string csv("../testData/mav0/imu0/data.csv");
+    const std::string file("imu0_test.bin");
+    std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+    ImuLog parsed(csv);
+    const double csvMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    GTEST_ASSERT_EQ(ImuLog::convert(csv, file), long(parsed.size()));
 
+    t0 = std::chrono::steady_clock::now();
+    ImuLog mapped(file);
+    const double mapMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    GTEST_ASSERT_EQ(mapped.mapped(), true);
+    GTEST_ASSERT_EQ(mapped.size(), parsed.size());
+    GTEST_ASSERT_EQ(memcmp(mapped.all().begin(), parsed.all().begin(), parsed.size() * sizeof(ImuRecord)), 0);
 
+    // every interval between two samples, the span is known by construction
+    const ImuSpan all = mapped.all();
+    int wrong = 0;
+    t0 = std::chrono::steady_clock::now();
+    for(size_t i = 0; i + 10 < all.size(); ++i) {
+        const int64_t start = all[i].t + 1, end = all[i + 10].t - 1;
+        const ImuSpan span = mapped.range(start, end);
+        wrong += span.begin() != all.begin() + i || span.end() != all.begin() + i + 11;
+    }
+    const double queryUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count();
+    printf("%lu samples: csv %.1f ms, mapped %.3f ms, %.3f us per range\n", all.size(), csvMs, mapMs,
+           queryUs / (all.size() - 10));
+    GTEST_ASSERT_EQ(wrong, 0);
+
+    // random intervals against a linear scan: on samples, between them and beyond both ends of the log
+    std::mt19937_64 rng(5);
+    const int64_t lo = all.front().t - 50000000, span = all.back().t + 50000000 - lo;
+    for(int k = 0; k < 2000; ++k) {
+        int64_t start = lo + int64_t(rng() % uint64_t(span)), end = start + int64_t(rng() % 100000000);
+        if(k % 4 == 0)
+            start = all[rng() % all.size()].t;
+        if(k % 8 == 0)
+            end = all[rng() % all.size()].t;
+        size_t b = 0, e = 0;
+        while(b + 1 < all.size() && all[b + 1].t <= start)
+            ++b;
+        while(e < all.size() && all[e].t < end)
+            ++e;
+        e = std::max(e, b);
+        if(e < all.size())
+            ++e;
+        const ImuSpan range = mapped.range(start, end);
+        wrong += range.begin() != all.begin() + b || range.end() != all.begin() + e;
+    }
+    GTEST_ASSERT_EQ(wrong, 0);
+    remove(file.c_str());
+}
+
+// a csv with two samples swapped is neither converted nor cached
+TEST(ImuLog, unsorted) {
+    const std::string csv("imu_unsorted_test.csv"), file("imu_unsorted_test.bin");
+    {
+        std::ofstream out(csv);
+        out << "#timestamp [ns],w_RS_S_x,w_RS_S_y,w_RS_S_z,a_RS_S_x,a_RS_S_y,a_RS_S_z\n";
+        const int64_t t[5] = {1000, 2000, 4000, 3000, 5000};
+        for(int i = 0; i < 5; ++i)
+            out << t[i] << ",0.1,0.2,0.3,1,2,9.8\n";
+    }
+    GTEST_ASSERT_EQ(ImuLog::convert(csv, file), -1);
+    GTEST_ASSERT_EQ(std::ifstream(file).good(), false);
+    std::shared_ptr<ImuLog> log = ImuLog::openCached(csv);
+    GTEST_ASSERT_EQ(log->size(), size_t(5));
+    GTEST_ASSERT_EQ(ImuLog::isSorted(log->all()), false);
+    GTEST_ASSERT_EQ(std::ifstream(csv + ".bin").good(), false);
+    remove(csv.c_str());
+}
+
+// a simulated sensor pushes 200 Hz samples with a few swapped pairs, repeated and ancient ones while the
+// front end asks for the samples between two frames and releases everything before the last keyframe.
+// the sensor stays at most lead samples ahead of the last release, so the counters don't depend on the
+// scheduling: an ancient sample always comes after a release and is late, the window never overflows
+TEST(ImuStream, live) {
+    const int64_t t0 = 1403636579758555392LL, dt = 5000000;
+    const int sampleNum = 20000, step = 10, lead = 512;
+    auto sample = [&](int i) {
+        ImuRecord r;
+        r.t = t0 + i * dt;
+        for(int k = 0; k < 3; ++k)
+            r.gyr[k] = r.acc[k] = i;
+        return r;
+    };
+
+    std::shared_ptr<ImuStream> stream = std::make_shared<ImuStream>(1024);
+    IMUIO imuIO(stream, std::make_shared<ImuParameters>());
+    long swaps = 0, repeats = 0, ancients = 0;
+    std::atomic<int> released(-1);
+    std::thread sensor([&] {
+        for(int i = 0; i < sampleNum; ++i) {
+            while(i - released.load() > lead)
+                std::this_thread::yield();
+            // never around a frame, a frame can't wait for a sample it already got past
+            if(i % 100 == 45 && i + 1 < sampleNum) {
+                stream->push(sample(i + 1));
+                stream->push(sample(i));
+                swaps++;
+                ++i;
+            }
+            else
+                stream->push(sample(i));
+            if(i % 53 == 0) {
+                stream->push(sample(i));
+                repeats++;
+            }
+            if(i % 1000 == 999) {
+                stream->push(sample(-1));
+                ancients++;
+            }
+            if(i % 8 == 0)
+                std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }
+        stream->close();
+    });
+
+    long wrong = 0;
+    size_t held = 0;
+    for(int i = 0; i + step < sampleNum; i += step) {
+        okvis::Time start = sample(i).time(), end = sample(i + step).time();
+        IMUIO::dataDeque_t imu = imuIO.pop(start, end);
+        wrong += imu.size() != size_t(step + 1);
+        for(size_t k = 0; k < imu.size(); ++k)
+            wrong += imu[k]->timeStamp != sample(i + int(k)).time() || imu[k]->measurement.gyroscopes[0] != i + int(k);
+        imuIO.release(start);
+        released = i;
+        held = std::max(held, stream->size());
+    }
+    sensor.join();
+
+    const ImuStream::Stats stats = stream->stats();
+    stream->printStats();
+    printf("at most %lu of %lu samples held\n", held, stream->capacity());
+    GTEST_ASSERT_EQ(wrong, 0);
+    GTEST_ASSERT_EQ(stats.duplicate, repeats);
+    GTEST_ASSERT_EQ(stats.reordered, swaps);
+    GTEST_ASSERT_EQ(stats.late, ancients);
+    GTEST_ASSERT_EQ(stats.overflow, 0);
+    GTEST_ASSERT_EQ(stats.full, 0);
+    GTEST_ASSERT_LE(held, stream->capacity());
+}
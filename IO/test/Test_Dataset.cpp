@@ -0,0 +1,103 @@
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+#include <opencv2/ts/ts.hpp>
+
+#include "../Dataset.h"
+#include "../TextLoader.h"
+
+namespace {
+    double msSince(const std::chrono::steady_clock::time_point &start) {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    // the stream parser the imu csv used to go through, the reference for values and speed
+    size_t streamParse(const std::string &csv, std::vector<ImuRecord> &records) {
+        std::ifstream imu_file(csv);
+        std::string line;
+        std::getline(imu_file, line);
+        while(std::getline(imu_file, line)) {
+            if(line.empty() || line[0] == '#')
+                continue;
+            std::stringstream stream(line);
+            std::string s;
+            std::getline(stream, s, ',');
+            ImuRecord r;
+            r.t = strtoll(s.c_str(), nullptr, 10);
+            for(int j = 0; j < 6; ++j) {
+                std::getline(stream, s, ',');
+                sscanf(s.c_str(), "%lf", j < 3 ? &r.gyr[j] : &r.acc[j - 3]);
+            }
+            records.push_back(r);
+        }
+        return records.size();
+    }
+}
+
+TEST(TextLoader, parse) {
+    const char text[] = "# header\n\n1403636579758555392, -0.0991, 1.5e-3,-2\r\n-7,abc\n";
+    const std::vector<char> buf(text, text + sizeof(text));
+    std::vector<loader::Line> lines;
+    loader::splitLines(buf, lines);
+    GTEST_ASSERT_EQ(lines.size(), 2u);
+
+    int64_t t = 0;
+    double v[3];
+    const char* p = loader::parseInt64(lines[0].begin, lines[0].end, t);
+    for(int i = 0; i < 3 && p; ++i) {
+        p = loader::skipPast(p, lines[0].end, ',');
+        p = p ? loader::parseDouble(p, lines[0].end, v[i]) : nullptr;
+    }
+    GTEST_ASSERT_EQ(p, lines[0].end);
+    GTEST_ASSERT_EQ(t, 1403636579758555392LL);
+    GTEST_ASSERT_EQ(v[0], -0.0991);
+    GTEST_ASSERT_EQ(v[1], 1.5e-3);
+    GTEST_ASSERT_EQ(v[2], -2.0);
+
+    p = loader::parseInt64(lines[1].begin, lines[1].end, t);
+    GTEST_ASSERT_EQ(t, -7);
+    p = loader::skipPast(p, lines[1].end, ',');
+    GTEST_ASSERT_EQ(loader::parseDouble(p, lines[1].end, v[0]), nullptr);
+}
+
+// startup of a whole EuRoC sequence: the file by file construction against the manifest
+TEST(Dataset, startup) {
+    const std::string root("../testData/mav0/");
+    std::string imufile = root + "imu0/data.csv", imuParamfile = root + "imu0/sensor.yaml";
+    std::string camfile = root + "cam0/data.csv", camParamfile = root + "cam0/sensor.yaml";
+
+    std::vector<ImuRecord> reference, parsed;
+    std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+    streamParse(imufile, reference);
+    const double streamMs = msSince(t0);
+    t0 = std::chrono::steady_clock::now();
+    GTEST_ASSERT_EQ(ImuLog::parseCsv(imufile, parsed), true);
+    const double loaderMs = msSince(t0);
+    GTEST_ASSERT_EQ(parsed.size(), reference.size());
+    GTEST_ASSERT_EQ(memcmp(parsed.data(), reference.data(), parsed.size() * sizeof(ImuRecord)), 0);
+
+    t0 = std::chrono::steady_clock::now();
+    CameraIO camIO(camfile, camParamfile);
+    ImageIO imageIO(camfile, root + "cam0/data/", camIO.getCamera());
+    IMUIO imuIO(imufile, imuParamfile);
+    const double sequentialMs = msSince(t0);
+
+    Dataset dataset(root, 0);
+    GTEST_ASSERT_EQ(dataset.good(), true);
+    GTEST_ASSERT_EQ(dataset.imuLog()->size(), reference.size());
+    GTEST_ASSERT_EQ(dataset.camera()->fx(), camIO.getCamera()->fx());
+    GTEST_ASSERT_EQ(dataset.camera()->d(3), camIO.getCamera()->d(3));
+    GTEST_ASSERT_EQ(dataset.imuParam()->sigma_g_c, imuIO.getImuParam()->sigma_g_c);
+    GTEST_ASSERT_EQ(dataset.imuParam()->T_BS.matrix(), imuIO.getImuParam()->T_BS.matrix());
+
+    std::shared_ptr<ImageIO> images = dataset.imageIO();
+    const okvis::Time first = images->popImageAndTimestamp().first;
+    GTEST_ASSERT_EQ(first, imageIO.popImageAndTimestamp().first);
+    GTEST_ASSERT_EQ(uint64_t(first.toNSec()), uint64_t(dataset.images().front().first.toNSec()));
+
+    printf("%lu imu samples: stream parse %.1f ms, loader %.1f ms\n", reference.size(), streamMs, loaderMs);
+    printf("file by file startup %.1f ms\n", sequentialMs);
+    dataset.printTimes();
+}
@@ -4,6 +4,7 @@
 
 #include "DataStructure/cv/Feature.h"
 #include "Detector.h"
+#include "util/Trace.h"
 
 using namespace feature_detection;
 
@@ -13,6 +14,8 @@ Detector::Detector(const int img_width, const int img_height, const int cell_siz
 }
 
 void Detector::detect(cvframePtr_t frame, const ImgPyr_t &img_pyr, features_t &fts) {
+    TRACE_SCOPE("detection");
     fastDetector->detect(frame, img_pyr, fast_threshold, fts);
     edgeDetector->detect(frame, img_pyr, edge_threshold, fts);
+    TRACE_GAUGE("detected features", fts.size());
 }
@@ -5,6 +5,8 @@
 
 #include "EdgeDetector.h"
 #include "DataStructure/cv/Feature.h"
+#include "util/ThreadReduce.h"
+#include "util/simd.h"
 
 #define MIN_GRAD_HIST_CUT 0.5
 namespace feature_detection {
@@ -42,13 +44,79 @@ int computeHistQuantil(int* hist, float below)
     return 60;
 }
 
+static const double pyrScale = 1.0 / PYR_ONE;
+
+///< histogram bin of every gradient norm of a row: int(sqrt(norm)) clamped to 48, exactly like the double path.
+///< sqrt in float can't round up to the next integer below 49^2 on the 1/256 grid of the Q8 norms.
+static void binRowScalar(const uint16_t* gn, int n, int* bins)
+{
+    for (int i = 0; i < n; ++i) {
+        int g = sqrt(gn[i] * pyrScale);
+        bins[i] = g > 48 ? 48 : g;
+    }
+}
+
+#if SIMPLE_VIO_X86_SIMD
+SIMD_TARGET_SSE4
+static void binRowSSE4(const uint16_t* gn, int n, int* bins)
+{
+    const __m128 scale = _mm_set1_ps(1.0f / PYR_ONE);
+    const __m128i top = _mm_set1_epi32(48);
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i v = _mm_cvtepu16_epi32(_mm_loadl_epi64((const __m128i*)(gn + i)));
+        __m128 g = _mm_sqrt_ps(_mm_mul_ps(_mm_cvtepi32_ps(v), scale));
+        _mm_storeu_si128((__m128i*)(bins + i), _mm_min_epi32(_mm_cvttps_epi32(g), top));
+    }
+    binRowScalar(gn + i, n - i, bins + i);
+}
+
+SIMD_TARGET_AVX2
+static void binRowAVX2(const uint16_t* gn, int n, int* bins)
+{
+    const __m256 scale = _mm256_set1_ps(1.0f / PYR_ONE);
+    const __m256i top = _mm256_set1_epi32(48);
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i v = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)(gn + i)));
+        __m256 g = _mm256_sqrt_ps(_mm256_mul_ps(_mm256_cvtepi32_ps(v), scale));
+        _mm256_storeu_si256((__m256i*)(bins + i), _mm256_min_epi32(_mm256_cvttps_epi32(g), top));
+    }
+    binRowSSE4(gn + i, n - i, bins + i);
+}
+#endif
+
+static void binRow(const uint16_t* gn, int n, int* bins)
+{
+#if SIMPLE_VIO_X86_SIMD
+    static const simd::InstructionSet set = simd::detect();
+    if (set == simd::AVX2)  { binRowAVX2(gn, n, bins); return; }
+    if (set == simd::SSE4)  { binRowSSE4(gn, n, bins); return; }
+#endif
+    binRowScalar(gn, n, bins);
+}
+
+///< unit gradient of an edgelet found on level, px in level 0 coordinates
+static void emitEdgelet(cvframePtr_t& frame, int u, int v, int level, features_t& fts)
+{
+    cvFrame::grad_t  out;
+    if(frame->getGrad(u,v,out,level)){
+        double outNormal = sqrt(out(0)*out(0)+out(1)*out(1));
+        out /= outNormal;
+        fts.push_back(makeFeature(frame,Eigen::Vector2d(u<<level,v<<level),out,level));
+    }
+}
+
 EdgeDetector::EdgeDetector(
         const int img_width,
         const int img_height,
         const int cell_size,
-        const int n_pyr_levels) :
-    AbstractDetector(img_width, img_height, cell_size, n_pyr_levels),currentFrame(0)
+        const int n_pyr_levels,
+        DetectMode mode) :
+    AbstractDetector(img_width, img_height, cell_size, n_pyr_levels),currentFrame(0),mode_(mode)
 {
+    threadReduce_ = std::make_shared<ThreadReduce>();
+    cellCandidates_.resize(detectWidthGrid * detectCellWidth * detectHeightGrid * detectCellHeight);
     std::allocator<char> alloc;
     randomPattern = (unsigned char*)alloc.allocate(img_width*img_height);
     std::srand(314152926);
@@ -97,6 +165,51 @@ void EdgeDetector::makeHists(cvframePtr_t frame)
         threshold[x+y*w32] = computeHistQuantil(hist0,MIN_GRAD_HIST_CUT) + 5;
     }
 
+    smoothThreshold(w32, h32);
+}
+
+void EdgeDetector::makeHistsParallel(cvframePtr_t frame)
+{
+    currentFrame = frame;
+    int h = frame->getHeight(0);
+    int w = frame->getWidth(0);
+    const ImgLevel& img = frame->gradientLevel(0);
+
+    int w32 = w>>4;
+    int h32 = h>>4;
+    thresholdStepU = w32;
+    thresholdStepV = h32;
+
+    memset(threshold,0,sizeof(float)*w32*h32+100);
+    memset(thresholdSmoothed,0,sizeof(float)*w32*h32+100);
+
+    // one task per row of 16*16 blocks, histograms live on the worker stack
+    threadReduce_->reduce([&](int first, int last, int) {
+        int bins[16];
+        for (int y = first; y < last; ++y) for (int x = 0; x < w32; ++x)
+        {
+            int hist0[60];
+            memset(hist0,0,sizeof(hist0));
+
+            // same border as makeHists: 1 <= it <= w-2, 1 <= jt <= h-2
+            const int it0 = std::max(16*x, 1), it1 = std::min(16*x+16, w-1);
+            const int jt0 = std::max(16*y, 1), jt1 = std::min(16*y+16, h-1);
+            for (int jt = jt0; jt < jt1; ++jt) {
+                binRow(img.gradNorm.data() + jt * img.stride + it0, it1 - it0, bins);
+                for (int i = 0; i < it1 - it0; ++i)
+                    hist0[bins[i]+1]++;
+                hist0[0] += it1 - it0;
+            }
+
+            threshold[x+y*w32] = computeHistQuantil(hist0,MIN_GRAD_HIST_CUT) + 5;
+        }
+    }, 0, h32);
+
+    smoothThreshold(w32, h32);
+}
+
+void EdgeDetector::smoothThreshold(int w32, int h32)
+{
     // SSD
     for(int y=0;y<h32;y++)
         for(int x=0;x<w32;x++)
@@ -124,13 +237,25 @@ void EdgeDetector::makeHists(cvframePtr_t frame)
             thresholdSmoothed[x+y*w32] = averge_*averge_;
         }
 }
+
 void EdgeDetector::detect(cvframePtr_t frame,
                           const ImgPyr_t &img_pyr,
                           const double detection_threshold,
                           features_t &fts)
 {
-    if(currentFrame != frame) makeHists(frame);
+    frame->preparePyramid();
+    if(mode_ == EDGE_SERIAL) {
+        if(currentFrame != frame) makeHists(frame);
+        detectSerial(frame, fts);
+    }
+    else {
+        if(currentFrame != frame) makeHistsParallel(frame);
+        detectParallel(frame, fts);
+    }
+}
 
+void EdgeDetector::detectSerial(cvframePtr_t frame, features_t &fts)
+{
     float thresholdFactor = 1.0f;
     float dw1 = 0.75f, dw2 = dw1*dw1;
 
@@ -232,7 +357,7 @@ void EdgeDetector::detect(cvframePtr_t frame,
                             if(frame->getGrad(bestU0,bestV0,out,0)){
                                 double outNormal = sqrt(out(0)*out(0)+out(1)*out(1));
                                 out /= outNormal;
-                                fts.push_back(std::shared_ptr<Feature>(new Feature(frame,Eigen::Vector2d(bestU0,bestV0),out,0)));
+                                fts.push_back(makeFeature(frame,Eigen::Vector2d(bestU0,bestV0),out,0));
                             }
                             bestVal3 = 1e10;
                             n2++;
@@ -245,7 +370,7 @@ void EdgeDetector::detect(cvframePtr_t frame,
                         if(frame->getGrad(bestU1,bestV1,out,1)){
                             double outNormal = sqrt(out(0)*out(0)+out(1)*out(1));
                             out /= outNormal;
-                            fts.push_back(std::shared_ptr<Feature>(new Feature(frame,Eigen::Vector2d(bestU1*2,bestV1*2),out,1)));
+                            fts.push_back(makeFeature(frame,Eigen::Vector2d(bestU1*2,bestV1*2),out,1));
                         }
                         bestVal4 = 1e10;
                         n3++;
@@ -258,7 +383,7 @@ void EdgeDetector::detect(cvframePtr_t frame,
                     if(frame->getGrad(bestU2,bestV2,out,2)){
                         double outNormal = sqrt(out(0)*out(0)+out(1)*out(1));
                         out /= outNormal;
-                        fts.push_back(std::shared_ptr<Feature>(new Feature(frame,Eigen::Vector2d(bestU2*4,bestV2*4),out,2)));
+                        fts.push_back(makeFeature(frame,Eigen::Vector2d(bestU2*4,bestV2*4),out,2));
                     }
                     n4++;
                 }
@@ -267,6 +392,192 @@ void EdgeDetector::detect(cvframePtr_t frame,
 
 }
 
+void EdgeDetector::collectCell(cvframePtr_t frame, int cellU, int cellV, std::vector<Candidate>& candidates)
+{
+    candidates.clear();
+    if(frame->checkOccupy(cellU,cellV))     return;
+
+    float thresholdFactor = 1.0f;
+    float dw1 = 0.75f, dw2 = dw1*dw1;
+
+    int w  = frame->getWidth(0);
+    int h  = frame->getHeight(0);
+    const ImgLevel& L0 = frame->gradientLevel(0);
+    const ImgLevel& L1 = frame->gradientLevel(1);
+    const ImgLevel& L2 = frame->gradientLevel(2);
+
+    int pot = 5;
+    int cellHeight = h/(detectHeightGrid * detectCellHeight);
+    int cellWidth = w/(detectWidthGrid * detectCellWidth);
+
+    // the block walk of detectSerial, pixels are recorded in visiting order.
+    // the border keeps every coordinate inside its level, the planes are read directly.
+    int y4 = cellV * cellHeight, y4Top = y4+cellHeight;
+    int x4 = cellU * cellWidth, x4Top = x4+cellWidth;
+    for(;y4<y4Top;y4+=(4*pot)) for(;x4<x4Top;x4+=(4*pot))
+    {
+        int my3 = std::min((4*pot), h-y4);
+        int mx3 = std::min((4*pot), w-x4);
+        for(int y3=0;y3<my3;y3+=(2*pot)) for(int x3=0;x3<mx3;x3+=(2*pot))
+        {
+            int x34 = x3+x4;
+            int y34 = y3+y4;
+            int my2 = std::min((2*pot), h-y34);
+            int mx2 = std::min((2*pot), w-x34);
+            for(int y2=0;y2<my2;y2+=pot) for(int x2=0;x2<mx2;x2+=pot)
+            {
+                int x234 = x2+x34;
+                int y234 = y2+y34;
+                int my1 = std::min(pot, h-y234);
+                int mx1 = std::min(pot, w-x234);
+                for(int y1=0;y1<my1;y1+=1) for(int x1=0;x1<mx1;x1+=1)
+                {
+                    int xf = x1+x234;
+                    int yf = y1+y234;
+
+                    if(xf<4 || xf>=w-5 || yf<4 || yf>h-4) continue;
+
+                    double pixelTH0 = thresholdSmoothed[(xf>>4) + (yf>>4) * thresholdStepU];
+                    double pixelTH1 = pixelTH0*dw1;
+                    double pixelTH2 = pixelTH1*dw2;
+
+                    Candidate c;
+                    c.pass = 0;
+                    int k0 = xf + yf * L0.stride;
+                    float ag0 = L0.gradNorm[k0] * pyrScale;
+                    if(ag0 > pixelTH0*thresholdFactor) {
+                        c.pass |= 1;
+                        c.grad[0] = L0.gradX[k0];    c.grad[1] = L0.gradY[k0];
+                    }
+                    int k1 = (int)(xf*0.5f+0.25f) + (int)(yf*0.5f+0.25f) * L1.stride;
+                    float ag1 = L1.gradNorm[k1] * pyrScale;
+                    if(ag1 > pixelTH1*thresholdFactor) {
+                        c.pass |= 2;
+                        c.grad[2] = L1.gradX[k1];    c.grad[3] = L1.gradY[k1];
+                    }
+                    int k2 = (int)(xf*0.25f+0.125f) + (int)(yf*0.25f+0.125f) * L2.stride;
+                    float ag2 = L2.gradNorm[k2] * pyrScale;
+                    if(ag2 > pixelTH2*thresholdFactor) {
+                        c.pass |= 4;
+                        c.grad[4] = L2.gradX[k2];    c.grad[5] = L2.gradY[k2];
+                    }
+                    if(!c.pass) continue;
+
+                    c.x = short(xf);
+                    c.y = short(yf);
+                    candidates.push_back(c);
+                }
+            }
+        }
+    }
+}
+
+void EdgeDetector::detectParallel(cvframePtr_t frame, features_t &fts)
+{
+    // thresholds and gradients of every cell are independent and gathered on the pool,
+    // the selection depends on the random directions consumed across cells and is replayed serially
+    const int cellsU = detectWidthGrid * detectCellWidth;
+    threadReduce_->reduce([&](int first, int last, int) {
+        for (int k = first; k < last; ++k)
+            collectCell(frame, k % cellsU, k / cellsU, cellCandidates_[k]);
+    }, 0, int(cellCandidates_.size()), 4);
+
+    int w  = frame->getWidth(0);
+    int h  = frame->getHeight(0);
+
+    int n2=0;
+    int pot = 5;
+    int bestU0 = -1, bestU1 = -1,  bestU2 = -1, bestV0 = -1, bestV1 = -1,  bestV2 = -1;
+    int cellHeight = h/(detectHeightGrid * detectCellHeight);
+    int cellWidth = w/(detectWidthGrid * detectCellWidth);
+
+    for (int cellV = 0; cellV < detectHeightGrid * detectCellHeight; ++cellV)
+        for (int cellU = 0; cellU < cellsU; ++cellU) {
+            if(frame->checkOccupy(cellU,cellV))     continue;
+            const std::vector<Candidate>& candidates = cellCandidates_[cellU + cellV * cellsU];
+            size_t next = 0;
+            int y4 = cellV * cellHeight, y4Top = y4+cellHeight;
+            int x4 = cellU * cellWidth, x4Top = x4+cellWidth;
+            for(;y4<y4Top;y4+=(4*pot)) for(;x4<x4Top;x4+=(4*pot))
+            {
+                int my3 = std::min((4*pot), h-y4);
+                int mx3 = std::min((4*pot), w-x4);
+                int bestIdx4=-1; float bestVal4=0;
+                Eigen::Vector2d dir4 = directions[randomPattern[n2] & 0xF];
+                for(int y3=0;y3<my3;y3+=(2*pot)) for(int x3=0;x3<mx3;x3+=(2*pot))
+                {
+                    int x34 = x3+x4;
+                    int y34 = y3+y4;
+                    int my2 = std::min((2*pot), h-y34);
+                    int mx2 = std::min((2*pot), w-x34);
+                    int bestIdx3=-1; float bestVal3=0;
+                    Eigen::Vector2d dir3 = directions[randomPattern[n2] & 0xF];
+                    for(int y2=0;y2<my2;y2+=pot) for(int x2=0;x2<mx2;x2+=pot)
+                    {
+                        int x234 = x2+x34;
+                        int y234 = y2+y34;
+                        int my1 = std::min(pot, h-y234);
+                        int mx1 = std::min(pot, w-x234);
+                        int bestIdx2=-1; float bestVal2=0;
+                        Eigen::Vector2d dir2 = directions[randomPattern[n2] & 0xF];
+
+                        // the blocks tile the cell, its candidates are the next ones inside the block
+                        for(; next < candidates.size(); ++next)
+                        {
+                            const Candidate& c = candidates[next];
+                            int xf = c.x;
+                            int yf = c.y;
+                            if(xf<x234 || xf>=x234+mx1 || yf<y234 || yf>=y234+my1) break;
+                            int idx = xf + w*yf;
+
+                            if(c.pass & 1)
+                            {
+                                float dirNorm = fabs((float)((Eigen::Vector2d(c.grad[0],c.grad[1]) * pyrScale).dot(dir2)));
+
+                                if(dirNorm > bestVal2)
+                                { bestVal2 = dirNorm; bestIdx2 = idx, bestU0 = xf, bestV0 = yf; bestIdx3 = -2; bestIdx4 = -2;}
+                            }
+                            if(bestIdx3==-2) continue;
+
+                            if(c.pass & 2)
+                            {
+                                float dirNorm = fabs((float)((Eigen::Vector2d(c.grad[2],c.grad[3]) * pyrScale).dot(dir3)));
+
+                                if(dirNorm > bestVal3)
+                                { bestVal3 = dirNorm; bestIdx3 = idx, bestU1 = (int)(xf*0.5f+0.25f), bestV1 = (int)(yf*0.5f+0.25f); bestIdx4 = -2;}
+                            }
+                            if(bestIdx4==-2) continue;
+
+                            if(c.pass & 4)
+                            {
+                                float dirNorm = fabs((float)((Eigen::Vector2d(c.grad[4],c.grad[5]) * pyrScale).dot(dir4)));
+
+                                if(dirNorm > bestVal4)
+                                { bestVal4 = dirNorm; bestIdx4 = idx, bestU2 = (int)(xf*0.25f+0.125),bestV2 = (int)(yf*0.25f+0.125f); }
+                            }
+                        }
+
+                        if(bestIdx2>0)
+                        {
+                            emitEdgelet(frame, bestU0, bestV0, 0, fts);
+                            bestVal3 = 1e10;
+                            n2++;
+                        }
+                    }
+
+                    if(bestIdx3>0)
+                    {
+                        emitEdgelet(frame, bestU1, bestV1, 1, fts);
+                        bestVal4 = 1e10;
+                    }
+                }
+
+                if(bestIdx4>0)
+                    emitEdgelet(frame, bestU2, bestV2, 2, fts);
+            }// end of x4
+        }// end of cellU
+}
+
 
 class Pt {
 public:
@@ -5,17 +5,27 @@
 #ifndef SIMPLE_VIO_EDGEDETECTOR_H
 #define SIMPLE_VIO_EDGEDETECTOR_H
 
+#include <memory>
 #include "AbstractDetector.h"
 
+class ThreadReduce;
+
 namespace feature_detection {
 
     class EdgeDetector : public AbstractDetector {
+    public:
+        enum DetectMode {
+            EDGE_SERIAL,        //!< histograms and cells one after the other
+            EDGE_PARALLEL       //!< histograms and cells on a thread pool, same edgelets in the same order
+        };
+
     public:
         EdgeDetector(
                 const int img_width,
                 const int img_height,
                 const int cell_size,
-                const int n_pyr_levels);
+                const int n_pyr_levels,
+                DetectMode mode = EDGE_PARALLEL);
 
         virtual ~EdgeDetector()
         {
@@ -43,8 +53,23 @@ namespace feature_detection {
                 const double detection_threshold,
                 features_t &fts);
 
+        void setDetectMode(DetectMode mode) { mode_ = mode; }
+        DetectMode getDetectMode() const { return mode_; }
+
     private:
+        /// a pixel passing the gradient threshold on at least one of the three levels
+        struct Candidate {
+            short           x, y;
+            unsigned char   pass;       //!< bit l: level l passed
+            short           grad[6];    //!< Q8 gradient on level 0, 1, 2
+        };
+
         void makeHists(cvframePtr_t frame);
+        void makeHistsParallel(cvframePtr_t frame);
+        void smoothThreshold(int w32, int h32);
+        void detectSerial(cvframePtr_t frame, features_t &fts);
+        void detectParallel(cvframePtr_t frame, features_t &fts);
+        void collectCell(cvframePtr_t frame, int cellU, int cellV, std::vector<Candidate>& candidates);
 
     private:
         int                  *gradHist;
@@ -55,6 +80,10 @@ namespace feature_detection {
 
         cvframePtr_t         currentFrame;
         features_t           edge;
+
+        DetectMode                              mode_;
+        std::shared_ptr<ThreadReduce>           threadReduce_;
+        std::vector<std::vector<Candidate>>     cellCandidates_;    //!< one buffer per cell, kept across frames
     };
 
 }
@@ -6,6 +6,7 @@
 #include "FastDetector.h"
 #include "DataStructure/cv/Feature.h"
 #include "util/util.h"
+#include "util/ThreadReduce.h"
 
 namespace feature_detection {
 
@@ -16,13 +17,15 @@ namespace feature_detection {
             const int img_width,
             const int img_height,
             const int cell_size,
-            const int n_pyr_levels) :
-            AbstractDetector(img_width, img_height, cell_size, n_pyr_levels) {
+            const int n_pyr_levels,
+            DetectMode mode) :
+            AbstractDetector(img_width, img_height, cell_size, n_pyr_levels), mode_(mode) {
+        threadReduce_ = std::make_shared<ThreadReduce>();
+        packed_.resize(ThreadNum);
     }
 
-    static inline bool test_gt_set(const cvData::Img_t::value_type& a_, double b, double& min_diff)
+    static inline bool test_gt_set(int a, int b, int& min_diff)
     {
-        double a = a_(0);
         if(a > b)
         {
             if(a-b < min_diff)
@@ -33,24 +36,15 @@ namespace feature_detection {
         return 0;
     }
 
-    static inline bool test_gt_set(double a, const cvData::Img_t::value_type& b_, double& min_diff) {
-        double b = b_(0);
-        if(a > b){
-            if(a-b < min_diff)
-                min_diff = a-b;
-
-            return 1;
-        }
-        return 0;
-    }
-
-    void FastDetector::fast_corner_detect_10(vector<Eigen::Matrix<double, 3, 1, 0, 3, 1>>::const_iterator& img,
+    template<typename Pixel>
+    void FastDetector::fast_corner_detect_10(const Pixel* img,
                                              int img_width, int img_height, int img_stride,
-                                             double barrier, std::vector<fast_xy> &corners) {
+                                             int barrier, std::vector<fast_xy> &corners) {
         int y;
-        double cb, c_b;
-        cvData::Img_t::const_iterator line_max, line_min;
-        cvData::Img_t::const_iterator cache_0;
+        int cb, c_b;
+        const Pixel* line_max;
+        const Pixel* line_min;
+        const Pixel* cache_0;
 
         int pixel[16] = {
                 0 + img_stride * 3,
@@ -82,29 +76,29 @@ namespace feature_detection {
             //printf("y = %d\n",y);
             for(; cache_0 < line_max; cache_0++)
             {
-                cb = (*cache_0)(0) + barrier;
-                c_b= (*cache_0)(0) - barrier;
+                cb = *cache_0 + barrier;
+                c_b= *cache_0 - barrier;
 
-                if((*(cache_0 + pixel[0]))(0) > cb)
-                    if((*(cache_0 + pixel[8]))(0) > cb)
-                        if((*(cache_0 + pixel[3]))(0) > cb)
-                            if((*(cache_0 + pixel[5]))(0) > cb)
-                                if((*(cache_0 + pixel[2]))(0) > cb)
-                                    if((*(cache_0 + pixel[6]))(0) > cb)
-                                        if((*(cache_0 + 3))(0) > cb)
-                                            if((*(cache_0 + pixel[7]))(0) > cb)
-                                                if((*(cache_0 + pixel[1]))(0) > cb)
-                                                    if((*(cache_0 + pixel[9]))(0) > cb)
+                if(cache_0[pixel[0]] > cb)
+                    if(cache_0[pixel[8]] > cb)
+                        if(cache_0[pixel[3]] > cb)
+                            if(cache_0[pixel[5]] > cb)
+                                if(cache_0[pixel[2]] > cb)
+                                    if(cache_0[pixel[6]] > cb)
+                                        if(cache_0[3] > cb)
+                                            if(cache_0[pixel[7]] > cb)
+                                                if(cache_0[pixel[1]] > cb)
+                                                    if(cache_0[pixel[9]] > cb)
                                                         goto success;
                                                     else
-                                                    if((*(cache_0 + pixel[15]))(0) > cb)
+                                                    if(cache_0[pixel[15]] > cb)
                                                         goto success;
                                                     else
                                                         continue;
-                                                else if((*(cache_0 + pixel[1]))(0) < c_b)
-                                                    if((*(cache_0 + pixel[9]))(0) > cb)
-                                                        if((*(cache_0 + pixel[10]))(0) > cb)
-                                                            if((*(cache_0 + pixel[11]))(0) > cb)
+                                                else if(cache_0[pixel[1]] < c_b)
+                                                    if(cache_0[pixel[9]] > cb)
+                                                        if(cache_0[pixel[10]] > cb)
+                                                            if(cache_0[pixel[11]] > cb)
                                                                 goto success;
                                                             else
                                                                 continue;
@@ -113,9 +107,9 @@ namespace feature_detection {
                                                     else
                                                         continue;
                                                 else
-                                                if((*(cache_0 + pixel[11]))(0) > cb)
-                                                    if((*(cache_0 + pixel[10]))(0) > cb)
-                                                        if((*(cache_0 + pixel[9]))(0) > cb)
+                                                if(cache_0[pixel[11]] > cb)
+                                                    if(cache_0[pixel[10]] > cb)
+                                                        if(cache_0[pixel[9]] > cb)
                                                             goto success;
                                                         else
                                                             continue;
@@ -123,11 +117,11 @@ namespace feature_detection {
                                                         continue;
                                                 else
                                                     continue;
-                                            else if((*(cache_0 + pixel[7]))(0) < c_b)
-                                                if((*(cache_0 + pixel[1]))(0) > cb)
-                                                    if((*(cache_0 + pixel[13]))(0) > cb)
-                                                        if((*(cache_0 + pixel[14]))(0) > cb)
-                                                            if((*(cache_0 + pixel[15]))(0) > cb)
+                                            else if(cache_0[pixel[7]] < c_b)
+                                                if(cache_0[pixel[1]] > cb)
+                                                    if(cache_0[pixel[13]] > cb)
+                                                        if(cache_0[pixel[14]] > cb)
+                                                            if(cache_0[pixel[15]] > cb)
                                                                 goto success;
                                                             else
                                                                 continue;
@@ -138,10 +132,10 @@ namespace feature_detection {
                                                 else
                                                     continue;
                                             else
-                                            if((*(cache_0 + pixel[13]))(0) > cb)
-                                                if((*(cache_0 + pixel[14]))(0) > cb)
-                                                    if((*(cache_0 + pixel[15]))(0) > cb)
-                                                        if((*(cache_0 + pixel[1]))(0) > cb)
+                                            if(cache_0[pixel[13]] > cb)
+                                                if(cache_0[pixel[14]] > cb)
+                                                    if(cache_0[pixel[15]] > cb)
+                                                        if(cache_0[pixel[1]] > cb)
                                                             goto success;
                                                         else
                                                             continue;
@@ -151,26 +145,26 @@ namespace feature_detection {
                                                     continue;
                                             else
                                                 continue;
-                                        else if((*(cache_0 + 3))(0) < c_b)
-                                            if((*(cache_0 + pixel[10]))(0) > cb)
-                                                if((*(cache_0 + pixel[11]))(0) > cb)
-                                                    if((*(cache_0 + -3))(0) > cb)
-                                                        if((*(cache_0 + pixel[13]))(0) > cb)
-                                                            if((*(cache_0 + pixel[14]))(0) > cb)
-                                                                if((*(cache_0 + pixel[1]))(0) > cb)
-                                                                    if((*(cache_0 + pixel[15]))(0) > cb)
+                                        else if(cache_0[3] < c_b)
+                                            if(cache_0[pixel[10]] > cb)
+                                                if(cache_0[pixel[11]] > cb)
+                                                    if(cache_0[-3] > cb)
+                                                        if(cache_0[pixel[13]] > cb)
+                                                            if(cache_0[pixel[14]] > cb)
+                                                                if(cache_0[pixel[1]] > cb)
+                                                                    if(cache_0[pixel[15]] > cb)
                                                                         goto success;
                                                                     else
-                                                                    if((*(cache_0 + pixel[7]))(0) > cb)
-                                                                        if((*(cache_0 + pixel[9]))(0) > cb)
+                                                                    if(cache_0[pixel[7]] > cb)
+                                                                        if(cache_0[pixel[9]] > cb)
                                                                             goto success;
                                                                         else
                                                                             continue;
                                                                     else
                                                                         continue;
                                                                 else
-                                                                if((*(cache_0 + pixel[7]))(0) > cb)
-                                                                    if((*(cache_0 + pixel[9]))(0) > cb)
+                                                                if(cache_0[pixel[7]] > cb)
+                                                                    if(cache_0[pixel[9]] > cb)
                                                                         goto success;
                                                                     else
                                                                         continue;
@@ -187,36 +181,36 @@ namespace feature_detection {
                                             else
                                                 continue;
                                         else
-                                        if((*(cache_0 + -3))(0) > cb)
-                                            if((*(cache_0 + pixel[14]))(0) > cb)
-                                                if((*(cache_0 + pixel[10]))(0) > cb)
-                                                    if((*(cache_0 + pixel[11]))(0) > cb)
-                                                        if((*(cache_0 + pixel[13]))(0) > cb)
-                                                            if((*(cache_0 + pixel[1]))(0) > cb)
-                                                                if((*(cache_0 + pixel[7]))(0) > cb)
-                                                                    if((*(cache_0 + pixel[9]))(0) > cb)
+                                        if(cache_0[-3] > cb)
+                                            if(cache_0[pixel[14]] > cb)
+                                                if(cache_0[pixel[10]] > cb)
+                                                    if(cache_0[pixel[11]] > cb)
+                                                        if(cache_0[pixel[13]] > cb)
+                                                            if(cache_0[pixel[1]] > cb)
+                                                                if(cache_0[pixel[7]] > cb)
+                                                                    if(cache_0[pixel[9]] > cb)
                                                                         goto success;
                                                                     else
-                                                                    if((*(cache_0 + pixel[15]))(0) > cb)
+                                                                    if(cache_0[pixel[15]] > cb)
                                                                         goto success;
                                                                     else
                                                                         continue;
                                                                 else
-                                                                if((*(cache_0 + pixel[15]))(0) > cb)
+                                                                if(cache_0[pixel[15]] > cb)
                                                                     goto success;
                                                                 else
                                                                     continue;
-                                                            else if((*(cache_0 + pixel[1]))(0) < c_b)
-                                                                if((*(cache_0 + pixel[7]))(0) > cb)
-                                                                    if((*(cache_0 + pixel[9]))(0) > cb)
+                                                            else if(cache_0[pixel[1]] < c_b)
+                                                                if(cache_0[pixel[7]] > cb)
+                                                                    if(cache_0[pixel[9]] > cb)
                                                                         goto success;
                                                                     else
                                                                         continue;
                                                                 else
                                                                     continue;
                                                             else
-                                                            if((*(cache_0 + pixel[9]))(0) > cb)
-                                                                if((*(cache_0 + pixel[7]))(0) > cb)
+                                                            if(cache_0[pixel[9]] > cb)
+                                                                if(cache_0[pixel[7]] > cb)
                                                                     goto success;
                                                                 else
                                                                     continue;
@@ -232,27 +226,27 @@ namespace feature_detection {
                                                 continue;
                                         else
                                             continue;
-                                    else if((*(cache_0 + pixel[6]))(0) < c_b)
-                                        if((*(cache_0 + -3))(0) > cb)
-                                            if((*(cache_0 + pixel[13]))(0) > cb)
-                                                if((*(cache_0 + pixel[14]))(0) > cb)
-                                                    if((*(cache_0 + pixel[15]))(0) > cb)
-                                                        if((*(cache_0 + pixel[1]))(0) > cb)
-                                                            if((*(cache_0 + 3))(0) > cb)
+                                    else if(cache_0[pixel[6]] < c_b)
+                                        if(cache_0[-3] > cb)
+                                            if(cache_0[pixel[13]] > cb)
+                                                if(cache_0[pixel[14]] > cb)
+                                                    if(cache_0[pixel[15]] > cb)
+                                                        if(cache_0[pixel[1]] > cb)
+                                                            if(cache_0[3] > cb)
                                                                 goto success;
                                                             else
-                                                            if((*(cache_0 + pixel[10]))(0) > cb)
-                                                                if((*(cache_0 + pixel[11]))(0) > cb)
+                                                            if(cache_0[pixel[10]] > cb)
+                                                                if(cache_0[pixel[11]] > cb)
                                                                     goto success;
                                                                 else
                                                                     continue;
                                                             else
                                                                 continue;
                                                         else
-                                                        if((*(cache_0 + pixel[7]))(0) > cb)
-                                                            if((*(cache_0 + pixel[9]))(0) > cb)
-                                                                if(((*(cache_0 + pixel[10])))(0) > cb)
-                                                                    if((*(cache_0 + pixel[11]))(0) > cb)
+                                                        if(cache_0[pixel[7]] > cb)
+                                                            if(cache_0[pixel[9]] > cb)
+                                                                if(cache_0[pixel[10]] > cb)
+                                                                    if(cache_0[pixel[11]] > cb)
                                                                         goto success;
                                                                     else
                                                                         continue;
@@ -271,26 +265,26 @@ namespace feature_detection {
                                         else
                                             continue;
                                     else
-                                    if((*(cache_0 + -3))(0) > cb)
-                                        if((*(cache_0 + pixel[14]))(0) > cb)
-                                            if((*(cache_0 + pixel[15]))(0) > cb)
-                                                if((*(cache_0 + pixel[13]))(0) > cb)
-                                                    if((*(cache_0 + pixel[1]))(0) > cb)
-                                                        if((*(cache_0 + 3))(0) > cb)
+                                    if(cache_0[-3] > cb)
+                                        if(cache_0[pixel[14]] > cb)
+                                            if(cache_0[pixel[15]] > cb)
+                                                if(cache_0[pixel[13]] > cb)
+                                                    if(cache_0[pixel[1]] > cb)
+                                                        if(cache_0[3] > cb)
                                                             goto success;
                                                         else
-                                                        if((*(cache_0 + pixel[10]))(0) > cb)
-                                                            if((*(cache_0 + pixel[11]))(0) > cb)
+                                                        if(cache_0[pixel[10]] > cb)
+                                                            if(cache_0[pixel[11]] > cb)
                                                                 goto success;
                                                             else
                                                                 continue;
                                                         else
                                                             continue;
-                                                    else if((*(cache_0 + pixel[1]))(0) < c_b)
-                                                        if((*(cache_0 + pixel[7]))(0) > cb)
-                                                            if((*(cache_0 + pixel[9]))(0) > cb)
-                                                                if((*(cache_0 + pixel[10]))(0) > cb)
-                                                                    if((*(cache_0 + pixel[11]))(0) > cb)
+                                                    else if(cache_0[pixel[1]] < c_b)
+                                                        if(cache_0[pixel[7]] > cb)
+                                                            if(cache_0[pixel[9]] > cb)
+                                                                if(cache_0[pixel[10]] > cb)
+                                                                    if(cache_0[pixel[11]] > cb)
                                                                         goto success;
                                                                     else
                                                                         continue;
@@ -301,10 +295,10 @@ namespace feature_detection {
                                                         else
                                                             continue;
                                                     else
-                                                    if((*(cache_0 + pixel[7]))(0) > cb)
-                                                        if((*(cache_0 + pixel[10]))(0) > cb)
-                                                            if((*(cache_0 + pixel[11]))(0) > cb)
-                                                                if((*(cache_0 + pixel[9]))(0) > cb)
+                                                    if(cache_0[pixel[7]] > cb)
+                                                        if(cache_0[pixel[10]] > cb)
+                                                            if(cache_0[pixel[11]] > cb)
+                                                                if(cache_0[pixel[9]] > cb)
                                                                     goto success;
                                                                 else
                                                                     continue;
@@ -322,27 +316,27 @@ namespace feature_detection {
                                             continue;
                                     else
                                         continue;
-                                else if((*(cache_0 + pixel[2]))(0) < c_b)
-                                    if((*(cache_0 + -3))(0) > cb)
-                                        if((*(cache_0 + pixel[9]))(0) > cb)
-                                            if((*(cache_0 + pixel[10]))(0) > cb)
-                                                if((*(cache_0 + pixel[11]))(0) > cb)
-                                                    if((*(cache_0 + pixel[7]))(0) > cb)
-                                                        if((*(cache_0 + pixel[6]))(0) > cb)
-                                                            if((*(cache_0 + 3))(0) > cb)
+                                else if(cache_0[pixel[2]] < c_b)
+                                    if(cache_0[-3] > cb)
+                                        if(cache_0[pixel[9]] > cb)
+                                            if(cache_0[pixel[10]] > cb)
+                                                if(cache_0[pixel[11]] > cb)
+                                                    if(cache_0[pixel[7]] > cb)
+                                                        if(cache_0[pixel[6]] > cb)
+                                                            if(cache_0[3] > cb)
                                                                 goto success;
                                                             else
-                                                            if((*(cache_0 + pixel[13]))(0) > cb)
-                                                                if((*(cache_0 + pixel[14]))(0) > cb)
+                                                            if(cache_0[pixel[13]] > cb)
+                                                                if(cache_0[pixel[14]] > cb)
                                                                     goto success;
                                                                 else
                                                                     continue;
                                                             else
                                                                 continue;
                                                         else
-                                                        if((*(cache_0 + pixel[13]))(0) > cb)
-                                                            if((*(cache_0 + pixel[14]))(0) > cb)
-                                                                if((*(cache_0 + pixel[15]))(0) > cb)
+                                                        if(cache_0[pixel[13]] > cb)
+                                                            if(cache_0[pixel[14]] > cb)
+                                                                if(cache_0[pixel[15]] > cb)
                                                                     goto success;
                                                                 else
                                                                     continue;
@@ -351,10 +345,10 @@ namespace feature_detection {
                                                         else
                                                             continue;
                                                     else
-                                                    if((*(cache_0 + pixel[1]))(0) > cb)
-                                                        if((*(cache_0 + pixel[13]))(0) > cb)
-                                                            if((*(cache_0 + pixel[14]))(0) > cb)
-                                                                if((*(cache_0 + pixel[15]))(0) > cb)
+                                                    if(cache_0[pixel[1]] > cb)
+                                                        if(cache_0[pixel[13]] > cb)
+                                                            if(cache_0[pixel[14]] > cb)
+                                                                if(cache_0[pixel[15]] > cb)
                                                                     goto success;
                                                                 else
                                                                     continue;
@@ -373,34 +367,34 @@ namespace feature_detection {
                                     else
                                         continue;
                                 else
-                                if((*(cache_0 + pixel[11]))(0) > cb)
-                                    if((*(cache_0 + pixel[10]))(0) > cb)
-                                        if((*(cache_0 + -3))(0) > cb)
-                                            if((*(cache_0 + pixel[9]))(0) > cb)
-                                                if((*(cache_0 + pixel[7]))(0) > cb)
-                                                    if((*(cache_0 + pixel[6]))(0) > cb)
-                                                        if(((*(cache_0 + 3)))(0) > cb)
+                                if(cache_0[pixel[11]] > cb)
+                                    if(cache_0[pixel[10]] > cb)
+                                        if(cache_0[-3] > cb)
+                                            if(cache_0[pixel[9]] > cb)
+                                                if(cache_0[pixel[7]] > cb)
+                                                    if(cache_0[pixel[6]] > cb)
+                                                        if(cache_0[3] > cb)
                                                             goto success;
-                                                        else if((*(cache_0 + 3))(0) < c_b)
-                                                            if((*(cache_0 + pixel[13]))(0) > cb)
-                                                                if((*(cache_0 + pixel[14]))(0) > cb)
+                                                        else if(cache_0[3] < c_b)
+                                                            if(cache_0[pixel[13]] > cb)
+                                                                if(cache_0[pixel[14]] > cb)
                                                                     goto success;
                                                                 else
                                                                     continue;
                                                             else
                                                                 continue;
                                                         else
-                                                        if((*(cache_0 + pixel[14]))(0) > cb)
-                                                            if((*(cache_0 + pixel[13]))(0) > cb)
+                                                        if(cache_0[pixel[14]] > cb)
+                                                            if(cache_0[pixel[13]] > cb)
                                                                 goto success;
                                                             else
                                                                 continue;
                                                         else
                                                             continue;
-                                                    else if((*(cache_0 + pixel[6]))(0) < c_b)
-                                                        if((*(cache_0 + pixel[13]))(0) > cb)
-                                                            if((*(cache_0 + pixel[14]))(0) > cb)
-                                                                if((*(cache_0 + pixel[15]))(0) > cb)
+                                                    else if(cache_0[pixel[6]] < c_b)
+                                                        if(cache_0[pixel[13]] > cb)
+                                                            if(cache_0[pixel[14]] > cb)
+                                                                if(cache_0[pixel[15]] > cb)
                                                                     goto success;
                                                                 else
                                                                     continue;
@@ -409,9 +403,9 @@ namespace feature_detection {
                                                         else
                                                             continue;
                                                     else
-                                                    if((*(cache_0 + pixel[14]))(0) > cb)
-                                                        if((*(cache_0 + pixel[13]))(0) > cb)
-                                                            if((*(cache_0 + pixel[15]))(0) > cb)
+                                                    if(cache_0[pixel[14]] > cb)
+                                                        if(cache_0[pixel[13]] > cb)
+                                                            if(cache_0[pixel[15]] > cb)
                                                                 goto success;
                                                             else
                                                                 continue;
@@ -419,11 +413,11 @@ namespace feature_detection {
                                                             continue;
                                                     else
                                                         continue;
-                                                else if((*(cache_0 + pixel[7]))(0) < c_b)
-                                                    if((*(cache_0 + pixel[1]))(0) > cb)
-                                                        if((*(cache_0 + pixel[13]))(0) > cb)
-                                                            if((*(cache_0 + pixel[14]))(0) > cb)
-                                                                if((*(cache_0 + pixel[15]))(0) > cb)
+                                                else if(cache_0[pixel[7]] < c_b)
+                                                    if(cache_0[pixel[1]] > cb)
+                                                        if(cache_0[pixel[13]] > cb)
+                                                            if(cache_0[pixel[14]] > cb)
+                                                                if(cache_0[pixel[15]] > cb)
                                                                     goto success;
                                                                 else
                                                                     continue;
@@ -434,10 +428,10 @@ namespace feature_detection {
                                                     else
                                                         continue;
                                                 else
-                                                if((*(cache_0 + pixel[14]))(0) > cb)
-                                                    if((*(cache_0 + pixel[1]))(0) > cb)
-                                                        if((*(cache_0 + pixel[13]))(0) > cb)
-                                                            if((*(cache_0 + pixel[15]))(0) > cb)
+                                                if(cache_0[pixel[14]] > cb)
+                                                    if(cache_0[pixel[1]] > cb)
+                                                        if(cache_0[pixel[13]] > cb)
+                                                            if(cache_0[pixel[15]] > cb)
                                                                 goto success;
                                                             else
                                                                 continue;
@@ -455,33 +449,33 @@ namespace feature_detection {
                                         continue;
                                 else
                                     continue;
-                            else if((*(cache_0 + pixel[5]))(0) < c_b)
-                                if((*(cache_0 + pixel[13]))(0) > cb)
-                                    if((*(cache_0 + pixel[11]))(0) > cb)
-                                        if((*(cache_0 + -3))(0) > cb)
-                                            if((*(cache_0 + pixel[14]))(0) > cb)
-                                                if((*(cache_0 + pixel[15]))(0) > cb)
-                                                    if((*(cache_0 + pixel[10]))(0) > cb)
-                                                        if((*(cache_0 + pixel[9]))(0) > cb)
-                                                            if((*(cache_0 + pixel[1]))(0) > cb)
+                            else if(cache_0[pixel[5]] < c_b)
+                                if(cache_0[pixel[13]] > cb)
+                                    if(cache_0[pixel[11]] > cb)
+                                        if(cache_0[-3] > cb)
+                                            if(cache_0[pixel[14]] > cb)
+                                                if(cache_0[pixel[15]] > cb)
+                                                    if(cache_0[pixel[10]] > cb)
+                                                        if(cache_0[pixel[9]] > cb)
+                                                            if(cache_0[pixel[1]] > cb)
                                                                 goto success;
                                                             else
-                                                            if((*(cache_0 + pixel[7]))(0) > cb)
+                                                            if(cache_0[pixel[7]] > cb)
                                                                 goto success;
                                                             else
                                                                 continue;
                                                         else
-                                                        if((*(cache_0 + pixel[1]))(0) > cb)
-                                                            if((*(cache_0 + pixel[2]))(0) > cb)
+                                                        if(cache_0[pixel[1]] > cb)
+                                                            if(cache_0[pixel[2]] > cb)
                                                                 goto success;
                                                             else
                                                                 continue;
                                                         else
                                                             continue;
                                                     else
-                                                    if((*(cache_0 + pixel[1]))(0) > cb)
-                                                        if((*(cache_0 + pixel[2]))(0) > cb)
-                                                            if((*(cache_0 + 3))(0) > cb)
+                                                    if(cache_0[pixel[1]] > cb)
+                                                        if(cache_0[pixel[2]] > cb)
+                                                            if(cache_0[3] > cb)
                                                                 goto success;
                                                             else
                                                                 continue;
@@ -500,23 +494,23 @@ namespace feature_detection {
                                 else
                                     continue;
                             else
-                            if((*(cache_0 + -3))(0) > cb)
-                                if((*(cache_0 + pixel[14]))(0) > cb)
-                                    if((*(cache_0 + pixel[11]))(0) > cb)
-                                        if((*(cache_0 + pixel[15]))(0) > cb)
-                                            if((*(cache_0 + pixel[10]))(0) > cb)
-                                                if((*(cache_0 + pixel[13]))(0) > cb)
-                                                    if((*(cache_0 + pixel[1]))(0) > cb)
-                                                        if((*(cache_0 + pixel[2]))(0) > cb)
+                            if(cache_0[-3] > cb)
+                                if(cache_0[pixel[14]] > cb)
+                                    if(cache_0[pixel[11]] > cb)
+                                        if(cache_0[pixel[15]] > cb)
+                                            if(cache_0[pixel[10]] > cb)
+                                                if(cache_0[pixel[13]] > cb)
+                                                    if(cache_0[pixel[1]] > cb)
+                                                        if(cache_0[pixel[2]] > cb)
                                                             goto success;
                                                         else
-                                                        if((*(cache_0 + pixel[9]))(0) > cb)
+                                                        if(cache_0[pixel[9]] > cb)
                                                             goto success;
                                                         else
                                                             continue;
                                                     else
-                                                    if((*(cache_0 + pixel[7]))(0) > cb)
-                                                        if((*(cache_0 + pixel[9]))(0) > cb)
+                                                    if(cache_0[pixel[7]] > cb)
+                                                        if(cache_0[pixel[9]] > cb)
                                                             goto success;
                                                         else
                                                             continue;
@@ -524,11 +518,11 @@ namespace feature_detection {
                                                         continue;
                                                 else
                                                     continue;
-                                            else if((*(cache_0 + pixel[10]))(0) < c_b)
-                                                if((*(cache_0 + pixel[1]))(0) > cb)
-                                                    if((*(cache_0 + pixel[2]))(0) > cb)
-                                                        if((*(cache_0 + 3))(0) > cb)
-                                                            if((*(cache_0 + pixel[13]))(0) > cb)
+                                            else if(cache_0[pixel[10]] < c_b)
+                                                if(cache_0[pixel[1]] > cb)
+                                                    if(cache_0[pixel[2]] > cb)
+                                                        if(cache_0[3] > cb)
+                                                            if(cache_0[pixel[13]] > cb)
                                                                 goto success;
                                                             else
                                                                 continue;
@@ -539,10 +533,10 @@ namespace feature_detection {
                                                 else
                                                     continue;
                                             else
-                                            if((*(cache_0 + 3))(0) > cb)
-                                                if((*(cache_0 + pixel[2]))(0) > cb)
-                                                    if((*(cache_0 + pixel[1]))(0) > cb)
-                                                        if((*(cache_0 + pixel[13]))(0) > cb)
+                                            if(cache_0[3] > cb)
+                                                if(cache_0[pixel[2]] > cb)
+                                                    if(cache_0[pixel[1]] > cb)
+                                                        if(cache_0[pixel[13]] > cb)
                                                             goto success;
                                                         else
                                                             continue;
@@ -560,25 +554,25 @@ namespace feature_detection {
                                     continue;
                             else
                                 continue;
-                        else if((*(cache_0 + pixel[3]))(0) < c_b)
-                            if((*(cache_0 + -3))(0) > cb)
-                                if((*(cache_0 + pixel[10]))(0) > cb)
-                                    if((*(cache_0 + pixel[13]))(0) > cb)
-                                        if((*(cache_0 + pixel[9]))(0) > cb)
-                                            if((*(cache_0 + pixel[11]))(0) > cb)
-                                                if((*(cache_0 + pixel[14]))(0) > cb)
-                                                    if((*(cache_0 + pixel[15]))(0) > cb)
-                                                        if((*(cache_0 + pixel[7]))(0) > cb)
+                        else if(cache_0[pixel[3]] < c_b)
+                            if(cache_0[-3] > cb)
+                                if(cache_0[pixel[10]] > cb)
+                                    if(cache_0[pixel[13]] > cb)
+                                        if(cache_0[pixel[9]] > cb)
+                                            if(cache_0[pixel[11]] > cb)
+                                                if(cache_0[pixel[14]] > cb)
+                                                    if(cache_0[pixel[15]] > cb)
+                                                        if(cache_0[pixel[7]] > cb)
                                                             goto success;
                                                         else
-                                                        if((*(cache_0 + pixel[1]))(0) > cb)
+                                                        if(cache_0[pixel[1]] > cb)
                                                             goto success;
                                                         else
                                                             continue;
                                                     else
-                                                    if((*(cache_0 + pixel[5]))(0) > cb)
-                                                        if((*(cache_0 + pixel[6]))(0) > cb)
-                                                            if((*(cache_0 + pixel[7]))(0) > cb)
+                                                    if(cache_0[pixel[5]] > cb)
+                                                        if(cache_0[pixel[6]] > cb)
+                                                            if(cache_0[pixel[7]] > cb)
                                                                 goto success;
                                                             else
                                                                 continue;
@@ -587,10 +581,10 @@ namespace feature_detection {
                                                     else
                                                         continue;
                                                 else
-                                                if((*(cache_0 + 3))(0) > cb)
-                                                    if((*(cache_0 + pixel[5]))(0) > cb)
-                                                        if((*(cache_0 + pixel[6]))(0) > cb)
-                                                            if((*(cache_0 + pixel[7]))(0) > cb)
+                                                if(cache_0[3] > cb)
+                                                    if(cache_0[pixel[5]] > cb)
+                                                        if(cache_0[pixel[6]] > cb)
+                                                            if(cache_0[pixel[7]] > cb)
                                                                 goto success;
                                                             else
                                                                 continue;
@@ -611,26 +605,26 @@ namespace feature_detection {
                             else
                                 continue;
                         else
-                        if((*(cache_0 + -3))(0) > cb)
-                            if((*(cache_0 + pixel[10]))(0) > cb)
-                                if((*(cache_0 + pixel[14]))(0) > cb)
-                                    if((*(cache_0 + pixel[11]))(0) > cb)
-                                        if((*(cache_0 + pixel[13]))(0) > cb)
-                                            if((*(cache_0 + pixel[9]))(0) > cb)
-                                                if((*(cache_0 + pixel[7]))(0) > cb)
-                                                    if((*(cache_0 + pixel[15]))(0) > cb)
+                        if(cache_0[-3] > cb)
+                            if(cache_0[pixel[10]] > cb)
+                                if(cache_0[pixel[14]] > cb)
+                                    if(cache_0[pixel[11]] > cb)
+                                        if(cache_0[pixel[13]] > cb)
+                                            if(cache_0[pixel[9]] > cb)
+                                                if(cache_0[pixel[7]] > cb)
+                                                    if(cache_0[pixel[15]] > cb)
                                                         goto success;
                                                     else
-                                                    if((*(cache_0 + pixel[5]))(0) > cb)
-                                                        if((*(cache_0 + pixel[6]))(0) > cb)
+                                                    if(cache_0[pixel[5]] > cb)
+                                                        if(cache_0[pixel[6]] > cb)
                                                             goto success;
                                                         else
                                                             continue;
                                                     else
                                                         continue;
                                                 else
-                                                if((*(cache_0 + pixel[1]))(0) > cb)
-                                                    if((*(cache_0 + pixel[15]))(0) > cb)
+                                                if(cache_0[pixel[1]] > cb)
+                                                    if(cache_0[pixel[15]] > cb)
                                                         goto success;
                                                     else
                                                         continue;
@@ -642,14 +636,14 @@ namespace feature_detection {
                                             continue;
                                     else
                                         continue;
-                                else if((*(cache_0 + pixel[14]))(0) < c_b)
-                                    if((*(cache_0 + 3))(0) > cb)
-                                        if((*(cache_0 + pixel[5]))(0) > cb)
-                                            if((*(cache_0 + pixel[6]))(0) > cb)
-                                                if((*(cache_0 + pixel[7]))(0) > cb)
-                                                    if((*(cache_0 + pixel[9]))(0) > cb)
-                                                        if((*(cache_0 + pixel[11]))(0) > cb)
-                                                            if((*(cache_0 + pixel[13]))(0) > cb)
+                                else if(cache_0[pixel[14]] < c_b)
+                                    if(cache_0[3] > cb)
+                                        if(cache_0[pixel[5]] > cb)
+                                            if(cache_0[pixel[6]] > cb)
+                                                if(cache_0[pixel[7]] > cb)
+                                                    if(cache_0[pixel[9]] > cb)
+                                                        if(cache_0[pixel[11]] > cb)
+                                                            if(cache_0[pixel[13]] > cb)
                                                                 goto success;
                                                             else
                                                                 continue;
@@ -666,13 +660,13 @@ namespace feature_detection {
                                     else
                                         continue;
                                 else
-                                if((*(cache_0 + 3))(0) > cb)
-                                    if((*(cache_0 + pixel[13]))(0) > cb)
-                                        if((*(cache_0 + pixel[6]))(0) > cb)
-                                            if((*(cache_0 + pixel[11]))(0) > cb)
-                                                if((*(cache_0 + pixel[7]))(0) > cb)
-                                                    if((*(cache_0 + pixel[5]))(0) > cb)
-                                                        if((*(cache_0 + pixel[9]))(0) > cb)
+                                if(cache_0[3] > cb)
+                                    if(cache_0[pixel[13]] > cb)
+                                        if(cache_0[pixel[6]] > cb)
+                                            if(cache_0[pixel[11]] > cb)
+                                                if(cache_0[pixel[7]] > cb)
+                                                    if(cache_0[pixel[5]] > cb)
+                                                        if(cache_0[pixel[9]] > cb)
                                                             goto success;
                                                         else
                                                             continue;
@@ -692,26 +686,26 @@ namespace feature_detection {
                                 continue;
                         else
                             continue;
-                    else if((*(cache_0 + pixel[8]))(0) < c_b)
-                        if((*(cache_0 + pixel[11]))(0) > cb)
-                            if((*(cache_0 + pixel[2]))(0) > cb)
-                                if((*(cache_0 + pixel[15]))(0) > cb)
-                                    if((*(cache_0 + pixel[1]))(0) > cb)
-                                        if((*(cache_0 + pixel[14]))(0) > cb)
-                                            if((*(cache_0 + pixel[13]))(0) > cb)
-                                                if((*(cache_0 + pixel[3]))(0) > cb)
-                                                    if((*(cache_0 + -3))(0) > cb)
-                                                        if((*(cache_0 + 3))(0) > cb)
+                    else if(cache_0[pixel[8]] < c_b)
+                        if(cache_0[pixel[11]] > cb)
+                            if(cache_0[pixel[2]] > cb)
+                                if(cache_0[pixel[15]] > cb)
+                                    if(cache_0[pixel[1]] > cb)
+                                        if(cache_0[pixel[14]] > cb)
+                                            if(cache_0[pixel[13]] > cb)
+                                                if(cache_0[pixel[3]] > cb)
+                                                    if(cache_0[-3] > cb)
+                                                        if(cache_0[3] > cb)
                                                             goto success;
                                                         else
-                                                        if((*(cache_0 + pixel[10]))(0) > cb)
+                                                        if(cache_0[pixel[10]] > cb)
                                                             goto success;
                                                         else
                                                             continue;
                                                     else
-                                                    if((*(cache_0 + 3))(0) > cb)
-                                                        if((*(cache_0 + pixel[5]))(0) > cb)
-                                                            if((*(cache_0 + pixel[6]))(0) > cb)
+                                                    if(cache_0[3] > cb)
+                                                        if(cache_0[pixel[5]] > cb)
+                                                            if(cache_0[pixel[6]] > cb)
                                                                 goto success;
                                                             else
                                                                 continue;
@@ -720,9 +714,9 @@ namespace feature_detection {
                                                     else
                                                         continue;
                                                 else
-                                                if((*(cache_0 + pixel[9]))(0) > cb)
-                                                    if((*(cache_0 + pixel[10]))(0) > cb)
-                                                        if((*(cache_0 + -3))(0) > cb)
+                                                if(cache_0[pixel[9]] > cb)
+                                                    if(cache_0[pixel[10]] > cb)
+                                                        if(cache_0[-3] > cb)
                                                             goto success;
                                                         else
                                                             continue;
@@ -731,11 +725,11 @@ namespace feature_detection {
                                                 else
                                                     continue;
                                             else
-                                            if((*(cache_0 + pixel[3]))(0) > cb)
-                                                if((*(cache_0 + 3))(0) > cb)
-                                                    if((*(cache_0 + pixel[5]))(0) > cb)
-                                                        if((*(cache_0 + pixel[6]))(0) > cb)
-                                                            if((*(cache_0 + pixel[7]))(0) > cb)
+                                            if(cache_0[pixel[3]] > cb)
+                                                if(cache_0[3] > cb)
+                                                    if(cache_0[pixel[5]] > cb)
+                                                        if(cache_0[pixel[6]] > cb)
+                                                            if(cache_0[pixel[7]] > cb)
                                                                 goto success;
                                                             else
                                                                 continue;
@@ -753,15 +747,15 @@ namespace feature_detection {
                                         continue;
                                 else
                                     continue;
-                            else if((*(cache_0 + pixel[2]))(0) < c_b)
-                                if((*(cache_0 + pixel[1]))(0) < c_b)
-                                    if((*(cache_0 + pixel[3]))(0) < c_b)
-                                        if((*(cache_0 + 3))(0) < c_b)
-                                            if((*(cache_0 + pixel[5]))(0) < c_b)
-                                                if((*(cache_0 + pixel[6]))(0) < c_b)
-                                                    if((*(cache_0 + pixel[7]))(0) < c_b)
-                                                        if((*(cache_0 + pixel[9]))(0) < c_b)
-                                                            if((*(cache_0 + pixel[10]))(0) < c_b)
+                            else if(cache_0[pixel[2]] < c_b)
+                                if(cache_0[pixel[1]] < c_b)
+                                    if(cache_0[pixel[3]] < c_b)
+                                        if(cache_0[3] < c_b)
+                                            if(cache_0[pixel[5]] < c_b)
+                                                if(cache_0[pixel[6]] < c_b)
+                                                    if(cache_0[pixel[7]] < c_b)
+                                                        if(cache_0[pixel[9]] < c_b)
+                                                            if(cache_0[pixel[10]] < c_b)
                                                                 goto success;
                                                             else
                                                                 continue;
@@ -781,19 +775,19 @@ namespace feature_detection {
                                     continue;
                             else
                                 continue;
-                        else if((*(cache_0 + pixel[11]))(0) < c_b)
-                            if((*(cache_0 + pixel[6]))(0) > cb)
-                                if((*(cache_0 + pixel[14]))(0) > cb)
-                                    if((*(cache_0 + pixel[3]))(0) > cb)
-                                        if((*(cache_0 + pixel[1]))(0) > cb)
-                                            if((*(cache_0 + pixel[2]))(0) > cb)
-                                                if((*(cache_0 + 3))(0) > cb)
-                                                    if((*(cache_0 + pixel[5]))(0) > cb)
-                                                        if((*(cache_0 + pixel[15]))(0) > cb)
-                                                            if((*(cache_0 + pixel[7]))(0) > cb)
+                        else if(cache_0[pixel[11]] < c_b)
+                            if(cache_0[pixel[6]] > cb)
+                                if(cache_0[pixel[14]] > cb)
+                                    if(cache_0[pixel[3]] > cb)
+                                        if(cache_0[pixel[1]] > cb)
+                                            if(cache_0[pixel[2]] > cb)
+                                                if(cache_0[3] > cb)
+                                                    if(cache_0[pixel[5]] > cb)
+                                                        if(cache_0[pixel[15]] > cb)
+                                                            if(cache_0[pixel[7]] > cb)
                                                                 goto success;
                                                             else
-                                                            if((*(cache_0 + pixel[13]))(0) > cb)
+                                                            if(cache_0[pixel[13]] > cb)
                                                                 goto success;
                                                             else
                                                                 continue;
@@ -811,17 +805,17 @@ namespace feature_detection {
                                         continue;
                                 else
                                     continue;
-                            else if((*(cache_0 + pixel[6]))(0) < c_b)
-                                if((*(cache_0 + pixel[10]))(0) > cb)
-                                    if((*(cache_0 + pixel[1]))(0) > cb)
-                                        if((*(cache_0 + pixel[2]))(0) > cb)
-                                            if((*(cache_0 + pixel[3]))(0) > cb)
-                                                if((*(cache_0 + 3))(0) > cb)
-                                                    if((*(cache_0 + pixel[5]))(0) > cb)
-                                                        if((*(cache_0 + -3))(0) > cb)
-                                                            if((*(cache_0 + pixel[13]))(0) > cb)
-                                                                if((*(cache_0 + pixel[14]))(0) > cb)
-                                                                    if((*(cache_0 + pixel[15]))(0) > cb)
+                            else if(cache_0[pixel[6]] < c_b)
+                                if(cache_0[pixel[10]] > cb)
+                                    if(cache_0[pixel[1]] > cb)
+                                        if(cache_0[pixel[2]] > cb)
+                                            if(cache_0[pixel[3]] > cb)
+                                                if(cache_0[3] > cb)
+                                                    if(cache_0[pixel[5]] > cb)
+                                                        if(cache_0[-3] > cb)
+                                                            if(cache_0[pixel[13]] > cb)
+                                                                if(cache_0[pixel[14]] > cb)
+                                                                    if(cache_0[pixel[15]] > cb)
                                                                         goto success;
                                                                     else
                                                                         continue;
@@ -841,17 +835,17 @@ namespace feature_detection {
                                             continue;
                                     else
                                         continue;
-                                else if((*(cache_0 + pixel[10]))(0) < c_b)
-                                    if((*(cache_0 + pixel[5]))(0) > cb)
-                                        if((*(cache_0 + pixel[7]))(0) > cb)
-                                            if((*(cache_0 + pixel[1]))(0) > cb)
-                                                if((*(cache_0 + pixel[2]))(0) > cb)
-                                                    if((*(cache_0 + pixel[3]))(0) > cb)
-                                                        if((*(cache_0 + 3))(0) > cb)
-                                                            if((*(cache_0 + -3))(0) > cb)
-                                                                if((*(cache_0 + pixel[13]))(0) > cb)
-                                                                    if((*(cache_0 + pixel[14]))(0) > cb)
-                                                                        if((*(cache_0 + pixel[15]))(0) > cb)
+                                else if(cache_0[pixel[10]] < c_b)
+                                    if(cache_0[pixel[5]] > cb)
+                                        if(cache_0[pixel[7]] > cb)
+                                            if(cache_0[pixel[1]] > cb)
+                                                if(cache_0[pixel[2]] > cb)
+                                                    if(cache_0[pixel[3]] > cb)
+                                                        if(cache_0[3] > cb)
+                                                            if(cache_0[-3] > cb)
+                                                                if(cache_0[pixel[13]] > cb)
+                                                                    if(cache_0[pixel[14]] > cb)
+                                                                        if(cache_0[pixel[15]] > cb)
                                                                             goto success;
                                                                         else
                                                                             continue;
@@ -869,15 +863,15 @@ namespace feature_detection {
                                                     continue;
                                             else
                                                 continue;
-                                        else if((*(cache_0 + pixel[7]))(0) < c_b)
-                                            if((*(cache_0 + pixel[14]))(0) > cb)
-                                                if((*(cache_0 + -3))(0) > cb)
-                                                    if((*(cache_0 + pixel[1]))(0) > cb)
-                                                        if((*(cache_0 + pixel[2]))(0) > cb)
-                                                            if((*(cache_0 + pixel[3]))(0) > cb)
-                                                                if((*(cache_0 + 3))(0) > cb)
-                                                                    if((*(cache_0 + pixel[13]))(0) > cb)
-                                                                        if((*(cache_0 + pixel[15]))(0) > cb)
+                                        else if(cache_0[pixel[7]] < c_b)
+                                            if(cache_0[pixel[14]] > cb)
+                                                if(cache_0[-3] > cb)
+                                                    if(cache_0[pixel[1]] > cb)
+                                                        if(cache_0[pixel[2]] > cb)
+                                                            if(cache_0[pixel[3]] > cb)
+                                                                if(cache_0[3] > cb)
+                                                                    if(cache_0[pixel[13]] > cb)
+                                                                        if(cache_0[pixel[15]] > cb)
                                                                             goto success;
                                                                         else
                                                                             continue;
@@ -893,11 +887,11 @@ namespace feature_detection {
                                                         continue;
                                                 else
                                                     continue;
-                                            else if((*(cache_0 + pixel[14]))(0) < c_b)
-                                                if((*(cache_0 + pixel[9]))(0) < c_b)
-                                                    if((*(cache_0 + -3))(0) < c_b)
-                                                        if((*(cache_0 + pixel[13]))(0) < c_b)
-                                                            if((*(cache_0 + pixel[15]))(0) < c_b)
+                                            else if(cache_0[pixel[14]] < c_b)
+                                                if(cache_0[pixel[9]] < c_b)
+                                                    if(cache_0[-3] < c_b)
+                                                        if(cache_0[pixel[13]] < c_b)
+                                                            if(cache_0[pixel[15]] < c_b)
                                                                 goto success;
                                                             else
                                                                 continue;
@@ -910,14 +904,14 @@ namespace feature_detection {
                                             else
                                                 continue;
                                         else
-                                        if((*(cache_0 + -3))(0) > cb)
-                                            if((*(cache_0 + pixel[1]))(0) > cb)
-                                                if((*(cache_0 + pixel[2]))(0) > cb)
-                                                    if((*(cache_0 + pixel[3]))(0) > cb)
-                                                        if((*(cache_0 + 3))(0) > cb)
-                                                            if((*(cache_0 + pixel[13]))(0) > cb)
-                                                                if((*(cache_0 + pixel[14]))(0) > cb)
-                                                                    if((*(cache_0 + pixel[15]))(0) > cb)
+                                        if(cache_0[-3] > cb)
+                                            if(cache_0[pixel[1]] > cb)
+                                                if(cache_0[pixel[2]] > cb)
+                                                    if(cache_0[pixel[3]] > cb)
+                                                        if(cache_0[3] > cb)
+                                                            if(cache_0[pixel[13]] > cb)
+                                                                if(cache_0[pixel[14]] > cb)
+                                                                    if(cache_0[pixel[15]] > cb)
                                                                         goto success;
                                                                     else
                                                                         continue;
@@ -935,13 +929,13 @@ namespace feature_detection {
                                                 continue;
                                         else
                                             continue;
-                                    else if((*(cache_0 + pixel[5]))(0) < c_b)
-                                        if((*(cache_0 + -3))(0) > cb)
-                                            if((*(cache_0 + pixel[2]))(0) < c_b)
-                                                if((*(cache_0 + pixel[3]))(0) < c_b)
-                                                    if((*(cache_0 + 3))(0) < c_b)
-                                                        if((*(cache_0 + pixel[7]))(0) < c_b)
-                                                            if((*(cache_0 + pixel[9]))(0) < c_b)
+                                    else if(cache_0[pixel[5]] < c_b)
+                                        if(cache_0[-3] > cb)
+                                            if(cache_0[pixel[2]] < c_b)
+                                                if(cache_0[pixel[3]] < c_b)
+                                                    if(cache_0[3] < c_b)
+                                                        if(cache_0[pixel[7]] < c_b)
+                                                            if(cache_0[pixel[9]] < c_b)
                                                                 goto success;
                                                             else
                                                                 continue;
@@ -953,53 +947,35 @@ namespace feature_detection {
                                                     continue;
                                             else
                                                 continue;
-                                        else if((*(cache_0 + -3))(0) < c_b)
-                                            if((*(cache_0 + pixel[9]))(0) < c_b)
-                                                if((*(cache_0 + 3))(0) > cb)
-                                                    if((*(cache_0 + 3))(0) > cb)
-                                                        if((*(cache_0 + pixel[7]))(0) < c_b)
-                                                            if((*(cache_0 + pixel[13]))(0) < c_b)
-                                                                if((*(cache_0 + pixel[14]))(0) < c_b)
-                                                                    goto success;
-                                                                else
-                                                                    continue;
-                                                            else
-                                                                continue;
-                                                        else
-                                                            continue;
-                                                    else if((*(cache_0 + 3))(0) < c_b)
-                                                        if((*(cache_0 + pixel[7]))(0) < c_b)
-                                                            if((*(cache_0 + pixel[13]))(0) < c_b)
-                                                                goto success;
-                                                            else
-                                                            if((*(cache_0 + pixel[3]))(0) < c_b)
+                                        else if(cache_0[-3] < c_b)
+                                            if(cache_0[pixel[9]] < c_b)
+                                                if(cache_0[3] > cb)
+                                                    if(cache_0[pixel[7]] < c_b)
+                                                        if(cache_0[pixel[13]] < c_b)
+                                                            if(cache_0[pixel[14]] < c_b)
                                                                 goto success;
                                                             else
                                                                 continue;
                                                         else
                                                             continue;
                                                     else
-                                                    if((*(cache_0 + pixel[14]))(0) < c_b)
-                                                        if((*(cache_0 + pixel[13]))(0) < c_b)
-                                                            if((*(cache_0 + pixel[7]))(0) < c_b)
-                                                                goto success;
-                                                            else
-                                                                continue;
+                                                        continue;
+                                                else if(cache_0[3] < c_b)
+                                                    if(cache_0[pixel[7]] < c_b)
+                                                        if(cache_0[pixel[13]] < c_b)
+                                                            goto success;
+                                                        else
+                                                        if(cache_0[pixel[3]] < c_b)
+                                                            goto success;
                                                         else
                                                             continue;
                                                     else
                                                         continue;
                                                 else
-                                                    continue;
-                                            else
-                                            if((*(cache_0 + pixel[2]))(0) < c_b)
-                                                if((*(cache_0 + pixel[7]))(0) < c_b)
-                                                    if((*(cache_0 + pixel[3]))(0) < c_b)
-                                                        if((*(cache_0 + pixel[9]))(0) < c_b)
-                                                            if((*(cache_0 + 3))(0) < c_b)
-                                                                goto success;
-                                                            else
-                                                                continue;
+                                                if(cache_0[pixel[14]] < c_b)
+                                                    if(cache_0[pixel[13]] < c_b)
+                                                        if(cache_0[pixel[7]] < c_b)
+                                                            goto success;
                                                         else
                                                             continue;
                                                     else
@@ -1009,15 +985,12 @@ namespace feature_detection {
                                             else
                                                 continue;
                                         else
-                                        if((*(cache_0 + pixel[15]))(0) < c_b)
-                                            if((*(cache_0 + pixel[14]))(0) < c_b)
-                                                if((*(cache_0 + pixel[7]))(0) < c_b)
-                                                    if((*(cache_0 + pixel[9]))(0) < c_b)
-                                                        if((*(cache_0 + -3))(0) < c_b)
-                                                            if((*(cache_0 + pixel[13]))(0) < c_b)
-                                                                goto success;
-                                                            else
-                                                                continue;
+                                        if(cache_0[pixel[2]] < c_b)
+                                            if(cache_0[pixel[7]] < c_b)
+                                                if(cache_0[pixel[3]] < c_b)
+                                                    if(cache_0[pixel[9]] < c_b)
+                                                        if(cache_0[3] < c_b)
+                                                            goto success;
                                                         else
                                                             continue;
                                                     else
@@ -1029,22 +1002,13 @@ namespace feature_detection {
                                         else
                                             continue;
                                     else
-                                    if((*(cache_0 + -3))(0) > cb)
-                                        if((*(cache_0 + pixel[1]))(0) > cb)
-                                            if((*(cache_0 + pixel[2]))(0) > cb)
-                                                if((*(cache_0 + pixel[3]))(0) > cb)
-                                                    if((*(cache_0 + 3))(0) > cb)
-                                                        if((*(cache_0 + pixel[5]))(0) > cb)
-                                                            if((*(cache_0 + pixel[13]))(0) > cb)
-                                                                if((*(cache_0 + pixel[14]))(0) > cb)
-                                                                    if((*(cache_0 + pixel[15]))(0) > cb)
-                                                                        goto success;
-                                                                    else
-                                                                        continue;
-                                                                else
-                                                                    continue;
-                                                            else
-                                                                continue;
+                                    if(cache_0[pixel[15]] < c_b)
+                                        if(cache_0[pixel[14]] < c_b)
+                                            if(cache_0[pixel[7]] < c_b)
+                                                if(cache_0[pixel[9]] < c_b)
+                                                    if(cache_0[-3] < c_b)
+                                                        if(cache_0[pixel[13]] < c_b)
+                                                            goto success;
                                                         else
                                                             continue;
                                                     else
@@ -1058,15 +1022,15 @@ namespace feature_detection {
                                     else
                                         continue;
                                 else
-                                if((*(cache_0 + -3))(0) > cb)
-                                    if((*(cache_0 + pixel[3]))(0) > cb)
-                                        if((*(cache_0 + pixel[1]))(0) > cb)
-                                            if((*(cache_0 + pixel[2]))(0) > cb)
-                                                if((*(cache_0 + 3))(0) > cb)
-                                                    if((*(cache_0 + pixel[5]))(0) > cb)
-                                                        if((*(cache_0 + pixel[13]))(0) > cb)
-                                                            if((*(cache_0 + pixel[14]))(0) > cb)
-                                                                if((*(cache_0 + pixel[15]))(0) > cb)
+                                if(cache_0[-3] > cb)
+                                    if(cache_0[pixel[1]] > cb)
+                                        if(cache_0[pixel[2]] > cb)
+                                            if(cache_0[pixel[3]] > cb)
+                                                if(cache_0[3] > cb)
+                                                    if(cache_0[pixel[5]] > cb)
+                                                        if(cache_0[pixel[13]] > cb)
+                                                            if(cache_0[pixel[14]] > cb)
+                                                                if(cache_0[pixel[15]] > cb)
                                                                     goto success;
                                                                 else
                                                                     continue;
@@ -1087,18 +1051,15 @@ namespace feature_detection {
                                 else
                                     continue;
                             else
-                            if((*(cache_0 + pixel[3]))(0) > cb)
-                                if((*(cache_0 + pixel[5]))(0) > cb)
-                                    if((*(cache_0 + pixel[14]))(0) > cb)
-                                        if((*(cache_0 + pixel[15]))(0) > cb)
-                                            if((*(cache_0 + pixel[13]))(0) > cb)
-                                                if((*(cache_0 + pixel[1]))(0) > cb)
-                                                    if((*(cache_0 + pixel[2]))(0) > cb)
-                                                        if((*(cache_0 + 3))(0) > cb)
-                                                            if((*(cache_0 + pixel[6]))(0) > cb)
-                                                                goto success;
-                                                            else
-                                                            if((*(cache_0 + -3))(0) > cb)
+                            if(cache_0[-3] > cb)
+                                if(cache_0[pixel[3]] > cb)
+                                    if(cache_0[pixel[1]] > cb)
+                                        if(cache_0[pixel[2]] > cb)
+                                            if(cache_0[3] > cb)
+                                                if(cache_0[pixel[5]] > cb)
+                                                    if(cache_0[pixel[13]] > cb)
+                                                        if(cache_0[pixel[14]] > cb)
+                                                            if(cache_0[pixel[15]] > cb)
                                                                 goto success;
                                                             else
                                                                 continue;
@@ -1108,17 +1069,30 @@ namespace feature_detection {
                                                         continue;
                                                 else
                                                     continue;
-                                            else if((*(cache_0 + pixel[13]))(0) < c_b)
-                                                if((*(cache_0 + pixel[6]))(0) > cb)
-                                                    if((*(cache_0 + pixel[1]))(0) > cb)
-                                                        if((*(cache_0 + pixel[2]))(0) > cb)
-                                                            if((*(cache_0 + 3))(0) > cb)
-                                                                if((*(cache_0 + pixel[7]))(0) > cb)
-                                                                    goto success;
-                                                                else
-                                                                    continue;
-                                                            else
-                                                                continue;
+                                            else
+                                                continue;
+                                        else
+                                            continue;
+                                    else
+                                        continue;
+                                else
+                                    continue;
+                            else
+                                continue;
+                        else
+                        if(cache_0[pixel[3]] > cb)
+                            if(cache_0[pixel[5]] > cb)
+                                if(cache_0[pixel[14]] > cb)
+                                    if(cache_0[pixel[15]] > cb)
+                                        if(cache_0[pixel[13]] > cb)
+                                            if(cache_0[pixel[1]] > cb)
+                                                if(cache_0[pixel[2]] > cb)
+                                                    if(cache_0[3] > cb)
+                                                        if(cache_0[pixel[6]] > cb)
+                                                            goto success;
+                                                        else
+                                                        if(cache_0[-3] > cb)
+                                                            goto success;
                                                         else
                                                             continue;
                                                     else
@@ -1126,11 +1100,13 @@ namespace feature_detection {
                                                 else
                                                     continue;
                                             else
-                                            if((*(cache_0 + pixel[7]))(0) > cb)
-                                                if((*(cache_0 + pixel[1]))(0) > cb)
-                                                    if((*(cache_0 + pixel[2]))(0) > cb)
-                                                        if((*(cache_0 + 3))(0) > cb)
-                                                            if((*(cache_0 + pixel[6]))(0) > cb)
+                                                continue;
+                                        else if(cache_0[pixel[13]] < c_b)
+                                            if(cache_0[pixel[6]] > cb)
+                                                if(cache_0[pixel[1]] > cb)
+                                                    if(cache_0[pixel[2]] > cb)
+                                                        if(cache_0[3] > cb)
+                                                            if(cache_0[pixel[7]] > cb)
                                                                 goto success;
                                                             else
                                                                 continue;
@@ -1142,24 +1118,39 @@ namespace feature_detection {
                                                     continue;
                                             else
                                                 continue;
+                                        else
+                                        if(cache_0[pixel[7]] > cb)
+                                            if(cache_0[pixel[1]] > cb)
+                                                if(cache_0[pixel[2]] > cb)
+                                                    if(cache_0[3] > cb)
+                                                        if(cache_0[pixel[6]] > cb)
+                                                            goto success;
+                                                        else
+                                                            continue;
+                                                    else
+                                                        continue;
+                                                else
+                                                    continue;
+                                            else
+                                                continue;
                                         else
                                             continue;
                                     else
                                         continue;
                                 else
                                     continue;
-                            else if((*(cache_0 + pixel[3]))(0) < c_b)
-                                if((*(cache_0 + pixel[1]))(0) < c_b)
-                                    if((*(cache_0 + pixel[10]))(0) < c_b)
-                                        if((*(cache_0 + pixel[2]))(0) < c_b)
-                                            if((*(cache_0 + 3))(0) < c_b)
-                                                if((*(cache_0 + pixel[5]))(0) < c_b)
-                                                    if((*(cache_0 + pixel[6]))(0) < c_b)
-                                                        if((*(cache_0 + pixel[7]))(0) < c_b)
-                                                            if((*(cache_0 + pixel[9]))(0) < c_b)
-                                                                goto success;
-                                                            else
-                                                                continue;
+                            else
+                                continue;
+                        else if(cache_0[pixel[3]] < c_b)
+                            if(cache_0[pixel[1]] < c_b)
+                                if(cache_0[pixel[10]] < c_b)
+                                    if(cache_0[pixel[2]] < c_b)
+                                        if(cache_0[3] < c_b)
+                                            if(cache_0[pixel[5]] < c_b)
+                                                if(cache_0[pixel[6]] < c_b)
+                                                    if(cache_0[pixel[7]] < c_b)
+                                                        if(cache_0[pixel[9]] < c_b)
+                                                            goto success;
                                                         else
                                                             continue;
                                                     else
@@ -1177,36 +1168,27 @@ namespace feature_detection {
                             else
                                 continue;
                         else
-                        if((*(cache_0 + pixel[3]))(0) > cb)
-                            if((*(cache_0 + pixel[14]))(0) > cb)
-                                if((*(cache_0 + -3))(0) > cb)
-                                    if((*(cache_0 + pixel[2]))(0) > cb)
-                                        if((*(cache_0 + 3))(0) > cb)
-                                            if((*(cache_0 + pixel[15]))(0) > cb)
-                                                if((*(cache_0 + pixel[1]))(0) > cb)
-                                                    if((*(cache_0 + pixel[13]))(0) > cb)
-                                                        if((*(cache_0 + pixel[11]))(0) > cb)
-                                                            goto success;
-                                                        else
-                                                        if((*(cache_0 + pixel[5]))(0) > cb)
-                                                            goto success;
-                                                        else
-                                                            continue;
-                                                    else if((*(cache_0 + pixel[13]))(0) < c_b)
-                                                        if((*(cache_0 + pixel[5]))(0) > cb)
-                                                            if((*(cache_0 + pixel[6]))(0) > cb)
-                                                                if((*(cache_0 + pixel[7]))(0) > cb)
-                                                                    goto success;
-                                                                else
-                                                                    continue;
-                                                            else
-                                                                continue;
-                                                        else
-                                                            continue;
+                            continue;
+                    else
+                    if(cache_0[pixel[3]] > cb)
+                        if(cache_0[pixel[14]] > cb)
+                            if(cache_0[-3] > cb)
+                                if(cache_0[pixel[2]] > cb)
+                                    if(cache_0[3] > cb)
+                                        if(cache_0[pixel[15]] > cb)
+                                            if(cache_0[pixel[1]] > cb)
+                                                if(cache_0[pixel[13]] > cb)
+                                                    if(cache_0[pixel[11]] > cb)
+                                                        goto success;
+                                                    else
+                                                    if(cache_0[pixel[5]] > cb)
+                                                        goto success;
                                                     else
-                                                    if((*(cache_0 + pixel[7]))(0) > cb)
-                                                        if((*(cache_0 + pixel[5]))(0) > cb)
-                                                            if((*(cache_0 + pixel[6]))(0) > cb)
+                                                        continue;
+                                                else if(cache_0[pixel[13]] < c_b)
+                                                    if(cache_0[pixel[5]] > cb)
+                                                        if(cache_0[pixel[6]] > cb)
+                                                            if(cache_0[pixel[7]] > cb)
                                                                 goto success;
                                                             else
                                                                 continue;
@@ -1215,18 +1197,10 @@ namespace feature_detection {
                                                     else
                                                         continue;
                                                 else
-                                                    continue;
-                                            else
-                                                continue;
-                                        else if((*(cache_0 + 3))(0) < c_b)
-                                            if((*(cache_0 + pixel[1]))(0) > cb)
-                                                if((*(cache_0 + pixel[10]))(0) > cb)
-                                                    if((*(cache_0 + pixel[11]))(0) > cb)
-                                                        if((*(cache_0 + pixel[13]))(0) > cb)
-                                                            if((*(cache_0 + pixel[15]))(0) > cb)
-                                                                goto success;
-                                                            else
-                                                                continue;
+                                                if(cache_0[pixel[7]] > cb)
+                                                    if(cache_0[pixel[5]] > cb)
+                                                        if(cache_0[pixel[6]] > cb)
+                                                            goto success;
                                                         else
                                                             continue;
                                                     else
@@ -1236,11 +1210,13 @@ namespace feature_detection {
                                             else
                                                 continue;
                                         else
-                                        if((*(cache_0 + pixel[10]))(0) > cb)
-                                            if((*(cache_0 + pixel[13]))(0) > cb)
-                                                if((*(cache_0 + pixel[11]))(0) > cb)
-                                                    if((*(cache_0 + pixel[15]))(0) > cb)
-                                                        if((*(cache_0 + pixel[1]))(0) > cb)
+                                            continue;
+                                    else if(cache_0[3] < c_b)
+                                        if(cache_0[pixel[1]] > cb)
+                                            if(cache_0[pixel[10]] > cb)
+                                                if(cache_0[pixel[11]] > cb)
+                                                    if(cache_0[pixel[13]] > cb)
+                                                        if(cache_0[pixel[15]] > cb)
                                                             goto success;
                                                         else
                                                             continue;
@@ -1253,23 +1229,12 @@ namespace feature_detection {
                                         else
                                             continue;
                                     else
-                                        continue;
-                                else if((*(cache_0 + -3))(0) < c_b)
-                                    if((*(cache_0 + pixel[6]))(0) > cb)
-                                        if((*(cache_0 + pixel[1]))(0) > cb)
-                                            if((*(cache_0 + pixel[2]))(0) > cb)
-                                                if((*(cache_0 + 3))(0) > cb)
-                                                    if((*(cache_0 + pixel[5]))(0) > cb)
-                                                        if((*(cache_0 + pixel[15]))(0) > cb)
-                                                            if((*(cache_0 + pixel[7]))(0) > cb)
-                                                                goto success;
-                                                            else
-                                                            if((*(cache_0 + pixel[13]))(0) > cb)
-                                                                goto success;
-                                                            else
-                                                                continue;
-                                                        else
-                                                            continue;
+                                    if(cache_0[pixel[10]] > cb)
+                                        if(cache_0[pixel[13]] > cb)
+                                            if(cache_0[pixel[11]] > cb)
+                                                if(cache_0[pixel[15]] > cb)
+                                                    if(cache_0[pixel[1]] > cb)
+                                                        goto success;
                                                     else
                                                         continue;
                                                 else
@@ -1281,13 +1246,18 @@ namespace feature_detection {
                                     else
                                         continue;
                                 else
-                                if((*(cache_0 + pixel[6]))(0) > cb)
-                                    if((*(cache_0 + pixel[2]))(0) > cb)
-                                        if((*(cache_0 + pixel[5]))(0) > cb)
-                                            if((*(cache_0 + pixel[13]))(0) > cb)
-                                                if((*(cache_0 + pixel[15]))(0) > cb)
-                                                    if((*(cache_0 + 3))(0) > cb)
-                                                        if((*(cache_0 + pixel[1]))(0) > cb)
+                                    continue;
+                            else if(cache_0[-3] < c_b)
+                                if(cache_0[pixel[6]] > cb)
+                                    if(cache_0[pixel[1]] > cb)
+                                        if(cache_0[pixel[2]] > cb)
+                                            if(cache_0[3] > cb)
+                                                if(cache_0[pixel[5]] > cb)
+                                                    if(cache_0[pixel[15]] > cb)
+                                                        if(cache_0[pixel[7]] > cb)
+                                                            goto success;
+                                                        else
+                                                        if(cache_0[pixel[13]] > cb)
                                                             goto success;
                                                         else
                                                             continue;
@@ -1295,25 +1265,34 @@ namespace feature_detection {
                                                         continue;
                                                 else
                                                     continue;
-                                            else if((*(cache_0 + pixel[13]))(0) < c_b)
-                                                if((*(cache_0 + pixel[1]))(0) > cb)
-                                                    if((*(cache_0 + 3))(0) > cb)
-                                                        if((*(cache_0 + pixel[7]))(0) > cb)
-                                                            if((*(cache_0 + pixel[15]))(0) > cb)
-                                                                goto success;
-                                                            else
-                                                                continue;
-                                                        else
-                                                            continue;
+                                            else
+                                                continue;
+                                        else
+                                            continue;
+                                    else
+                                        continue;
+                                else
+                                    continue;
+                            else
+                            if(cache_0[pixel[6]] > cb)
+                                if(cache_0[pixel[2]] > cb)
+                                    if(cache_0[pixel[5]] > cb)
+                                        if(cache_0[pixel[13]] > cb)
+                                            if(cache_0[pixel[15]] > cb)
+                                                if(cache_0[3] > cb)
+                                                    if(cache_0[pixel[1]] > cb)
+                                                        goto success;
                                                     else
                                                         continue;
                                                 else
                                                     continue;
                                             else
-                                            if((*(cache_0 + pixel[7]))(0) > cb)
-                                                if((*(cache_0 + pixel[15]))(0) > cb)
-                                                    if((*(cache_0 + 3))(0) > cb)
-                                                        if((*(cache_0 + pixel[1]))(0) > cb)
+                                                continue;
+                                        else if(cache_0[pixel[13]] < c_b)
+                                            if(cache_0[pixel[1]] > cb)
+                                                if(cache_0[3] > cb)
+                                                    if(cache_0[pixel[7]] > cb)
+                                                        if(cache_0[pixel[15]] > cb)
                                                             goto success;
                                                         else
                                                             continue;
@@ -1323,6 +1302,18 @@ namespace feature_detection {
                                                     continue;
                                             else
                                                 continue;
+                                        else
+                                        if(cache_0[pixel[7]] > cb)
+                                            if(cache_0[pixel[15]] > cb)
+                                                if(cache_0[3] > cb)
+                                                    if(cache_0[pixel[1]] > cb)
+                                                        goto success;
+                                                    else
+                                                        continue;
+                                                else
+                                                    continue;
+                                            else
+                                                continue;
                                         else
                                             continue;
                                     else
@@ -1331,19 +1322,19 @@ namespace feature_detection {
                                     continue;
                             else
                                 continue;
-                        else if((*(cache_0 + pixel[3]))(0) < c_b)
-                            if((*(cache_0 + pixel[2]))(0) > cb)
-                                if((*(cache_0 + pixel[9]))(0) > cb)
-                                    if((*(cache_0 + pixel[1]))(0) > cb)
-                                        if((*(cache_0 + pixel[10]))(0) > cb)
-                                            if((*(cache_0 + pixel[11]))(0) > cb)
-                                                if((*(cache_0 + -3))(0) > cb)
-                                                    if((*(cache_0 + pixel[13]))(0) > cb)
-                                                        if((*(cache_0 + pixel[14]))(0) > cb)
-                                                            if((*(cache_0 + pixel[15]))(0) > cb)
-                                                                goto success;
-                                                            else
-                                                                continue;
+                        else
+                            continue;
+                    else if(cache_0[pixel[3]] < c_b)
+                        if(cache_0[pixel[2]] > cb)
+                            if(cache_0[pixel[9]] > cb)
+                                if(cache_0[pixel[1]] > cb)
+                                    if(cache_0[pixel[10]] > cb)
+                                        if(cache_0[pixel[11]] > cb)
+                                            if(cache_0[-3] > cb)
+                                                if(cache_0[pixel[13]] > cb)
+                                                    if(cache_0[pixel[14]] > cb)
+                                                        if(cache_0[pixel[15]] > cb)
+                                                            goto success;
                                                         else
                                                             continue;
                                                     else
@@ -1361,18 +1352,18 @@ namespace feature_detection {
                             else
                                 continue;
                         else
-                        if((*(cache_0 + pixel[9]))(0) > cb)
-                            if((*(cache_0 + pixel[2]))(0) > cb)
-                                if((*(cache_0 + -3))(0) > cb)
-                                    if((*(cache_0 + pixel[14]))(0) > cb)
-                                        if((*(cache_0 + pixel[11]))(0) > cb)
-                                            if((*(cache_0 + pixel[13]))(0) > cb)
-                                                if((*(cache_0 + pixel[15]))(0) > cb)
-                                                    if((*(cache_0 + pixel[10]))(0) > cb)
-                                                        if((*(cache_0 + pixel[1]))(0) > cb)
-                                                            goto success;
-                                                        else
-                                                            continue;
+                            continue;
+                    else
+                    if(cache_0[pixel[9]] > cb)
+                        if(cache_0[pixel[2]] > cb)
+                            if(cache_0[-3] > cb)
+                                if(cache_0[pixel[14]] > cb)
+                                    if(cache_0[pixel[11]] > cb)
+                                        if(cache_0[pixel[13]] > cb)
+                                            if(cache_0[pixel[15]] > cb)
+                                                if(cache_0[pixel[10]] > cb)
+                                                    if(cache_0[pixel[1]] > cb)
+                                                        goto success;
                                                     else
                                                         continue;
                                                 else
@@ -1389,41 +1380,32 @@ namespace feature_detection {
                                 continue;
                         else
                             continue;
-                    else if((*(cache_0 + pixel[0]))(0) < c_b)
-                        if((*(cache_0 + pixel[8]))(0) > cb)
-                            if((*(cache_0 + pixel[2]))(0) > cb)
-                                if((*(cache_0 + pixel[10]))(0) > cb)
-                                    if((*(cache_0 + pixel[6]))(0) > cb)
-                                        if((*(cache_0 + pixel[7]))(0) > cb)
-                                            if((*(cache_0 + pixel[9]))(0) > cb)
-                                                if((*(cache_0 + pixel[5]))(0) > cb)
-                                                    if((*(cache_0 + pixel[11]))(0) > cb)
-                                                        if((*(cache_0 + 3))(0) > cb)
-                                                            if((*(cache_0 + pixel[3]))(0) > cb)
-                                                                goto success;
-                                                            else
-                                                            if((*(cache_0 + -3))(0) > cb)
-                                                                if((*(cache_0 + pixel[13]))(0) > cb)
-                                                                    goto success;
-                                                                else
-                                                                    continue;
-                                                            else
-                                                                continue;
+                    else
+                        continue;
+                else if(cache_0[pixel[0]] < c_b)
+                    if(cache_0[pixel[8]] > cb)
+                        if(cache_0[pixel[2]] > cb)
+                            if(cache_0[pixel[10]] > cb)
+                                if(cache_0[pixel[6]] > cb)
+                                    if(cache_0[pixel[7]] > cb)
+                                        if(cache_0[pixel[9]] > cb)
+                                            if(cache_0[pixel[5]] > cb)
+                                                if(cache_0[pixel[11]] > cb)
+                                                    if(cache_0[3] > cb)
+                                                        if(cache_0[pixel[3]] > cb)
+                                                            goto success;
                                                         else
-                                                        if((*(cache_0 + -3))(0) > cb)
-                                                            if((*(cache_0 + pixel[13]))(0) > cb)
-                                                                if((*(cache_0 + pixel[14]))(0) > cb)
-                                                                    goto success;
-                                                                else
-                                                                    continue;
+                                                        if(cache_0[-3] > cb)
+                                                            if(cache_0[pixel[13]] > cb)
+                                                                goto success;
                                                             else
                                                                 continue;
                                                         else
                                                             continue;
                                                     else
-                                                    if((*(cache_0 + pixel[1]))(0) > cb)
-                                                        if((*(cache_0 + pixel[3]))(0) > cb)
-                                                            if((*(cache_0 + 3))(0) > cb)
+                                                    if(cache_0[-3] > cb)
+                                                        if(cache_0[pixel[13]] > cb)
+                                                            if(cache_0[pixel[14]] > cb)
                                                                 goto success;
                                                             else
                                                                 continue;
@@ -1431,15 +1413,24 @@ namespace feature_detection {
                                                             continue;
                                                     else
                                                         continue;
-                                                else if((*(cache_0 + pixel[5]))(0) < c_b)
-                                                    if((*(cache_0 + pixel[11]))(0) > cb)
-                                                        if((*(cache_0 + -3))(0) > cb)
-                                                            if((*(cache_0 + pixel[13]))(0) > cb)
-                                                                if((*(cache_0 + pixel[14]))(0) > cb)
-                                                                    if((*(cache_0 + pixel[15]))(0) > cb)
-                                                                        goto success;
-                                                                    else
-                                                                        continue;
+                                                else
+                                                if(cache_0[pixel[1]] > cb)
+                                                    if(cache_0[pixel[3]] > cb)
+                                                        if(cache_0[3] > cb)
+                                                            goto success;
+                                                        else
+                                                            continue;
+                                                    else
+                                                        continue;
+                                                else
+                                                    continue;
+                                            else if(cache_0[pixel[5]] < c_b)
+                                                if(cache_0[pixel[11]] > cb)
+                                                    if(cache_0[-3] > cb)
+                                                        if(cache_0[pixel[13]] > cb)
+                                                            if(cache_0[pixel[14]] > cb)
+                                                                if(cache_0[pixel[15]] > cb)
+                                                                    goto success;
                                                                 else
                                                                     continue;
                                                             else
@@ -1449,14 +1440,14 @@ namespace feature_detection {
                                                     else
                                                         continue;
                                                 else
-                                                if((*(cache_0 + pixel[13]))(0) > cb)
-                                                    if((*(cache_0 + pixel[11]))(0) > cb)
-                                                        if((*(cache_0 + -3))(0) > cb)
-                                                            if((*(cache_0 + pixel[14]))(0) > cb)
-                                                                if((*(cache_0 + pixel[15]))(0) > cb)
-                                                                    goto success;
-                                                                else
-                                                                    continue;
+                                                    continue;
+                                            else
+                                            if(cache_0[pixel[13]] > cb)
+                                                if(cache_0[pixel[11]] > cb)
+                                                    if(cache_0[-3] > cb)
+                                                        if(cache_0[pixel[14]] > cb)
+                                                            if(cache_0[pixel[15]] > cb)
+                                                                goto success;
                                                             else
                                                                 continue;
                                                         else
@@ -1473,31 +1464,31 @@ namespace feature_detection {
                                         continue;
                                 else
                                     continue;
-                            else if((*(cache_0 + pixel[2]))(0) < c_b)
-                                if((*(cache_0 + pixel[13]))(0) > cb)
-                                    if((*(cache_0 + pixel[6]))(0) > cb)
-                                        if((*(cache_0 + pixel[11]))(0) > cb)
-                                            if((*(cache_0 + pixel[9]))(0) > cb)
-                                                if((*(cache_0 + pixel[7]))(0) > cb)
-                                                    if((*(cache_0 + pixel[10]))(0) > cb)
-                                                        if((*(cache_0 + pixel[5]))(0) > cb)
-                                                            if((*(cache_0 + -3))(0) > cb)
-                                                                if((*(cache_0 + 3))(0) > cb)
-                                                                    goto success;
-                                                                else
-                                                                if((*(cache_0 + pixel[14]))(0) > cb)
-                                                                    goto success;
-                                                                else
-                                                                    continue;
+                            else
+                                continue;
+                        else if(cache_0[pixel[2]] < c_b)
+                            if(cache_0[pixel[13]] > cb)
+                                if(cache_0[pixel[6]] > cb)
+                                    if(cache_0[pixel[11]] > cb)
+                                        if(cache_0[pixel[9]] > cb)
+                                            if(cache_0[pixel[7]] > cb)
+                                                if(cache_0[pixel[10]] > cb)
+                                                    if(cache_0[pixel[5]] > cb)
+                                                        if(cache_0[-3] > cb)
+                                                            if(cache_0[3] > cb)
+                                                                goto success;
+                                                            else
+                                                            if(cache_0[pixel[14]] > cb)
+                                                                goto success;
                                                             else
                                                                 continue;
                                                         else
-                                                        if((*(cache_0 + pixel[15]))(0) > cb)
-                                                            if((*(cache_0 + -3))(0) > cb)
-                                                                if((*(cache_0 + pixel[14]))(0) > cb)
-                                                                    goto success;
-                                                                else
-                                                                    continue;
+                                                            continue;
+                                                    else
+                                                    if(cache_0[pixel[15]] > cb)
+                                                        if(cache_0[-3] > cb)
+                                                            if(cache_0[pixel[14]] > cb)
+                                                                goto success;
                                                             else
                                                                 continue;
                                                         else
@@ -1510,17 +1501,17 @@ namespace feature_detection {
                                                 continue;
                                         else
                                             continue;
-                                    else if((*(cache_0 + pixel[6]))(0) < c_b)
-                                        if((*(cache_0 + pixel[7]))(0) < c_b)
-                                            if((*(cache_0 + pixel[1]))(0) < c_b)
-                                                if((*(cache_0 + pixel[3]))(0) < c_b)
-                                                    if((*(cache_0 + 3))(0) < c_b)
-                                                        if((*(cache_0 + pixel[5]))(0) < c_b)
-                                                            if((*(cache_0 + pixel[14]))(0) < c_b)
-                                                                if((*(cache_0 + pixel[15]))(0) < c_b)
-                                                                    goto success;
-                                                                else
-                                                                    continue;
+                                    else
+                                        continue;
+                                else if(cache_0[pixel[6]] < c_b)
+                                    if(cache_0[pixel[7]] < c_b)
+                                        if(cache_0[pixel[1]] < c_b)
+                                            if(cache_0[pixel[3]] < c_b)
+                                                if(cache_0[3] < c_b)
+                                                    if(cache_0[pixel[5]] < c_b)
+                                                        if(cache_0[pixel[14]] < c_b)
+                                                            if(cache_0[pixel[15]] < c_b)
+                                                                goto success;
                                                             else
                                                                 continue;
                                                         else
@@ -1535,19 +1526,19 @@ namespace feature_detection {
                                             continue;
                                     else
                                         continue;
-                                else if((*(cache_0 + pixel[13]))(0) < c_b)
-                                    if((*(cache_0 + pixel[3]))(0) > cb)
-                                        if((*(cache_0 + pixel[10]))(0) > cb)
-                                            if((*(cache_0 + pixel[7]))(0) > cb)
-                                                if((*(cache_0 + 3))(0) > cb)
-                                                    if((*(cache_0 + pixel[5]))(0) > cb)
-                                                        if((*(cache_0 + pixel[6]))(0) > cb)
-                                                            if((*(cache_0 + pixel[9]))(0) > cb)
-                                                                if((*(cache_0 + pixel[11]))(0) > cb)
-                                                                    if((*(cache_0 + -3))(0) > cb)
-                                                                        goto success;
-                                                                    else
-                                                                        continue;
+                                else
+                                    continue;
+                            else if(cache_0[pixel[13]] < c_b)
+                                if(cache_0[pixel[3]] > cb)
+                                    if(cache_0[pixel[10]] > cb)
+                                        if(cache_0[pixel[7]] > cb)
+                                            if(cache_0[3] > cb)
+                                                if(cache_0[pixel[5]] > cb)
+                                                    if(cache_0[pixel[6]] > cb)
+                                                        if(cache_0[pixel[9]] > cb)
+                                                            if(cache_0[pixel[11]] > cb)
+                                                                if(cache_0[-3] > cb)
+                                                                    goto success;
                                                                 else
                                                                     continue;
                                                             else
@@ -1560,16 +1551,16 @@ namespace feature_detection {
                                                     continue;
                                             else
                                                 continue;
-                                        else if((*(cache_0 + pixel[10]))(0) < c_b)
-                                            if((*(cache_0 + pixel[9]))(0) < c_b)
-                                                if((*(cache_0 + pixel[1]))(0) < c_b)
-                                                    if((*(cache_0 + pixel[11]))(0) < c_b)
-                                                        if((*(cache_0 + -3))(0) < c_b)
-                                                            if((*(cache_0 + pixel[14]))(0) < c_b)
-                                                                if((*(cache_0 + pixel[15]))(0) < c_b)
-                                                                    goto success;
-                                                                else
-                                                                    continue;
+                                        else
+                                            continue;
+                                    else if(cache_0[pixel[10]] < c_b)
+                                        if(cache_0[pixel[9]] < c_b)
+                                            if(cache_0[pixel[1]] < c_b)
+                                                if(cache_0[pixel[11]] < c_b)
+                                                    if(cache_0[-3] < c_b)
+                                                        if(cache_0[pixel[14]] < c_b)
+                                                            if(cache_0[pixel[15]] < c_b)
+                                                                goto success;
                                                             else
                                                                 continue;
                                                         else
@@ -1582,58 +1573,58 @@ namespace feature_detection {
                                                 continue;
                                         else
                                             continue;
-                                    else if((*(cache_0 + pixel[3]))(0) < c_b)
-                                        if((*(cache_0 + pixel[15]))(0) < c_b)
-                                            if((*(cache_0 + pixel[1]))(0) < c_b)
-                                                if((*(cache_0 + pixel[5]))(0) > cb)
-                                                    if((*(cache_0 + pixel[10]))(0) < c_b)
-                                                        if((*(cache_0 + pixel[14]))(0) < c_b)
-                                                            if((*(cache_0 + pixel[11]))(0) < c_b)
-                                                                if((*(cache_0 + -3))(0) < c_b)
-                                                                    goto success;
-                                                                else
-                                                                    continue;
+                                    else
+                                        continue;
+                                else if(cache_0[pixel[3]] < c_b)
+                                    if(cache_0[pixel[15]] < c_b)
+                                        if(cache_0[pixel[1]] < c_b)
+                                            if(cache_0[pixel[5]] > cb)
+                                                if(cache_0[pixel[10]] < c_b)
+                                                    if(cache_0[pixel[14]] < c_b)
+                                                        if(cache_0[pixel[11]] < c_b)
+                                                            if(cache_0[-3] < c_b)
+                                                                goto success;
                                                             else
                                                                 continue;
                                                         else
                                                             continue;
                                                     else
-                                                    if((*(cache_0 + 3))(0) < c_b)
-                                                        if((*(cache_0 + pixel[11]))(0) < c_b)
-                                                            if((*(cache_0 + -3))(0) < c_b)
-                                                                if((*(cache_0 + pixel[14]))(0) < c_b)
-                                                                    goto success;
-                                                                else
-                                                                    continue;
+                                                        continue;
+                                                else
+                                                if(cache_0[3] < c_b)
+                                                    if(cache_0[pixel[11]] < c_b)
+                                                        if(cache_0[-3] < c_b)
+                                                            if(cache_0[pixel[14]] < c_b)
+                                                                goto success;
                                                             else
                                                                 continue;
                                                         else
                                                             continue;
                                                     else
                                                         continue;
-                                                else if((*(cache_0 + pixel[5]))(0) < c_b)
-                                                    if((*(cache_0 + 3))(0) < c_b)
-                                                        if((*(cache_0 + pixel[6]))(0) < c_b)
-                                                            if((*(cache_0 + pixel[14]))(0) < c_b)
-                                                                goto success;
-                                                            else
-                                                                continue;
+                                                else
+                                                    continue;
+                                            else if(cache_0[pixel[5]] < c_b)
+                                                if(cache_0[3] < c_b)
+                                                    if(cache_0[pixel[6]] < c_b)
+                                                        if(cache_0[pixel[14]] < c_b)
+                                                            goto success;
                                                         else
-                                                        if((*(cache_0 + -3))(0) < c_b)
-                                                            if((*(cache_0 + pixel[14]))(0) < c_b)
-                                                                goto success;
-                                                            else
-                                                                continue;
+                                                            continue;
+                                                    else
+                                                    if(cache_0[-3] < c_b)
+                                                        if(cache_0[pixel[14]] < c_b)
+                                                            goto success;
                                                         else
                                                             continue;
                                                     else
-                                                    if((*(cache_0 + pixel[10]))(0) < c_b)
-                                                        if((*(cache_0 + pixel[11]))(0) < c_b)
-                                                            if((*(cache_0 + -3))(0) < c_b)
-                                                                if((*(cache_0 + pixel[14]))(0) < c_b)
-                                                                    goto success;
-                                                                else
-                                                                    continue;
+                                                        continue;
+                                                else
+                                                if(cache_0[pixel[10]] < c_b)
+                                                    if(cache_0[pixel[11]] < c_b)
+                                                        if(cache_0[-3] < c_b)
+                                                            if(cache_0[pixel[14]] < c_b)
+                                                                goto success;
                                                             else
                                                                 continue;
                                                         else
@@ -1641,33 +1632,54 @@ namespace feature_detection {
                                                     else
                                                         continue;
                                                 else
-                                                if((*(cache_0 + pixel[11]))(0) < c_b)
-                                                    if((*(cache_0 + pixel[10]))(0) > cb)
-                                                        if((*(cache_0 + 3))(0) < c_b)
-                                                            if((*(cache_0 + -3))(0) < c_b)
-                                                                if((*(cache_0 + pixel[14]))(0) < c_b)
-                                                                    goto success;
-                                                                else
-                                                                    continue;
+                                                    continue;
+                                            else
+                                            if(cache_0[pixel[11]] < c_b)
+                                                if(cache_0[pixel[10]] > cb)
+                                                    if(cache_0[3] < c_b)
+                                                        if(cache_0[-3] < c_b)
+                                                            if(cache_0[pixel[14]] < c_b)
+                                                                goto success;
                                                             else
                                                                 continue;
                                                         else
                                                             continue;
-                                                    else if((*(cache_0 + pixel[10]))(0) < c_b)
-                                                        if((*(cache_0 + pixel[14]))(0) < c_b)
-                                                            if((*(cache_0 + -3))(0) < c_b)
-                                                                goto success;
-                                                            else
-                                                                continue;
+                                                    else
+                                                        continue;
+                                                else if(cache_0[pixel[10]] < c_b)
+                                                    if(cache_0[pixel[14]] < c_b)
+                                                        if(cache_0[-3] < c_b)
+                                                            goto success;
                                                         else
                                                             continue;
                                                     else
-                                                    if((*(cache_0 + 3))(0) < c_b)
-                                                        if((*(cache_0 + pixel[14]))(0) < c_b)
-                                                            if((*(cache_0 + -3))(0) < c_b)
-                                                                goto success;
-                                                            else
-                                                                continue;
+                                                        continue;
+                                                else
+                                                if(cache_0[3] < c_b)
+                                                    if(cache_0[pixel[14]] < c_b)
+                                                        if(cache_0[-3] < c_b)
+                                                            goto success;
+                                                        else
+                                                            continue;
+                                                    else
+                                                        continue;
+                                                else
+                                                    continue;
+                                            else
+                                                continue;
+                                        else
+                                            continue;
+                                    else
+                                        continue;
+                                else
+                                if(cache_0[pixel[9]] < c_b)
+                                    if(cache_0[pixel[11]] < c_b)
+                                        if(cache_0[pixel[1]] < c_b)
+                                            if(cache_0[pixel[10]] < c_b)
+                                                if(cache_0[-3] < c_b)
+                                                    if(cache_0[pixel[14]] < c_b)
+                                                        if(cache_0[pixel[15]] < c_b)
+                                                            goto success;
                                                         else
                                                             continue;
                                                     else
@@ -1679,13 +1691,19 @@ namespace feature_detection {
                                         else
                                             continue;
                                     else
-                                    if((*(cache_0 + pixel[9]))(0) < c_b)
-                                        if((*(cache_0 + pixel[11]))(0) < c_b)
-                                            if((*(cache_0 + pixel[1]))(0) < c_b)
-                                                if((*(cache_0 + pixel[10]))(0) < c_b)
-                                                    if((*(cache_0 + -3))(0) < c_b)
-                                                        if((*(cache_0 + pixel[14]))(0) < c_b)
-                                                            if((*(cache_0 + pixel[15]))(0) < c_b)
+                                        continue;
+                                else
+                                    continue;
+                            else
+                            if(cache_0[pixel[7]] > cb)
+                                if(cache_0[pixel[3]] > cb)
+                                    if(cache_0[pixel[10]] > cb)
+                                        if(cache_0[3] > cb)
+                                            if(cache_0[pixel[5]] > cb)
+                                                if(cache_0[pixel[6]] > cb)
+                                                    if(cache_0[pixel[9]] > cb)
+                                                        if(cache_0[pixel[11]] > cb)
+                                                            if(cache_0[-3] > cb)
                                                                 goto success;
                                                             else
                                                                 continue;
@@ -1702,20 +1720,16 @@ namespace feature_detection {
                                     else
                                         continue;
                                 else
-                                if((*(cache_0 + pixel[7]))(0) > cb)
-                                    if((*(cache_0 + pixel[3]))(0) > cb)
-                                        if((*(cache_0 + pixel[10]))(0) > cb)
-                                            if((*(cache_0 + 3))(0) > cb)
-                                                if((*(cache_0 + pixel[5]))(0) > cb)
-                                                    if((*(cache_0 + pixel[6]))(0) > cb)
-                                                        if((*(cache_0 + pixel[9]))(0) > cb)
-                                                            if((*(cache_0 + pixel[11]))(0) > cb)
-                                                                if((*(cache_0 + -3))(0) > cb)
-                                                                    goto success;
-                                                                else
-                                                                    continue;
-                                                            else
-                                                                continue;
+                                    continue;
+                            else if(cache_0[pixel[7]] < c_b)
+                                if(cache_0[pixel[1]] < c_b)
+                                    if(cache_0[pixel[3]] < c_b)
+                                        if(cache_0[3] < c_b)
+                                            if(cache_0[pixel[5]] < c_b)
+                                                if(cache_0[pixel[6]] < c_b)
+                                                    if(cache_0[pixel[14]] < c_b)
+                                                        if(cache_0[pixel[15]] < c_b)
+                                                            goto success;
                                                         else
                                                             continue;
                                                     else
@@ -1728,17 +1742,42 @@ namespace feature_detection {
                                             continue;
                                     else
                                         continue;
-                                else if((*(cache_0 + pixel[7]))(0) < c_b)
-                                    if((*(cache_0 + pixel[1]))(0) < c_b)
-                                        if((*(cache_0 + pixel[3]))(0) < c_b)
-                                            if((*(cache_0 + 3))(0) < c_b)
-                                                if((*(cache_0 + pixel[5]))(0) < c_b)
-                                                    if((*(cache_0 + pixel[6]))(0) < c_b)
-                                                        if((*(cache_0 + pixel[14]))(0) < c_b)
-                                                            if((*(cache_0 + pixel[15]))(0) < c_b)
-                                                                goto success;
-                                                            else
-                                                                continue;
+                                else
+                                    continue;
+                            else
+                                continue;
+                        else
+                        if(cache_0[-3] > cb)
+                            if(cache_0[pixel[6]] > cb)
+                                if(cache_0[pixel[11]] > cb)
+                                    if(cache_0[pixel[9]] > cb)
+                                        if(cache_0[pixel[10]] > cb)
+                                            if(cache_0[pixel[13]] > cb)
+                                                if(cache_0[pixel[7]] > cb)
+                                                    if(cache_0[pixel[5]] > cb)
+                                                        if(cache_0[3] > cb)
+                                                            goto success;
+                                                        else
+                                                        if(cache_0[pixel[14]] > cb)
+                                                            goto success;
+                                                        else
+                                                            continue;
+                                                    else
+                                                    if(cache_0[pixel[15]] > cb)
+                                                        if(cache_0[pixel[14]] > cb)
+                                                            goto success;
+                                                        else
+                                                            continue;
+                                                    else
+                                                        continue;
+                                                else
+                                                    continue;
+                                            else
+                                            if(cache_0[pixel[3]] > cb)
+                                                if(cache_0[3] > cb)
+                                                    if(cache_0[pixel[5]] > cb)
+                                                        if(cache_0[pixel[7]] > cb)
+                                                            goto success;
                                                         else
                                                             continue;
                                                     else
@@ -1754,24 +1793,31 @@ namespace feature_detection {
                                 else
                                     continue;
                             else
-                            if((*(cache_0 + -3))(0) > cb)
-                                if((*(cache_0 + pixel[6]))(0) > cb)
-                                    if((*(cache_0 + pixel[11]))(0) > cb)
-                                        if((*(cache_0 + pixel[9]))(0) > cb)
-                                            if((*(cache_0 + pixel[10]))(0) > cb)
-                                                if((*(cache_0 + pixel[13]))(0) > cb)
-                                                    if((*(cache_0 + pixel[7]))(0) > cb)
-                                                        if((*(cache_0 + pixel[5]))(0) > cb)
-                                                            if((*(cache_0 + 3))(0) > cb)
-                                                                goto success;
-                                                            else
-                                                            if((*(cache_0 + pixel[14]))(0) > cb)
-                                                                goto success;
+                                continue;
+                        else
+                            continue;
+                    else if(cache_0[pixel[8]] < c_b)
+                        if(cache_0[3] > cb)
+                            if(cache_0[-3] < c_b)
+                                if(cache_0[pixel[10]] < c_b)
+                                    if(cache_0[pixel[14]] < c_b)
+                                        if(cache_0[pixel[15]] < c_b)
+                                            if(cache_0[pixel[13]] < c_b)
+                                                if(cache_0[pixel[1]] < c_b)
+                                                    if(cache_0[pixel[11]] < c_b)
+                                                        if(cache_0[pixel[9]] > cb)
+                                                            if(cache_0[pixel[2]] < c_b)
+                                                                if(cache_0[pixel[3]] < c_b)
+                                                                    goto success;
+                                                                else
+                                                                    continue;
                                                             else
                                                                 continue;
+                                                        else if(cache_0[pixel[9]] < c_b)
+                                                            goto success;
                                                         else
-                                                        if((*(cache_0 + pixel[15]))(0) > cb)
-                                                            if((*(cache_0 + pixel[14]))(0) > cb)
+                                                        if(cache_0[pixel[3]] < c_b)
+                                                            if(cache_0[pixel[2]] < c_b)
                                                                 goto success;
                                                             else
                                                                 continue;
@@ -1780,10 +1826,25 @@ namespace feature_detection {
                                                     else
                                                         continue;
                                                 else
-                                                if((*(cache_0 + pixel[3]))(0) > cb)
-                                                    if((*(cache_0 + 3))(0) > cb)
-                                                        if((*(cache_0 + pixel[5]))(0) > cb)
-                                                            if((*(cache_0 + pixel[7]))(0) > cb)
+                                                if(cache_0[pixel[7]] < c_b)
+                                                    if(cache_0[pixel[9]] < c_b)
+                                                        if(cache_0[pixel[11]] < c_b)
+                                                            goto success;
+                                                        else
+                                                            continue;
+                                                    else
+                                                        continue;
+                                                else
+                                                    continue;
+                                            else
+                                                continue;
+                                        else
+                                        if(cache_0[pixel[5]] < c_b)
+                                            if(cache_0[pixel[6]] < c_b)
+                                                if(cache_0[pixel[7]] < c_b)
+                                                    if(cache_0[pixel[9]] < c_b)
+                                                        if(cache_0[pixel[11]] < c_b)
+                                                            if(cache_0[pixel[13]] < c_b)
                                                                 goto success;
                                                             else
                                                                 continue;
@@ -1803,39 +1864,45 @@ namespace feature_detection {
                                     continue;
                             else
                                 continue;
-                        else if((*(cache_0 + pixel[8]))(0) < c_b)
-                            if((*(cache_0 + 3))(0) > cb)
-                                if((*(cache_0 + -3))(0) < c_b)
-                                    if((*(cache_0 + pixel[10]))(0) < c_b)
-                                        if((*(cache_0 + pixel[14]))(0) < c_b)
-                                            if((*(cache_0 + pixel[15]))(0) < c_b)
-                                                if((*(cache_0 + pixel[13]))(0) < c_b)
-                                                    if((*(cache_0 + pixel[1]))(0) < c_b)
-                                                        if((*(cache_0 + pixel[11]))(0) < c_b)
-                                                            if((*(cache_0 + pixel[9]))(0) > cb)
-                                                                if((*(cache_0 + pixel[2]))(0) < c_b)
-                                                                    if((*(cache_0 + pixel[3]))(0) < c_b)
+                        else if(cache_0[3] < c_b)
+                            if(cache_0[pixel[2]] > cb)
+                                if(cache_0[pixel[10]] < c_b)
+                                    if(cache_0[-3] < c_b)
+                                        if(cache_0[pixel[11]] < c_b)
+                                            if(cache_0[pixel[9]] < c_b)
+                                                if(cache_0[pixel[13]] < c_b)
+                                                    if(cache_0[pixel[14]] < c_b)
+                                                        if(cache_0[pixel[7]] < c_b)
+                                                            if(cache_0[pixel[15]] > cb)
+                                                                if(cache_0[pixel[5]] < c_b)
+                                                                    if(cache_0[pixel[6]] < c_b)
                                                                         goto success;
                                                                     else
                                                                         continue;
                                                                 else
                                                                     continue;
-                                                            else if((*(cache_0 + pixel[9]))(0) < c_b)
+                                                            else if(cache_0[pixel[15]] < c_b)
                                                                 goto success;
                                                             else
-                                                            if((*(cache_0 + pixel[3]))(0) < c_b)
-                                                                if((*(cache_0 + pixel[2]))(0) < c_b)
+                                                            if(cache_0[pixel[6]] < c_b)
+                                                                if(cache_0[pixel[5]] < c_b)
                                                                     goto success;
                                                                 else
                                                                     continue;
                                                             else
                                                                 continue;
+                                                        else
+                                                        if(cache_0[pixel[1]] < c_b)
+                                                            if(cache_0[pixel[15]] < c_b)
+                                                                goto success;
+                                                            else
+                                                                continue;
                                                         else
                                                             continue;
                                                     else
-                                                    if((*(cache_0 + pixel[7]))(0) < c_b)
-                                                        if((*(cache_0 + pixel[9]))(0) < c_b)
-                                                            if((*(cache_0 + pixel[11]))(0) < c_b)
+                                                    if(cache_0[pixel[5]] < c_b)
+                                                        if(cache_0[pixel[6]] < c_b)
+                                                            if(cache_0[pixel[7]] < c_b)
                                                                 goto success;
                                                             else
                                                                 continue;
@@ -1844,17 +1911,11 @@ namespace feature_detection {
                                                     else
                                                         continue;
                                                 else
-                                                    continue;
-                                            else
-                                            if((*(cache_0 + pixel[5]))(0) < c_b)
-                                                if((*(cache_0 + pixel[6]))(0) < c_b)
-                                                    if((*(cache_0 + pixel[7]))(0) < c_b)
-                                                        if((*(cache_0 + pixel[9]))(0) < c_b)
-                                                            if((*(cache_0 + pixel[11]))(0) < c_b)
-                                                                if((*(cache_0 + pixel[13]))(0) < c_b)
-                                                                    goto success;
-                                                                else
-                                                                    continue;
+                                                if(cache_0[pixel[3]] < c_b)
+                                                    if(cache_0[pixel[5]] < c_b)
+                                                        if(cache_0[pixel[6]] < c_b)
+                                                            if(cache_0[pixel[7]] < c_b)
+                                                                goto success;
                                                             else
                                                                 continue;
                                                         else
@@ -1871,45 +1932,25 @@ namespace feature_detection {
                                         continue;
                                 else
                                     continue;
-                            else if((*(cache_0 + 3))(0) < c_b)
-                                if((*(cache_0 + pixel[2]))(0) > cb)
-                                    if((*(cache_0 + pixel[10]))(0) < c_b)
-                                        if((*(cache_0 + -3))(0) < c_b)
-                                            if((*(cache_0 + pixel[11]))(0) < c_b)
-                                                if((*(cache_0 + pixel[9]))(0) < c_b)
-                                                    if((*(cache_0 + pixel[13]))(0) < c_b)
-                                                        if((*(cache_0 + pixel[14]))(0) < c_b)
-                                                            if((*(cache_0 + pixel[7]))(0) < c_b)
-                                                                if((*(cache_0 + pixel[15]))(0) > cb)
-                                                                    if((*(cache_0 + pixel[5]))(0) < c_b)
-                                                                        if((*(cache_0 + pixel[6]))(0) < c_b)
-                                                                            goto success;
-                                                                        else
-                                                                            continue;
-                                                                    else
-                                                                        continue;
-                                                                else if((*(cache_0 + pixel[15]))(0) < c_b)
-                                                                    goto success;
-                                                                else
-                                                                if((*(cache_0 + pixel[6]))(0) < c_b)
-                                                                    if((*(cache_0 + pixel[5]))(0) < c_b)
-                                                                        goto success;
-                                                                    else
-                                                                        continue;
-                                                                else
-                                                                    continue;
+                            else if(cache_0[pixel[2]] < c_b)
+                                if(cache_0[pixel[6]] > cb)
+                                    if(cache_0[pixel[13]] < c_b)
+                                        if(cache_0[pixel[14]] < c_b)
+                                            if(cache_0[pixel[15]] < c_b)
+                                                if(cache_0[-3] < c_b)
+                                                    if(cache_0[pixel[1]] < c_b)
+                                                        if(cache_0[pixel[3]] < c_b)
+                                                            if(cache_0[pixel[11]] < c_b)
+                                                                goto success;
                                                             else
-                                                            if((*(cache_0 + pixel[1]))(0) < c_b)
-                                                                if((*(cache_0 + pixel[15]))(0) < c_b)
-                                                                    goto success;
-                                                                else
-                                                                    continue;
+                                                            if(cache_0[pixel[5]] < c_b)
+                                                                goto success;
                                                             else
                                                                 continue;
                                                         else
-                                                        if((*(cache_0 + pixel[5]))(0) < c_b)
-                                                            if((*(cache_0 + pixel[6]))(0) < c_b)
-                                                                if((*(cache_0 + pixel[7]))(0) < c_b)
+                                                        if(cache_0[pixel[9]] < c_b)
+                                                            if(cache_0[pixel[10]] < c_b)
+                                                                if(cache_0[pixel[11]] < c_b)
                                                                     goto success;
                                                                 else
                                                                     continue;
@@ -1918,10 +1959,10 @@ namespace feature_detection {
                                                         else
                                                             continue;
                                                     else
-                                                    if((*(cache_0 + pixel[3]))(0) < c_b)
-                                                        if((*(cache_0 + pixel[5]))(0) < c_b)
-                                                            if((*(cache_0 + pixel[6]))(0) < c_b)
-                                                                if((*(cache_0 + pixel[7]))(0) < c_b)
+                                                    if(cache_0[pixel[7]] < c_b)
+                                                        if(cache_0[pixel[9]] < c_b)
+                                                            if(cache_0[pixel[10]] < c_b)
+                                                                if(cache_0[pixel[11]] < c_b)
                                                                     goto success;
                                                                 else
                                                                     continue;
@@ -1939,37 +1980,28 @@ namespace feature_detection {
                                             continue;
                                     else
                                         continue;
-                                else if((*(cache_0 + pixel[2]))(0) < c_b)
-                                    if((*(cache_0 + pixel[6]))(0) > cb)
-                                        if((*(cache_0 + pixel[13]))(0) < c_b)
-                                            if((*(cache_0 + pixel[14]))(0) < c_b)
-                                                if((*(cache_0 + pixel[15]))(0) < c_b)
-                                                    if((*(cache_0 + -3))(0) < c_b)
-                                                        if((*(cache_0 + pixel[1]))(0) < c_b)
-                                                            if((*(cache_0 + pixel[3]))(0) < c_b)
-                                                                if((*(cache_0 + pixel[11]))(0) < c_b)
+                                else if(cache_0[pixel[6]] < c_b)
+                                    if(cache_0[pixel[3]] > cb)
+                                        if(cache_0[pixel[9]] < c_b)
+                                            if(cache_0[pixel[10]] < c_b)
+                                                if(cache_0[pixel[11]] < c_b)
+                                                    if(cache_0[-3] < c_b)
+                                                        if(cache_0[pixel[13]] < c_b)
+                                                            if(cache_0[pixel[7]] < c_b)
+                                                                if(cache_0[pixel[5]] < c_b)
                                                                     goto success;
                                                                 else
-                                                                if((*(cache_0 + pixel[5]))(0) < c_b)
-                                                                    goto success;
-                                                                else
-                                                                    continue;
-                                                            else
-                                                            if((*(cache_0 + pixel[9]))(0) < c_b)
-                                                                if((*(cache_0 + pixel[10]))(0) < c_b)
-                                                                    if((*(cache_0 + pixel[11]))(0) < c_b)
+                                                                if(cache_0[pixel[14]] < c_b)
+                                                                    if(cache_0[pixel[15]] < c_b)
                                                                         goto success;
                                                                     else
                                                                         continue;
                                                                 else
                                                                     continue;
                                                             else
-                                                                continue;
-                                                        else
-                                                        if((*(cache_0 + pixel[7]))(0) < c_b)
-                                                            if((*(cache_0 + pixel[9]))(0) < c_b)
-                                                                if((*(cache_0 + pixel[10]))(0) < c_b)
-                                                                    if((*(cache_0 + pixel[11]))(0) < c_b)
+                                                            if(cache_0[pixel[1]] < c_b)
+                                                                if(cache_0[pixel[14]] < c_b)
+                                                                    if(cache_0[pixel[15]] < c_b)
                                                                         goto success;
                                                                     else
                                                                         continue;
@@ -1987,28 +2019,19 @@ namespace feature_detection {
                                                 continue;
                                         else
                                             continue;
-                                    else if((*(cache_0 + pixel[6]))(0) < c_b)
-                                        if((*(cache_0 + pixel[3]))(0) > cb)
-                                            if((*(cache_0 + pixel[9]))(0) < c_b)
-                                                if((*(cache_0 + pixel[10]))(0) < c_b)
-                                                    if((*(cache_0 + pixel[11]))(0) < c_b)
-                                                        if((*(cache_0 + -3))(0) < c_b)
-                                                            if((*(cache_0 + pixel[13]))(0) < c_b)
-                                                                if((*(cache_0 + pixel[7]))(0) < c_b)
-                                                                    if((*(cache_0 + pixel[5]))(0) < c_b)
-                                                                        goto success;
-                                                                    else
-                                                                    if((*(cache_0 + pixel[14]))(0) < c_b)
-                                                                        if((*(cache_0 + pixel[15]))(0) < c_b)
-                                                                            goto success;
-                                                                        else
-                                                                            continue;
-                                                                    else
-                                                                        continue;
+                                    else if(cache_0[pixel[3]] < c_b)
+                                        if(cache_0[pixel[5]] > cb)
+                                            if(cache_0[pixel[11]] < c_b)
+                                                if(cache_0[-3] < c_b)
+                                                    if(cache_0[pixel[13]] < c_b)
+                                                        if(cache_0[pixel[14]] < c_b)
+                                                            if(cache_0[pixel[15]] < c_b)
+                                                                if(cache_0[pixel[1]] < c_b)
+                                                                    goto success;
                                                                 else
-                                                                if((*(cache_0 + pixel[1]))(0) < c_b)
-                                                                    if((*(cache_0 + pixel[14]))(0) < c_b)
-                                                                        if((*(cache_0 + pixel[15]))(0) < c_b)
+                                                                if(cache_0[pixel[7]] < c_b)
+                                                                    if(cache_0[pixel[9]] < c_b)
+                                                                        if(cache_0[pixel[10]] < c_b)
                                                                             goto success;
                                                                         else
                                                                             continue;
@@ -2026,28 +2049,13 @@ namespace feature_detection {
                                                     continue;
                                             else
                                                 continue;
-                                        else if((*(cache_0 + pixel[3]))(0) < c_b)
-                                            if((*(cache_0 + pixel[5]))(0) > cb)
-                                                if((*(cache_0 + pixel[11]))(0) < c_b)
-                                                    if((*(cache_0 + -3))(0) < c_b)
-                                                        if((*(cache_0 + pixel[13]))(0) < c_b)
-                                                            if((*(cache_0 + pixel[14]))(0) < c_b)
-                                                                if((*(cache_0 + pixel[15]))(0) < c_b)
-                                                                    if((*(cache_0 + pixel[1]))(0) < c_b)
-                                                                        goto success;
-                                                                    else
-                                                                    if((*(cache_0 + pixel[7]))(0) < c_b)
-                                                                        if((*(cache_0 + pixel[9]))(0) < c_b)
-                                                                            if((*(cache_0 + pixel[10]))(0) < c_b)
-                                                                                goto success;
-                                                                            else
-                                                                                continue;
-                                                                        else
-                                                                            continue;
-                                                                    else
-                                                                        continue;
-                                                                else
-                                                                    continue;
+                                        else if(cache_0[pixel[5]] < c_b)
+                                            if(cache_0[pixel[7]] > cb)
+                                                if(cache_0[pixel[1]] < c_b)
+                                                    if(cache_0[pixel[13]] < c_b)
+                                                        if(cache_0[pixel[14]] < c_b)
+                                                            if(cache_0[pixel[15]] < c_b)
+                                                                goto success;
                                                             else
                                                                 continue;
                                                         else
@@ -2056,60 +2064,31 @@ namespace feature_detection {
                                                         continue;
                                                 else
                                                     continue;
-                                            else if((*(cache_0 + pixel[5]))(0) < c_b)
-                                                if((*(cache_0 + pixel[7]))(0) > cb)
-                                                    if((*(cache_0 + pixel[1]))(0) < c_b)
-                                                        if((*(cache_0 + pixel[13]))(0) < c_b)
-                                                            if((*(cache_0 + pixel[14]))(0) < c_b)
-                                                                if((*(cache_0 + pixel[15]))(0) < c_b)
-                                                                    goto success;
-                                                                else
-                                                                    continue;
+                                            else if(cache_0[pixel[7]] < c_b)
+                                                if(cache_0[pixel[1]] > cb)
+                                                    if(cache_0[pixel[9]] < c_b)
+                                                        if(cache_0[pixel[10]] < c_b)
+                                                            if(cache_0[pixel[11]] < c_b)
+                                                                goto success;
                                                             else
                                                                 continue;
                                                         else
                                                             continue;
                                                     else
                                                         continue;
-                                                else if((*(cache_0 + pixel[7]))(0) < c_b)
-                                                    if((*(cache_0 + pixel[1]))(0) > cb)
-                                                        if((*(cache_0 + pixel[9]))(0) < c_b)
-                                                            if((*(cache_0 + pixel[10]))(0) < c_b)
-                                                                if((*(cache_0 + pixel[11]))(0) < c_b)
-                                                                    goto success;
-                                                                else
-                                                                    continue;
-                                                            else
-                                                                continue;
-                                                        else
-                                                            continue;
-                                                    else if((*(cache_0 + pixel[1]))(0) < c_b)
-                                                        if((*(cache_0 + pixel[9]))(0) < c_b)
-                                                            goto success;
-                                                        else
-                                                        if((*(cache_0 + pixel[15]))(0) < c_b)
-                                                            goto success;
-                                                        else
-                                                            continue;
+                                                else if(cache_0[pixel[1]] < c_b)
+                                                    if(cache_0[pixel[9]] < c_b)
+                                                        goto success;
                                                     else
-                                                    if((*(cache_0 + pixel[11]))(0) < c_b)
-                                                        if((*(cache_0 + pixel[10]))(0) < c_b)
-                                                            if((*(cache_0 + pixel[9]))(0) < c_b)
-                                                                goto success;
-                                                            else
-                                                                continue;
-                                                        else
-                                                            continue;
+                                                    if(cache_0[pixel[15]] < c_b)
+                                                        goto success;
                                                     else
                                                         continue;
                                                 else
-                                                if((*(cache_0 + pixel[13]))(0) < c_b)
-                                                    if((*(cache_0 + pixel[15]))(0) < c_b)
-                                                        if((*(cache_0 + pixel[14]))(0) < c_b)
-                                                            if((*(cache_0 + pixel[1]))(0) < c_b)
-                                                                goto success;
-                                                            else
-                                                                continue;
+                                                if(cache_0[pixel[11]] < c_b)
+                                                    if(cache_0[pixel[10]] < c_b)
+                                                        if(cache_0[pixel[9]] < c_b)
+                                                            goto success;
                                                         else
                                                             continue;
                                                     else
@@ -2117,37 +2096,11 @@ namespace feature_detection {
                                                 else
                                                     continue;
                                             else
-                                            if((*(cache_0 + -3))(0) < c_b)
-                                                if((*(cache_0 + pixel[14]))(0) < c_b)
-                                                    if((*(cache_0 + pixel[11]))(0) < c_b)
-                                                        if((*(cache_0 + pixel[13]))(0) < c_b)
-                                                            if((*(cache_0 + pixel[15]))(0) < c_b)
-                                                                if((*(cache_0 + pixel[1]))(0) > cb)
-                                                                    if((*(cache_0 + pixel[7]))(0) < c_b)
-                                                                        if((*(cache_0 + pixel[9]))(0) < c_b)
-                                                                            if((*(cache_0 + pixel[10]))(0) < c_b)
-                                                                                goto success;
-                                                                            else
-                                                                                continue;
-                                                                        else
-                                                                            continue;
-                                                                    else
-                                                                        continue;
-                                                                else if((*(cache_0 + pixel[1]))(0) < c_b)
-                                                                    goto success;
-                                                                else
-                                                                if((*(cache_0 + pixel[9]))(0) < c_b)
-                                                                    if((*(cache_0 + pixel[7]))(0) < c_b)
-                                                                        if((*(cache_0 + pixel[10]))(0) < c_b)
-                                                                            goto success;
-                                                                        else
-                                                                            continue;
-                                                                    else
-                                                                        continue;
-                                                                else
-                                                                    continue;
-                                                            else
-                                                                continue;
+                                            if(cache_0[pixel[13]] < c_b)
+                                                if(cache_0[pixel[15]] < c_b)
+                                                    if(cache_0[pixel[14]] < c_b)
+                                                        if(cache_0[pixel[1]] < c_b)
+                                                            goto success;
                                                         else
                                                             continue;
                                                     else
@@ -2157,15 +2110,15 @@ namespace feature_detection {
                                             else
                                                 continue;
                                         else
-                                        if((*(cache_0 + pixel[11]))(0) < c_b)
-                                            if((*(cache_0 + pixel[13]))(0) < c_b)
-                                                if((*(cache_0 + pixel[10]))(0) < c_b)
-                                                    if((*(cache_0 + pixel[9]))(0) < c_b)
-                                                        if((*(cache_0 + -3))(0) < c_b)
-                                                            if((*(cache_0 + pixel[7]))(0) > cb)
-                                                                if((*(cache_0 + pixel[1]))(0) < c_b)
-                                                                    if((*(cache_0 + pixel[14]))(0) < c_b)
-                                                                        if((*(cache_0 + pixel[15]))(0) < c_b)
+                                        if(cache_0[-3] < c_b)
+                                            if(cache_0[pixel[14]] < c_b)
+                                                if(cache_0[pixel[11]] < c_b)
+                                                    if(cache_0[pixel[13]] < c_b)
+                                                        if(cache_0[pixel[15]] < c_b)
+                                                            if(cache_0[pixel[1]] > cb)
+                                                                if(cache_0[pixel[7]] < c_b)
+                                                                    if(cache_0[pixel[9]] < c_b)
+                                                                        if(cache_0[pixel[10]] < c_b)
                                                                             goto success;
                                                                         else
                                                                             continue;
@@ -2173,21 +2126,12 @@ namespace feature_detection {
                                                                         continue;
                                                                 else
                                                                     continue;
-                                                            else if((*(cache_0 + pixel[7]))(0) < c_b)
-                                                                if((*(cache_0 + pixel[5]))(0) < c_b)
-                                                                    goto success;
-                                                                else
-                                                                if((*(cache_0 + pixel[14]))(0) < c_b)
-                                                                    if((*(cache_0 + pixel[15]))(0) < c_b)
-                                                                        goto success;
-                                                                    else
-                                                                        continue;
-                                                                else
-                                                                    continue;
+                                                            else if(cache_0[pixel[1]] < c_b)
+                                                                goto success;
                                                             else
-                                                            if((*(cache_0 + pixel[15]))(0) < c_b)
-                                                                if((*(cache_0 + pixel[1]))(0) < c_b)
-                                                                    if((*(cache_0 + pixel[14]))(0) < c_b)
+                                                            if(cache_0[pixel[9]] < c_b)
+                                                                if(cache_0[pixel[7]] < c_b)
+                                                                    if(cache_0[pixel[10]] < c_b)
                                                                         goto success;
                                                                     else
                                                                         continue;
@@ -2206,26 +2150,15 @@ namespace feature_detection {
                                         else
                                             continue;
                                     else
-                                    if((*(cache_0 + -3))(0) < c_b)
-                                        if((*(cache_0 + pixel[14]))(0) < c_b)
-                                            if((*(cache_0 + pixel[15]))(0) < c_b)
-                                                if((*(cache_0 + pixel[13]))(0) < c_b)
-                                                    if((*(cache_0 + pixel[11]))(0) > cb)
-                                                        if((*(cache_0 + pixel[1]))(0) < c_b)
-                                                            if((*(cache_0 + pixel[3]))(0) < c_b)
-                                                                if((*(cache_0 + pixel[5]))(0) < c_b)
-                                                                    goto success;
-                                                                else
-                                                                    continue;
-                                                            else
-                                                                continue;
-                                                        else
-                                                            continue;
-                                                    else if((*(cache_0 + pixel[11]))(0) < c_b)
-                                                        if((*(cache_0 + pixel[1]))(0) > cb)
-                                                            if((*(cache_0 + pixel[7]))(0) < c_b)
-                                                                if((*(cache_0 + pixel[9]))(0) < c_b)
-                                                                    if((*(cache_0 + pixel[10]))(0) < c_b)
+                                    if(cache_0[pixel[11]] < c_b)
+                                        if(cache_0[pixel[13]] < c_b)
+                                            if(cache_0[pixel[10]] < c_b)
+                                                if(cache_0[pixel[9]] < c_b)
+                                                    if(cache_0[-3] < c_b)
+                                                        if(cache_0[pixel[7]] > cb)
+                                                            if(cache_0[pixel[1]] < c_b)
+                                                                if(cache_0[pixel[14]] < c_b)
+                                                                    if(cache_0[pixel[15]] < c_b)
                                                                         goto success;
                                                                     else
                                                                         continue;
@@ -2233,29 +2166,21 @@ namespace feature_detection {
                                                                     continue;
                                                             else
                                                                 continue;
-                                                        else if((*(cache_0 + pixel[1]))(0) < c_b)
-                                                            if((*(cache_0 + pixel[3]))(0) > cb)
-                                                                if((*(cache_0 + pixel[9]))(0) < c_b)
-                                                                    if((*(cache_0 + pixel[10]))(0) < c_b)
-                                                                        goto success;
-                                                                    else
-                                                                        continue;
-                                                                else
-                                                                    continue;
-                                                            else if((*(cache_0 + pixel[3]))(0) < c_b)
+                                                        else if(cache_0[pixel[7]] < c_b)
+                                                            if(cache_0[pixel[5]] < c_b)
                                                                 goto success;
                                                             else
-                                                            if((*(cache_0 + pixel[10]))(0) < c_b)
-                                                                if((*(cache_0 + pixel[9]))(0) < c_b)
+                                                            if(cache_0[pixel[14]] < c_b)
+                                                                if(cache_0[pixel[15]] < c_b)
                                                                     goto success;
                                                                 else
                                                                     continue;
                                                             else
                                                                 continue;
                                                         else
-                                                        if((*(cache_0 + pixel[7]))(0) < c_b)
-                                                            if((*(cache_0 + pixel[10]))(0) < c_b)
-                                                                if((*(cache_0 + pixel[9]))(0) < c_b)
+                                                        if(cache_0[pixel[15]] < c_b)
+                                                            if(cache_0[pixel[1]] < c_b)
+                                                                if(cache_0[pixel[14]] < c_b)
                                                                     goto success;
                                                                 else
                                                                     continue;
@@ -2263,15 +2188,6 @@ namespace feature_detection {
                                                                 continue;
                                                         else
                                                             continue;
-                                                    else
-                                                    if((*(cache_0 + pixel[5]))(0) < c_b)
-                                                        if((*(cache_0 + pixel[3]))(0) < c_b)
-                                                            if((*(cache_0 + pixel[1]))(0) < c_b)
-                                                                goto success;
-                                                            else
-                                                                continue;
-                                                        else
-                                                            continue;
                                                     else
                                                         continue;
                                                 else
@@ -2283,49 +2199,56 @@ namespace feature_detection {
                                     else
                                         continue;
                                 else
-                                if((*(cache_0 + pixel[11]))(0) < c_b)
-                                    if((*(cache_0 + pixel[10]))(0) < c_b)
-                                        if((*(cache_0 + -3))(0) < c_b)
-                                            if((*(cache_0 + pixel[9]))(0) < c_b)
-                                                if((*(cache_0 + pixel[13]))(0) > cb)
-                                                    if((*(cache_0 + pixel[3]))(0) < c_b)
-                                                        if((*(cache_0 + pixel[5]))(0) < c_b)
-                                                            if((*(cache_0 + pixel[6]))(0) < c_b)
-                                                                if((*(cache_0 + pixel[7]))(0) < c_b)
-                                                                    goto success;
-                                                                else
-                                                                    continue;
+                                if(cache_0[-3] < c_b)
+                                    if(cache_0[pixel[14]] < c_b)
+                                        if(cache_0[pixel[15]] < c_b)
+                                            if(cache_0[pixel[13]] < c_b)
+                                                if(cache_0[pixel[11]] > cb)
+                                                    if(cache_0[pixel[1]] < c_b)
+                                                        if(cache_0[pixel[3]] < c_b)
+                                                            if(cache_0[pixel[5]] < c_b)
+                                                                goto success;
                                                             else
                                                                 continue;
                                                         else
                                                             continue;
                                                     else
                                                         continue;
-                                                else if((*(cache_0 + pixel[13]))(0) < c_b)
-                                                    if((*(cache_0 + pixel[7]))(0) < c_b)
-                                                        if((*(cache_0 + pixel[6]))(0) < c_b)
-                                                            if((*(cache_0 + pixel[5]))(0) < c_b)
-                                                                goto success;
+                                                else if(cache_0[pixel[11]] < c_b)
+                                                    if(cache_0[pixel[1]] > cb)
+                                                        if(cache_0[pixel[7]] < c_b)
+                                                            if(cache_0[pixel[9]] < c_b)
+                                                                if(cache_0[pixel[10]] < c_b)
+                                                                    goto success;
+                                                                else
+                                                                    continue;
                                                             else
-                                                            if((*(cache_0 + pixel[14]))(0) < c_b)
-                                                                if((*(cache_0 + pixel[15]))(0) < c_b)
+                                                                continue;
+                                                        else
+                                                            continue;
+                                                    else if(cache_0[pixel[1]] < c_b)
+                                                        if(cache_0[pixel[3]] > cb)
+                                                            if(cache_0[pixel[9]] < c_b)
+                                                                if(cache_0[pixel[10]] < c_b)
                                                                     goto success;
                                                                 else
                                                                     continue;
                                                             else
                                                                 continue;
+                                                        else if(cache_0[pixel[3]] < c_b)
+                                                            goto success;
                                                         else
-                                                        if((*(cache_0 + pixel[14]))(0) < c_b)
-                                                            if((*(cache_0 + pixel[15]))(0) < c_b)
+                                                        if(cache_0[pixel[10]] < c_b)
+                                                            if(cache_0[pixel[9]] < c_b)
                                                                 goto success;
                                                             else
                                                                 continue;
                                                         else
                                                             continue;
                                                     else
-                                                    if((*(cache_0 + pixel[1]))(0) < c_b)
-                                                        if((*(cache_0 + pixel[14]))(0) < c_b)
-                                                            if((*(cache_0 + pixel[15]))(0) < c_b)
+                                                    if(cache_0[pixel[7]] < c_b)
+                                                        if(cache_0[pixel[10]] < c_b)
+                                                            if(cache_0[pixel[9]] < c_b)
                                                                 goto success;
                                                             else
                                                                 continue;
@@ -2334,13 +2257,10 @@ namespace feature_detection {
                                                     else
                                                         continue;
                                                 else
-                                                if((*(cache_0 + pixel[3]))(0) < c_b)
-                                                    if((*(cache_0 + pixel[6]))(0) < c_b)
-                                                        if((*(cache_0 + pixel[7]))(0) < c_b)
-                                                            if((*(cache_0 + pixel[5]))(0) < c_b)
-                                                                goto success;
-                                                            else
-                                                                continue;
+                                                if(cache_0[pixel[5]] < c_b)
+                                                    if(cache_0[pixel[3]] < c_b)
+                                                        if(cache_0[pixel[1]] < c_b)
+                                                            goto success;
                                                         else
                                                             continue;
                                                     else
@@ -2356,50 +2276,62 @@ namespace feature_detection {
                                 else
                                     continue;
                             else
-                            if((*(cache_0 + -3))(0) < c_b)
-                                if((*(cache_0 + pixel[10]))(0) < c_b)
-                                    if((*(cache_0 + pixel[14]))(0) < c_b)
-                                        if((*(cache_0 + pixel[11]))(0) < c_b)
-                                            if((*(cache_0 + pixel[13]))(0) < c_b)
-                                                if((*(cache_0 + pixel[15]))(0) < c_b)
-                                                    if((*(cache_0 + pixel[9]))(0) > cb)
-                                                        if((*(cache_0 + pixel[1]))(0) < c_b)
-                                                            if((*(cache_0 + pixel[2]))(0) < c_b)
-                                                                if((*(cache_0 + pixel[3]))(0) < c_b)
-                                                                    goto success;
-                                                                else
-                                                                    continue;
+                            if(cache_0[pixel[11]] < c_b)
+                                if(cache_0[pixel[10]] < c_b)
+                                    if(cache_0[-3] < c_b)
+                                        if(cache_0[pixel[9]] < c_b)
+                                            if(cache_0[pixel[13]] > cb)
+                                                if(cache_0[pixel[3]] < c_b)
+                                                    if(cache_0[pixel[5]] < c_b)
+                                                        if(cache_0[pixel[6]] < c_b)
+                                                            if(cache_0[pixel[7]] < c_b)
+                                                                goto success;
                                                             else
                                                                 continue;
                                                         else
                                                             continue;
-                                                    else if((*(cache_0 + pixel[9]))(0) < c_b)
-                                                        if((*(cache_0 + pixel[1]))(0) < c_b)
+                                                    else
+                                                        continue;
+                                                else
+                                                    continue;
+                                            else if(cache_0[pixel[13]] < c_b)
+                                                if(cache_0[pixel[7]] < c_b)
+                                                    if(cache_0[pixel[6]] < c_b)
+                                                        if(cache_0[pixel[5]] < c_b)
                                                             goto success;
                                                         else
-                                                        if((*(cache_0 + pixel[7]))(0) < c_b)
+                                                        if(cache_0[pixel[14]] < c_b)
+                                                            if(cache_0[pixel[15]] < c_b)
+                                                                goto success;
+                                                            else
+                                                                continue;
+                                                        else
+                                                            continue;
+                                                    else
+                                                    if(cache_0[pixel[14]] < c_b)
+                                                        if(cache_0[pixel[15]] < c_b)
                                                             goto success;
                                                         else
                                                             continue;
                                                     else
-                                                    if((*(cache_0 + pixel[3]))(0) < c_b)
-                                                        if((*(cache_0 + pixel[2]))(0) < c_b)
-                                                            if((*(cache_0 + pixel[1]))(0) < c_b)
-                                                                goto success;
-                                                            else
-                                                                continue;
+                                                        continue;
+                                                else
+                                                if(cache_0[pixel[1]] < c_b)
+                                                    if(cache_0[pixel[14]] < c_b)
+                                                        if(cache_0[pixel[15]] < c_b)
+                                                            goto success;
                                                         else
                                                             continue;
                                                     else
                                                         continue;
                                                 else
-                                                if((*(cache_0 + pixel[5]))(0) < c_b)
-                                                    if((*(cache_0 + pixel[6]))(0) < c_b)
-                                                        if((*(cache_0 + pixel[7]))(0) < c_b)
-                                                            if((*(cache_0 + pixel[9]))(0) < c_b)
-                                                                goto success;
-                                                            else
-                                                                continue;
+                                                    continue;
+                                            else
+                                            if(cache_0[pixel[3]] < c_b)
+                                                if(cache_0[pixel[6]] < c_b)
+                                                    if(cache_0[pixel[7]] < c_b)
+                                                        if(cache_0[pixel[5]] < c_b)
+                                                            goto success;
                                                         else
                                                             continue;
                                                     else
@@ -2417,36 +2349,78 @@ namespace feature_detection {
                             else
                                 continue;
                         else
-                        if((*(cache_0 + pixel[2]))(0) < c_b)
-                            if((*(cache_0 + -3))(0) > cb)
-                                if((*(cache_0 + pixel[6]))(0) < c_b)
-                                    if((*(cache_0 + pixel[14]))(0) < c_b)
-                                        if((*(cache_0 + pixel[7]))(0) > cb)
-                                            if((*(cache_0 + pixel[1]))(0) < c_b)
-                                                if((*(cache_0 + pixel[3]))(0) < c_b)
-                                                    if((*(cache_0 + 3))(0) < c_b)
-                                                        if((*(cache_0 + pixel[5]))(0) < c_b)
-                                                            if((*(cache_0 + pixel[13]))(0) < c_b)
-                                                                if((*(cache_0 + pixel[15]))(0) < c_b)
-                                                                    goto success;
-                                                                else
-                                                                    continue;
+                        if(cache_0[-3] < c_b)
+                            if(cache_0[pixel[10]] < c_b)
+                                if(cache_0[pixel[14]] < c_b)
+                                    if(cache_0[pixel[11]] < c_b)
+                                        if(cache_0[pixel[13]] < c_b)
+                                            if(cache_0[pixel[15]] < c_b)
+                                                if(cache_0[pixel[9]] > cb)
+                                                    if(cache_0[pixel[1]] < c_b)
+                                                        if(cache_0[pixel[2]] < c_b)
+                                                            if(cache_0[pixel[3]] < c_b)
+                                                                goto success;
                                                             else
                                                                 continue;
                                                         else
                                                             continue;
                                                     else
                                                         continue;
+                                                else if(cache_0[pixel[9]] < c_b)
+                                                    if(cache_0[pixel[1]] < c_b)
+                                                        goto success;
+                                                    else
+                                                    if(cache_0[pixel[7]] < c_b)
+                                                        goto success;
+                                                    else
+                                                        continue;
+                                                else
+                                                if(cache_0[pixel[3]] < c_b)
+                                                    if(cache_0[pixel[2]] < c_b)
+                                                        if(cache_0[pixel[1]] < c_b)
+                                                            goto success;
+                                                        else
+                                                            continue;
+                                                    else
+                                                        continue;
+                                                else
+                                                    continue;
+                                            else
+                                            if(cache_0[pixel[5]] < c_b)
+                                                if(cache_0[pixel[6]] < c_b)
+                                                    if(cache_0[pixel[7]] < c_b)
+                                                        if(cache_0[pixel[9]] < c_b)
+                                                            goto success;
+                                                        else
+                                                            continue;
+                                                    else
+                                                        continue;
                                                 else
                                                     continue;
                                             else
                                                 continue;
-                                        else if((*(cache_0 + pixel[7]))(0) < c_b)
-                                            if((*(cache_0 + 3))(0) < c_b)
-                                                if((*(cache_0 + pixel[5]))(0) < c_b)
-                                                    if((*(cache_0 + pixel[1]))(0) < c_b)
-                                                        if((*(cache_0 + pixel[3]))(0) < c_b)
-                                                            if((*(cache_0 + pixel[15]))(0) < c_b)
+                                        else
+                                            continue;
+                                    else
+                                        continue;
+                                else
+                                    continue;
+                            else
+                                continue;
+                        else
+                            continue;
+                    else
+                    if(cache_0[pixel[2]] < c_b)
+                        if(cache_0[-3] > cb)
+                            if(cache_0[pixel[6]] < c_b)
+                                if(cache_0[pixel[14]] < c_b)
+                                    if(cache_0[pixel[7]] > cb)
+                                        if(cache_0[pixel[1]] < c_b)
+                                            if(cache_0[pixel[3]] < c_b)
+                                                if(cache_0[3] < c_b)
+                                                    if(cache_0[pixel[5]] < c_b)
+                                                        if(cache_0[pixel[13]] < c_b)
+                                                            if(cache_0[pixel[15]] < c_b)
                                                                 goto success;
                                                             else
                                                                 continue;
@@ -2459,15 +2433,32 @@ namespace feature_detection {
                                             else
                                                 continue;
                                         else
-                                        if((*(cache_0 + pixel[13]))(0) < c_b)
-                                            if((*(cache_0 + pixel[1]))(0) < c_b)
-                                                if((*(cache_0 + pixel[3]))(0) < c_b)
-                                                    if((*(cache_0 + 3))(0) < c_b)
-                                                        if((*(cache_0 + pixel[5]))(0) < c_b)
-                                                            if((*(cache_0 + pixel[15]))(0) < c_b)
-                                                                goto success;
-                                                            else
-                                                                continue;
+                                            continue;
+                                    else if(cache_0[pixel[7]] < c_b)
+                                        if(cache_0[3] < c_b)
+                                            if(cache_0[pixel[5]] < c_b)
+                                                if(cache_0[pixel[1]] < c_b)
+                                                    if(cache_0[pixel[3]] < c_b)
+                                                        if(cache_0[pixel[15]] < c_b)
+                                                            goto success;
+                                                        else
+                                                            continue;
+                                                    else
+                                                        continue;
+                                                else
+                                                    continue;
+                                            else
+                                                continue;
+                                        else
+                                            continue;
+                                    else
+                                    if(cache_0[pixel[13]] < c_b)
+                                        if(cache_0[pixel[1]] < c_b)
+                                            if(cache_0[pixel[3]] < c_b)
+                                                if(cache_0[3] < c_b)
+                                                    if(cache_0[pixel[5]] < c_b)
+                                                        if(cache_0[pixel[15]] < c_b)
+                                                            goto success;
                                                         else
                                                             continue;
                                                     else
@@ -2482,18 +2473,18 @@ namespace feature_detection {
                                         continue;
                                 else
                                     continue;
-                            else if((*(cache_0 + -3))(0) < c_b)
-                                if((*(cache_0 + pixel[3]))(0) > cb)
-                                    if((*(cache_0 + pixel[9]))(0) < c_b)
-                                        if((*(cache_0 + pixel[11]))(0) < c_b)
-                                            if((*(cache_0 + pixel[14]))(0) < c_b)
-                                                if((*(cache_0 + pixel[13]))(0) < c_b)
-                                                    if((*(cache_0 + pixel[15]))(0) < c_b)
-                                                        if((*(cache_0 + pixel[1]))(0) < c_b)
-                                                            if((*(cache_0 + pixel[10]))(0) < c_b)
-                                                                goto success;
-                                                            else
-                                                                continue;
+                            else
+                                continue;
+                        else if(cache_0[-3] < c_b)
+                            if(cache_0[pixel[3]] > cb)
+                                if(cache_0[pixel[9]] < c_b)
+                                    if(cache_0[pixel[11]] < c_b)
+                                        if(cache_0[pixel[14]] < c_b)
+                                            if(cache_0[pixel[13]] < c_b)
+                                                if(cache_0[pixel[15]] < c_b)
+                                                    if(cache_0[pixel[1]] < c_b)
+                                                        if(cache_0[pixel[10]] < c_b)
+                                                            goto success;
                                                         else
                                                             continue;
                                                     else
@@ -2506,17 +2497,17 @@ namespace feature_detection {
                                             continue;
                                     else
                                         continue;
-                                else if((*(cache_0 + pixel[3]))(0) < c_b)
-                                    if((*(cache_0 + pixel[14]))(0) < c_b)
-                                        if((*(cache_0 + 3))(0) > cb)
-                                            if((*(cache_0 + pixel[10]))(0) < c_b)
-                                                if((*(cache_0 + pixel[15]))(0) < c_b)
-                                                    if((*(cache_0 + pixel[1]))(0) < c_b)
-                                                        if((*(cache_0 + pixel[11]))(0) < c_b)
-                                                            if((*(cache_0 + pixel[13]))(0) < c_b)
-                                                                goto success;
-                                                            else
-                                                                continue;
+                                else
+                                    continue;
+                            else if(cache_0[pixel[3]] < c_b)
+                                if(cache_0[pixel[14]] < c_b)
+                                    if(cache_0[3] > cb)
+                                        if(cache_0[pixel[10]] < c_b)
+                                            if(cache_0[pixel[15]] < c_b)
+                                                if(cache_0[pixel[1]] < c_b)
+                                                    if(cache_0[pixel[11]] < c_b)
+                                                        if(cache_0[pixel[13]] < c_b)
+                                                            goto success;
                                                         else
                                                             continue;
                                                     else
@@ -2525,35 +2516,35 @@ namespace feature_detection {
                                                     continue;
                                             else
                                                 continue;
-                                        else if((*(cache_0 + 3))(0) < c_b)
-                                            if((*(cache_0 + pixel[15]))(0) < c_b)
-                                                if((*(cache_0 + pixel[1]))(0) < c_b)
-                                                    if((*(cache_0 + pixel[13]))(0) > cb)
-                                                        if((*(cache_0 + pixel[5]))(0) < c_b)
-                                                            if((*(cache_0 + pixel[6]))(0) < c_b)
-                                                                if((*(cache_0 + pixel[7]))(0) < c_b)
-                                                                    goto success;
-                                                                else
-                                                                    continue;
+                                        else
+                                            continue;
+                                    else if(cache_0[3] < c_b)
+                                        if(cache_0[pixel[15]] < c_b)
+                                            if(cache_0[pixel[1]] < c_b)
+                                                if(cache_0[pixel[13]] > cb)
+                                                    if(cache_0[pixel[5]] < c_b)
+                                                        if(cache_0[pixel[6]] < c_b)
+                                                            if(cache_0[pixel[7]] < c_b)
+                                                                goto success;
                                                             else
                                                                 continue;
                                                         else
                                                             continue;
-                                                    else if((*(cache_0 + pixel[13]))(0) < c_b)
-                                                        if((*(cache_0 + pixel[5]))(0) < c_b)
-                                                            goto success;
-                                                        else
-                                                        if((*(cache_0 + pixel[11]))(0) < c_b)
-                                                            goto success;
-                                                        else
-                                                            continue;
                                                     else
-                                                    if((*(cache_0 + pixel[7]))(0) < c_b)
-                                                        if((*(cache_0 + pixel[6]))(0) < c_b)
-                                                            if((*(cache_0 + pixel[5]))(0) < c_b)
-                                                                goto success;
-                                                            else
-                                                                continue;
+                                                        continue;
+                                                else if(cache_0[pixel[13]] < c_b)
+                                                    if(cache_0[pixel[5]] < c_b)
+                                                        goto success;
+                                                    else
+                                                    if(cache_0[pixel[11]] < c_b)
+                                                        goto success;
+                                                    else
+                                                        continue;
+                                                else
+                                                if(cache_0[pixel[7]] < c_b)
+                                                    if(cache_0[pixel[6]] < c_b)
+                                                        if(cache_0[pixel[5]] < c_b)
+                                                            goto success;
                                                         else
                                                             continue;
                                                     else
@@ -2563,14 +2554,14 @@ namespace feature_detection {
                                             else
                                                 continue;
                                         else
-                                        if((*(cache_0 + pixel[10]))(0) < c_b)
-                                            if((*(cache_0 + pixel[11]))(0) < c_b)
-                                                if((*(cache_0 + pixel[15]))(0) < c_b)
-                                                    if((*(cache_0 + pixel[13]))(0) < c_b)
-                                                        if((*(cache_0 + pixel[1]))(0) < c_b)
-                                                            goto success;
-                                                        else
-                                                            continue;
+                                            continue;
+                                    else
+                                    if(cache_0[pixel[10]] < c_b)
+                                        if(cache_0[pixel[11]] < c_b)
+                                            if(cache_0[pixel[15]] < c_b)
+                                                if(cache_0[pixel[13]] < c_b)
+                                                    if(cache_0[pixel[1]] < c_b)
+                                                        goto success;
                                                     else
                                                         continue;
                                                 else
@@ -2582,16 +2573,16 @@ namespace feature_detection {
                                     else
                                         continue;
                                 else
-                                if((*(cache_0 + pixel[9]))(0) < c_b)
-                                    if((*(cache_0 + pixel[10]))(0) < c_b)
-                                        if((*(cache_0 + pixel[14]))(0) < c_b)
-                                            if((*(cache_0 + pixel[11]))(0) < c_b)
-                                                if((*(cache_0 + pixel[15]))(0) < c_b)
-                                                    if((*(cache_0 + pixel[1]))(0) < c_b)
-                                                        if((*(cache_0 + pixel[13]))(0) < c_b)
-                                                            goto success;
-                                                        else
-                                                            continue;
+                                    continue;
+                            else
+                            if(cache_0[pixel[9]] < c_b)
+                                if(cache_0[pixel[10]] < c_b)
+                                    if(cache_0[pixel[14]] < c_b)
+                                        if(cache_0[pixel[11]] < c_b)
+                                            if(cache_0[pixel[15]] < c_b)
+                                                if(cache_0[pixel[1]] < c_b)
+                                                    if(cache_0[pixel[13]] < c_b)
+                                                        goto success;
                                                     else
                                                         continue;
                                                 else
@@ -2605,18 +2596,18 @@ namespace feature_detection {
                                 else
                                     continue;
                             else
-                            if((*(cache_0 + pixel[6]))(0) < c_b)
-                                if((*(cache_0 + pixel[14]))(0) < c_b)
-                                    if((*(cache_0 + 3))(0) < c_b)
-                                        if((*(cache_0 + pixel[13]))(0) > cb)
-                                            if((*(cache_0 + pixel[7]))(0) < c_b)
-                                                if((*(cache_0 + pixel[3]))(0) < c_b)
-                                                    if((*(cache_0 + pixel[1]))(0) < c_b)
-                                                        if((*(cache_0 + pixel[5]))(0) < c_b)
-                                                            if((*(cache_0 + pixel[15]))(0) < c_b)
-                                                                goto success;
-                                                            else
-                                                                continue;
+                                continue;
+                        else
+                        if(cache_0[pixel[6]] < c_b)
+                            if(cache_0[pixel[14]] < c_b)
+                                if(cache_0[3] < c_b)
+                                    if(cache_0[pixel[13]] > cb)
+                                        if(cache_0[pixel[7]] < c_b)
+                                            if(cache_0[pixel[3]] < c_b)
+                                                if(cache_0[pixel[1]] < c_b)
+                                                    if(cache_0[pixel[5]] < c_b)
+                                                        if(cache_0[pixel[15]] < c_b)
+                                                            goto success;
                                                         else
                                                             continue;
                                                     else
@@ -2625,14 +2616,14 @@ namespace feature_detection {
                                                     continue;
                                             else
                                                 continue;
-                                        else if((*(cache_0 + pixel[13]))(0) < c_b)
-                                            if((*(cache_0 + pixel[5]))(0) < c_b)
-                                                if((*(cache_0 + pixel[15]))(0) < c_b)
-                                                    if((*(cache_0 + pixel[1]))(0) < c_b)
-                                                        if((*(cache_0 + pixel[3]))(0) < c_b)
-                                                            goto success;
-                                                        else
-                                                            continue;
+                                        else
+                                            continue;
+                                    else if(cache_0[pixel[13]] < c_b)
+                                        if(cache_0[pixel[5]] < c_b)
+                                            if(cache_0[pixel[15]] < c_b)
+                                                if(cache_0[pixel[1]] < c_b)
+                                                    if(cache_0[pixel[3]] < c_b)
+                                                        goto success;
                                                     else
                                                         continue;
                                                 else
@@ -2640,14 +2631,14 @@ namespace feature_detection {
                                             else
                                                 continue;
                                         else
-                                        if((*(cache_0 + pixel[7]))(0) < c_b)
-                                            if((*(cache_0 + pixel[15]))(0) < c_b)
-                                                if((*(cache_0 + pixel[3]))(0) < c_b)
-                                                    if((*(cache_0 + pixel[5]))(0) < c_b)
-                                                        if((*(cache_0 + pixel[1]))(0) < c_b)
-                                                            goto success;
-                                                        else
-                                                            continue;
+                                            continue;
+                                    else
+                                    if(cache_0[pixel[7]] < c_b)
+                                        if(cache_0[pixel[15]] < c_b)
+                                            if(cache_0[pixel[3]] < c_b)
+                                                if(cache_0[pixel[5]] < c_b)
+                                                    if(cache_0[pixel[1]] < c_b)
+                                                        goto success;
                                                     else
                                                         continue;
                                                 else
@@ -2665,41 +2656,41 @@ namespace feature_detection {
                         else
                             continue;
                     else
-                    if((*(cache_0 + pixel[8]))(0) > cb)
-                        if((*(cache_0 + pixel[10]))(0) > cb)
-                            if((*(cache_0 + 3))(0) > cb)
-                                if((*(cache_0 + pixel[2]))(0) > cb)
-                                    if((*(cache_0 + pixel[6]))(0) > cb)
-                                        if((*(cache_0 + pixel[7]))(0) > cb)
-                                            if((*(cache_0 + pixel[11]))(0) > cb)
-                                                if((*(cache_0 + pixel[9]))(0) > cb)
-                                                    if((*(cache_0 + pixel[5]))(0) > cb)
-                                                        if((*(cache_0 + pixel[3]))(0) > cb)
-                                                            goto success;
-                                                        else if((*(cache_0 + pixel[3]))(0) < c_b)
-                                                            if((*(cache_0 + -3))(0) > cb)
-                                                                if((*(cache_0 + pixel[13]))(0) > cb)
-                                                                    goto success;
-                                                                else
-                                                                    continue;
-                                                            else
-                                                                continue;
-                                                        else
-                                                        if((*(cache_0 + pixel[13]))(0) > cb)
-                                                            if((*(cache_0 + -3))(0) > cb)
+                        continue;
+                else
+                if(cache_0[pixel[8]] > cb)
+                    if(cache_0[pixel[10]] > cb)
+                        if(cache_0[3] > cb)
+                            if(cache_0[pixel[2]] > cb)
+                                if(cache_0[pixel[6]] > cb)
+                                    if(cache_0[pixel[7]] > cb)
+                                        if(cache_0[pixel[11]] > cb)
+                                            if(cache_0[pixel[9]] > cb)
+                                                if(cache_0[pixel[5]] > cb)
+                                                    if(cache_0[pixel[3]] > cb)
+                                                        goto success;
+                                                    else if(cache_0[pixel[3]] < c_b)
+                                                        if(cache_0[-3] > cb)
+                                                            if(cache_0[pixel[13]] > cb)
                                                                 goto success;
                                                             else
                                                                 continue;
                                                         else
                                                             continue;
-                                                    else if((*(cache_0 + pixel[5]))(0) < c_b)
-                                                        if((*(cache_0 + -3))(0) > cb)
-                                                            if((*(cache_0 + pixel[13]))(0) > cb)
-                                                                if((*(cache_0 + pixel[14]))(0) > cb)
-                                                                    if((*(cache_0 + pixel[15]))(0) > cb)
-                                                                        goto success;
-                                                                    else
-                                                                        continue;
+                                                    else
+                                                    if(cache_0[pixel[13]] > cb)
+                                                        if(cache_0[-3] > cb)
+                                                            goto success;
+                                                        else
+                                                            continue;
+                                                    else
+                                                        continue;
+                                                else if(cache_0[pixel[5]] < c_b)
+                                                    if(cache_0[-3] > cb)
+                                                        if(cache_0[pixel[13]] > cb)
+                                                            if(cache_0[pixel[14]] > cb)
+                                                                if(cache_0[pixel[15]] > cb)
+                                                                    goto success;
                                                                 else
                                                                     continue;
                                                             else
@@ -2707,13 +2698,13 @@ namespace feature_detection {
                                                         else
                                                             continue;
                                                     else
-                                                    if((*(cache_0 + pixel[15]))(0) > cb)
-                                                        if((*(cache_0 + pixel[14]))(0) > cb)
-                                                            if((*(cache_0 + -3))(0) > cb)
-                                                                if((*(cache_0 + pixel[13]))(0) > cb)
-                                                                    goto success;
-                                                                else
-                                                                    continue;
+                                                        continue;
+                                                else
+                                                if(cache_0[pixel[15]] > cb)
+                                                    if(cache_0[pixel[14]] > cb)
+                                                        if(cache_0[-3] > cb)
+                                                            if(cache_0[pixel[13]] > cb)
+                                                                goto success;
                                                             else
                                                                 continue;
                                                         else
@@ -2723,13 +2714,13 @@ namespace feature_detection {
                                                 else
                                                     continue;
                                             else
-                                            if((*(cache_0 + pixel[1]))(0) > cb)
-                                                if((*(cache_0 + pixel[3]))(0) > cb)
-                                                    if((*(cache_0 + pixel[5]))(0) > cb)
-                                                        if((*(cache_0 + pixel[9]))(0) > cb)
-                                                            goto success;
-                                                        else
-                                                            continue;
+                                                continue;
+                                        else
+                                        if(cache_0[pixel[1]] > cb)
+                                            if(cache_0[pixel[3]] > cb)
+                                                if(cache_0[pixel[5]] > cb)
+                                                    if(cache_0[pixel[9]] > cb)
+                                                        goto success;
                                                     else
                                                         continue;
                                                 else
@@ -2740,31 +2731,31 @@ namespace feature_detection {
                                             continue;
                                     else
                                         continue;
-                                else if((*(cache_0 + pixel[2]))(0) < c_b)
-                                    if((*(cache_0 + pixel[11]))(0) > cb)
-                                        if((*(cache_0 + -3))(0) > cb)
-                                            if((*(cache_0 + pixel[9]))(0) > cb)
-                                                if((*(cache_0 + pixel[6]))(0) > cb)
-                                                    if((*(cache_0 + pixel[7]))(0) > cb)
-                                                        if((*(cache_0 + pixel[13]))(0) > cb)
-                                                            if((*(cache_0 + pixel[5]))(0) > cb)
-                                                                goto success;
-                                                            else
-                                                            if((*(cache_0 + pixel[14]))(0) > cb)
-                                                                if((*(cache_0 + pixel[15]))(0) > cb)
-                                                                    goto success;
-                                                                else
-                                                                    continue;
-                                                            else
-                                                                continue;
+                                else
+                                    continue;
+                            else if(cache_0[pixel[2]] < c_b)
+                                if(cache_0[pixel[11]] > cb)
+                                    if(cache_0[-3] > cb)
+                                        if(cache_0[pixel[9]] > cb)
+                                            if(cache_0[pixel[6]] > cb)
+                                                if(cache_0[pixel[7]] > cb)
+                                                    if(cache_0[pixel[13]] > cb)
+                                                        if(cache_0[pixel[5]] > cb)
+                                                            goto success;
                                                         else
-                                                        if((*(cache_0 + pixel[3]))(0) > cb)
-                                                            if((*(cache_0 + pixel[5]))(0) > cb)
+                                                        if(cache_0[pixel[14]] > cb)
+                                                            if(cache_0[pixel[15]] > cb)
                                                                 goto success;
                                                             else
                                                                 continue;
                                                         else
                                                             continue;
+                                                    else
+                                                    if(cache_0[pixel[3]] > cb)
+                                                        if(cache_0[pixel[5]] > cb)
+                                                            goto success;
+                                                        else
+                                                            continue;
                                                     else
                                                         continue;
                                                 else
@@ -2776,42 +2767,28 @@ namespace feature_detection {
                                     else
                                         continue;
                                 else
-                                if((*(cache_0 + -3))(0) > cb)
-                                    if((*(cache_0 + pixel[6]))(0) > cb)
-                                        if((*(cache_0 + pixel[11]))(0) > cb)
-                                            if((*(cache_0 + pixel[13]))(0) > cb)
-                                                if((*(cache_0 + pixel[7]))(0) > cb)
-                                                    if((*(cache_0 + pixel[9]))(0) > cb)
-                                                        if((*(cache_0 + pixel[5]))(0) > cb)
-                                                            goto success;
-                                                        else if((*(cache_0 + pixel[5]))(0) < c_b)
-                                                            if((*(cache_0 + pixel[14]))(0) > cb)
-                                                                if((*(cache_0 + pixel[15]))(0) > cb)
-                                                                    goto success;
-                                                                else
-                                                                    continue;
-                                                            else
-                                                                continue;
-                                                        else
-                                                        if((*(cache_0 + pixel[15]))(0) > cb)
-                                                            if((*(cache_0 + pixel[14]))(0) > cb)
+                                    continue;
+                            else
+                            if(cache_0[-3] > cb)
+                                if(cache_0[pixel[6]] > cb)
+                                    if(cache_0[pixel[11]] > cb)
+                                        if(cache_0[pixel[13]] > cb)
+                                            if(cache_0[pixel[7]] > cb)
+                                                if(cache_0[pixel[9]] > cb)
+                                                    if(cache_0[pixel[5]] > cb)
+                                                        goto success;
+                                                    else if(cache_0[pixel[5]] < c_b)
+                                                        if(cache_0[pixel[14]] > cb)
+                                                            if(cache_0[pixel[15]] > cb)
                                                                 goto success;
                                                             else
                                                                 continue;
                                                         else
                                                             continue;
                                                     else
-                                                        continue;
-                                                else
-                                                    continue;
-                                            else if((*(cache_0 + pixel[13]))(0) < c_b)
-                                                if((*(cache_0 + pixel[3]))(0) > cb)
-                                                    if((*(cache_0 + pixel[5]))(0) > cb)
-                                                        if((*(cache_0 + pixel[7]))(0) > cb)
-                                                            if((*(cache_0 + pixel[9]))(0) > cb)
-                                                                goto success;
-                                                            else
-                                                                continue;
+                                                    if(cache_0[pixel[15]] > cb)
+                                                        if(cache_0[pixel[14]] > cb)
+                                                            goto success;
                                                         else
                                                             continue;
                                                     else
@@ -2819,10 +2796,12 @@ namespace feature_detection {
                                                 else
                                                     continue;
                                             else
-                                            if((*(cache_0 + pixel[3]))(0) > cb)
-                                                if((*(cache_0 + pixel[7]))(0) > cb)
-                                                    if((*(cache_0 + pixel[9]))(0) > cb)
-                                                        if((*(cache_0 + pixel[5]))(0) > cb)
+                                                continue;
+                                        else if(cache_0[pixel[13]] < c_b)
+                                            if(cache_0[pixel[3]] > cb)
+                                                if(cache_0[pixel[5]] > cb)
+                                                    if(cache_0[pixel[7]] > cb)
+                                                        if(cache_0[pixel[9]] > cb)
                                                             goto success;
                                                         else
                                                             continue;
@@ -2832,36 +2811,48 @@ namespace feature_detection {
                                                     continue;
                                             else
                                                 continue;
+                                        else
+                                        if(cache_0[pixel[3]] > cb)
+                                            if(cache_0[pixel[7]] > cb)
+                                                if(cache_0[pixel[9]] > cb)
+                                                    if(cache_0[pixel[5]] > cb)
+                                                        goto success;
+                                                    else
+                                                        continue;
+                                                else
+                                                    continue;
+                                            else
+                                                continue;
                                         else
                                             continue;
                                     else
                                         continue;
                                 else
                                     continue;
-                            else if((*(cache_0 + 3))(0) < c_b)
-                                if((*(cache_0 + pixel[6]))(0) > cb)
-                                    if((*(cache_0 + pixel[14]))(0) > cb)
-                                        if((*(cache_0 + pixel[13]))(0) > cb)
-                                            if((*(cache_0 + pixel[7]))(0) > cb)
-                                                if((*(cache_0 + pixel[15]))(0) > cb)
-                                                    if((*(cache_0 + pixel[9]))(0) > cb)
-                                                        if((*(cache_0 + pixel[11]))(0) > cb)
-                                                            if((*(cache_0 + -3))(0) > cb)
-                                                                goto success;
-                                                            else
-                                                                continue;
+                            else
+                                continue;
+                        else if(cache_0[3] < c_b)
+                            if(cache_0[pixel[6]] > cb)
+                                if(cache_0[pixel[14]] > cb)
+                                    if(cache_0[pixel[13]] > cb)
+                                        if(cache_0[pixel[7]] > cb)
+                                            if(cache_0[pixel[15]] > cb)
+                                                if(cache_0[pixel[9]] > cb)
+                                                    if(cache_0[pixel[11]] > cb)
+                                                        if(cache_0[-3] > cb)
+                                                            goto success;
                                                         else
                                                             continue;
                                                     else
                                                         continue;
                                                 else
-                                                if((*(cache_0 + pixel[5]))(0) > cb)
-                                                    if((*(cache_0 + pixel[9]))(0) > cb)
-                                                        if((*(cache_0 + pixel[11]))(0) > cb)
-                                                            if((*(cache_0 + -3))(0) > cb)
-                                                                goto success;
-                                                            else
-                                                                continue;
+                                                    continue;
+                                            else
+                                            if(cache_0[pixel[5]] > cb)
+                                                if(cache_0[pixel[9]] > cb)
+                                                    if(cache_0[pixel[11]] > cb)
+                                                        if(cache_0[-3] > cb)
+                                                            goto success;
                                                         else
                                                             continue;
                                                     else
@@ -2877,32 +2868,32 @@ namespace feature_detection {
                                 else
                                     continue;
                             else
-                            if((*(cache_0 + pixel[14]))(0) > cb)
-                                if((*(cache_0 + pixel[6]))(0) > cb)
-                                    if((*(cache_0 + -3))(0) > cb)
-                                        if((*(cache_0 + pixel[5]))(0) > cb)
-                                            if((*(cache_0 + pixel[11]))(0) > cb)
-                                                if((*(cache_0 + pixel[9]))(0) > cb)
-                                                    if((*(cache_0 + pixel[7]))(0) > cb)
-                                                        if((*(cache_0 + pixel[13]))(0) > cb)
-                                                            goto success;
-                                                        else
-                                                            continue;
+                                continue;
+                        else
+                        if(cache_0[pixel[14]] > cb)
+                            if(cache_0[pixel[6]] > cb)
+                                if(cache_0[-3] > cb)
+                                    if(cache_0[pixel[5]] > cb)
+                                        if(cache_0[pixel[11]] > cb)
+                                            if(cache_0[pixel[9]] > cb)
+                                                if(cache_0[pixel[7]] > cb)
+                                                    if(cache_0[pixel[13]] > cb)
+                                                        goto success;
                                                     else
                                                         continue;
                                                 else
                                                     continue;
                                             else
                                                 continue;
-                                        else if((*(cache_0 + pixel[5]))(0) < c_b)
-                                            if((*(cache_0 + pixel[15]))(0) > cb)
-                                                if((*(cache_0 + pixel[7]))(0) > cb)
-                                                    if((*(cache_0 + pixel[9]))(0) > cb)
-                                                        if((*(cache_0 + pixel[11]))(0) > cb)
-                                                            if((*(cache_0 + pixel[13]))(0) > cb)
-                                                                goto success;
-                                                            else
-                                                                continue;
+                                        else
+                                            continue;
+                                    else if(cache_0[pixel[5]] < c_b)
+                                        if(cache_0[pixel[15]] > cb)
+                                            if(cache_0[pixel[7]] > cb)
+                                                if(cache_0[pixel[9]] > cb)
+                                                    if(cache_0[pixel[11]] > cb)
+                                                        if(cache_0[pixel[13]] > cb)
+                                                            goto success;
                                                         else
                                                             continue;
                                                     else
@@ -2912,14 +2903,14 @@ namespace feature_detection {
                                             else
                                                 continue;
                                         else
-                                        if((*(cache_0 + pixel[15]))(0) > cb)
-                                            if((*(cache_0 + pixel[11]))(0) > cb)
-                                                if((*(cache_0 + pixel[9]))(0) > cb)
-                                                    if((*(cache_0 + pixel[13]))(0) > cb)
-                                                        if((*(cache_0 + pixel[7]))(0) > cb)
-                                                            goto success;
-                                                        else
-                                                            continue;
+                                            continue;
+                                    else
+                                    if(cache_0[pixel[15]] > cb)
+                                        if(cache_0[pixel[11]] > cb)
+                                            if(cache_0[pixel[9]] > cb)
+                                                if(cache_0[pixel[13]] > cb)
+                                                    if(cache_0[pixel[7]] > cb)
+                                                        goto success;
                                                     else
                                                         continue;
                                                 else
@@ -2936,29 +2927,29 @@ namespace feature_detection {
                                 continue;
                         else
                             continue;
-                    else if((*(cache_0 + pixel[8]))(0) < c_b)
-                        if((*(cache_0 + pixel[10]))(0) < c_b)
-                            if((*(cache_0 + 3))(0) > cb)
-                                if((*(cache_0 + pixel[14]))(0) < c_b)
-                                    if((*(cache_0 + pixel[6]))(0) < c_b)
-                                        if((*(cache_0 + -3))(0) < c_b)
-                                            if((*(cache_0 + pixel[9]))(0) < c_b)
-                                                if((*(cache_0 + pixel[11]))(0) < c_b)
-                                                    if((*(cache_0 + pixel[15]))(0) < c_b)
-                                                        if((*(cache_0 + pixel[13]))(0) < c_b)
-                                                            if((*(cache_0 + pixel[7]))(0) < c_b)
-                                                                goto success;
-                                                            else
-                                                                continue;
+                    else
+                        continue;
+                else if(cache_0[pixel[8]] < c_b)
+                    if(cache_0[pixel[10]] < c_b)
+                        if(cache_0[3] > cb)
+                            if(cache_0[pixel[14]] < c_b)
+                                if(cache_0[pixel[6]] < c_b)
+                                    if(cache_0[-3] < c_b)
+                                        if(cache_0[pixel[9]] < c_b)
+                                            if(cache_0[pixel[11]] < c_b)
+                                                if(cache_0[pixel[15]] < c_b)
+                                                    if(cache_0[pixel[13]] < c_b)
+                                                        if(cache_0[pixel[7]] < c_b)
+                                                            goto success;
                                                         else
                                                             continue;
                                                     else
-                                                    if((*(cache_0 + pixel[5]))(0) < c_b)
-                                                        if((*(cache_0 + pixel[7]))(0) < c_b)
-                                                            if((*(cache_0 + pixel[13]))(0) < c_b)
-                                                                goto success;
-                                                            else
-                                                                continue;
+                                                        continue;
+                                                else
+                                                if(cache_0[pixel[5]] < c_b)
+                                                    if(cache_0[pixel[7]] < c_b)
+                                                        if(cache_0[pixel[13]] < c_b)
+                                                            goto success;
                                                         else
                                                             continue;
                                                     else
@@ -2973,19 +2964,19 @@ namespace feature_detection {
                                         continue;
                                 else
                                     continue;
-                            else if((*(cache_0 + 3))(0) < c_b)
-                                if((*(cache_0 + pixel[6]))(0) < c_b)
-                                    if((*(cache_0 + -3))(0) > cb)
-                                        if((*(cache_0 + pixel[2]))(0) < c_b)
-                                            if((*(cache_0 + pixel[1]))(0) > cb)
-                                                if((*(cache_0 + pixel[3]))(0) < c_b)
-                                                    if((*(cache_0 + pixel[5]))(0) < c_b)
-                                                        if((*(cache_0 + pixel[7]))(0) < c_b)
-                                                            if((*(cache_0 + pixel[9]))(0) < c_b)
-                                                                if((*(cache_0 + pixel[11]))(0) < c_b)
-                                                                    goto success;
-                                                                else
-                                                                    continue;
+                            else
+                                continue;
+                        else if(cache_0[3] < c_b)
+                            if(cache_0[pixel[6]] < c_b)
+                                if(cache_0[-3] > cb)
+                                    if(cache_0[pixel[2]] < c_b)
+                                        if(cache_0[pixel[1]] > cb)
+                                            if(cache_0[pixel[3]] < c_b)
+                                                if(cache_0[pixel[5]] < c_b)
+                                                    if(cache_0[pixel[7]] < c_b)
+                                                        if(cache_0[pixel[9]] < c_b)
+                                                            if(cache_0[pixel[11]] < c_b)
+                                                                goto success;
                                                             else
                                                                 continue;
                                                         else
@@ -2994,14 +2985,14 @@ namespace feature_detection {
                                                         continue;
                                                 else
                                                     continue;
-                                            else if((*(cache_0 + pixel[1]))(0) < c_b)
-                                                if((*(cache_0 + pixel[5]))(0) < c_b)
-                                                    if((*(cache_0 + pixel[9]))(0) < c_b)
-                                                        if((*(cache_0 + pixel[3]))(0) < c_b)
-                                                            if((*(cache_0 + pixel[7]))(0) < c_b)
-                                                                goto success;
-                                                            else
-                                                                continue;
+                                            else
+                                                continue;
+                                        else if(cache_0[pixel[1]] < c_b)
+                                            if(cache_0[pixel[5]] < c_b)
+                                                if(cache_0[pixel[9]] < c_b)
+                                                    if(cache_0[pixel[3]] < c_b)
+                                                        if(cache_0[pixel[7]] < c_b)
+                                                            goto success;
                                                         else
                                                             continue;
                                                     else
@@ -3009,14 +3000,14 @@ namespace feature_detection {
                                                 else
                                                     continue;
                                             else
-                                            if((*(cache_0 + pixel[11]))(0) < c_b)
-                                                if((*(cache_0 + pixel[3]))(0) < c_b)
-                                                    if((*(cache_0 + pixel[5]))(0) < c_b)
-                                                        if((*(cache_0 + pixel[7]))(0) < c_b)
-                                                            if((*(cache_0 + pixel[9]))(0) < c_b)
-                                                                goto success;
-                                                            else
-                                                                continue;
+                                                continue;
+                                        else
+                                        if(cache_0[pixel[11]] < c_b)
+                                            if(cache_0[pixel[3]] < c_b)
+                                                if(cache_0[pixel[5]] < c_b)
+                                                    if(cache_0[pixel[7]] < c_b)
+                                                        if(cache_0[pixel[9]] < c_b)
+                                                            goto success;
                                                         else
                                                             continue;
                                                     else
@@ -3027,17 +3018,17 @@ namespace feature_detection {
                                                 continue;
                                         else
                                             continue;
-                                    else if((*(cache_0 + -3))(0) < c_b)
-                                        if((*(cache_0 + pixel[7]))(0) < c_b)
-                                            if((*(cache_0 + pixel[11]))(0) > cb)
-                                                if((*(cache_0 + pixel[1]))(0) < c_b)
-                                                    if((*(cache_0 + pixel[2]))(0) < c_b)
-                                                        if((*(cache_0 + pixel[3]))(0) < c_b)
-                                                            if((*(cache_0 + pixel[5]))(0) < c_b)
-                                                                if((*(cache_0 + pixel[9]))(0) < c_b)
-                                                                    goto success;
-                                                                else
-                                                                    continue;
+                                    else
+                                        continue;
+                                else if(cache_0[-3] < c_b)
+                                    if(cache_0[pixel[7]] < c_b)
+                                        if(cache_0[pixel[11]] > cb)
+                                            if(cache_0[pixel[1]] < c_b)
+                                                if(cache_0[pixel[2]] < c_b)
+                                                    if(cache_0[pixel[3]] < c_b)
+                                                        if(cache_0[pixel[5]] < c_b)
+                                                            if(cache_0[pixel[9]] < c_b)
+                                                                goto success;
                                                             else
                                                                 continue;
                                                         else
@@ -3046,34 +3037,34 @@ namespace feature_detection {
                                                         continue;
                                                 else
                                                     continue;
-                                            else if((*(cache_0 + pixel[11]))(0) < c_b)
-                                                if((*(cache_0 + pixel[9]))(0) < c_b)
-                                                    if((*(cache_0 + pixel[5]))(0) > cb)
-                                                        if((*(cache_0 + pixel[13]))(0) < c_b)
-                                                            if((*(cache_0 + pixel[14]))(0) < c_b)
-                                                                if((*(cache_0 + pixel[15]))(0) < c_b)
-                                                                    goto success;
-                                                                else
-                                                                    continue;
+                                            else
+                                                continue;
+                                        else if(cache_0[pixel[11]] < c_b)
+                                            if(cache_0[pixel[9]] < c_b)
+                                                if(cache_0[pixel[5]] > cb)
+                                                    if(cache_0[pixel[13]] < c_b)
+                                                        if(cache_0[pixel[14]] < c_b)
+                                                            if(cache_0[pixel[15]] < c_b)
+                                                                goto success;
                                                             else
                                                                 continue;
                                                         else
                                                             continue;
-                                                    else if((*(cache_0 + pixel[5]))(0) < c_b)
-                                                        if((*(cache_0 + pixel[13]))(0) < c_b)
-                                                            goto success;
-                                                        else
-                                                        if((*(cache_0 + pixel[3]))(0) < c_b)
-                                                            goto success;
-                                                        else
-                                                            continue;
                                                     else
-                                                    if((*(cache_0 + pixel[15]))(0) < c_b)
-                                                        if((*(cache_0 + pixel[14]))(0) < c_b)
-                                                            if((*(cache_0 + pixel[13]))(0) < c_b)
-                                                                goto success;
-                                                            else
-                                                                continue;
+                                                        continue;
+                                                else if(cache_0[pixel[5]] < c_b)
+                                                    if(cache_0[pixel[13]] < c_b)
+                                                        goto success;
+                                                    else
+                                                    if(cache_0[pixel[3]] < c_b)
+                                                        goto success;
+                                                    else
+                                                        continue;
+                                                else
+                                                if(cache_0[pixel[15]] < c_b)
+                                                    if(cache_0[pixel[14]] < c_b)
+                                                        if(cache_0[pixel[13]] < c_b)
+                                                            goto success;
                                                         else
                                                             continue;
                                                     else
@@ -3081,14 +3072,14 @@ namespace feature_detection {
                                                 else
                                                     continue;
                                             else
-                                            if((*(cache_0 + pixel[1]))(0) < c_b)
-                                                if((*(cache_0 + pixel[2]))(0) < c_b)
-                                                    if((*(cache_0 + pixel[9]))(0) < c_b)
-                                                        if((*(cache_0 + pixel[3]))(0) < c_b)
-                                                            if((*(cache_0 + pixel[5]))(0) < c_b)
-                                                                goto success;
-                                                            else
-                                                                continue;
+                                                continue;
+                                        else
+                                        if(cache_0[pixel[1]] < c_b)
+                                            if(cache_0[pixel[2]] < c_b)
+                                                if(cache_0[pixel[9]] < c_b)
+                                                    if(cache_0[pixel[3]] < c_b)
+                                                        if(cache_0[pixel[5]] < c_b)
+                                                            goto success;
                                                         else
                                                             continue;
                                                     else
@@ -3100,15 +3091,15 @@ namespace feature_detection {
                                         else
                                             continue;
                                     else
-                                    if((*(cache_0 + pixel[2]))(0) < c_b)
-                                        if((*(cache_0 + pixel[1]))(0) < c_b)
-                                            if((*(cache_0 + pixel[3]))(0) < c_b)
-                                                if((*(cache_0 + pixel[7]))(0) < c_b)
-                                                    if((*(cache_0 + pixel[9]))(0) < c_b)
-                                                        if((*(cache_0 + pixel[5]))(0) < c_b)
-                                                            goto success;
-                                                        else
-                                                            continue;
+                                        continue;
+                                else
+                                if(cache_0[pixel[2]] < c_b)
+                                    if(cache_0[pixel[1]] < c_b)
+                                        if(cache_0[pixel[3]] < c_b)
+                                            if(cache_0[pixel[7]] < c_b)
+                                                if(cache_0[pixel[9]] < c_b)
+                                                    if(cache_0[pixel[5]] < c_b)
+                                                        goto success;
                                                     else
                                                         continue;
                                                 else
@@ -3116,14 +3107,14 @@ namespace feature_detection {
                                             else
                                                 continue;
                                         else
-                                        if((*(cache_0 + pixel[11]))(0) < c_b)
-                                            if((*(cache_0 + pixel[3]))(0) < c_b)
-                                                if((*(cache_0 + pixel[5]))(0) < c_b)
-                                                    if((*(cache_0 + pixel[7]))(0) < c_b)
-                                                        if((*(cache_0 + pixel[9]))(0) < c_b)
-                                                            goto success;
-                                                        else
-                                                            continue;
+                                            continue;
+                                    else
+                                    if(cache_0[pixel[11]] < c_b)
+                                        if(cache_0[pixel[3]] < c_b)
+                                            if(cache_0[pixel[5]] < c_b)
+                                                if(cache_0[pixel[7]] < c_b)
+                                                    if(cache_0[pixel[9]] < c_b)
+                                                        goto success;
                                                     else
                                                         continue;
                                                 else
@@ -3137,18 +3128,18 @@ namespace feature_detection {
                                 else
                                     continue;
                             else
-                            if((*(cache_0 + pixel[14]))(0) < c_b)
-                                if((*(cache_0 + pixel[6]))(0) < c_b)
-                                    if((*(cache_0 + -3))(0) < c_b)
-                                        if((*(cache_0 + pixel[5]))(0) > cb)
-                                            if((*(cache_0 + pixel[9]))(0) < c_b)
-                                                if((*(cache_0 + pixel[7]))(0) < c_b)
-                                                    if((*(cache_0 + pixel[11]))(0) < c_b)
-                                                        if((*(cache_0 + pixel[13]))(0) < c_b)
-                                                            if((*(cache_0 + pixel[15]))(0) < c_b)
-                                                                goto success;
-                                                            else
-                                                                continue;
+                                continue;
+                        else
+                        if(cache_0[pixel[14]] < c_b)
+                            if(cache_0[pixel[6]] < c_b)
+                                if(cache_0[-3] < c_b)
+                                    if(cache_0[pixel[5]] > cb)
+                                        if(cache_0[pixel[9]] < c_b)
+                                            if(cache_0[pixel[7]] < c_b)
+                                                if(cache_0[pixel[11]] < c_b)
+                                                    if(cache_0[pixel[13]] < c_b)
+                                                        if(cache_0[pixel[15]] < c_b)
+                                                            goto success;
                                                         else
                                                             continue;
                                                     else
@@ -3157,14 +3148,14 @@ namespace feature_detection {
                                                     continue;
                                             else
                                                 continue;
-                                        else if((*(cache_0 + pixel[5]))(0) < c_b)
-                                            if((*(cache_0 + pixel[13]))(0) < c_b)
-                                                if((*(cache_0 + pixel[11]))(0) < c_b)
-                                                    if((*(cache_0 + pixel[7]))(0) < c_b)
-                                                        if((*(cache_0 + pixel[9]))(0) < c_b)
-                                                            goto success;
-                                                        else
-                                                            continue;
+                                        else
+                                            continue;
+                                    else if(cache_0[pixel[5]] < c_b)
+                                        if(cache_0[pixel[13]] < c_b)
+                                            if(cache_0[pixel[11]] < c_b)
+                                                if(cache_0[pixel[7]] < c_b)
+                                                    if(cache_0[pixel[9]] < c_b)
+                                                        goto success;
                                                     else
                                                         continue;
                                                 else
@@ -3172,14 +3163,14 @@ namespace feature_detection {
                                             else
                                                 continue;
                                         else
-                                        if((*(cache_0 + pixel[15]))(0) < c_b)
-                                            if((*(cache_0 + pixel[13]))(0) < c_b)
-                                                if((*(cache_0 + pixel[7]))(0) < c_b)
-                                                    if((*(cache_0 + pixel[9]))(0) < c_b)
-                                                        if((*(cache_0 + pixel[11]))(0) < c_b)
-                                                            goto success;
-                                                        else
-                                                            continue;
+                                            continue;
+                                    else
+                                    if(cache_0[pixel[15]] < c_b)
+                                        if(cache_0[pixel[13]] < c_b)
+                                            if(cache_0[pixel[7]] < c_b)
+                                                if(cache_0[pixel[9]] < c_b)
+                                                    if(cache_0[pixel[11]] < c_b)
+                                                        goto success;
                                                     else
                                                         continue;
                                                 else
@@ -3198,6 +3189,8 @@ namespace feature_detection {
                             continue;
                     else
                         continue;
+                else
+                    continue;
 
                 success:
                 corners.push_back(fast_xy(static_cast<short>(cache_0-line_min),
@@ -3207,56 +3200,91 @@ namespace feature_detection {
     }
 
 
+    void FastDetector::detectCell(const ImgLevel& level, int u, int v, int L, int thread, Corners& corners) {
+        const int scale = (1 << L);
+        vector<fast_xy> fast_corners;
+        vector<int> scores;
+        int height = level.height / detectCellHeight;
+        int width = level.width / detectCellWidth;
+        const int offset = u * width + v * height * level.stride;
+
+        if(mode_ == FAST_TILED_U8) {
+            // the cell alone, packed and rounded to 8 bit, is all the segment test reads
+            vector<uint8_t>& packed = packed_[thread];
+            packed.resize(width * height);
+            for(int y = 0; y < height; ++y) {
+                const uint16_t* src = level.intensity.data() + offset + y * level.stride;
+                uint8_t* dst = packed.data() + y * width;
+                for(int x = 0; x < width; ++x)
+                    dst[x] = uint8_t((src[x] + PYR_ONE / 2) >> PYR_FRAC_BITS);
+            }
+            fast::detect10(packed.data(), width, height, width, 8, fast_corners);
+            fast::score10(packed.data(), width, fast_corners, scores);
+        }
+        else {
+            fast_corner_detect_10(level.intensity.data() + offset, width, height, level.stride, 8 * PYR_ONE, fast_corners);
+            fast_corner_score_10(level.intensity.data() + offset, level.stride, fast_corners, 8 * PYR_ONE, PYR_ONE, scores);
+        }
+
+        vector<double> nm_corners;
+        fast_nonmax_3x3(fast_corners, scores, nm_corners);
+
+        corners.clear();
+        for (auto it = nm_corners.begin(); it != nm_corners.end(); ++it) {
+            fast_xy xy = fast_corners.at(*it);
+            xy.x += u * width;
+            xy.y += v * height;
+            const int k = static_cast<int>((xy.y * scale) / cell_size_) * grid_n_cols_
+                          + static_cast<int>((xy.x * scale) / cell_size_);
+            if (k > grid_occupancy_.size())
+                continue;
+            if (grid_occupancy_[k])
+                continue;
+            corners.push_back(Corner(xy.x * scale, xy.y * scale, shiTomasiScore(level, xy.x, xy.y), L, 0.0f));
+        }
+    }
+
     void FastDetector::detect(
             cvframePtr_t frame,
             const ImgPyr_t& img_pyr,
             const double detection_threshold,
             features_t& fts)  {
+        frame->preparePyramid();
         Corners corners(grid_n_cols_ * grid_n_rows_, Corner(0,0,detection_threshold,0,0.0f));
         //Corners corners(grid_n_cols_*grid_n_rows_, Corner(0,0,0,0,0.0f));
         bool* cell_ = frame->cell;
-        for(int u = 0; u < detectCellWidth; ++u) {
-            for (int v = 0; v < detectCellHeight; ++v) {
-                if(cell_[u + v * detectCellWidth])
-                    continue;
-                for (int L = 0; L < n_pyr_levels_ - 2; ++L) {
-                    const int scale = (1 << L);
-                    vector<fast_xy> fast_corners;
-                    vector<Eigen::Matrix<double, 3, 1, 0, 3, 1>>::const_iterator img =  img_pyr[L].begin();
-                    int height = frame->getHeight(L) / detectCellHeight;
-                    int width = frame->getWidth(L) /detectCellWidth;
-                    //printf("lens = %u, index = %d\n", img_pyr[L].size(), u * width + v * height * frame->getWidth(L));
-                    img = img + u * width + v * height * frame->getWidth(L);
-                    fast_corner_detect_10(img, width, height, frame->getWidth(L), 8.0, fast_corners);
-                    //printf("a cell over!\n");
-
-                    for (auto &pt : fast_corners) {
-                        pt.x += u * width;
-                        pt.y += v * height;
-                       // printf("x, y = %d, %d", pt.x, pt.y);
-                    }
 
+        // one task per free cell and level, numbered in the order the cells used to be scanned
+        const int n_levels = n_pyr_levels_ - 2;
+        vector<int> tasks;
+        for(int u = 0; u < detectCellWidth; ++u)
+            for (int v = 0; v < detectCellHeight; ++v)
+                if(!cell_[u + v * detectCellWidth])
+                    for (int L = 0; L < n_levels; ++L)
+                        tasks.push_back((u * detectCellHeight + v) * n_levels + L);
 
-                    vector<double> scores, nm_corners;
-                    fast_corner_score_10(img_pyr[L].begin(), frame->getWidth(L), fast_corners, 8, scores);// 20
-                    fast_nonmax_3x3(fast_corners, scores, nm_corners);
-
-                    for (auto it = nm_corners.begin(); it != nm_corners.end(); ++it) {
-                        fast_xy &xy = fast_corners.at(*it);
-                        // printf("fast 1\n");
-                        const int k = static_cast<int>((xy.y * scale) / cell_size_) * grid_n_cols_
-                                      + static_cast<int>((xy.x * scale) / cell_size_);
-                        if (k > grid_occupancy_.size() || k > corners.size())
-                            continue;
-                        if (grid_occupancy_[k])
-                            continue;
-                        const double score = shiTomasiScore(img_pyr[L], frame->getWidth(L), frame->getHeight(L), xy.x,
-                                                            xy.y);
+        vector<Corners> found(tasks.size());
+        auto run = [&](int first, int last, int thread) {
+            for(int t = first; t < last; ++t) {
+                const int L = tasks[t] % n_levels;
+                const int v = tasks[t] / n_levels % detectCellHeight;
+                const int u = tasks[t] / n_levels / detectCellHeight;
+                detectCell(img_pyr[L], u, v, L, thread, found[t]);
+            }
+        };
+        if(mode_ == FAST_SERIAL)
+            run(0, int(tasks.size()), 0);
+        else
+            threadReduce_->reduce(run, 0, int(tasks.size()), 1);
 
-                        if (score > corners.at(k).score)
-                            corners.at(k) = Corner(xy.x * scale, xy.y * scale, score, L, 0.0f);
-                    }
-                }
+        // merged serially in task order, ties keep resolving exactly like the serial scan
+        for(auto& cellCorners : found) {
+            for(auto& c : cellCorners) {
+                const int k = (c.y / cell_size_) * grid_n_cols_ + c.x / cell_size_;
+                if (k > corners.size())
+                    continue;
+                if (c.score > corners.at(k).score)
+                    corners.at(k) = c;
             }
         }
         int gridWidth = frame->getWidth() / (detectWidthGrid * detectCellWidth);
@@ -3265,7 +3293,7 @@ namespace feature_detection {
         // Create feature for every corner that has high enough corner score
         std::for_each(corners.begin(), corners.end(), [&](Corner& c) {
             if(c.score > detection_threshold) {
-                fts.push_back(std::shared_ptr<Feature>(new Feature(frame, Vector2d(c.x, c.y), c.level)));
+                fts.push_back(makeFeature(frame, Vector2d(c.x, c.y), c.level));
                 int gridx = c.x / gridWidth;
                 int gridy = c.y / gridHeight;
                 frame->occupy[gridx + gridy * detectWidthGrid  * detectCellWidth] = true;
@@ -3275,14 +3303,16 @@ namespace feature_detection {
         resetGrid();
     }
 
-    inline double fast_corner_score(cvData::Img_t::const_iterator cache_0, const int offset[], double b) {
-        b += 1.0;
+    // on the Q8 planes the minimal threshold step is PYR_ONE rather than 1
+    template<typename Pixel>
+    inline int fast_corner_score(const Pixel* cache_0, const int offset[], int b, const int one) {
+        b += one;
 
         for(;;)
         {
-            double cb = (*cache_0)(0) + b;
-            double c_b= (*cache_0)(0) - b;
-            double min_diff = double(INT_MAX);
+            int cb = *cache_0 + b;
+            int c_b= *cache_0 - b;
+            int min_diff = INT_MAX;
             if(test_gt_set(*(cache_0 + offset[0]), cb, min_diff))
                 if(test_gt_set(*(cache_0 + offset[8]), cb, min_diff))
                     if(test_gt_set(*(cache_0 + offset[3]), cb, min_diff))
@@ -6398,12 +6428,13 @@ namespace feature_detection {
 
         }
 
-        return b-1;
+        return b - one;
     }
 
-    void FastDetector::fast_corner_score_10(cvData::Img_t::const_iterator img, const int img_stride,
-                                            const std::vector<fast_xy> &corners, const double threshold,
-                                            std::vector<double> &scores){
+    template<typename Pixel>
+    void FastDetector::fast_corner_score_10(const Pixel* img, const int img_stride,
+                                            const std::vector<fast_xy> &corners, const int threshold,
+                                            const int one, std::vector<int> &scores){
         scores.resize(corners.size());
         int pixel[16] = {
                 0 + img_stride * 3,
@@ -6424,11 +6455,11 @@ namespace feature_detection {
                 -1 + img_stride * 3,
         };
         for(unsigned int n=0; n < corners.size(); n++) {
-            scores[n] = fast_corner_score(img + corners[n].y * img_stride + corners[n].x, pixel, threshold);
+            scores[n] = fast_corner_score(img + corners[n].y * img_stride + corners[n].x, pixel, threshold, one);
         }
     }
 
-    void FastDetector::fast_nonmax_3x3(const std::vector<fast_xy> &corners, const std::vector<double> &scores,
+    void FastDetector::fast_nonmax_3x3(const std::vector<fast_xy> &corners, const std::vector<int> &scores,
                                        std::vector<double> &nonmax_corners){
         nonmax_corners.clear();
         nonmax_corners.reserve(corners.size());
@@ -6461,7 +6492,7 @@ namespace feature_detection {
 
         for(int i=0; i < sz; i++)
         {
-            double score = scores[i];
+            int score = scores[i];
             fast_xy pos = corners[i];
 
             //Check left
@@ -6521,4 +6552,10 @@ namespace feature_detection {
             ;
         }
     }
+
+    // the 8-bit trees stay available as reference for the kernels of FastKernel.h
+    template void FastDetector::fast_corner_detect_10<uint8_t>(const uint8_t*, int, int, int, int,
+                                                               std::vector<fast_xy>&);
+    template void FastDetector::fast_corner_score_10<uint8_t>(const uint8_t*, const int, const std::vector<fast_xy>&,
+                                                              const int, const int, std::vector<int>&);
 }
@@ -6,23 +6,37 @@
 #define SIMPLE_VIO_FASTDETECTOR_H
 
 
+#include <memory>
 #include "AbstractDetector.h"
+#include "FastKernel.h"
 
+class ThreadReduce;
 
 namespace feature_detection {
 
     class FastDetector : public AbstractDetector {
     public:
         friend class Detector;
+
+        enum DetectMode {
+            FAST_SERIAL,        //!< cells and levels one after the other
+            FAST_TILED,         //!< cells and levels as tasks of a thread pool, same corners as FAST_SERIAL
+            FAST_TILED_U8       //!< FAST_TILED on cells repacked to uint8 with the SIMD kernels of FastKernel.h
+        };
+
     public:
         FastDetector(
                 const int img_width,
                 const int img_height,
                 const int cell_size,
-                const int n_pyr_levels);
+                const int n_pyr_levels,
+                DetectMode mode = FAST_TILED);
 
         virtual ~FastDetector() {}
 
+        void setDetectMode(DetectMode mode) { mode_ = mode; }
+        DetectMode getDetectMode() const { return mode_; }
+
         virtual void detect(
                 cvframePtr_t frame,
                 const ImgPyr_t& img_pyr,
@@ -30,20 +44,29 @@ namespace feature_detection {
                 features_t& fts);
 
     protected:
-        struct fast_xy {
-            short x, y;
-            fast_xy(short x_, short y_) : x(x_), y(y_) {}
-        };
+        typedef fast::xy fast_xy;
+
+        /// corners of one cell on one level, scored with shiTomasiScore and already in level 0 coordinates.
+        void detectCell(const ImgLevel& level, int u, int v, int L, int thread, Corners& corners);
 
-        void fast_corner_detect_10(std::vector<Eigen::Matrix<double, 3, 1, 0, 3, 1>>::const_iterator& img, int imgWidth, int imgHeight,
-                                   int img_stride, double barrier, std::vector<fast_xy>& corners);
+        template<typename Pixel>
+        void fast_corner_detect_10(const Pixel* img, int imgWidth, int imgHeight,
+                                   int img_stride, int barrier, std::vector<fast_xy>& corners);
 
-        void fast_corner_score_10(cvData::Img_t::const_iterator img, const int img_stride,
-                                  const std::vector<fast_xy>& corners, const double threshold, std::vector<double>& scores);
+        /// one is the smallest intensity step, PYR_ONE on the Q8 planes and 1 on uint8.
+        template<typename Pixel>
+        void fast_corner_score_10(const Pixel* img, const int img_stride,
+                                  const std::vector<fast_xy>& corners, const int threshold, const int one,
+                                  std::vector<int>& scores);
 
         void fast_nonmax_3x3(const std::vector<fast_xy>& corners,
-                             const std::vector<double>& scores,
+                             const std::vector<int>& scores,
                              std::vector<double>& nonmax_corners);
+
+    private:
+        DetectMode                              mode_;
+        std::shared_ptr<ThreadReduce>           threadReduce_;
+        std::vector<std::vector<uint8_t>>       packed_;        //!< FAST_TILED_U8 cell buffer of each worker
     };
 }
 
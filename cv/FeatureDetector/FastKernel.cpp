@@ -0,0 +1,308 @@
+#include <algorithm>
+
+#include "FastKernel.h"
+
+namespace fast {
+
+    typedef void (*DetectRow_t)(const uint8_t* row, const int offset[], int begin, int end, int barrier,
+                                short y, std::vector<xy>& corners);
+    typedef void (*Score_t)(const uint8_t* img, int stride, const int offset[], const xy* corners, int n, int* scores);
+
+    struct Kernels {
+        DetectRow_t detect;
+        Score_t     score;
+    };
+
+    //! the circle of radius 3 in the order of FastDetector, contiguous around the ring
+    static const int circleX[16] = {0, 1, 2, 3, 3,  3,  2,  1,  0, -1, -2, -3, -3, -3, -2, -1};
+    static const int circleY[16] = {3, 3, 2, 1, 0, -1, -2, -3, -3, -3, -2, -1,  0,  1,  2,  3};
+
+    /////////////////////////////////////////// scalar ///////////////////////////////////////////
+
+    //! true when 10 contiguous bits of the 16-bit ring are set
+    static inline bool hasArc10(unsigned ring) {
+        unsigned m = ring | (ring << 16);
+        unsigned r = m;
+        for(int k = 1; k < 10; ++k)
+            r &= m >> k;
+        return (r & 0xFFFF) != 0;
+    }
+
+    static void detectRowScalar(const uint8_t* row, const int offset[], int begin, int end, int barrier,
+                                short y, std::vector<xy>& corners) {
+        for(int x = begin; x < end; ++x) {
+            const uint8_t* p = row + x;
+            const int cb = *p + barrier;
+            const int c_b = *p - barrier;
+            unsigned bright = 0, dark = 0;
+            for(int k = 0; k < 16; ++k) {
+                bright |= unsigned(p[offset[k]] > cb) << k;
+                dark   |= unsigned(p[offset[k]] < c_b) << k;
+            }
+            if(hasArc10(bright) || hasArc10(dark))
+                corners.push_back(xy(short(x), y));
+        }
+    }
+
+    //! max over the 16 arcs of 10 of the smallest difference along the arc, for both polarities, minus one
+    static inline int scoreOf(const int d[16]) {
+        int best = -255;
+        for(int k = 0; k < 16; ++k) {
+            int lo = 255, hi = -255;
+            for(int q = 0; q < 10; ++q) {
+                lo = std::min(lo, d[(k + q) & 15]);
+                hi = std::max(hi, d[(k + q) & 15]);
+            }
+            best = std::max(best, std::max(lo, -hi));
+        }
+        return best - 1;
+    }
+
+    static void scoreScalar(const uint8_t* img, int stride, const int offset[], const xy* corners, int n, int* scores) {
+        int d[16];
+        for(int i = 0; i < n; ++i) {
+            const uint8_t* p = img + corners[i].y * stride + corners[i].x;
+            for(int k = 0; k < 16; ++k)
+                d[k] = int(p[offset[k]]) - int(*p);
+            scores[i] = scoreOf(d);
+        }
+    }
+
+#if SIMPLE_VIO_X86_SIMD
+    //////////////////////////////////////////// SSE4 ////////////////////////////////////////////
+    // x > p + t  <=>  subs(x, adds(p, t)) != 0 and x < p - t  <=>  subs(subs(p, t), x) != 0, the saturation
+    // is exact since no 8-bit pixel can pass a bound clamped to 0 or 255. runs are counted per byte lane.
+
+    SIMD_TARGET_SSE4 static void detectRowSSE4(const uint8_t* row, const int offset[], int begin, int end, int barrier,
+                                               short y, std::vector<xy>& corners) {
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i ones = _mm_set1_epi8(-1);
+        const __m128i nine = _mm_set1_epi8(9);
+        const __m128i t    = _mm_set1_epi8(char(std::min(barrier, 255)));
+
+        int x = begin;
+        for(; x + 16 <= end; x += 16) {
+            const uint8_t* p = row + x;
+            const __m128i c  = _mm_loadu_si128((const __m128i*)p);
+            const __m128i hi = _mm_adds_epu8(c, t);
+            const __m128i lo = _mm_subs_epu8(c, t);
+
+            __m128i bright[16], dark[16];
+            for(int k = 0; k < 16; ++k) {
+                const __m128i v = _mm_loadu_si128((const __m128i*)(p + offset[k]));
+                bright[k] = _mm_xor_si128(_mm_cmpeq_epi8(_mm_subs_epu8(v, hi), zero), ones);
+                dark[k]   = _mm_xor_si128(_mm_cmpeq_epi8(_mm_subs_epu8(lo, v), zero), ones);
+            }
+
+            // an arc of 10 covers two neighbouring compass pixels
+            __m128i any = _mm_or_si128(
+                    _mm_or_si128(_mm_and_si128(bright[0], bright[4]), _mm_and_si128(bright[4], bright[8])),
+                    _mm_or_si128(_mm_and_si128(bright[8], bright[12]), _mm_and_si128(bright[12], bright[0])));
+            any = _mm_or_si128(any, _mm_or_si128(
+                    _mm_or_si128(_mm_and_si128(dark[0], dark[4]), _mm_and_si128(dark[4], dark[8])),
+                    _mm_or_si128(_mm_and_si128(dark[8], dark[12]), _mm_and_si128(dark[12], dark[0]))));
+            if(_mm_movemask_epi8(any) == 0)
+                continue;
+
+            __m128i runB = zero, runD = zero, maxB = zero, maxD = zero;
+            for(int k = 0; k < 25; ++k) {
+                runB = _mm_and_si128(_mm_sub_epi8(runB, ones), bright[k & 15]);
+                runD = _mm_and_si128(_mm_sub_epi8(runD, ones), dark[k & 15]);
+                maxB = _mm_max_epu8(maxB, runB);
+                maxD = _mm_max_epu8(maxD, runD);
+            }
+            unsigned mask = unsigned(_mm_movemask_epi8(
+                    _mm_or_si128(_mm_cmpgt_epi8(maxB, nine), _mm_cmpgt_epi8(maxD, nine))));
+            while(mask) {
+                const int i = __builtin_ctz(mask);
+                corners.push_back(xy(short(x + i), y));
+                mask &= mask - 1;
+            }
+        }
+        detectRowScalar(row, offset, x, end, barrier, y, corners);
+    }
+
+    //! eight corners per call, one int16 lane each
+    SIMD_TARGET_SSE4 static void scoreSSE4(const uint8_t* img, int stride, const int offset[], const xy* corners, int n,
+                                           int* scores) {
+        alignas(16) int16_t ring[16][8];
+        alignas(16) int16_t out[8];
+        const __m128i one = _mm_set1_epi16(1);
+
+        int i = 0;
+        for(; i + 8 <= n; i += 8) {
+            for(int l = 0; l < 8; ++l) {
+                const uint8_t* p = img + corners[i + l].y * stride + corners[i + l].x;
+                for(int k = 0; k < 16; ++k)
+                    ring[k][l] = int16_t(int(p[offset[k]]) - int(*p));
+            }
+
+            __m128i d[16], lo2[16], hi2[16], lo4[16], hi4[16], lo8[16], hi8[16];
+            for(int k = 0; k < 16; ++k)
+                d[k] = _mm_load_si128((const __m128i*)ring[k]);
+            for(int k = 0; k < 16; ++k) {
+                lo2[k] = _mm_min_epi16(d[k], d[(k + 1) & 15]);
+                hi2[k] = _mm_max_epi16(d[k], d[(k + 1) & 15]);
+            }
+            for(int k = 0; k < 16; ++k) {
+                lo4[k] = _mm_min_epi16(lo2[k], lo2[(k + 2) & 15]);
+                hi4[k] = _mm_max_epi16(hi2[k], hi2[(k + 2) & 15]);
+            }
+            for(int k = 0; k < 16; ++k) {
+                lo8[k] = _mm_min_epi16(lo4[k], lo4[(k + 4) & 15]);
+                hi8[k] = _mm_max_epi16(hi4[k], hi4[(k + 4) & 15]);
+            }
+            __m128i best = _mm_set1_epi16(-255);
+            for(int k = 0; k < 16; ++k) {
+                const __m128i lo10 = _mm_min_epi16(lo8[k], lo2[(k + 8) & 15]);
+                const __m128i hi10 = _mm_max_epi16(hi8[k], hi2[(k + 8) & 15]);
+                best = _mm_max_epi16(best, _mm_max_epi16(lo10, _mm_sub_epi16(_mm_setzero_si128(), hi10)));
+            }
+            _mm_store_si128((__m128i*)out, _mm_sub_epi16(best, one));
+            for(int l = 0; l < 8; ++l)
+                scores[i + l] = out[l];
+        }
+        scoreScalar(img, stride, offset, corners + i, n - i, scores + i);
+    }
+
+    //////////////////////////////////////////// AVX2 ////////////////////////////////////////////
+
+    SIMD_TARGET_AVX2 static void detectRowAVX2(const uint8_t* row, const int offset[], int begin, int end, int barrier,
+                                               short y, std::vector<xy>& corners) {
+        const __m256i zero = _mm256_setzero_si256();
+        const __m256i ones = _mm256_set1_epi8(-1);
+        const __m256i nine = _mm256_set1_epi8(9);
+        const __m256i t    = _mm256_set1_epi8(char(std::min(barrier, 255)));
+
+        int x = begin;
+        for(; x + 32 <= end; x += 32) {
+            const uint8_t* p = row + x;
+            const __m256i c  = _mm256_loadu_si256((const __m256i*)p);
+            const __m256i hi = _mm256_adds_epu8(c, t);
+            const __m256i lo = _mm256_subs_epu8(c, t);
+
+            __m256i bright[16], dark[16];
+            for(int k = 0; k < 16; ++k) {
+                const __m256i v = _mm256_loadu_si256((const __m256i*)(p + offset[k]));
+                bright[k] = _mm256_xor_si256(_mm256_cmpeq_epi8(_mm256_subs_epu8(v, hi), zero), ones);
+                dark[k]   = _mm256_xor_si256(_mm256_cmpeq_epi8(_mm256_subs_epu8(lo, v), zero), ones);
+            }
+
+            __m256i any = _mm256_or_si256(
+                    _mm256_or_si256(_mm256_and_si256(bright[0], bright[4]), _mm256_and_si256(bright[4], bright[8])),
+                    _mm256_or_si256(_mm256_and_si256(bright[8], bright[12]), _mm256_and_si256(bright[12], bright[0])));
+            any = _mm256_or_si256(any, _mm256_or_si256(
+                    _mm256_or_si256(_mm256_and_si256(dark[0], dark[4]), _mm256_and_si256(dark[4], dark[8])),
+                    _mm256_or_si256(_mm256_and_si256(dark[8], dark[12]), _mm256_and_si256(dark[12], dark[0]))));
+            if(_mm256_movemask_epi8(any) == 0)
+                continue;
+
+            __m256i runB = zero, runD = zero, maxB = zero, maxD = zero;
+            for(int k = 0; k < 25; ++k) {
+                runB = _mm256_and_si256(_mm256_sub_epi8(runB, ones), bright[k & 15]);
+                runD = _mm256_and_si256(_mm256_sub_epi8(runD, ones), dark[k & 15]);
+                maxB = _mm256_max_epu8(maxB, runB);
+                maxD = _mm256_max_epu8(maxD, runD);
+            }
+            unsigned mask = unsigned(_mm256_movemask_epi8(
+                    _mm256_or_si256(_mm256_cmpgt_epi8(maxB, nine), _mm256_cmpgt_epi8(maxD, nine))));
+            while(mask) {
+                const int i = __builtin_ctz(mask);
+                corners.push_back(xy(short(x + i), y));
+                mask &= mask - 1;
+            }
+        }
+        detectRowScalar(row, offset, x, end, barrier, y, corners);
+    }
+
+    //! sixteen corners per call
+    SIMD_TARGET_AVX2 static void scoreAVX2(const uint8_t* img, int stride, const int offset[], const xy* corners, int n,
+                                           int* scores) {
+        alignas(32) int16_t ring[16][16];
+        alignas(32) int16_t out[16];
+        const __m256i one = _mm256_set1_epi16(1);
+
+        int i = 0;
+        for(; i + 16 <= n; i += 16) {
+            for(int l = 0; l < 16; ++l) {
+                const uint8_t* p = img + corners[i + l].y * stride + corners[i + l].x;
+                for(int k = 0; k < 16; ++k)
+                    ring[k][l] = int16_t(int(p[offset[k]]) - int(*p));
+            }
+
+            __m256i d[16], lo2[16], hi2[16], lo4[16], hi4[16], lo8[16], hi8[16];
+            for(int k = 0; k < 16; ++k)
+                d[k] = _mm256_load_si256((const __m256i*)ring[k]);
+            for(int k = 0; k < 16; ++k) {
+                lo2[k] = _mm256_min_epi16(d[k], d[(k + 1) & 15]);
+                hi2[k] = _mm256_max_epi16(d[k], d[(k + 1) & 15]);
+            }
+            for(int k = 0; k < 16; ++k) {
+                lo4[k] = _mm256_min_epi16(lo2[k], lo2[(k + 2) & 15]);
+                hi4[k] = _mm256_max_epi16(hi2[k], hi2[(k + 2) & 15]);
+            }
+            for(int k = 0; k < 16; ++k) {
+                lo8[k] = _mm256_min_epi16(lo4[k], lo4[(k + 4) & 15]);
+                hi8[k] = _mm256_max_epi16(hi4[k], hi4[(k + 4) & 15]);
+            }
+            __m256i best = _mm256_set1_epi16(-255);
+            for(int k = 0; k < 16; ++k) {
+                const __m256i lo10 = _mm256_min_epi16(lo8[k], lo2[(k + 8) & 15]);
+                const __m256i hi10 = _mm256_max_epi16(hi8[k], hi2[(k + 8) & 15]);
+                best = _mm256_max_epi16(best, _mm256_max_epi16(lo10, _mm256_sub_epi16(_mm256_setzero_si256(), hi10)));
+            }
+            _mm256_store_si256((__m256i*)out, _mm256_sub_epi16(best, one));
+            for(int l = 0; l < 16; ++l)
+                scores[i + l] = out[l];
+        }
+        scoreScalar(img, stride, offset, corners + i, n - i, scores + i);
+    }
+#endif
+
+    static Kernels kernelsOf(simd::InstructionSet set) {
+#if SIMPLE_VIO_X86_SIMD
+        if(set == simd::AVX2) {
+            Kernels k = {detectRowAVX2, scoreAVX2};
+            return k;
+        }
+        if(set == simd::SSE4) {
+            Kernels k = {detectRowSSE4, scoreSSE4};
+            return k;
+        }
+#endif
+        Kernels k = {detectRowScalar, scoreScalar};
+        return k;
+    }
+
+    static simd::InstructionSet instructionSet = simd::detect();
+    static Kernels kernels = kernelsOf(instructionSet);
+
+    void setInstructionSet(simd::InstructionSet set) {
+        instructionSet = set > simd::detect() ? simd::detect() : set;
+        kernels = kernelsOf(instructionSet);
+    }
+
+    simd::InstructionSet getInstructionSet() {
+        return instructionSet;
+    }
+
+    static inline void circleOffsets(int stride, int offset[16]) {
+        for(int k = 0; k < 16; ++k)
+            offset[k] = circleX[k] + circleY[k] * stride;
+    }
+
+    void detect10(const uint8_t* img, int width, int height, int stride, int barrier, std::vector<xy>& corners) {
+        int offset[16];
+        circleOffsets(stride, offset);
+        for(int y = 3; y < height - 3; ++y)
+            kernels.detect(img + y * stride, offset, 3, width - 3, barrier, short(y), corners);
+    }
+
+    void score10(const uint8_t* img, int stride, const std::vector<xy>& corners, std::vector<int>& scores) {
+        int offset[16];
+        circleOffsets(stride, offset);
+        scores.resize(corners.size());
+        if(!corners.empty())
+            kernels.score(img, stride, offset, corners.data(), int(corners.size()), scores.data());
+    }
+}
@@ -0,0 +1,29 @@
+#ifndef SIMPLE_VIO_FASTKERNEL_H
+#define SIMPLE_VIO_FASTKERNEL_H
+
+#include <cstdint>
+#include <vector>
+
+#include "util/simd.h"
+
+namespace fast {
+
+    struct xy {
+        short x, y;
+        xy(short x_, short y_) : x(x_), y(y_) {}
+    };
+
+    /// force a kernel set (benchmarks and tests), an unsupported set falls back to the best available one.
+    void setInstructionSet(simd::InstructionSet set);
+    simd::InstructionSet getInstructionSet();
+
+    /// plain FAST-10 segment test on a packed 8-bit image, corners in raster order: 10 contiguous pixels of the
+    /// radius 3 circle brighter than p + barrier or darker than p - barrier. the same corners as the decision tree
+    /// of FastDetector at the same barrier.
+    void detect10(const uint8_t* img, int width, int height, int stride, int barrier, std::vector<xy>& corners);
+
+    /// score of every corner under the same segment test: the largest barrier it still passes.
+    void score10(const uint8_t* img, int stride, const std::vector<xy>& corners, std::vector<int>& scores);
+}
+
+#endif //SIMPLE_VIO_FASTKERNEL_H
@@ -0,0 +1,72 @@
+#ifndef SIMPLE_VIO_DETECTORTEST_H
+#define SIMPLE_VIO_DETECTORTEST_H
+
+#include <cstdio>
+#include <cstdint>
+#include <memory>
+#include "opencv2/ts/ts.hpp"
+
+#include "DataStructure/cv/cvFrame.h"
+#include "DataStructure/cv/Feature.h"
+#include "cv/FeatureDetector/AbstractDetector.h"
+#include "util/util.h"
+
+/// what the detector tests share: the plain segment test as reference, a timed detection and
+/// the comparison of two detection modes which have to agree
+namespace detector_test {
+
+    /// plain FAST-10 segment test, 10 contiguous ring pixels strictly beyond the barrier
+    inline bool isCorner(const uint8_t* p, int stride, int barrier) {
+        static const int cx[16] = {0, 1, 2, 3, 3,  3,  2,  1,  0, -1, -2, -3, -3, -3, -2, -1};
+        static const int cy[16] = {3, 3, 2, 1, 0, -1, -2, -3, -3, -3, -2, -1,  0,  1,  2,  3};
+        for(int s = 0; s < 16; ++s) {
+            int bright = 0, dark = 0;
+            for(int q = 0; q < 10; ++q) {
+                const int d = int(p[cx[(s + q) & 15] + cy[(s + q) & 15] * stride]) - int(*p);
+                bright += d > barrier;
+                dark += d < -barrier;
+            }
+            if(bright == 10 || dark == 10)
+                return true;
+        }
+        return false;
+    }
+
+    /// the segment test at (x, y) of a pyramid level, rounded to 8 bit as FAST_TILED_U8 packs it
+    inline bool isCorner(const ImgLevel& level, int x, int y, int barrier) {
+        uint8_t patch[7 * 7];
+        for(int dy = -3; dy <= 3; ++dy)
+            for(int dx = -3; dx <= 3; ++dx) {
+                const uint16_t v = level.intensity[(y + dy) * level.stride + x + dx];
+                patch[(dy + 3) * 7 + dx + 3] = uint8_t((v + PYR_ONE / 2) >> PYR_FRAC_BITS);
+            }
+        return isCorner(patch + 3 * 7 + 3, 7, barrier);
+    }
+
+    inline void detectTimed(const char* name, const std::shared_ptr<cvFrame>& frame,
+                            feature_detection::AbstractDetector& detector, double threshold,
+                            feature_detection::features_t& fts) {
+        frame->preparePyramid();
+        {
+            printf("%s:\n", name);
+            TimeUse time(name, __LINE__);
+            detector.detect(frame, frame->getMeasure().measurement.imgPyr, threshold, fts);
+        }
+        printf("%lu features\n", fts.size());
+    }
+
+    /// same features in the same order
+    inline void expectSame(const feature_detection::features_t& a, const feature_detection::features_t& b,
+                           bool compareGrad) {
+        GTEST_ASSERT_EQ(a.size(), b.size());
+        auto ia = a.begin();
+        for(auto ib = b.begin(); ib != b.end(); ++ia, ++ib) {
+            EXPECT_EQ((*ia)->px, (*ib)->px);
+            EXPECT_EQ((*ia)->level, (*ib)->level);
+            if(compareGrad)
+                EXPECT_EQ((*ia)->grad, (*ib)->grad);
+        }
+    }
+}
+
+#endif //SIMPLE_VIO_DETECTORTEST_H
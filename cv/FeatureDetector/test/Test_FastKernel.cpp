@@ -0,0 +1,73 @@
+#include "opencv2/ts/ts.hpp"
+
+#include "../FastDetector.h"
+#include "../FastKernel.h"
+#include "util/util.h"
+#include "DetectorTest.h"
+
+namespace {
+    // the scalar decision trees of FastDetector
+    class FastTree : public feature_detection::FastDetector {
+    public:
+        FastTree(int width, int height) : FastDetector(width, height, 25, IMG_LEVEL, FAST_SERIAL) {}
+        using FastDetector::fast_corner_detect_10;
+        using FastDetector::fast_corner_score_10;
+    };
+}
+
+TEST(FastKernel, segmentTest) {
+    cv::Mat pic = cv::imread("../testData/mav0/cam0/data/1403715278262142976.png", 0);
+    if(pic.empty()) {
+        pic.create(480, 752, CV_8UC1);
+        cv::randu(pic, cv::Scalar(0), cv::Scalar(256));
+    }
+    const int barrier = 8;
+    const simd::InstructionSet best = fast::getInstructionSet();
+
+    FastTree tree(pic.cols, pic.rows);
+    std::vector<fast::xy> treeCorners;
+    std::vector<int> treeScores;
+    {
+        printf("decision tree:\n");
+        TimeUse time(__FUNCTION__, __LINE__);
+        tree.fast_corner_detect_10(pic.data, pic.cols, pic.rows, int(pic.step[0]), barrier, treeCorners);
+        tree.fast_corner_score_10(pic.data, int(pic.step[0]), treeCorners, barrier, 1, treeScores);
+    }
+
+    std::vector<fast::xy> reference;
+    for(int y = 3; y < pic.rows - 3; ++y)
+        for(int x = 3; x < pic.cols - 3; ++x)
+            if(detector_test::isCorner(pic.ptr<uint8_t>(y) + x, int(pic.step[0]), barrier))
+                reference.push_back(fast::xy(short(x), short(y)));
+    std::vector<int> referenceScores;
+    tree.fast_corner_score_10(pic.data, int(pic.step[0]), reference, barrier, 1, referenceScores);
+
+    // the tree decides the segment test, both find the same corners in the same order
+    printf("segment test %lu corners, decision tree %lu\n", reference.size(), treeCorners.size());
+    GTEST_ASSERT_EQ(treeCorners.size(), reference.size());
+    for(size_t k = 0; k < treeCorners.size(); ++k) {
+        EXPECT_EQ(treeCorners[k].x, reference[k].x);
+        EXPECT_EQ(treeCorners[k].y, reference[k].y);
+        EXPECT_EQ(treeScores[k], referenceScores[k]);
+    }
+
+    for(int set = simd::SCALAR; set <= best; ++set) {
+        fast::setInstructionSet(simd::InstructionSet(set));
+        std::vector<fast::xy> corners;
+        std::vector<int> scores;
+        {
+            printf("%s:\n", simd::name(fast::getInstructionSet()));
+            TimeUse time(__FUNCTION__, __LINE__);
+            fast::detect10(pic.data, pic.cols, pic.rows, int(pic.step[0]), barrier, corners);
+            fast::score10(pic.data, int(pic.step[0]), corners, scores);
+        }
+
+        GTEST_ASSERT_EQ(corners.size(), reference.size());
+        for(size_t k = 0; k < corners.size(); ++k) {
+            EXPECT_EQ(corners[k].x, reference[k].x);
+            EXPECT_EQ(corners[k].y, reference[k].y);
+            EXPECT_EQ(scores[k], referenceScores[k]);
+        }
+    }
+    fast::setInstructionSet(best);
+}
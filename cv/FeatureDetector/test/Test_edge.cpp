@@ -8,6 +8,8 @@
 #include "IO/camera/CameraIO.h"
 #include "DataStructure/cv/Feature.h"
 #include "cv/FeatureDetector/EdgeDetector.h"
+#include "util/util.h"
+#include "DetectorTest.h"
 
 TEST(edge_detector, edge_detector) {
     std::string camDatafile = "../testData/mav0/cam1/data.csv";
@@ -90,3 +92,25 @@ TEST(edge_detector, edge_detector) {
 
 }
 
+TEST(edge_detector, parallel) {
+    std::string camDatafile = "../testData/mav0/cam1/data.csv";
+    std::string camParamfile ="../testData/mav0/cam1/sensor.yaml";
+    CameraIO camTest(camDatafile,camParamfile);
+    const CameraIO::pCamereParam cam = camTest.getCamera();
+    cv::Mat pic = cv::imread("../testData/mav0/cam0/data/1403715278462142976.png",0);
+    GTEST_ASSERT_NE(pic.empty(), true);
+    typedef feature_detection::EdgeDetector EdgeDetector;
+
+    // cells run on the pool, the same edgelets come out in the same order with the same gradients
+    feature_detection::features_t serial, parallel;
+    EdgeDetector serialDetector(pic.cols, pic.rows, 25, IMG_LEVEL, EdgeDetector::EDGE_SERIAL);
+    EdgeDetector parallelDetector(pic.cols, pic.rows, 25, IMG_LEVEL, EdgeDetector::EDGE_PARALLEL);
+    detector_test::detectTimed("serial", std::make_shared<cvFrame>(cam, pic), serialDetector, 5, serial);
+    detector_test::detectTimed("parallel", std::make_shared<cvFrame>(cam, pic), parallelDetector, 5, parallel);
+    detector_test::expectSame(serial, parallel, true);
+
+    // a second frame through the same detector, the per worker buffers don't carry anything over
+    feature_detection::features_t again;
+    detector_test::detectTimed("parallel, again", std::make_shared<cvFrame>(cam, pic), parallelDetector, 5, again);
+    detector_test::expectSame(serial, again, true);
+}
@@ -8,6 +8,8 @@
 #include "IO/camera/CameraIO.h"
 #include "DataStructure/cv/Feature.h"
 #include "cv/FeatureDetector/FastDetector.h"
+#include "util/util.h"
+#include "DetectorTest.h"
 
 //#define SHOW_FAST
 
@@ -70,3 +72,46 @@ TEST(fast_detector, fast_detector) {
 
 }
 
+
+TEST(fast_detector, tiled) {
+    std::string camDatafile = "../testData/mav0/cam1/data.csv";
+    std::string camParamfile ="../testData/mav0/cam1/sensor.yaml";
+    CameraIO camTest(camDatafile,camParamfile);
+    const CameraIO::pCamereParam cam = camTest.getCamera();
+    cv::Mat pic = cv::imread("../testData/mav0/cam0/data/1403715278262142976.png", 0);
+    GTEST_ASSERT_NE(pic.empty(), true);
+    typedef feature_detection::FastDetector FastDetector;
+
+    // the tiled mode only changes who does the work
+    feature_detection::features_t serial, tiled;
+    FastDetector serialDetector(pic.cols, pic.rows, 25, IMG_LEVEL, FastDetector::FAST_SERIAL);
+    FastDetector tiledDetector(pic.cols, pic.rows, 25, IMG_LEVEL, FastDetector::FAST_TILED);
+    detector_test::detectTimed("serial", std::make_shared<cvFrame>(cam, pic), serialDetector, fast_threshold, serial);
+    detector_test::detectTimed("tiled", std::make_shared<cvFrame>(cam, pic), tiledDetector, fast_threshold, tiled);
+    detector_test::expectSame(serial, tiled, false);
+
+    // the u8 mode runs the segment test on the level rounded to 8 bit, every corner it keeps has to pass it
+    // there. the scalar kernel set is that test written out, the SIMD sets have to agree with it
+    const simd::InstructionSet best = fast::getInstructionSet();
+    feature_detection::features_t scalar;
+    std::shared_ptr<cvFrame> frame = std::make_shared<cvFrame>(cam, pic);
+    FastDetector u8Detector(pic.cols, pic.rows, 25, IMG_LEVEL, FastDetector::FAST_TILED_U8);
+    fast::setInstructionSet(simd::SCALAR);
+    detector_test::detectTimed("tiled u8, scalar", frame, u8Detector, fast_threshold, scalar);
+    GTEST_ASSERT_NE(scalar.empty(), true);
+    for(auto &ft : scalar) {
+        const int scale = 1 << ft->level;
+        const ImgLevel &level = frame->getMeasure().measurement.imgPyr[ft->level];
+        EXPECT_TRUE(detector_test::isCorner(level, int(ft->px(0)) / scale, int(ft->px(1)) / scale, 8));
+    }
+
+    for(int set = simd::SCALAR + 1; set <= best; ++set) {
+        fast::setInstructionSet(simd::InstructionSet(set));
+        feature_detection::features_t u8;
+        FastDetector detector(pic.cols, pic.rows, 25, IMG_LEVEL, FastDetector::FAST_TILED_U8);
+        detector_test::detectTimed(simd::name(fast::getInstructionSet()), std::make_shared<cvFrame>(cam, pic),
+                                   detector, fast_threshold, u8);
+        detector_test::expectSame(scalar, u8, false);
+    }
+    fast::setInstructionSet(best);
+}
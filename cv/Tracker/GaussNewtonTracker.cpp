@@ -0,0 +1,191 @@
+#include <algorithm>
+
+#include "GaussNewtonTracker.h"
+#include "PhotometricBatch.h"
+#include "DataStructure/cv/cvFrame.h"
+#include "DataStructure/viFrame.h"
+#include "DataStructure/cv/Feature.h"
+#include "DataStructure/cv/Point.h"
+#include "util/util.h"
+
+namespace direct_tracker {
+
+    GaussNewtonTracker::GaussNewtonTracker(const Options& options)
+            : options_(options), prior_(nullptr), iterations_(0), initialCost_(0.0), finalCost_(0.0) {
+        pattern_.push_back(Eigen::Vector2i(0, 0));
+        const std::vector<Eigen::Vector2i>& model = trackModel();
+        pattern_.insert(pattern_.end(), model.begin(), model.end());
+    }
+
+    void GaussNewtonTracker::precompute(const std::shared_ptr<viFrame>& viframe_i, int level) {
+        const viFrame::cam_t& cam = viframe_i->getCam();
+        const ImgLevel& img = viframe_i->getCVFrame()->intensityLevel(level);
+        const double scale = 1.0 / (1 << level);
+        const int P = int(pattern_.size());
+        const int N = int(X_.size()) * P;
+
+        // centre and the four neighbours of every reference pixel, sampled in one call
+        u_.resize(5 * N);
+        v_.resize(5 * N);
+        I_.resize(5 * N);
+        static const int du[5] = {0, 1, -1, 0, 0};
+        static const int dv[5] = {0, 0, 0, 1, -1};
+        for(int k = 0; k < int(X_.size()); ++k) {
+            Eigen::Vector2d px(-1.0, -1.0);
+            if(X_[k](2) > 0.0000000001)
+                px = cam->world2cam(X_[k]) * scale;
+            for(int s = 0; s < P; ++s) {
+                for(int c = 0; c < 5; ++c) {
+                    u_[5 * (k * P + s) + c] = float(px(0) + pattern_[s](0) + du[c]);
+                    v_[5 * (k * P + s) + c] = float(px(1) + pattern_[s](1) + dv[c]);
+                }
+            }
+        }
+        sampleIntensity(img, u_.data(), v_.data(), 5 * N, I_.data());
+
+        feature_.clear();
+        offset_.clear();
+        refI_.clear();
+        J_.clear();
+        const double fx = cam->fx(), fy = cam->fy();
+        for(int k = 0; k < int(X_.size()); ++k) {
+            const Eigen::Vector3d& X = X_[k];
+            if(X(2) <= 0.0000000001)
+                continue;
+
+            // d(pixel on this level) / d(se3 increment) at the identity, shared by the whole pattern
+            Eigen::Matrix<double, 2, 3> dpi;
+            dpi << fx / X(2), 0.0, -fx * X(0) / (X(2) * X(2)),
+                   0.0, fy / X(2), -fy * X(1) / (X(2) * X(2));
+            Eigen::Matrix<double, 3, 6> dX;
+            dX.block<3, 3>(0, 0) = Eigen::Matrix3d::Identity();
+            dX.block<3, 3>(0, 3) = -Sophus::SO3d::hat(X);
+            const Eigen::Matrix<double, 2, 6> dW = scale * dpi * dX;
+
+            for(int s = 0; s < P; ++s) {
+                const float* I = &I_[5 * (k * P + s)];
+                if(I[0] < 0 || I[1] < 0 || I[2] < 0 || I[3] < 0 || I[4] < 0)
+                    continue;
+                Eigen::Vector2d grad(0.5 * (I[1] - I[2]), 0.5 * (I[3] - I[4]));
+                feature_.push_back(k);
+                offset_.push_back(s);
+                refI_.push_back(I[0]);
+                J_.push_back(dW.transpose() * grad);
+            }
+        }
+    }
+
+    double GaussNewtonTracker::accumulate(const std::shared_ptr<viFrame>& viframe_j, const Sophus::SE3d& T_ji,
+                                          int level, Matrix6d& H, Vector6d& b, int& n) {
+        const viFrame::cam_t& cam = viframe_j->getCam();
+        const double scale = 1.0 / (1 << level);
+        const int R = int(feature_.size());
+
+        proj_.resize(X_.size());
+        for(int k = 0; k < int(X_.size()); ++k) {
+            const Eigen::Vector3d Xj = T_ji * X_[k];
+            proj_[k] = Xj(2) > 0.0000000001 ? Eigen::Vector2d(cam->world2cam(Xj) * scale) : Eigen::Vector2d(-1e6, -1e6);
+        }
+
+        u_.resize(R);
+        v_.resize(R);
+        I_.resize(R);
+        for(int r = 0; r < R; ++r) {
+            const Eigen::Vector2d& px = proj_[feature_[r]];
+            u_[r] = float(px(0) + pattern_[offset_[r]](0));
+            v_[r] = float(px(1) + pattern_[offset_[r]](1));
+        }
+        sampleIntensity(viframe_j->getCVFrame()->intensityLevel(level), u_.data(), v_.data(), R, I_.data());
+
+        H.setZero();
+        b.setZero();
+        n = 0;
+        double cost = 0.0;
+        const double k = options_.huber;
+        for(int r = 0; r < R; ++r) {
+            if(I_[r] < 0)
+                continue;
+            const double e = I_[r] - refI_[r];
+            const double abs_e = std::abs(e);
+            const double w = abs_e <= k ? 1.0 : k / abs_e;
+            H.selfadjointView<Eigen::Upper>().rankUpdate(J_[r], w);
+            b.noalias() += w * e * J_[r];
+            cost += abs_e <= k ? 0.5 * e * e : k * (abs_e - 0.5 * k);
+            ++n;
+        }
+        H.triangularView<Eigen::StrictlyLower>() = H.transpose();
+
+        // the rotation of T_ji * exp(delta)^-1 moves by -omega: r(delta) = r - S * Jr^-1(phi) * omega
+        if(prior_) {
+            const Eigen::Vector3d phi = (prior_->R_ji.inverse() * T_ji.so3()).log();
+            const Eigen::Vector3d r = prior_->sqrtInfo * phi;
+            Eigen::Matrix<double, 3, 6> Jp = Eigen::Matrix<double, 3, 6>::Zero();
+            Jp.block<3, 3>(0, 3) = prior_->sqrtInfo * rightJacobian(phi).inverse();
+            H.noalias() += Jp.transpose() * Jp;
+            b.noalias() += Jp.transpose() * r;
+            cost += 0.5 * r.squaredNorm();
+        }
+        return cost;
+    }
+
+    bool GaussNewtonTracker::solve(const std::shared_ptr<viFrame>& viframe_i, const std::shared_ptr<viFrame>& viframe_j,
+                                   const std::vector<std::shared_ptr<Feature>>& fts, Sophus::SE3d& T_ji, int n_iter,
+                                   const RotationPrior* prior) {
+        const pose_t pose_i = viframe_i->getCVFrame()->getPose();
+        handles_.resize(fts.size());
+        for(size_t k = 0; k < fts.size(); ++k)
+            handles_[k] = fts[k]->point->handle();
+        X_.resize(fts.size());
+        PointStore::instance().gather(handles_.data(), handles_.size(), X_.data());
+        for(size_t k = 0; k < fts.size(); ++k)
+            X_[k] = pose_i * X_[k];
+
+        prior_ = prior;
+        iterations_ = 0;
+        initialCost_ = finalCost_ = -1.0;
+        bool success = false;
+        Matrix6d H, H_try;
+        Vector6d b, b_try;
+        const int coarsest = std::min(options_.coarsestLevel, IMG_LEVEL - 1);
+        for(int level = coarsest; level >= options_.finestLevel; --level) {
+            precompute(viframe_i, level);
+            int n = 0;
+            double cost = accumulate(viframe_j, T_ji, level, H, b, n);
+            // coarse levels may simply lack valid pixels, only the finest one decides
+            success = n >= options_.minResiduals;
+            if(!success)
+                continue;
+            if(initialCost_ < 0)
+                initialCost_ = cost / n;
+
+            double lambda = 1e-3;
+            for(int it = 0; it < n_iter; ++it) {
+                Matrix6d A = H;
+                A.diagonal() *= 1.0 + lambda;
+                const Vector6d delta = A.ldlt().solve(b);
+                const Sophus::SE3d T_try = T_ji * Sophus::SE3d::exp(delta).inverse();
+
+                int n_try = 0;
+                const double cost_try = accumulate(viframe_j, T_try, level, H_try, b_try, n_try);
+                ++iterations_;
+                if(n_try >= options_.minResiduals && cost_try / n_try < cost / n) {
+                    T_ji = T_try;
+                    H = H_try;  b = b_try;
+                    cost = cost_try;    n = n_try;
+                    lambda = std::max(lambda * 0.1, 1e-7);
+                    if(delta.norm() < options_.epsilon)
+                        break;
+                }
+                else {
+                    lambda *= 10.0;
+                    if(lambda > 1e4)
+                        break;
+                }
+            }
+            finalCost_ = cost / n;
+        }
+
+        prior_ = nullptr;
+        return success;
+    }
+}
@@ -0,0 +1,80 @@
+#ifndef SIMPLE_VIO_GAUSSNEWTONTRACKER_H
+#define SIMPLE_VIO_GAUSSNEWTONTRACKER_H
+
+#include <memory>
+#include <vector>
+
+#include "ThirdParty/sophus/se3.hpp"
+#include "util/setting.h"
+#include "DataStructure/cv/PointStore.h"
+
+class viFrame;
+struct Feature;
+
+namespace direct_tracker {
+
+    /// a rotation residual next to the photometric ones: sqrtInfo * log(R_ji^-1 * R), R the rotation of T_ji
+    struct RotationPrior {
+        Sophus::SO3d    R_ji;
+        Eigen::Matrix3d sqrtInfo;
+        EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+    };
+
+    /// sparse direct alignment of frame j against frame i without Ceres.
+    /// inverse compositional Gauss-Newton with Levenberg-Marquardt damping on SE3: the jacobians come from
+    /// frame i and are fixed per pyramid level, so every iteration only resamples frame j and accumulates
+    /// the 6x6 normal equations. levels are processed from coarse to fine.
+    class GaussNewtonTracker {
+    public:
+        typedef Eigen::Matrix<double, 6, 6> Matrix6d;
+        typedef Eigen::Matrix<double, 6, 1> Vector6d;
+
+        struct Options {
+            Options() : coarsestLevel(3), finestLevel(0), epsilon(1e-6), huber(10.0), minResiduals(40) {}
+            int    coarsestLevel;
+            int    finestLevel;
+            double epsilon;         //!< stop a level once the update norm drops below this
+            double huber;           //!< huber threshold on the intensity residual
+            int    minResiduals;
+        };
+
+    public:
+        GaussNewtonTracker(const Options& options = Options());
+
+        /// refine T_ji (camera i -> camera j) with the features of frame i, n_iter iterations at most per level.
+        /// a prior adds its rotation residual on every level.
+        bool solve(const std::shared_ptr<viFrame>& viframe_i, const std::shared_ptr<viFrame>& viframe_j,
+                   const std::vector<std::shared_ptr<Feature>>& fts, Sophus::SE3d& T_ji, int n_iter,
+                   const RotationPrior* prior = nullptr);
+
+        int    iterations() const { return iterations_; }
+        double initialCost() const { return initialCost_; }
+        double finalCost() const { return finalCost_; }
+
+    private:
+        void precompute(const std::shared_ptr<viFrame>& viframe_i, int level);
+        double accumulate(const std::shared_ptr<viFrame>& viframe_j, const Sophus::SE3d& T_ji, int level,
+                          Matrix6d& H, Vector6d& b, int& n);
+
+    private:
+        Options                                 options_;
+        std::vector<PointStore::Handle>         handles_;
+        std::vector<Eigen::Vector3d>            X_;             //!< feature points in camera i
+        std::vector<Eigen::Vector2i>            pattern_;
+
+        // reference pixels of the current level, one per feature and pattern offset
+        std::vector<int>                        feature_;
+        std::vector<int>                        offset_;        //!< index into pattern_
+        std::vector<float>                      refI_;
+        std::vector<Vector6d, Eigen::aligned_allocator<Vector6d>> J_;
+        std::vector<float>                      u_, v_, I_;
+        std::vector<Eigen::Vector2d>            proj_;          //!< feature projections in frame j, level 0
+        const RotationPrior*                    prior_;         //!< of the running solve
+
+        int                                     iterations_;
+        double                                  initialCost_;
+        double                                  finalCost_;
+    };
+}
+
+#endif //SIMPLE_VIO_GAUSSNEWTONTRACKER_H
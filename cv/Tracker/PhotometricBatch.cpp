@@ -0,0 +1,373 @@
+#include <cstring>
+#include <algorithm>
+
+#include "PhotometricBatch.h"
+#include "DataStructure/cv/cvFrame.h"
+#include "DataStructure/viFrame.h"
+#include "DataStructure/cv/Feature.h"
+#include "DataStructure/cv/Point.h"
+#include "util/setting.h"
+#include "util/simd.h"
+
+#define PHOTOMATRICERROR 40
+
+namespace direct_tracker {
+
+    enum SampleState {
+        SKIP   = 0,     //!< feature already lost, contributes nothing
+        FAILED = 1,     //!< projection left the image, the feature gets marked lost
+        INSIDE = 2
+    };
+
+    static const float pyrScale = 1.0f / PYR_ONE;
+
+    static void sampleIntensityScalar(const ImgLevel& img, const float* u, const float* v, int n, float* out) {
+        const float w = float(img.width), h = float(img.height);
+        const int stride = img.stride;
+        for(int k = 0; k < n; ++k) {
+            if(!(u[k] >= 0 && v[k] >= 0 && u[k] < w && v[k] < h)) {
+                out[k] = -1.0f;
+                continue;
+            }
+            int ui = int(u[k]);     int vi = int(v[k]);
+            float ud = u[k] - ui;   float vd = v[k] - vi;
+            const uint16_t* ptr = img.intensity.data() + vi * stride + ui;
+            float row1 = ptr[0] * (1 - ud) + ptr[1] * ud;
+            float row2 = ptr[stride] * (1 - ud) + ptr[stride + 1] * ud;
+            out[k] = (row1 * (1 - vd) + row2 * vd) * pyrScale;
+        }
+    }
+
+    static void sampleGradientScalar(const ImgLevel& img, const int* u, const int* v, int n,
+                                     float* gx, float* gy, float* gn) {
+        for(int k = 0; k < n; ++k) {
+            if(u[k] < 0 || v[k] < 0 || u[k] >= img.width || v[k] >= img.height) {
+                gx[k] = gy[k] = 0.0f;
+                gn[k] = -1.0f;
+                continue;
+            }
+            const int idx = v[k] * img.stride + u[k];
+            gx[k] = img.gradX[idx] * pyrScale;
+            gy[k] = img.gradY[idx] * pyrScale;
+            gn[k] = img.gradNorm[idx] * pyrScale;
+        }
+    }
+
+#if SIMPLE_VIO_X86_SIMD
+    // one 32-bit gather at a 16-bit pixel returns the pixel and its right neighbour, so a bilinear
+    // sample is two gathers. lanes outside the image are redirected to pixel 0 and blended out.
+
+    SIMD_TARGET_AVX2 static void sampleIntensityAVX2(const ImgLevel& img, const float* u, const float* v, int n, float* out) {
+        const __m256 zero  = _mm256_setzero_ps();
+        const __m256 one   = _mm256_set1_ps(1.0f);
+        const __m256 minus = _mm256_set1_ps(-1.0f);
+        const __m256 scale = _mm256_set1_ps(pyrScale);
+        const __m256 w     = _mm256_set1_ps(float(img.width));
+        const __m256 h     = _mm256_set1_ps(float(img.height));
+        const __m256i stride = _mm256_set1_epi32(img.stride);
+        const __m256i low    = _mm256_set1_epi32(0xFFFF);
+        const int* base = reinterpret_cast<const int*>(img.intensity.data());
+
+        int k = 0;
+        for(; k + 8 <= n; k += 8) {
+            __m256 U = _mm256_loadu_ps(u + k);
+            __m256 V = _mm256_loadu_ps(v + k);
+            __m256 inside = _mm256_and_ps(_mm256_and_ps(_mm256_cmp_ps(U, zero, _CMP_GE_OQ), _mm256_cmp_ps(V, zero, _CMP_GE_OQ)),
+                                          _mm256_and_ps(_mm256_cmp_ps(U, w, _CMP_LT_OQ),    _mm256_cmp_ps(V, h, _CMP_LT_OQ)));
+            U = _mm256_and_ps(U, inside);
+            V = _mm256_and_ps(V, inside);
+
+            __m256i ui = _mm256_cvttps_epi32(U);
+            __m256i vi = _mm256_cvttps_epi32(V);
+            __m256 ud = _mm256_sub_ps(U, _mm256_cvtepi32_ps(ui));
+            __m256 vd = _mm256_sub_ps(V, _mm256_cvtepi32_ps(vi));
+            __m256i idx = _mm256_add_epi32(_mm256_mullo_epi32(vi, stride), ui);
+
+            __m256i top = _mm256_i32gather_epi32(base, idx, 2);
+            __m256i bot = _mm256_i32gather_epi32(base, _mm256_add_epi32(idx, stride), 2);
+
+            __m256 ud_ = _mm256_sub_ps(one, ud);
+            __m256 row1 = _mm256_add_ps(_mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_and_si256(top, low)), ud_),
+                                        _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_srli_epi32(top, 16)), ud));
+            __m256 row2 = _mm256_add_ps(_mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_and_si256(bot, low)), ud_),
+                                        _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_srli_epi32(bot, 16)), ud));
+            __m256 I = _mm256_mul_ps(_mm256_add_ps(_mm256_mul_ps(row1, _mm256_sub_ps(one, vd)), _mm256_mul_ps(row2, vd)), scale);
+            _mm256_storeu_ps(out + k, _mm256_blendv_ps(minus, I, inside));
+        }
+        sampleIntensityScalar(img, u + k, v + k, n - k, out + k);
+    }
+
+    SIMD_TARGET_AVX2 static void sampleGradientAVX2(const ImgLevel& img, const int* u, const int* v, int n,
+                                                    float* gx, float* gy, float* gn) {
+        const __m256i minusOne = _mm256_set1_epi32(-1);
+        const __m256i w      = _mm256_set1_epi32(img.width);
+        const __m256i h      = _mm256_set1_epi32(img.height);
+        const __m256i stride = _mm256_set1_epi32(img.stride);
+        const __m256i low    = _mm256_set1_epi32(0xFFFF);
+        const __m256  scale  = _mm256_set1_ps(pyrScale);
+        const __m256  zero   = _mm256_setzero_ps();
+        const __m256  minus  = _mm256_set1_ps(-1.0f);
+
+        int k = 0;
+        for(; k + 8 <= n; k += 8) {
+            __m256i U = _mm256_loadu_si256((const __m256i*)(u + k));
+            __m256i V = _mm256_loadu_si256((const __m256i*)(v + k));
+            __m256i inside = _mm256_and_si256(_mm256_and_si256(_mm256_cmpgt_epi32(U, minusOne), _mm256_cmpgt_epi32(V, minusOne)),
+                                              _mm256_and_si256(_mm256_cmpgt_epi32(w, U),        _mm256_cmpgt_epi32(h, V)));
+            __m256i idx = _mm256_and_si256(_mm256_add_epi32(_mm256_mullo_epi32(V, stride), U), inside);
+            __m256 mask = _mm256_castsi256_ps(inside);
+
+            // int16 planes: sign extend the low half of each gathered word
+            __m256i rx = _mm256_i32gather_epi32(reinterpret_cast<const int*>(img.gradX.data()), idx, 2);
+            __m256i ry = _mm256_i32gather_epi32(reinterpret_cast<const int*>(img.gradY.data()), idx, 2);
+            __m256i rn = _mm256_i32gather_epi32(reinterpret_cast<const int*>(img.gradNorm.data()), idx, 2);
+            __m256 GX = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_srai_epi32(_mm256_slli_epi32(rx, 16), 16)), scale);
+            __m256 GY = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_srai_epi32(_mm256_slli_epi32(ry, 16), 16)), scale);
+            __m256 GN = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_and_si256(rn, low)), scale);
+
+            _mm256_storeu_ps(gx + k, _mm256_blendv_ps(zero, GX, mask));
+            _mm256_storeu_ps(gy + k, _mm256_blendv_ps(zero, GY, mask));
+            _mm256_storeu_ps(gn + k, _mm256_blendv_ps(minus, GN, mask));
+        }
+        sampleGradientScalar(img, u + k, v + k, n - k, gx + k, gy + k, gn + k);
+    }
+#endif
+
+    void sampleIntensity(const ImgLevel& img, const float* u, const float* v, int n, float* out) {
+#if SIMPLE_VIO_X86_SIMD
+        if(simd::detect() == simd::AVX2)
+            return sampleIntensityAVX2(img, u, v, n, out);
+#endif
+        sampleIntensityScalar(img, u, v, n, out);
+    }
+
+    void sampleGradient(const ImgLevel& img, const int* u, const int* v, int n, float* gx, float* gy, float* gn) {
+#if SIMPLE_VIO_X86_SIMD
+        if(simd::detect() == simd::AVX2)
+            return sampleGradientAVX2(img, u, v, n, gx, gy, gn);
+#endif
+        sampleGradientScalar(img, u, v, n, gx, gy, gn);
+    }
+
+    PhotometricBatch::PhotometricBatch(const std::shared_ptr<viFrame>& viframe_i,
+                                       const std::shared_ptr<viFrame>& viframe_j)
+            : viframe_i_(viframe_i), viframe_j_(viframe_j), prepared_(false), cached_(false) {
+        T_SB_ = viframe_i_->getT_BS().inverse();
+        memset(levelBegin_, 0, sizeof(levelBegin_));
+    }
+
+    void PhotometricBatch::patternError(const std::vector<PatternQuery>& queries, std::vector<float>& err) {
+        const std::vector<Eigen::Vector2i>& model = trackModel();
+        const int m = int(model.size());
+        err.assign(queries.size(), 0.0f);
+
+        std::vector<int> index;
+        std::vector<float> uj, vj, ui, vi, Ij, Ii;
+        for(int level = 0; level < IMG_LEVEL; ++level) {
+            index.clear();
+            for(int k = 0; k < int(queries.size()); ++k)
+                if(queries[k].level == level)
+                    index.push_back(k);
+            if(index.empty())
+                continue;
+
+            const int n = int(index.size()) * m;
+            uj.resize(n); vj.resize(n); ui.resize(n); vi.resize(n); Ij.resize(n); Ii.resize(n);
+            for(int k = 0; k < int(index.size()); ++k) {
+                const PatternQuery& q = queries[index[k]];
+                for(int s = 0; s < m; ++s) {
+                    uj[k * m + s] = q.uj + model[s](0);
+                    vj[k * m + s] = q.vj + model[s](1);
+                    ui[k * m + s] = q.ui + model[s](0);
+                    vi[k * m + s] = q.vi + model[s](1);
+                }
+            }
+
+            sampleIntensity(viframe_j_->getCVFrame()->intensityLevel(level), uj.data(), vj.data(), n, Ij.data());
+            sampleIntensity(viframe_i_->getCVFrame()->intensityLevel(level), ui.data(), vi.data(), n, Ii.data());
+
+            for(int k = 0; k < int(index.size()); ++k) {
+                float sum = 0.0f;
+                for(int s = 0; s < m; ++s)
+                    sum += std::abs(Ij[k * m + s] - Ii[k * m + s]);
+                err[index[k]] = sum;
+            }
+        }
+    }
+
+    int PhotometricBatch::add(const std::shared_ptr<Feature>& ft) {
+        fts_.push_back(ft);
+        prepared_ = false;
+        cached_ = false;
+        return int(fts_.size()) - 1;
+    }
+
+    void PhotometricBatch::prepare() {
+        const int n = int(fts_.size());
+        order_.resize(n);
+        for(int k = 0; k < n; ++k)
+            order_[k] = k;
+        std::stable_sort(order_.begin(), order_.end(), [this](int a, int b) {
+            return fts_[a]->level < fts_[b]->level;
+        });
+        pos_.resize(n);
+        for(int k = 0; k < n; ++k)
+            pos_[order_[k]] = k;
+
+        int k = 0;
+        for(int level = 0; level <= IMG_LEVEL; ++level) {
+            levelBegin_[level] = k;
+            while(k < n && fts_[order_[k]]->level == level)
+                ++k;
+        }
+
+        handles_.resize(n);
+        sqrtInfo_.resize(n);     I_i_.resize(n);
+        p_.resize(n);            pj_.resize(n);
+        u_.resize(n);            v_.resize(n);           I_j_.resize(n);
+        ui_.resize(n);           vi_.resize(n);
+        gx_.resize(n);           gy_.resize(n);          gn_.resize(n);
+        state_.resize(n);
+        residuals_.resize(n);    jacobians_.resize(6 * n);
+
+        // reference intensities, projected with the pose of frame i
+        const viFrame::cam_t& cam = viframe_j_->getCam();
+        const pose_t pose_i = viframe_i_->getCVFrame()->getPose();
+        for(k = 0; k < n; ++k)
+            handles_[k] = fts_[order_[k]]->point->handle();
+        PointStore::instance().gather(handles_.data(), n, p_.data(), sqrtInfo_.data());
+        for(k = 0; k < n; ++k) {
+            const std::shared_ptr<Feature>& ft = fts_[order_[k]];
+            sqrtInfo_[k] = std::sqrt(sqrtInfo_[k]);
+            Eigen::Vector2d px = cam->world2cam(pose_i * p_[k]);
+            for (int i = 0; i < ft->level; ++i)
+                px /= 2.0;
+            u_[k] = float(px(0));
+            v_[k] = float(px(1));
+        }
+        for(int level = 0; level < IMG_LEVEL; ++level) {
+            const int b = levelBegin_[level], e = levelBegin_[level + 1];
+            if(b < e)
+                sampleIntensity(viframe_i_->getCVFrame()->intensityLevel(level), &u_[b], &v_[b], e - b, &I_i_[b]);
+        }
+        prepared_ = true;
+    }
+
+    void PhotometricBatch::evaluateAll(const double* parameters) {
+        const int n = int(fts_.size());
+        Eigen::Vector3d so3, trans_ij;
+        for (int i = 0; i < 3; ++i) {
+            so3(i) = parameters[i];
+            trans_ij(i) = parameters[3 + i];
+        }
+        const Sophus::SO3d R_ij = Sophus::SO3d::exp(so3);
+        const Sophus::SE3d T_Si = T_SB_ * viframe_i_->getPose();
+        const Eigen::Matrix3d R_Si = T_Si.rotationMatrix();
+        const viFrame::cam_t& cam = viframe_j_->getCam();
+        const std::shared_ptr<cvFrame>& frame_j = viframe_j_->getCVFrame();
+        const int width = frame_j->getWidth(), height = frame_j->getHeight();
+
+        // warp every feature, then sample level by level
+        PointStore::instance().gather(handles_.data(), n, p_.data());
+        for(int k = 0; k < n; ++k) {
+            const std::shared_ptr<Feature>& ft = fts_[order_[k]];
+            u_[k] = v_[k] = -1.0f;
+            ui_[k] = vi_[k] = -1;
+            if (ft->isProjected == false) {
+                state_[k] = SKIP;
+                continue;
+            }
+            state_[k] = FAILED;
+
+            const Eigen::Vector3d pj = T_Si * (R_ij * p_[k] + trans_ij);
+            pj_[k] = pj;
+            if (pj(2) <= 0.0000000001)
+                continue;
+
+            double u = cam->fx() * (pj(0) / pj(2)) + cam->cx();
+            double v = cam->fy() * (pj(1) / pj(2)) + cam->cy();
+            if (u < 0 || u >= width || v < 0 || v >= height)
+                continue;
+            for (int i = 0; i < ft->level; ++i) {
+                u /= 2.0;
+                v /= 2.0;
+            }
+            u_[k] = float(u);   v_[k] = float(v);
+            ui_[k] = int(u);    vi_[k] = int(v);
+            state_[k] = INSIDE;
+        }
+
+        for(int level = 0; level < IMG_LEVEL; ++level) {
+            const int b = levelBegin_[level], e = levelBegin_[level + 1];
+            if(b == e)
+                continue;
+            sampleIntensity(frame_j->intensityLevel(level), &u_[b], &v_[b], e - b, &I_j_[b]);
+            sampleGradient(frame_j->gradientLevel(level), &ui_[b], &vi_[b], e - b, &gx_[b], &gy_[b], &gn_[b]);
+        }
+
+        for(int k = 0; k < n; ++k) {
+            const std::shared_ptr<Feature>& ft = fts_[order_[k]];
+            double* jac = &jacobians_[6 * k];
+            residuals_[k] = 0.0;
+            memset(jac, 0, sizeof(double) * 6);
+            if(state_[k] == SKIP)
+                continue;
+
+            if(state_[k] == INSIDE) {
+                const double err = I_j_[k] - I_i_[k];
+                if (err < PHOTOMATRICERROR && err > -PHOTOMATRICERROR) {
+                    double w = 1.0 / gn_[k];
+                    if (w > 0.0000001 && !std::isinf(w)) {
+                        residuals_[k] = sqrtInfo_[k] * w * err;
+                        const Eigen::Vector3d& pj = pj_[k];
+                        const Eigen::Vector2d& dir = ft->grad;
+                        const double gx = gx_[k], gy = gy_[k];
+                        w = std::sqrt(w);
+                        double Ix, Iy;
+                        if (ft->type == Feature::EDGELET) {
+                            Ix = dir(1) * dir(0);
+                            Iy = Ix * gx + dir(1) * dir(1) * gy;
+                            Ix *= gy;
+                            Ix += dir(0) * dir(0) * gx;
+                        } else {
+                            Ix = gx;
+                            Iy = gy;
+                        }
+                        Eigen::Matrix<double, 1, 3> Jac;
+                        Jac(0, 0) = Ix * cam->fx(ft->level) / pj(2);
+                        Jac(0, 1) = Iy * cam->fy(ft->level) / pj(2);
+                        Jac(0, 2) = -Ix * cam->fx(ft->level) * pj(0) / pj(2) / pj(2) -
+                                    Iy * cam->fy(ft->level) * pj(1) / pj(2) / pj(2);
+                        Jac = sqrtInfo_[k] * w * Jac * R_Si;
+                        jac[3] = Jac(0, 0);
+                        jac[4] = Jac(0, 1);
+                        jac[5] = Jac(0, 2);
+                        Jac = -Jac * R_ij.matrix() * Sophus::SO3d::hat(p_[k]);
+                        jac[0] = Jac(0, 0);
+                        jac[1] = Jac(0, 1);
+                        jac[2] = Jac(0, 2);
+                        continue;
+                    }
+                }
+            }
+
+            ft->isProjected = false;
+        }
+    }
+
+    void PhotometricBatch::evaluate(const double* parameters, int slot, double* residual, double* jacobian) {
+        boost::mutex::scoped_lock lock(mutex_);
+        if(!prepared_)
+            prepare();
+        if(!cached_ || memcmp(cacheKey_, parameters, sizeof(cacheKey_)) != 0) {
+            evaluateAll(parameters);
+            memcpy(cacheKey_, parameters, sizeof(cacheKey_));
+            cached_ = true;
+        }
+
+        const int k = pos_[slot];
+        *residual = residuals_[k];
+        if(jacobian)
+            memcpy(jacobian, &jacobians_[6 * k], sizeof(double) * 6);
+    }
+}
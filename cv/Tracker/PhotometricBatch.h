@@ -0,0 +1,83 @@
+#ifndef SIMPLE_VIO_PHOTOMETRICBATCH_H
+#define SIMPLE_VIO_PHOTOMETRICBATCH_H
+
+#include <memory>
+#include <vector>
+#include <boost/thread/mutex.hpp>
+
+#include "ThirdParty/sophus/se3.hpp"
+#include "DataStructure/cv/ImgPyr.h"
+#include "DataStructure/cv/PointStore.h"
+
+class viFrame;
+struct Feature;
+
+namespace direct_tracker {
+
+    /// bilinear intensity of n points on one level, -1 outside the image like cvFrame::getIntensityBilinear.
+    void sampleIntensity(const ImgLevel& img, const float* u, const float* v, int n, float* out);
+
+    /// gradient and gradient norm at integer pixels, points outside the image give gn = -1.
+    void sampleGradient(const ImgLevel& img, const int* u, const int* v, int n, float* gx, float* gy, float* gn);
+
+    /// photometric terms of every tracked feature between viframe_i and viframe_j, evaluated in one pass.
+    /// the pixels are sampled straight from the pyramid planes, level by level, with AVX2 gathers when available.
+    class PhotometricBatch {
+    public:
+        struct PatternQuery {
+            float uj, vj;       //!< projection in frame j on the feature level
+            float ui, vi;       //!< projection in frame i on the feature level
+            int   level;
+        };
+
+    public:
+        PhotometricBatch(const std::shared_ptr<viFrame>& viframe_i, const std::shared_ptr<viFrame>& viframe_j);
+
+        /// sum of absolute differences over trackModel() for every query.
+        void patternError(const std::vector<PatternQuery>& queries, std::vector<float>& err);
+
+        /// register a feature as residual, returns its slot.
+        int add(const std::shared_ptr<Feature>& ft);
+
+        /// residual and 1x6 jacobian of one slot at parameters (so3, t_ij).
+        /// the whole batch is evaluated once per distinct parameter vector and cached.
+        void evaluate(const double* parameters, int slot, double* residual, double* jacobian);
+
+        int size() const { return int(fts_.size()); }
+
+    private:
+        void prepare();
+        void evaluateAll(const double* parameters);
+
+    private:
+        std::shared_ptr<viFrame>                viframe_i_;
+        std::shared_ptr<viFrame>                viframe_j_;
+        Sophus::SE3d                            T_SB_;
+
+        std::vector<std::shared_ptr<Feature>>   fts_;           //!< by slot
+        std::vector<int>                        order_;         //!< position -> slot, positions are sorted by level
+        std::vector<int>                        pos_;           //!< slot -> position
+        int                                     levelBegin_[IMG_LEVEL + 1];
+
+        // everything below is indexed by position
+        std::vector<PointStore::Handle>         handles_;
+        std::vector<double>                     sqrtInfo_;
+        std::vector<float>                      I_i_;           //!< reference intensity in frame i
+        std::vector<Eigen::Vector3d>            p_;
+        std::vector<Eigen::Vector3d>            pj_;
+        std::vector<float>                      u_, v_, I_j_;
+        std::vector<int>                        ui_, vi_;
+        std::vector<float>                      gx_, gy_, gn_;
+        std::vector<unsigned char>              state_;
+
+        std::vector<double>                     residuals_;
+        std::vector<double>                     jacobians_;     //!< 6 per position
+
+        bool                                    prepared_;
+        bool                                    cached_;
+        double                                  cacheKey_[6];
+        boost::mutex                            mutex_;
+    };
+}
+
+#endif //SIMPLE_VIO_PHOTOMETRICBATCH_H
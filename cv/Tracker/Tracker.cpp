@@ -9,134 +9,60 @@
 #include <boost/thread/shared_mutex.hpp>
 
 #include "Tracker.h"
+#include "PhotometricBatch.h"
+#include "GaussNewtonTracker.h"
 #include "DataStructure/cv/cvFrame.h"
 #include "DataStructure/viFrame.h"
 #include "DataStructure/cv/Feature.h"
 #include "DataStructure/cv/Point.h"
 #include "util/setting.h"
-
-#define PHOTOMATRICERROR 40
+#include "util/ThreadReduce.h"
+#include "util/util.h"
+#include "util/Trace.h"
 
 
 namespace direct_tracker {
 
 class TrackingErr : public ceres::SizedCostFunction<1, 6> {
 public:
-	TrackingErr(const std::shared_ptr<Feature> &ft, std::shared_ptr<viFrame> &viframe_i,
-	            std::shared_ptr<viFrame> &viframe_j) {
-		this->ft = ft;
-		this->viframe_i = viframe_i;
-		this->viframe_j = viframe_j;
-		T_SB = viframe_i->getT_BS().inverse();
-		sqrt_info = std::sqrt(ft->point->getDepthInformation());
-		ft->point->pos_mutex.lock_shared();
-		const Eigen::Vector3d p = ft->point->pos_;
-		ft->point->pos_mutex.unlock_shared();
-		const viFrame::cam_t &cam = viframe_j->getCam();
-		Eigen::Vector3d pi = viframe_i->getCVFrame()->getPose() * p;
-		Eigen::Vector2d px = cam->world2cam(pi);
-		for (int i = 0; i < ft->level; ++i)
-			px /= 2.0;
-
-		I_i = viframe_i->getCVFrame()->getIntensityBilinear(px(0), px(1), ft->level);
-	}
+	TrackingErr(const std::shared_ptr<PhotometricBatch> &batch, int slot) : batch(batch), slot(slot) {}
 
+	// every block of the problem reads its slot of one batched evaluation, the loss stays per feature
 	virtual bool Evaluate(double const *const *parameters,
 	                      double *residuals,
 	                      double **jacobians) const {
-		if (ft->isProjected == false) {
-			*residuals = 0;
-			//printf("projected failed!\n");
-			if (jacobians && jacobians[0])
-				memset(jacobians[0], 0, sizeof(double) * 6);
-			return true;
-		}
+		batch->evaluate(parameters[0], slot, residuals, jacobians ? jacobians[0] : nullptr);
+		return true;
+	}
 
-		Eigen::Vector3d so3, trans_ij;
-		for (int i = 0; i < 3; ++i) {
-			so3(i) = parameters[0][i];
-			trans_ij(i) = parameters[0][3 + i];
-		}
+private:
+	std::shared_ptr<PhotometricBatch> batch;
+	int slot;
+};
 
-		Sophus::SO3d R_ij = Sophus::SO3d::exp(so3);
-		ft->point->pos_mutex.lock_shared();
-		const Eigen::Vector3d p = ft->point->pos_;
-		ft->point->pos_mutex.unlock_shared();
-
-		Sophus::SE3d T_Si = T_SB * viframe_i->getPose();
-		Eigen::Vector3d pj = T_Si * (R_ij * p + trans_ij);
-
-		if (pj(2) > 0.0000000001) {
-			const viFrame::cam_t &cam = viframe_j->getCam();
-			double u = cam->fx() * (pj(0) / pj(2)) + cam->cx();
-			if (u >= 0 && u < viframe_j->getCVFrame()->getWidth()) {
-				double v = cam->fy() * (pj(1) / pj(2)) + cam->cy();
-				if (v >= 0 && v < viframe_j->getCVFrame()->getHeight()) {
-					for (int i = 0; i < ft->level; ++i) {
-						u /= 2.0;
-						v /= 2.0;
-					}
+// the rotation prior on the parameters (so3 of R_ij, t_ij), the so3 part moves as R_ij * exp(delta)
+class RotationPriorErr : public ceres::SizedCostFunction<3, 6> {
+public:
+	RotationPriorErr(const Sophus::SO3d &R_ij, const Eigen::Matrix3d &sqrtInfo) : R_ij_inv(R_ij.inverse()), sqrtInfo(sqrtInfo) {}
 
-					double err = viframe_j->getCVFrame()->getIntensityBilinear(u, v, ft->level) - I_i;
-					//std::cout << "err = " << err << std::endl;
-					if (err < PHOTOMATRICERROR && err > -PHOTOMATRICERROR) {
-						double w = 1.0 / viframe_j->getCVFrame()->getGradNorm(u, v, ft->level);
-
-						if (w > 0.0000001 && !std::isinf(w)) {
-							*residuals = sqrt_info * w * err;
-							Eigen::Vector2d grad;
-
-							if (viframe_j->getCVFrame()->getGrad(u, v, grad, ft->level)) {
-								Eigen::Vector2d &dir = ft->grad;
-								w = std::sqrt(w);
-								if (jacobians && jacobians[0]) {
-									double Ix, Iy;
-									if (ft->type == Feature::EDGELET) {
-										Ix = dir(1) * dir(0);
-										Iy = Ix * grad(0) + dir(1) * dir(1) * grad(1);
-										Ix *= grad(1);
-										Ix += dir(0) * dir(0) * grad(0);
-									} else {
-										Ix = grad(0);
-										Iy = grad(1);
-									}
-									Eigen::Matrix<double, 1, 3> Jac;
-									Jac(0, 0) = Ix * cam->fx(ft->level) / pj(2);
-									Jac(0, 1) = Iy * cam->fy(ft->level) / pj(2);
-									Jac(0, 2) = -Ix * cam->fx(ft->level) * pj(0) / pj(2) / pj(2) -
-									            Iy * cam->fy(ft->level) * pj(1) / pj(2) / pj(2);
-									Jac = sqrt_info * w * Jac * T_Si.rotationMatrix();
-									//	std::cout << "tracking dedt = \n" << Jac << std::endl;
-									jacobians[0][3] = Jac(0, 0);
-									jacobians[0][4] = Jac(0, 1);
-									jacobians[0][5] = Jac(0, 2);
-									Jac = -Jac * R_ij.matrix() * Sophus::SO3d::hat(p);
-									jacobians[0][0] = Jac(0, 0);
-									jacobians[0][1] = Jac(0, 1);
-									jacobians[0][2] = Jac(0, 2);
-									//	std::cout << "tracking dedphi = \n" << Jac << std::endl;
-								}
-								return true;
-							}
-						}
-					}
-				}
-			}
+	virtual bool Evaluate(double const *const *parameters,
+	                      double *residuals,
+	                      double **jacobians) const {
+		const Eigen::Vector3d phi = (R_ij_inv * Sophus::SO3d::exp(Eigen::Vector3d(parameters[0][0], parameters[0][1],
+		                                                                         parameters[0][2]))).log();
+		Eigen::Map<Eigen::Vector3d> r(residuals);
+		r = sqrtInfo * phi;
+		if (jacobians && jacobians[0]) {
+			Eigen::Map<Eigen::Matrix<double, 3, 6, Eigen::RowMajor>> J(jacobians[0]);
+			J.block<3, 3>(0, 0) = sqrtInfo * rightJacobian(phi).inverse();
+			J.block<3, 3>(0, 3).setZero();
 		}
-		*residuals = 0;
-		ft->isProjected = false;
-		if (jacobians && jacobians[0])
-			memset(jacobians[0], 0, sizeof(double) * 6);
 		return true;
 	}
 
 private:
-	std::shared_ptr<Feature> ft;
-	std::shared_ptr<viFrame> viframe_i;
-	std::shared_ptr<viFrame> viframe_j;
-	Sophus::SE3d T_SB;
-	double sqrt_info;
-	double I_i;
+	Sophus::SO3d R_ij_inv;
+	Eigen::Matrix3d sqrtInfo;
 };
 
 class CERES_EXPORT SE3Parameterization : public ceres::LocalParameterization {
@@ -185,242 +111,255 @@ bool SE3Parameterization::Plus(const double *x,
 	return true;
 }
 
-Tracker::Tracker() {}
+Tracker::Tracker(TrackingType type) : type_(type), prefilter_(PREFILTER_ALL), rotationPrior_(false), iterations_(0) {
+	gaussNewton_ = std::make_shared<GaussNewtonTracker>();
+	threadReduce_ = std::make_shared<ThreadReduce>();
+}
 
-class depthErr : public ceres::SizedCostFunction<1, 1> {
-public:
-	virtual ~depthErr() {}
-
-	depthErr(std::shared_ptr<viFrame> nextFrame, double I_k,
-	         const cvMeasure::features_t::value_type &f, Sophus::SE3d &pose_) : f_(f), pose(pose_) {
-		this->nextFrame = nextFrame;
-		this->I_k = I_k;
-		f_->point->pos_mutex.lock_shared();
-		normPoint = f_->point->pos_ / f_->point->pos_(2);
-		f_->point->pos_mutex.unlock_shared();
-	}
+/// what reProject decided for one feature of frame i, filled concurrently and merged in order.
+struct Reprojection {
+	Reprojection() : erase(false), projected(false), refined(false), depth(0.0), information(0.0) {}
+	bool            erase;          //!< drop the feature from frame i
+	bool            projected;      //!< lands in frame j, becomes a feature there
+	bool            refined;        //!< depth converged, fuse it before projecting
+	double          depth;
+	double          information;
+	Eigen::Vector3d pos;            //!< normalised point in frame j
+	Eigen::Vector2d uvj;
+	EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+};
 
-	virtual bool Evaluate(double const *const *parameters,
-	                      double *residuals,
-	                      double **jacobians) const {
-		double d = **parameters;
-		Eigen::Vector3d P_next = pose * (d * normPoint);
-		auto &cam = nextFrame->getCam();
-		auto uv = cam->world2cam(P_next);
-		// std::cout << "uv = \n" << uv << std::endl;
-		if (uv(0) < 0 || uv(0) >= nextFrame->getCVFrame()->getWidth() || uv(1) < 0 ||
-		    uv(1) >= nextFrame->getCVFrame()->getHeight())
+/// 1-D refinement of a feature depth along its ray, the photometric error of the former depthErr block
+/// minimised with Gauss-Newton steps and a backtracking line search under a Huber(1) loss.
+/// it only reads the pyramid of frame j and allocates nothing, so features can be refined concurrently.
+static bool refineDepth(const std::shared_ptr<viFrame> &nextFrame, const Feature &ft, double I_k,
+                        const Eigen::Vector3d &normPoint, const Sophus::SE3d &pose, double &depth) {
+	const viFrame::cam_t &cam = nextFrame->getCam();
+	const std::shared_ptr<cvFrame> &frame = nextFrame->getCVFrame();
+	const int width = frame->getWidth();
+	const int height = frame->getHeight();
+	const double fx = cam->fx(ft.level), fy = cam->fy(ft.level);
+	const Eigen::Vector3d ray = pose.so3() * normPoint;
+
+	// residual and d(residual)/d(depth), false once the point leaves frame j
+	auto evaluate = [&](double d, double &r, double &J) -> bool {
+		Eigen::Vector3d P = d * ray + pose.translation();
+		if (P(2) < 0.00000001)
 			return false;
-		//	std::cout << "uv1 = \n" << uv << std::endl;
-
-		for (int i = 0; i < f_->level; ++i) {
+		Eigen::Vector2d uv = cam->world2cam(P);
+		if (uv(0) < 0 || uv(0) >= width || uv(1) < 0 || uv(1) >= height)
+			return false;
+		for (int i = 0; i < ft.level; ++i)
 			uv /= 2.0;
+
+		r = frame->getIntensityBilinear(uv(0), uv(1), ft.level) - I_k;
+		Eigen::Vector2d grad = frame->getGradBilinear(uv(0), uv(1), ft.level);
+		double Ix = grad(0), Iy = grad(1);
+		if (ft.type == Feature::EDGELET) {
+			const Eigen::Vector2d &dir = ft.grad;
+			double proj = dir(0) * grad(0) + dir(1) * grad(1);
+			Ix = dir(0) * proj;
+			Iy = dir(1) * proj;
 		}
+		J = (Ix * fx * (ray(0) * P(2) - P(0) * ray(2)) + Iy * fy * (ray(1) * P(2) - P(1) * ray(2))) / (P(2) * P(2));
+		return true;
+	};
+	auto huber = [](double r) { return std::abs(r) <= 1.0 ? 0.5 * r * r : std::abs(r) - 0.5; };
 
-		*residuals = nextFrame->getCVFrame()->getIntensityBilinear(uv(0), uv(1), f_->level) - I_k;
-		if (jacobians && jacobians[0]) {
-			Eigen::Vector2d grad = nextFrame->getCVFrame()->getGradBilinear(uv(0), uv(1), f_->level);
-			double Ix, Iy;
-			if (f_->type == Feature::EDGELET) {
-				Eigen::Vector2d &dir = f_->grad;
-				Ix = dir(1) * dir(0);
-				Iy = Ix * grad(0) + dir(1) * dir(1) * grad(1);
-				Ix *= grad(1);
-				Ix += dir(0) * dir(0) * grad(0);
-			} else {
-				Ix = grad(0);
-				Iy = grad(1);
+	double r, J;
+	if (!evaluate(depth, r, J))
+		return false;
+	double cost = huber(r);
+	for (int it = 0; it < 50; ++it) {
+		if (std::abs(J) < 1e-10 || cost < 1e-12)
+			return true;
+		// the huber weight cancels in one dimension, the loss only steers the line search
+		const double step = -r / J;
+		double alpha = 1.0, r_try, J_try, cost_try;
+		bool accepted = false;
+		for (; alpha >= 0.001; alpha *= 0.5) {
+			if (evaluate(depth + alpha * step, r_try, J_try) && (cost_try = huber(r_try)) < cost) {
+				accepted = true;
+				break;
 			}
-
-			Eigen::Matrix<double, 1, 3> Jac;
-			Jac(0, 0) = Ix * cam->fx(f_->level) / P_next(2);
-			Jac(0, 1) = Iy * cam->fy(f_->level) / P_next(2);
-			Jac(0, 2) = -Ix * cam->fx(f_->level) * P_next(0) / P_next(2) / P_next(2) -
-			            Iy * cam->fy(f_->level) * P_next(1) / P_next(2) / P_next(2);
-			Jac = Jac * pose.rotationMatrix();
-			//		std::cout << "jac : \n" << Jac << std::endl;
-			jacobians[0][0] = Jac * normPoint;
 		}
+		if (!accepted)
+			return false;
 
+		depth += alpha * step;
+		const bool converged = std::abs(alpha * step) <= 1e-8 * std::abs(depth) || cost - cost_try <= 1e-6 * cost;
+		r = r_try;
+		J = J_try;
+		cost = cost_try;
+		if (converged)
+			return true;
 	}
+	return false;
+}
 
-private:
-	const cvMeasure::features_t::value_type f_;
-	Eigen::Vector3d normPoint;
-	std::shared_ptr<viFrame> nextFrame;
-	double I_k;
-	Sophus::SE3d &pose;
-};
-
+// the handles of the features' points, then their estimates in one pass over the store arrays
+template<typename Features>
+static void gatherPoints(const Features &fts, std::vector<PointStore::Handle> &handles,
+                         std::vector<Eigen::Vector3d> &pos, std::vector<double> *information = nullptr) {
+	handles.clear();
+	for (const auto &ft : fts)
+		handles.push_back(ft->point->handle());
+	pos.resize(handles.size());
+	if (information)
+		information->resize(handles.size());
+	PointStore::instance().gather(handles.data(), handles.size(), pos.data(), information ? information->data() : nullptr);
+}
 
 int Tracker::reProject(std::shared_ptr<viFrame> &viframe_i, std::shared_ptr<viFrame> &viframe_j,
                        Sophus::SE3d &Tij, Eigen::Matrix<double, 6, 6> &infomation) {
+	TRACE_SCOPE("reprojection");
 	cvMeasure::features_t &fts = viframe_i->getCVFrame()->getMeasure().fts_;
 	int width = viframe_j->getCVFrame()->getWidth();
 	int height = viframe_j->getCVFrame()->getHeight();
 	int cellwidth = viframe_j->getCVFrame()->getWidth() / detectCellWidth;
 	int chellheight = viframe_j->getCVFrame()->getHeight() / detectCellHeight;
-	Sophus::SE3d _SPose_j = viframe_i->getT_BS().inverse() * viframe_i->getPose() * Tij;
+	const Sophus::SE3d _SPose_j = viframe_i->getT_BS().inverse() * viframe_i->getPose() * Tij;
+	const Sophus::SE3d pose_i = viframe_i->getCVFrame()->getPose();
+	const Eigen::Matrix<double, 6, 6> covariance = infomation.inverse();
+	viframe_j->getCVFrame()->preparePyramid();
+
+	std::vector<cvMeasure::features_t::iterator> order;
+	order.reserve(fts.size());
+	for (cvMeasure::features_t::iterator it = fts.begin(); it != fts.end(); ++it)
+		order.push_back(it);
+	std::vector<Reprojection, Eigen::aligned_allocator<Reprojection>> results(order.size());
+	gatherPoints(fts, handles_, positions_);
+	PointStore &store = PointStore::instance();
+
+	// projections and depth refinements only read the frames, they run on the pool
+	threadReduce_->reduce([&](int first, int last, int) {
+		for (int k = first; k < last; ++k) {
+			const std::shared_ptr<Feature> &ft = *order[k];
+			Reprojection &res = results[k];
+			// one snapshot for the projection and the depth refinement
+			const Eigen::Vector3d pw = positions_[k];
+			Eigen::Vector3d pos = pw;
+
+			Eigen::Vector3d pi = pose_i * pos;
+			if (pi[2] < 0.00000001 || std::isinf(pi[2])) {
+				res.erase = true;
+				continue;
+			}
+			Eigen::Vector2d uvi = viframe_i->getCam()->world2cam(pi);
+			if (!(uvi(0) < width && uvi(1) < height && uvi(0) > 0 && uvi(1) > 0))
+				continue;
+
+			pos = _SPose_j * pos;
+			if (pos[2] < 0.00000001 || std::isinf(pos[2])) {
+				res.erase = true;
+				continue;
+			}
+			pos /= pos[2];
+			res.pos = pos;
+			res.uvj = viframe_j->getCam()->world2cam(Eigen::Vector2d(pos.block<2, 1>(0, 0)));
+			if (!(res.uvj(0) < width && res.uvj(1) < height && res.uvj(0) > 0 && res.uvj(1) > 0))
+				continue;
+			res.projected = true;
+			if (ft->isBAed == true)
+				continue;
+
+			for (int i = 0; i < ft->level; ++i)
+				uvi /= 2.0;
+			double Ii = viframe_i->getCVFrame()->getIntensityBilinear(uvi(0), uvi(1), ft->level);
+
+			double depth = pw[2];
+			Eigen::Vector3d normPoint = pw / pw(2);
+			if (!refineDepth(viframe_j, *ft, Ii, normPoint, _SPose_j, depth))
+				continue;
+
+			Eigen::Vector3d Pj = _SPose_j * (depth * normPoint);
+			if (Pj[2] < 0.00000001 || std::isinf(Pj[2])) {
+				res.projected = false;
+				res.erase = true;
+				continue;
+			}
+			Eigen::Vector2d uv = viframe_j->getCam()->world2cam(Pj);
+			if (uv(0) >= width || uv(1) >= height || uv(0) <= 0 || uv(1) <= 0) {
+				res.projected = false;
+				res.erase = true;
+				continue;
+			}
+
+			Eigen::Matrix<double, 1, 6> Jac;
+			Jac.block<1, 3>(0, 0) = normPoint.transpose() *
+			                        Sophus::SO3d::hat(_SPose_j.so3().inverse() * (Pj - _SPose_j.translation()));
+			Jac.block<1, 3>(0, 3) = normPoint.transpose() * _SPose_j.so3().inverse().matrix();
+			Jac = Jac / (normPoint.transpose() * normPoint);
+
+			res.refined = true;
+			res.depth = depth;
+			res.information = 1.0 / (Jac * covariance * Jac.transpose())(0, 0);
+		}
+	}, 0, int(order.size()));
+
+	// merged in the order of fts_, so frame j ends up the same whatever the scheduling was
 	int cntCell = 0;
-	std::list<cvMeasure::features_t::value_type> toErase;
-	int cnt = 0;
-	for (cvMeasure::features_t::iterator it = fts.begin(); it != fts.end(); ++it) {
-		auto &ft = *it;
-		ft->point->pos_mutex.lock_shared();
-		Eigen::Vector3d pos = ft->point->pos_;
-		ft->point->pos_mutex.unlock_shared();
-		Eigen::Vector2d pos_;
-		Eigen::Vector2d uvi, uvj;
-		Eigen::Vector3d pi = viframe_i->getCVFrame()->getPose() * pos;
-		if (pi[2] < 0.00000001 || std::isinf(pi[2]))
-			toErase.push_back(*it);
-
-		else {
-			uvi = viframe_i->getCam()->world2cam(pi);
-			if (uvi(0) < width && uvi(1) < height && uvi(0) > 0 && uvi(1) > 0) {
-				pos = _SPose_j * pos;
-				if (pos[2] < 0.00000001 || std::isinf(pos[2]))
-					toErase.push_back(*it);
-
-				else {
-					pos /= pos[2];
-					pos_ = pos.block<2, 1>(0, 0);
-					uvj = viframe_j->getCam()->world2cam(pos_);
-					if (uvj(0) < width && uvj(1) < height && uvj(0) > 0 && uvj(1) > 0) {
-						int u = int(uvj(0) / cellwidth);
-						int v = int(uvj(1) / chellheight);
-
-						if (ft->isBAed != true) {
-							for (int i = 0; i < ft->level; ++i)
-								uvi /= 2.0;
-
-							double Ii = viframe_i->getCVFrame()->getIntensityBilinear(uvi(0), uvi(1), ft->level);
-
-							ft->point->pos_mutex.lock_shared();
-							double initPth = ft->point->pos_[2];
-							ft->point->pos_mutex.unlock_shared();
-							ceres::Problem problem;
-							// std::cout <<" Ii = " << Ii << std::endl;
-							ceres::CostFunction *func = new depthErr(viframe_j, Ii, ft, _SPose_j);
-							problem.AddResidualBlock(func, new ceres::HuberLoss(1), &initPth);
-							ceres::Solver::Options option;
-							option.minimizer_type = ceres::LINE_SEARCH;
-							option.linear_solver_type = ceres::DENSE_QR;
-							option.min_line_search_step_size = 0.001;
-							ceres::Solver::Summary summary;
-							ceres::Solve(option, &problem, &summary);
-							//std::cout << summary.BriefReport() << std::endl;
-							if (summary.termination_type == ceres::CONVERGENCE) {
-								ft->point->pos_mutex.lock_shared();
-								Eigen::Vector3d normPoint = ft->point->pos_ / ft->point->pos_(2);
-								ft->point->pos_mutex.unlock_shared();
-								Eigen::Vector3d Pj = _SPose_j * (initPth * normPoint);
-								if (Pj[2] < 0.00000001 || std::isinf(Pj[2])) {
-									toErase.push_back(*it);
-									if (ft->point->n_succeeded_reproj_ >= 1)
-										ft->point->n_failed_reproj_++;
-									else
-										toErase.push_back(*it);
-
-									continue;
-								}
-
-								uvj = viframe_j->getCam()->world2cam(Pj);
-
-								if (uvj(0) >= width || uvj(1) >= height || uvj(0) <= 0 || uvj(1) <= 0) {
-									toErase.push_back(*it);
-									if (ft->point->n_succeeded_reproj_ >= 1)
-										ft->point->n_failed_reproj_++;
-									else
-										toErase.push_back(*it);
-									continue;
-								}
-
-								Eigen::Matrix<double, 1, 6> Jac;
-								Jac.block<1, 3>(0, 0) = normPoint.transpose() *
-								                        Sophus::SO3d::hat(
-										                        _SPose_j.so3().inverse() *
-										                        (Pj - _SPose_j.translation()));
-
-								Jac.block<1, 3>(0, 3) = normPoint.transpose() * _SPose_j.so3().inverse().matrix();
-								Jac = Jac / (normPoint.transpose() * normPoint);
-
-								double newJac = Jac * infomation.inverse() * Jac.transpose();
-								ft->point->updateDepth(initPth, 1.0 / newJac);
-
-								ft->point->pos_mutex.lock_shared();
-								pos = ft->point->pos_;
-								ft->point->pos_mutex.unlock_shared();
-								pos = _SPose_j * pos;
-								pos /= pos[2];
-								pos_ = pos.block<2, 1>(0, 0);
-								uvj = viframe_j->getCam()->world2cam(pos_);
-
-								u = int(uvj(0) / cellwidth);
-								v = int(uvj(1) / chellheight);
-
-								for (int i = 0; i < ft->level; ++i)
-									uvj /= 2.0;
+	for (size_t k = 0; k < order.size(); ++k) {
+		auto &ft = *order[k];
+		const PointStore::Handle h = handles_[k];
+		Reprojection &res = results[k];
+		if (!res.projected) {
+			if (store.succeeded(h) >= 1)
+				store.failed(h)++;
+			else
+				res.erase = true;
+			continue;
+		}
 
-							}
-							std::shared_ptr<Feature> ft_ = std::make_shared<Feature>(viframe_j->getCVFrame(),
-							                                                         ft->point, uvj, pos, ft->level);
-							ft_->isBAed.exchange(ft->isBAed);
-							ft_->point->obsMutex.lock();
-							ft_->point->obs_.push_back(ft_);
-							ft_->point->obsMutex.unlock();
-							viframe_j->getCVFrame()->addFeature(ft_);
-
-							if (!viframe_j->getCVFrame()->checkCell(u, v)) {
-								viframe_j->getCVFrame()->setCellTrue(u, v);
-								cntCell++;
-							}
-							ft->point->n_succeeded_reproj_++;
-							continue;
-						}
+		Eigen::Vector2d uvj = res.uvj;
+		Eigen::Vector3d pos = res.pos;
+		int u = int(uvj(0) / cellwidth);
+		int v = int(uvj(1) / chellheight);
+		if (res.refined) {
+			store.updateDepth(h, res.depth, res.information);
 
-						else {
-							std::shared_ptr<Feature> ft_ = std::make_shared<Feature>(viframe_j->getCVFrame(),
-							                                                         ft->point, uvj, pos, ft->level);
-							ft_->isBAed.exchange(ft->isBAed);
-							ft_->point->obsMutex.lock();
-							ft_->point->obs_.push_back(ft_);
-							ft_->point->obsMutex.unlock();
-							viframe_j->getCVFrame()->addFeature(ft_);
-							if (!viframe_j->getCVFrame()->checkCell(u, v)) {
-								viframe_j->getCVFrame()->setCellTrue(u, v);
-								cntCell++;
-							}
+			pos = store.position(h);
+			pos = _SPose_j * pos;
+			pos /= pos[2];
+			uvj = viframe_j->getCam()->world2cam(Eigen::Vector2d(pos.block<2, 1>(0, 0)));
 
-							ft->point->n_succeeded_reproj_++;
-							continue;
-						}
-					}
-				}
-			}
+			u = int(uvj(0) / cellwidth);
+			v = int(uvj(1) / chellheight);
+
+			for (int i = 0; i < ft->level; ++i)
+				uvj /= 2.0;
 		}
 
-		if (ft->point->n_succeeded_reproj_ >= 1)
-			ft->point->n_failed_reproj_++;
-		else
-			toErase.push_back(*it);
+		std::shared_ptr<Feature> ft_ = makeFeature(viframe_j->getCVFrame(),
+		                                           ft->point, uvj, pos, ft->level);
+		ft_->isBAed.exchange(ft->isBAed);
+		ft_->point->obsMutex.lock();
+		ft_->point->obs_.push_back(ft_);
+		ft_->point->obsMutex.unlock();
+		viframe_j->getCVFrame()->addFeature(ft_);
+
+		if (!viframe_j->getCVFrame()->checkCell(u, v)) {
+			viframe_j->getCVFrame()->setCellTrue(u, v);
+			cntCell++;
+		}
+		store.succeeded(h)++;
 	}
 
-	for (auto &it : toErase)
-		fts.remove(it);
+	// the iterators are still valid, frame j has its own list
+	for (size_t k = 0; k < order.size(); ++k)
+		if (results[k].erase)
+			fts.erase(order[k]);
 
 	return cntCell;
 }
 
-bool Tracker::Tracking(std::shared_ptr<viFrame> &viframe_i, std::shared_ptr<viFrame> &viframe_j,
-                       Sophus::SE3d &T_ij_, Eigen::Matrix<double, 6, 6> &infomation, int n_iter) {
-
+bool Tracker::solveCeres(std::shared_ptr<viFrame> &viframe_i, std::shared_ptr<viFrame> &viframe_j,
+                         const std::vector<std::shared_ptr<Feature>> &fts, const RotationPrior *prior,
+                         Sophus::SE3d &T_ij_, int n_iter) {
 	ceres::Problem problem;
 	ceres::Solver::Options options;
 	ceres::Solver::Summary summary;
 
-	cvMeasure::features_t &fts = viframe_i->getCVFrame()->getMeasure().fts_;
-	std::cout << "the size of fts is : " << fts.size() << std::endl;
 	Eigen::Vector3d so3 = T_ij_.so3().log();
 	Eigen::Vector3d &tij = T_ij_.translation();
 	double t_ij[6];
@@ -428,20 +367,144 @@ bool Tracker::Tracking(std::shared_ptr<viFrame> &viframe_i, std::shared_ptr<viFr
 		t_ij[i] = so3(i);
 		t_ij[3 + i] = tij(i);
 	}
+
+	std::shared_ptr<PhotometricBatch> batch = std::make_shared<PhotometricBatch>(viframe_i, viframe_j);
+	for (auto &ft : fts)
+		problem.AddResidualBlock(new TrackingErr(batch, batch->add(ft)), new ceres::HuberLoss(0.5), t_ij);
+	if (prior) {
+		// R_ij = R_Si^-1 * R_ji * R_Si, a perturbation of R_ji is R_Si times one of R_ij
+		const Sophus::SO3d R_Si = (viframe_i->getT_BS().inverse() * viframe_i->getPose()).so3();
+		problem.AddResidualBlock(new RotationPriorErr(R_Si.inverse() * prior->R_ji * R_Si,
+		                                              prior->sqrtInfo * R_Si.matrix()), nullptr, t_ij);
+	}
+
+	problem.SetParameterization(t_ij, new SE3Parameterization);
+
+	options.max_num_iterations = n_iter;
+	options.minimizer_type = ceres::TRUST_REGION;
+	options.trust_region_strategy_type = ceres::DOGLEG;
+	options.linear_solver_type = ceres::DENSE_QR;
+	//options.minimizer_progress_to_stdout = true;
+
+	ceres::Solve(options, &problem, &summary);
+	iterations_ = summary.num_successful_steps + summary.num_unsuccessful_steps;
+	TRACE_GAUGE("tracking iterations", iterations_);
+	TRACE_GAUGE("tracking cost", summary.final_cost);
+	for (int i = 0; i < 3; ++i) {
+		so3(i) = t_ij[i];
+		tij(i) = t_ij[3 + i];
+	}
+
+	if (summary.termination_type != ceres::CONVERGENCE)
+		return false;
+	T_ij_.so3() = Sophus::SO3d::exp(so3);
+	return true;
+}
+
+bool Tracker::solveGaussNewton(std::shared_ptr<viFrame> &viframe_i, std::shared_ptr<viFrame> &viframe_j,
+                               const std::vector<std::shared_ptr<Feature>> &fts, const RotationPrior *prior,
+                               Sophus::SE3d &T_ij_, int n_iter) {
+	// T_ij_ acts on world points ahead of T_Si, the solver wants the camera i -> camera j motion
+	const Sophus::SE3d T_Si = viframe_i->getT_BS().inverse() * viframe_i->getPose();
+	Sophus::SE3d T_ji = T_Si * T_ij_ * T_Si.inverse();
+	const bool solved = gaussNewton_->solve(viframe_i, viframe_j, fts, T_ji, n_iter, prior);
+	iterations_ = gaussNewton_->iterations();
+	TRACE_GAUGE("tracking iterations", iterations_);
+	TRACE_GAUGE("tracking cost", gaussNewton_->finalCost());
+	if (!solved)
+		return false;
+	T_ij_ = T_Si.inverse() * T_ji * T_Si;
+
+	// same bookkeeping as TrackingErr: features that left frame j are not projected any more
+	const viFrame::cam_t &cam = viframe_j->getCam();
+	const int width = viframe_j->getCVFrame()->getWidth();
+	const int height = viframe_j->getCVFrame()->getHeight();
+	gatherPoints(fts, handles_, positions_);
+	for (size_t k = 0; k < fts.size(); ++k) {
+		const Eigen::Vector3d pj = T_Si * T_ij_ * positions_[k];
+		if (pj(2) <= 0.0000000001) {
+			fts[k]->isProjected = false;
+			continue;
+		}
+		const Eigen::Vector2d uv = cam->world2cam(pj);
+		if (uv(0) < 0 || uv(0) >= width || uv(1) < 0 || uv(1) >= height)
+			fts[k]->isProjected = false;
+	}
+	return true;
+}
+
+MotionPrior MotionPrior::between(const Sophus::SO3d &R_i, const Sophus::SO3d &R_j, double dt, double sigma_g_c) {
+	MotionPrior prior;
+	prior.dR = R_i.inverse() * R_j;
+	prior.covariance = (sigma_g_c * sigma_g_c * dt + GyroBiasSigma * GyroBiasSigma * dt * dt) * Eigen::Matrix3d::Identity();
+	return prior;
+}
+
+Sophus::SE3d Tracker::predict(std::shared_ptr<viFrame> &viframe_i, const MotionPrior &prior) {
+	// camera i -> camera j of a body rotating about its own origin, then in the world point form of T_ij
+	const Sophus::SE3d T_BS = viframe_i->getT_BS();
+	const Sophus::SE3d T_ji = T_BS.inverse() * Sophus::SE3d(prior.dR.inverse(), Eigen::Vector3d::Zero()) * T_BS;
+	const Sophus::SE3d T_Si = T_BS.inverse() * viframe_i->getPose();
+	return T_Si.inverse() * T_ji * T_Si;
+}
+
+bool Tracker::Tracking(std::shared_ptr<viFrame> &viframe_i, std::shared_ptr<viFrame> &viframe_j,
+                       Sophus::SE3d &T_ij_, Eigen::Matrix<double, 6, 6> &infomation, int n_iter) {
+	return track(viframe_i, viframe_j, nullptr, T_ij_, infomation, n_iter);
+}
+
+bool Tracker::Tracking(std::shared_ptr<viFrame> &viframe_i, std::shared_ptr<viFrame> &viframe_j,
+                       const MotionPrior &prior, Sophus::SE3d &T_ij_, Eigen::Matrix<double, 6, 6> &infomation,
+                       int n_iter) {
+	T_ij_ = predict(viframe_i, prior);
+	return track(viframe_i, viframe_j, &prior, T_ij_, infomation, n_iter);
+}
+
+bool Tracker::track(std::shared_ptr<viFrame> &viframe_i, std::shared_ptr<viFrame> &viframe_j, const MotionPrior *prior,
+                    Sophus::SE3d &T_ij_, Eigen::Matrix<double, 6, 6> &infomation, int n_iter) {
+	TRACE_SCOPE("tracking");
+
+	// the prior in camera i -> camera j terms: R_ji = R_SB * dR^-1 * R_BS, a perturbation phi of dR moves it by
+	// -R_SB * dR * phi. its 3 sigma in pixels bounds how far the predicted projections may be off
+	iterations_ = 0;
+	RotationPrior camPrior;
+	double radius = 0.0;
+	if (prior) {
+		const Sophus::SO3d R_SB = viframe_i->getT_BS().so3().inverse();
+		const Eigen::Matrix3d M = (R_SB * prior->dR).matrix();
+		camPrior.R_ji = R_SB * prior->dR.inverse() * R_SB.inverse();
+		camPrior.sqrtInfo = RotationPriorWeight * (M * prior->covariance * M.transpose()).llt().matrixL()
+		        .solve(Eigen::Matrix3d::Identity());
+		radius = 3.0 * viframe_j->getCam()->fx() * std::sqrt(prior->covariance.trace());
+	}
+	const bool predicted = prefilter_ == PREFILTER_PREDICTED;
+	const bool prefilter = !predicted || (prior && radius <= PrefilterRadius);
+	// a loose prior doesn't starve the tracking, the band stays an eighth of the image at most
+	const double border = predicted ? std::min(3.0 + radius, std::min(viframe_j->getCVFrame()->getWidth(),
+	                                                                  viframe_j->getCVFrame()->getHeight()) / 8.0)
+	                                : 3.0;
+
+	cvMeasure::features_t &fts = viframe_i->getCVFrame()->getMeasure().fts_;
+	TRACE_GAUGE("tracked features", fts.size());
 	int numOpt = 0;
-	std::list<cvMeasure::features_t::iterator> toErase;
+	std::vector<cvMeasure::features_t::iterator> toErase;
+	std::vector<cvMeasure::features_t::iterator> candidates;
+	std::vector<std::shared_ptr<Feature>> accepted;
+	std::vector<PhotometricBatch::PatternQuery> queries;
 	auto &model = trackModel();
 	auto T_SB = viframe_i->getT_BS().inverse();
-	for (cvMeasure::features_t::iterator it = fts.begin(); it != fts.end(); it++) {
-		auto ft = *it;
-
-		ft->point->pos_mutex.lock_shared();
-		const Eigen::Vector3d p = ft->point->pos_;
-		ft->point->pos_mutex.unlock_shared();
-		Eigen::Vector3d pi = viframe_i->getCVFrame()->getPose() * p;
+	// the poses are read once, not under their lock for every feature
+	const Sophus::SE3d pose_i = viframe_i->getCVFrame()->getPose();
+	const Sophus::SE3d T_Sij = T_SB * viframe_i->getPose() * T_ij_;
+	gatherPoints(fts, handles_, positions_);
+	size_t k = 0;
+	for (cvMeasure::features_t::iterator it = fts.begin(); it != fts.end(); it++, k++) {
+		const std::shared_ptr<Feature> &ft = *it;
+
+		const Eigen::Vector3d &p = positions_[k];
+		Eigen::Vector3d pi = pose_i * p;
 		if (pi(2) > 0.0000000001) {
-			Sophus::SE3d T_Si = T_SB * viframe_i->getPose();
-			Eigen::Vector3d pj = T_Si * T_ij_ * p;
+			Eigen::Vector3d pj = T_Sij * p;
 
 			if (pj(2) > 0.0000000001) {
 				const viFrame::cam_t &cam = viframe_j->getCam();
@@ -454,32 +517,28 @@ bool Tracker::Tracking(std::shared_ptr<viFrame> &viframe_i, std::shared_ptr<viFr
 						if (px(0) >= 3 && px(0) < viframe_i->getCVFrame()->getWidth() - 3
 						    && px(1) >= 3 && px(1) < viframe_i->getCVFrame()->getHeight() - 3) {
 
+							// may be in frame j or not, left out of this tracking but kept
+							if (u < border || u >= viframe_j->getCVFrame()->getWidth() - border
+							    || v < border || v >= viframe_j->getCVFrame()->getHeight() - border) {
+								ft->isProjected = false;
+								continue;
+							}
+							if (!prefilter) {
+								numOpt++;
+								accepted.push_back(ft);
+								continue;
+							}
+
 							for (int i = 0; i < ft->level; ++i) {
 								u /= 2.0;
 								v /= 2.0;
 								px /= 2.0;
 							}
 
-							double err = 0.0;
-							for (auto &step : model) {
-								double u_ = u + double(step(0, 0));
-								double v_ = v + double(step(1, 0));
-								double px0 = px(0, 0) + double(step(0, 0));
-								double px1 = px(1, 0) + double(step(1, 0));
-								Eigen::Vector2d px_ = px;
-								px_(0, 0) += step(0, 0);
-								px_(1, 0) += step(1, 0);
-								err += std::abs(viframe_j->getCVFrame()->getIntensityBilinear(u_, v_, ft->level) -
-								                viframe_i->getCVFrame()->getIntensityBilinear(px0, px1, ft->level));
-							}
-
-							if (err < model.size() * IuminanceErr) {
-								//std::cout << "err = " << err << std::endl;
-								numOpt++;
-								problem.AddResidualBlock(new TrackingErr(ft, viframe_i, viframe_j),
-								                         new ceres::HuberLoss(0.5), t_ij);
-								continue;
-							}
+							PhotometricBatch::PatternQuery query = {float(u), float(v), float(px(0)), float(px(1)), ft->level};
+							queries.push_back(query);
+							candidates.push_back(it);
+							continue;
 						}
 					}
 				}
@@ -489,45 +548,47 @@ bool Tracker::Tracking(std::shared_ptr<viFrame> &viframe_i, std::shared_ptr<viFr
 		toErase.push_back(it);
 	}
 
-	printf("the num of bad point : %lu\n", toErase.size());
-	for (auto it : toErase) {
+	// pattern pre-filter for all candidates in one call
+	std::vector<float> patternErr;
+	PhotometricBatch(viframe_i, viframe_j).patternError(queries, patternErr);
+	for (size_t k = 0; k < candidates.size(); ++k) {
+		if (patternErr[k] < model.size() * IuminanceErr) {
+			numOpt++;
+			accepted.push_back(*candidates[k]);
+			continue;
+		}
+		(*candidates[k])->isProjected = false;
+		toErase.push_back(candidates[k]);
+	}
+
+	TRACE_GAUGE("rejected features", toErase.size());
+	for (auto &it : toErase) {
 		if ((*it)->point->n_succeeded_reproj_ < 2)
 			fts.erase(it);
 	}
 
 	if (numOpt < 20) {
-		std::cout << "the num of project point is too small : " << numOpt << std::endl;
+		TRACE_COUNT("too few tracked features", 1);
 		return false;
 	}
 
-	problem.SetParameterization(t_ij, new SE3Parameterization);
-
-	options.max_num_iterations = n_iter;
-	options.minimizer_type = ceres::TRUST_REGION;
-	options.trust_region_strategy_type = ceres::DOGLEG;
-	options.linear_solver_type = ceres::DENSE_QR;
-	//options.minimizer_progress_to_stdout = true;
-
-	ceres::Solve(options, &problem, &summary);
-	std::cout << summary.BriefReport() << std::endl;
-	for (int i = 0; i < 3; ++i) {
-		so3(i) = t_ij[i];
-		tij(i) = t_ij[3 + i];
-	}
-
-	if (summary.termination_type != ceres::CONVERGENCE)
+	const RotationPrior *residual = prior && rotationPrior_ ? &camPrior : nullptr;
+	bool converged = type_ == GAUSS_NEWTON_TRACKING ? solveGaussNewton(viframe_i, viframe_j, accepted, residual, T_ij_, n_iter)
+	                                                : solveCeres(viframe_i, viframe_j, accepted, residual, T_ij_, n_iter);
+	if (!converged)
 		return false;
-	T_ij_.so3() = Sophus::SO3d::exp(so3);
 
 	int cnt = 0;
 	double sq_norm = 0.0;
 	infomation = Eigen::Matrix<double, 6, 6>::Zero();
-	for (auto &ft : fts) {
-		if (ft->isProjected == false) continue;
-		ft->point->pos_mutex.lock_shared();
-		Eigen::Vector3d pj = T_ij_.so3().inverse() * (T_ij_ * ft->point->pos_);
-		Eigen::Vector3d normP = ft->point->pos_ / ft->point->pos_(2);
-		ft->point->pos_mutex.unlock_shared();
+	gatherPoints(fts, handles_, positions_, &depthInfo_);
+	k = 0;
+	for (auto it = fts.begin(); it != fts.end(); ++it, ++k) {
+		if ((*it)->isProjected == false) continue;
+		const Eigen::Vector3d &pw = positions_[k];
+		const double depthInfo = depthInfo_[k];
+		Eigen::Vector3d pj = T_ij_.so3().inverse() * (T_ij_ * pw);
+		Eigen::Vector3d normP = pw / pw(2);
 		if (pj(2) < 0.000000001 || std::isinf(pj(2)))
 			continue;
 
@@ -535,7 +596,7 @@ bool Tracker::Tracking(std::shared_ptr<viFrame> &viframe_i, std::shared_ptr<viFr
 		Jac.block<1, 3>(0, 0) = normP.transpose() * Sophus::SO3d::hat(pj);
 		Jac.block<1, 3>(0, 3) = normP.transpose();
 		sq_norm += Jac * Jac.transpose();
-		infomation += Jac.transpose() * Jac * (1.0 / ft->point->getDepthInformation());
+		infomation += Jac.transpose() * Jac * (1.0 / depthInfo);
 		cnt++;
 	}
 
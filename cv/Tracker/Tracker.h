@@ -6,22 +6,83 @@
 #define SIMPLE_VIO_TRACKER_H
 
 #include <memory>
+#include <vector>
 #include "ThirdParty/sophus/se3.hpp"
+#include "DataStructure/cv/PointStore.h"
 
 class cvFrame;
 class viFrame;
+struct Feature;
+class ThreadReduce;
 
 namespace direct_tracker {
 
+    class GaussNewtonTracker;
+    struct RotationPrior;
+
+    /// the motion the IMU predicts from frame i to frame j
+    struct MotionPrior {
+        Sophus::SO3d    dR;             //!< R_BiBj, the gyroscopes integrated between the two frames
+        Eigen::Matrix3d covariance;     //!< of dR, right perturbation [rad^2]
+
+        /// out of one integration which ran through both frames: R_i and R_j are the rotations it had integrated
+        /// when it reached frame i and frame j, dt apart. the gyro noise plus the bias the integration left out
+        static MotionPrior between(const Sophus::SO3d &R_i, const Sophus::SO3d &R_j, double dt, double sigma_g_c);
+    };
+
     class Tracker {
     public:
-        Tracker();
+        enum TrackingType {
+            CERES_TRACKING,             //!< one TrackingErr block per feature, DOGLEG on the detection levels
+            GAUSS_NEWTON_TRACKING       //!< GaussNewtonTracker, coarse to fine over the pyramid
+        };
+
+        enum PrefilterType {
+            PREFILTER_ALL,              //!< the pattern error at the initial T_ij for every visible feature
+            PREFILTER_PREDICTED         //!< only when a motion prior predicts the projections within PrefilterRadius,
+                                        //!< features which may leave frame j under the prior's uncertainty stay out
+        };
+
+    public:
+        Tracker(TrackingType type = CERES_TRACKING);
+        void setTrackingType(TrackingType type) { type_ = type; }
+        TrackingType getTrackingType() const { return type_; }
+        void setPrefilterType(PrefilterType type) { prefilter_ = type; }
+        /// add the rotation of a motion prior as a residual, otherwise it only seeds T_ij
+        void setRotationPrior(bool use) { rotationPrior_ = use; }
         bool Tracking(std::shared_ptr<viFrame>&viframe_i, std::shared_ptr<viFrame>&viframe_j,
                       Sophus::SE3d &Tij, Eigen::Matrix<double, 6, 6>& infomation, int n_iter = 30);
+        /// Tij starts from the prediction of prior instead of the value passed in
+        bool Tracking(std::shared_ptr<viFrame>&viframe_i, std::shared_ptr<viFrame>&viframe_j, const MotionPrior &prior,
+                      Sophus::SE3d &Tij, Eigen::Matrix<double, 6, 6>& infomation, int n_iter = 30);
         int  reProject(std::shared_ptr<viFrame>&viframe_i, std::shared_ptr<viFrame>&viframe_j,
                        Sophus::SE3d &Tij, Eigen::Matrix<double, 6, 6>& infomation);
+
+        /// Tij (world points ahead of frame i's pose) for a body that only rotates by prior.dR
+        static Sophus::SE3d predict(std::shared_ptr<viFrame>&viframe_i, const MotionPrior &prior);
+        /// solver iterations of the last Tracking
+        int iterations() const { return iterations_; }
+
     private:
+        bool track(std::shared_ptr<viFrame>&viframe_i, std::shared_ptr<viFrame>&viframe_j, const MotionPrior *prior,
+                   Sophus::SE3d &Tij, Eigen::Matrix<double, 6, 6>& infomation, int n_iter);
+        bool solveCeres(std::shared_ptr<viFrame>&viframe_i, std::shared_ptr<viFrame>&viframe_j,
+                        const std::vector<std::shared_ptr<Feature>>& fts, const RotationPrior *prior,
+                        Sophus::SE3d &Tij, int n_iter);
+        bool solveGaussNewton(std::shared_ptr<viFrame>&viframe_i, std::shared_ptr<viFrame>&viframe_j,
+                              const std::vector<std::shared_ptr<Feature>>& fts, const RotationPrior *prior,
+                              Sophus::SE3d &Tij, int n_iter);
 
+    private:
+        TrackingType                        type_;
+        PrefilterType                       prefilter_;
+        bool                                rotationPrior_;
+        int                                 iterations_;
+        std::shared_ptr<GaussNewtonTracker> gaussNewton_;
+        std::shared_ptr<ThreadReduce>       threadReduce_;      //!< runs the depth refinements of reProject
+        std::vector<PointStore::Handle>     handles_;           //!< points of the features of one pass, gathered once
+        std::vector<Eigen::Vector3d>        positions_;
+        std::vector<double>                 depthInfo_;
     };
 }
 
@@ -0,0 +1,51 @@
+#include <boost/random.hpp>
+#include "opencv2/ts/ts.hpp"
+
+#include "../PhotometricBatch.h"
+#include "DataStructure/cv/cvFrame.h"
+#include "util/util.h"
+
+TEST(PhotometricBatch, sampler) {
+    cv::Mat pic(480, 752, CV_8UC1);
+    cv::randu(pic, cv::Scalar(0), cv::Scalar(256));
+    std::shared_ptr<cvFrame> frame = std::make_shared<cvFrame>(nullptr, pic);
+    frame->preparePyramid();
+
+    boost::mt19937 rng(7);
+    const int n = 20000;
+    for(int level = 0; level < IMG_LEVEL; ++level) {
+        const ImgLevel& img = frame->gradientLevel(level);
+        // a few samples fall outside the image on purpose
+        boost::uniform_real<float> du(-2.0f, img.width + 1.0f), dv(-2.0f, img.height + 1.0f);
+        std::vector<float> u(n), v(n), I(n), gx(n), gy(n), gn(n);
+        std::vector<int> ui(n), vi(n);
+        for(int k = 0; k < n; ++k) {
+            u[k] = du(rng);         v[k] = dv(rng);
+            ui[k] = int(u[k]);      vi[k] = int(v[k]);
+        }
+
+        {
+            printf("level %d, %d bilinear samples:\n", level, n);
+            TimeUse time(__FUNCTION__, __LINE__);
+            direct_tracker::sampleIntensity(img, u.data(), v.data(), n, I.data());
+        }
+        {
+            TimeUse time(__FUNCTION__, __LINE__);
+            double sum = 0.0;
+            for(int k = 0; k < n; ++k)
+                sum += frame->getIntensityBilinear(u[k], v[k], level);
+            printf("cvFrame::getIntensityBilinear, checksum %f\n", sum);
+        }
+        direct_tracker::sampleGradient(img, ui.data(), vi.data(), n, gx.data(), gy.data(), gn.data());
+
+        for(int k = 0; k < n; ++k) {
+            EXPECT_NEAR(I[k], frame->getIntensityBilinear(u[k], v[k], level), 1e-3);
+            EXPECT_NEAR(gn[k], frame->getGradNorm(ui[k], vi[k], level), 1e-6);
+            Eigen::Vector2d grad;
+            if(frame->getGrad(ui[k], vi[k], grad, level)) {
+                EXPECT_NEAR(gx[k], grad(0), 1e-6);
+                EXPECT_NEAR(gy[k], grad(1), 1e-6);
+            }
+        }
+    }
+}
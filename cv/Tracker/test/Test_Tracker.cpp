@@ -2,6 +2,10 @@
 // Created by lancelot on 2/27/17.
 //
 
+#include <chrono>
+#include <cmath>
+#include <algorithm>
+
 #include "../Tracker.h"
 #include "opencv2/ts/ts.hpp"
 #include "DataStructure/viFrame.h"
@@ -10,6 +14,55 @@
 #include "cv/FeatureDetector/Detector.h"
 #include "DataStructure/cv/Feature.h"
 #include "DataStructure/imu/IMUMeasure.h"
+#include "util/util.h"
+#include "util/setting.h"
+#include "IO/imu/IMUIO.h"
+#include "IO/Dataset.h"
+#include "IO/TextLoader.h"
+#include "IMU/Preintegrator.h"
+
+namespace {
+	typedef std::vector<std::pair<int64_t, Eigen::Quaterniond>> Orientations;
+
+	// q_RS of the EuRoC ground truth: the orientation of the body in the world, by timestamp
+	bool loadGroundTruth(const std::string &file, Orientations &truth) {
+		std::vector<char> buf;
+		if(!loader::readFile(file, buf))
+			return false;
+		std::vector<loader::Line> lines;
+		loader::splitLines(buf, lines);
+		for(auto &line : lines) {
+			int64_t t;
+			double v[7];
+			const char* p = loader::parseInt64(line.begin, line.end, t);
+			for(int j = 0; j < 7 && p; ++j) {
+				p = loader::skipPast(p, line.end, ',');
+				if(p)
+					p = loader::parseDouble(p, line.end, v[j]);
+			}
+			if(!p)
+				continue;
+			truth.push_back(std::make_pair(t, Eigen::Quaterniond(v[3], v[4], v[5], v[6]).normalized()));
+		}
+		return !truth.empty();
+	}
+
+	// the sample closest to t, 200 Hz is close enough for a rotation error in tenths of a degree
+	Sophus::SO3d orientationAt(const Orientations &truth, int64_t t) {
+		auto it = std::lower_bound(truth.begin(), truth.end(), t,
+		                           [](const std::pair<int64_t, Eigen::Quaterniond> &s, int64_t t) { return s.first < t; });
+		if(it == truth.end() || (it != truth.begin() && t - (it - 1)->first < it->first - t))
+			--it;
+		return Sophus::SO3d(it->second);
+	}
+
+	double percentile(std::vector<double> v, double q) {
+		if(v.empty())
+			return 0.0;
+		std::sort(v.begin(), v.end());
+		return v[std::min(v.size() - 1, size_t(q * v.size()))];
+	}
+}
 
 TEST(Tracker, Tracker) {
 
@@ -122,3 +175,254 @@ TEST(Tracker, Tracker) {
         printf("failed!\n");
 
 }
+
+TEST(Tracker, GaussNewton) {
+	std::string camDatafile = "../testData/mav0/cam1/data.csv";
+	std::string camParamfile ="../testData/mav0/cam1/sensor.yaml";
+	CameraIO camTest(camDatafile,camParamfile);
+	const CameraIO::pCamereParam cam = camTest.getCamera();
+	cv::Mat pic_i = Undistort(cv::imread("../testData/mav0/cam0/data/1403715278262142976.png", 0), cam);
+	cv::Mat pic_j = Undistort(cv::imread("../testData/mav0/cam0/data/1403715278312143104.png", 0), cam);
+	auto imuParam = std::make_shared<ImuParameters>();
+
+	// Tracking drops outliers from frame i, so every engine gets its own copy of the pair
+	auto makePair = [&](std::shared_ptr<viFrame>& viframe_i, std::shared_ptr<viFrame>& viframe_j) {
+		std::shared_ptr<cvFrame> cvframe_i = std::make_shared<cvFrame>(cam, pic_i);
+		cvMeasure::features_t fts;
+		feature_detection::Detector detector(pic_i.cols, pic_i.rows, 25, IMG_LEVEL);
+		detector.detect(cvframe_i, cvframe_i->getMeasure().measurement.imgPyr, fts);
+		for(auto &ft : fts)
+			cvframe_i->addFeature(ft);
+		viframe_i = std::make_shared<viFrame>(1, cvframe_i, imuParam);
+		std::shared_ptr<cvFrame> cvframe_j = std::make_shared<cvFrame>(cam, pic_j);
+		viframe_j = std::make_shared<viFrame>(2, cvframe_j, imuParam);
+	};
+
+	Eigen::Matrix<double, 6, 6> info;
+	std::shared_ptr<viFrame> viframe_i, viframe_j;
+	Sophus::SE3d T_ceres, T_gn;
+	bool ceresTracked, gnTracked;
+
+	makePair(viframe_i, viframe_j);
+	direct_tracker::Tracker ceresTracker(direct_tracker::Tracker::CERES_TRACKING);
+	{
+		printf("ceres tracking:\n");
+		TimeUse time(__FUNCTION__, __LINE__);
+		ceresTracked = ceresTracker.Tracking(viframe_i, viframe_j, T_ceres, info, 50);
+	}
+
+	makePair(viframe_i, viframe_j);
+	direct_tracker::Tracker gnTracker(direct_tracker::Tracker::GAUSS_NEWTON_TRACKING);
+	{
+		printf("gauss-newton tracking:\n");
+		TimeUse time(__FUNCTION__, __LINE__);
+		gnTracked = gnTracker.Tracking(viframe_i, viframe_j, T_gn, info, 50);
+	}
+
+	printf("ceres: %d, gauss-newton: %d\n", ceresTracked, gnTracked);
+	std::cout << "ceres:\n" << T_ceres.matrix3x4() << "\ngauss-newton:\n" << T_gn.matrix3x4() << std::endl;
+	ASSERT_TRUE(gnTracked);
+	if(ceresTracked) {
+		// both engines minimise the same photometric error, they have to land on the same motion
+		EXPECT_LT((T_ceres.so3().inverse() * T_gn.so3()).log().norm(), 0.01);
+		EXPECT_LT((T_ceres.translation() - T_gn.translation()).norm(), 0.05);
+	}
+}
+
+// the same pair from identity and from the gyro prediction, both engines, with the prior as residual
+TEST(Tracker, RotationPrior) {
+	std::string camDatafile = "../testData/mav0/cam1/data.csv";
+	std::string camParamfile ="../testData/mav0/cam1/sensor.yaml";
+	CameraIO camTest(camDatafile,camParamfile);
+	const CameraIO::pCamereParam cam = camTest.getCamera();
+	cv::Mat pic_i = Undistort(cv::imread("../testData/mav0/cam0/data/1403715278262142976.png", 0), cam);
+	cv::Mat pic_j = Undistort(cv::imread("../testData/mav0/cam0/data/1403715278312143104.png", 0), cam);
+	std::string imuDatafile("../testData/mav0/imu0/data.csv");
+	std::string imuParamfile("../testData/mav0/imu0/sensor.yaml");
+	IMUIO imuIO(imuDatafile, imuParamfile);
+	std::shared_ptr<ImuParameters> imuParam = imuIO.getImuParam();
+
+	okvis::Time start, end;
+	start.fromNSec(1403715278262142976ULL);
+	end.fromNSec(1403715278312143104ULL);
+	okvis::Time from = start;
+	Preintegrator pre(*imuParam, start, Eigen::Vector3d::Zero(), Eigen::Vector3d::Zero());
+	for(auto &m : imuIO.pop(from, end))
+		pre.add(m->timeStamp, m->measurement.gyroscopes, m->measurement.acceleration, end);
+	ASSERT_TRUE(pre.time() == end);
+	const direct_tracker::MotionPrior prior = direct_tracker::MotionPrior::between(
+			Sophus::SO3d(), pre.deltaR(), (end - start).toSec(), imuParam->sigma_g_c);
+
+	auto makePair = [&](std::shared_ptr<viFrame>& viframe_i, std::shared_ptr<viFrame>& viframe_j) {
+		std::shared_ptr<cvFrame> cvframe_i = std::make_shared<cvFrame>(cam, pic_i);
+		cvMeasure::features_t fts;
+		feature_detection::Detector detector(pic_i.cols, pic_i.rows, 25, IMG_LEVEL);
+		detector.detect(cvframe_i, cvframe_i->getMeasure().measurement.imgPyr, fts);
+		for(auto &ft : fts)
+			cvframe_i->addFeature(ft);
+		viframe_i = std::make_shared<viFrame>(1, cvframe_i, imuParam);
+		std::shared_ptr<cvFrame> cvframe_j = std::make_shared<cvFrame>(cam, pic_j);
+		viframe_j = std::make_shared<viFrame>(2, cvframe_j, imuParam);
+	};
+
+	const direct_tracker::Tracker::TrackingType types[] = {direct_tracker::Tracker::CERES_TRACKING,
+	                                                       direct_tracker::Tracker::GAUSS_NEWTON_TRACKING};
+	for(auto type : types) {
+		Eigen::Matrix<double, 6, 6> info;
+		std::shared_ptr<viFrame> viframe_i, viframe_j;
+
+		makePair(viframe_i, viframe_j);
+		direct_tracker::Tracker plain(type);
+		Sophus::SE3d T_plain;
+		const bool plainTracked = plain.Tracking(viframe_i, viframe_j, T_plain, info, 50);
+
+		makePair(viframe_i, viframe_j);
+		direct_tracker::Tracker imu(type);
+		imu.setRotationPrior(true);
+		imu.setPrefilterType(direct_tracker::Tracker::PREFILTER_PREDICTED);
+		Sophus::SE3d T_imu;
+		const bool imuTracked = imu.Tracking(viframe_i, viframe_j, prior, T_imu, info, 50);
+		const Sophus::SE3d T_predicted = direct_tracker::Tracker::predict(viframe_i, prior);
+
+		printf("%s: identity %d in %d iterations, prior %d in %d iterations, %.4f rad from the prediction\n",
+		       type == direct_tracker::Tracker::CERES_TRACKING ? "ceres" : "gauss-newton",
+		       plainTracked, plain.iterations(), imuTracked, imu.iterations(),
+		       (T_predicted.so3().inverse() * T_imu.so3()).log().norm());
+		ASSERT_TRUE(imuTracked);
+		EXPECT_LT((T_predicted.so3().inverse() * T_imu.so3()).log().norm(), 3.0 * std::sqrt(prior.covariance.trace()));
+		if(plainTracked)
+			EXPECT_LE(imu.iterations(), plain.iterations());
+	}
+}
+
+// frame 1 is lost, frame 2 is tracked against frame 0 as the system does. the prior has to cover both intervals,
+// the rotation since the last integrated frame would only be the one from frame 1 to frame 2
+TEST(Tracker, SkippedFrame) {
+	Dataset dataset("../testData/mav0", 0);
+	ASSERT_TRUE(dataset.good());
+	const CameraIO::pCamereParam &cam = dataset.camera();
+	std::shared_ptr<ImageIO> images = dataset.imageIO(true);
+	std::vector<std::pair<okvis::Time, cv::Mat>> frames;
+	while(!images->isEmpty() && frames.size() < 3)
+		frames.push_back(images->popImageAndTimestamp());
+	ASSERT_EQ(frames.size(), size_t(3));
+
+	// one integration through all three frames, the rotations it had when it reached each of them
+	std::shared_ptr<IMUIO> imuIO = dataset.imuIO();
+	const std::shared_ptr<ImuParameters> &imuParam = dataset.imuParam();
+	Preintegrator pre(*imuParam, frames[0].first, Eigen::Vector3d::Zero(), Eigen::Vector3d::Zero());
+	Sophus::SO3d R[3];
+	for(int k = 1; k < 3; ++k) {
+		okvis::Time start = pre.time(), end = frames[k].first;
+		for(auto &m : imuIO->pop(start, end))
+			pre.add(m->timeStamp, m->measurement.gyroscopes, m->measurement.acceleration, end);
+		ASSERT_TRUE(pre.time() == frames[k].first);
+		R[k] = pre.deltaR();
+	}
+	const direct_tracker::MotionPrior prior = direct_tracker::MotionPrior::between(
+			R[0], R[2], (frames[2].first - frames[0].first).toSec(), imuParam->sigma_g_c);
+	const direct_tracker::MotionPrior lastFrame = direct_tracker::MotionPrior::between(
+			R[1], R[2], (frames[2].first - frames[1].first).toSec(), imuParam->sigma_g_c);
+
+	std::shared_ptr<cvFrame> cvframe_i = std::make_shared<cvFrame>(cam, frames[0].second);
+	cvMeasure::features_t fts;
+	feature_detection::Detector detector(cvframe_i->getWidth(), cvframe_i->getHeight(), 25, IMG_LEVEL);
+	detector.detect(cvframe_i, cvframe_i->getMeasure().measurement.imgPyr, fts);
+	for(auto &ft : fts)
+		cvframe_i->addFeature(ft);
+	std::shared_ptr<cvFrame> cvframe_j = std::make_shared<cvFrame>(cam, frames[2].second);
+	std::shared_ptr<viFrame> viframe_i = std::make_shared<viFrame>(0, cvframe_i, imuParam);
+	std::shared_ptr<viFrame> viframe_j = std::make_shared<viFrame>(2, cvframe_j, imuParam);
+
+	direct_tracker::Tracker tracker(direct_tracker::Tracker::GAUSS_NEWTON_TRACKING);
+	tracker.setRotationPrior(true);
+	tracker.setPrefilterType(direct_tracker::Tracker::PREFILTER_PREDICTED);
+	Sophus::SE3d T_ij;
+	Eigen::Matrix<double, 6, 6> info;
+	ASSERT_TRUE(tracker.Tracking(viframe_i, viframe_j, prior, T_ij, info, 50));
+
+	// the tracked rotation in the body frame, R_BiBj like the prior
+	const Sophus::SE3d T_BS = viframe_i->getT_BS();
+	const Sophus::SE3d T_Si = T_BS.inverse() * viframe_i->getPose();
+	const Sophus::SO3d R_BiBj = (T_BS * (T_Si * T_ij * T_Si.inverse()) * T_BS.inverse()).so3().inverse();
+	const double error = (prior.dR.inverse() * R_BiBj).log().norm();
+	const double lastFrameError = (lastFrame.dR.inverse() * R_BiBj).log().norm();
+	printf("%d iterations, %.4f rad from the prior over both intervals, %.4f rad from the one since frame 1\n",
+	       tracker.iterations(), error, lastFrameError);
+	EXPECT_LT(error, 3.0 * std::sqrt(prior.covariance.trace()));
+	EXPECT_LE(error, lastFrameError);
+}
+
+// a stretch of the sequence tracked frame to frame, every frame a fresh keyframe for the next one, with both
+// engines: the latency of every Tracking call and its rotation against the ground truth
+TEST(Tracker, Sequence) {
+	Dataset dataset("../testData/mav0", 0);
+	ASSERT_TRUE(dataset.good());
+	const CameraIO::pCamereParam &cam = dataset.camera();
+	Orientations truth;
+	const bool haveTruth = loadGroundTruth("../testData/mav0/state_groundtruth_estimate0/data.csv", truth);
+	if(!haveTruth)
+		printf("no ground truth, latency only\n");
+
+	const size_t pairNum = 100;
+	std::shared_ptr<ImageIO> images = dataset.imageIO(true);
+	std::vector<std::pair<okvis::Time, cv::Mat>> frames;
+	while(!images->isEmpty() && frames.size() < pairNum + 1)
+		frames.push_back(images->popImageAndTimestamp());
+	ASSERT_GE(frames.size(), size_t(2));
+	const Sophus::SO3d R_BC = cam->getT_BS().so3();
+
+	const direct_tracker::Tracker::TrackingType types[] = {direct_tracker::Tracker::CERES_TRACKING,
+	                                                       direct_tracker::Tracker::GAUSS_NEWTON_TRACKING};
+	int lost[2] = {0, 0};
+	double medianError[2] = {0.0, 0.0};
+	for(int e = 0; e < 2; ++e) {
+		direct_tracker::Tracker tracker(types[e]);
+		std::vector<double> latency, error;
+		for(size_t k = 0; k + 1 < frames.size(); ++k) {
+			std::shared_ptr<cvFrame> cvframe_i = std::make_shared<cvFrame>(cam, frames[k].second);
+			cvMeasure::features_t fts;
+			feature_detection::Detector detector(cvframe_i->getWidth(), cvframe_i->getHeight(), 25, IMG_LEVEL);
+			detector.detect(cvframe_i, cvframe_i->getMeasure().measurement.imgPyr, fts);
+			for(auto &ft : fts)
+				cvframe_i->addFeature(ft);
+			std::shared_ptr<cvFrame> cvframe_j = std::make_shared<cvFrame>(cam, frames[k + 1].second);
+			std::shared_ptr<viFrame> viframe_i = std::make_shared<viFrame>(int(k), cvframe_i, dataset.imuParam());
+			std::shared_ptr<viFrame> viframe_j = std::make_shared<viFrame>(int(k + 1), cvframe_j, dataset.imuParam());
+
+			Sophus::SE3d T_ij;
+			Eigen::Matrix<double, 6, 6> info;
+			const std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+			const bool tracked = tracker.Tracking(viframe_i, viframe_j, T_ij, info, 50);
+			latency.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count());
+			if(!tracked) {
+				lost[e]++;
+				continue;
+			}
+			if(!haveTruth)
+				continue;
+
+			// camera i -> camera j as the tracker sees it, against the one of the ground truth
+			const Sophus::SE3d T_Si = viframe_i->getT_BS().inverse() * viframe_i->getPose();
+			const Sophus::SO3d R_ji = (T_Si * T_ij * T_Si.inverse()).so3();
+			const Sophus::SO3d R_ji_true = (orientationAt(truth, int64_t(frames[k + 1].first.toNSec())) * R_BC).inverse()
+			                               * orientationAt(truth, int64_t(frames[k].first.toNSec())) * R_BC;
+			error.push_back((R_ji_true.inverse() * R_ji).log().norm() * 180.0 / M_PI);
+		}
+
+		double total = 0.0;
+		for(double ms : latency)
+			total += ms;
+		medianError[e] = percentile(error, 0.5);
+		printf("%s, %lu frames, %d lost: latency [ms] mean %.2f, p50 %.2f, p90 %.2f, max %.2f; "
+		       "rotation error [deg] p50 %.3f, p90 %.3f, max %.3f\n",
+		       e ? "gauss-newton" : "ceres", latency.size(), lost[e], total / latency.size(),
+		       percentile(latency, 0.5), percentile(latency, 0.9), percentile(latency, 1.0),
+		       medianError[e], percentile(error, 0.9), percentile(error, 1.0));
+	}
+
+	// the same photometric error minimised, the hand-written engine may not track worse than ceres
+	EXPECT_LE(lost[1], lost[0]);
+	if(haveTruth)
+		EXPECT_LE(medianError[1], medianError[0] + 0.1);
+}
@@ -0,0 +1,282 @@
+#include <cstdio>
+#include <cmath>
+#include <limits>
+
+#include "DepthFilter.h"
+#include "cv/Tracker/PhotometricBatch.h"
+#include "DataStructure/viFrame.h"
+#include "DataStructure/cv/cvFrame.h"
+#include "DataStructure/cv/Feature.h"
+#include "DataStructure/cv/Point.h"
+#include "util/ThreadReduce.h"
+
+DepthFilter::DepthFilter(const Options &options) : options_(options), iterations_(0), removed_(0) {
+    threadReduce_ = std::make_shared<ThreadReduce>();
+    work_.resize(ThreadNum);
+}
+
+DepthFilter::~DepthFilter() {}
+
+int DepthFilter::update(std::shared_ptr<viFrame> &keyFrame, std::shared_ptr<viFrame> &nextFrame,
+                        const Sophus::SE3d &T_kn, const Eigen::Matrix<double, 6, 6> &information,
+                        int maxIterations) {
+    keyFrame_ = keyFrame;
+    nextFrame_ = nextFrame;
+    T_SN_ = keyFrame->getT_BS().inverse() * keyFrame->getPose() * T_kn;
+    covariance_ = information.inverse();
+    iterations_ = maxIterations > 0 ? maxIterations : options_.maxIterations;
+    keyFrame->getCVFrame()->preparePyramid();
+    nextFrame->getCVFrame()->preparePyramid();
+
+    load(T_kn);
+    threadReduce_->reduce([this](int first, int last, int thread) { process(first, last, thread); },
+                          0, int(fts_.size()), options_.chunk);
+
+    // fusion and bookkeeping in the order of the keyframe features
+    PointStore &store = PointStore::instance();
+    int fused = 0;
+    for (size_t k = 0; k < fts_.size(); ++k) {
+        if (state_[k] == STATE_FUSE) {
+            store.updateDepth(handles_[k], depth_[k], info_[k]);
+            fused++;
+            continue;
+        }
+        if (store.succeeded(handles_[k]) < 1)
+            erase_[k] = 1;
+    }
+
+    cvMeasure::features_t &fts = keyFrame->getCVFrame()->getMeasure().fts_;
+    removed_ = 0;
+    size_t k = 0;
+    for (auto it = fts.begin(); it != fts.end(); ++k) {
+        if (erase_[k]) {
+            it = fts.erase(it);
+            removed_++;
+        }
+        else
+            ++it;
+    }
+
+    fts_.clear();
+    keyFrame_.reset();
+    nextFrame_.reset();
+    return fused;
+}
+
+void DepthFilter::load(const Sophus::SE3d &T_kn) {
+    cvMeasure::features_t &fts = keyFrame_->getCVFrame()->getMeasure().fts_;
+    const std::shared_ptr<cvFrame> &key = keyFrame_->getCVFrame();
+    const std::shared_ptr<cvFrame> &next = nextFrame_->getCVFrame();
+    const int width = next->getWidth();
+    const int height = next->getHeight();
+
+    const size_t n = fts.size();
+    fts_.assign(fts.begin(), fts.end());
+    handles_.resize(n); pos_.resize(n);
+    rayX_.resize(n);    rayY_.resize(n);
+    depth_.resize(n);   info_.resize(n);
+    refU_.resize(n);    refV_.resize(n);    refI_.resize(n);
+    search_.assign(n, 0);
+    state_.assign(n, STATE_SKIP);
+    erase_.assign(n, 0);
+
+    for (size_t k = 0; k < n; ++k)
+        handles_[k] = fts_[k]->point->handle();
+    PointStore &store = PointStore::instance();
+    store.gather(handles_.data(), n, pos_.data());
+
+    // serial: it draws the initial depths and writes the initial information of new points
+    for (size_t k = 0; k < n; ++k) {
+        const std::shared_ptr<Feature> &ft = fts_[k];
+        const Eigen::Vector3d &pw = pos_[k];
+        Eigen::Vector3d pos = T_SN_ * pw;
+        if (pos[2] < 0.00000001 || std::isinf(pos[2])) {
+            erase_[k] = 1;
+            continue;
+        }
+        pos /= pos[2];
+        Eigen::Vector2d uvj = nextFrame_->getCam()->world2cam(Eigen::Vector2d(pos.block<2, 1>(0, 0)));
+        // a copy, px stays in level 0 coordinates and the tracker and BA read it concurrently
+        Eigen::Vector2d uvi = ft->px;
+        double Ij = next->getIntensity(uvj(0), uvj(1));
+        double Ii = next->getIntensity(uvi(0), uvi(1));
+        if (!(uvj(0) < width && uvj(1) < height && uvj(0) > 0 && uvj(1) > 0 && std::abs(Ii - Ij) < IuminanceErr))
+            continue;
+        if (ft->isBAed == true)
+            continue;
+
+        for (int i = 0; i < ft->level; ++i)
+            uvi /= 2.0;
+        refU_[k] = float(uvi(0));
+        refV_[k] = float(uvi(1));
+        refI_[k] = float(key->getIntensityBilinear(uvi(0), uvi(1), ft->level));
+
+        double depth = pw[2];
+        rayX_[k] = pw[0] / depth;
+        rayY_[k] = pw[1] / depth;
+        if (depth > 0.999999999999 && depth < 1.0000000001) {
+            depth = init_depth((T_kn.so3() * T_kn.translation())[2]);
+            store.setInformation(handles_[k], initVar + 1.0 / (1.0 + key->getGradNorm(uvi(0), uvi(1), ft->level)));
+            search_[k] = 1;
+        }
+        depth_[k] = depth;
+        state_[k] = STATE_PENDING;
+    }
+}
+
+void DepthFilter::process(int first, int last, int thread) {
+    const viFrame::cam_t &cam = nextFrame_->getCam();
+    const int width = nextFrame_->getCVFrame()->getWidth();
+    const int height = nextFrame_->getCVFrame()->getHeight();
+
+    for (int k = first; k < last; ++k) {
+        if (state_[k] != STATE_PENDING)
+            continue;
+
+        double depth = search_[k] ? search(k, work_[thread]) : depth_[k];
+        if (!refine(k, depth)) {
+            state_[k] = STATE_SKIP;
+            continue;
+        }
+
+        const Eigen::Vector3d normPoint(rayX_[k], rayY_[k], 1.0);
+        Eigen::Vector3d Pj = T_SN_ * (depth * normPoint);
+        if (Pj[2] < 0.00000001 || std::isinf(Pj[2])) {
+            state_[k] = STATE_SKIP;
+            erase_[k] = 1;
+            continue;
+        }
+        Eigen::Vector2d uvj = cam->world2cam(Pj);
+        if (uvj(0) >= width || uvj(1) >= height || uvj(0) <= 0 || uvj(1) <= 0) {
+            state_[k] = STATE_SKIP;
+            erase_[k] = 1;
+            continue;
+        }
+
+        Eigen::Matrix<double, 1, 6> Jac;
+        Jac.block<1, 3>(0, 0) = normPoint.transpose() *
+                                Sophus::SO3d::hat(T_SN_.so3().inverse() * (Pj - T_SN_.translation()));
+        Jac.block<1, 3>(0, 3) = normPoint.transpose() * T_SN_.so3().inverse().matrix();
+        Jac = Jac / (normPoint.transpose() * normPoint);
+
+        depth_[k] = depth;
+        info_[k] = 1.0 / (Jac * covariance_ * Jac.transpose())(0, 0);
+        state_[k] = STATE_FUSE;
+    }
+}
+
+double DepthFilter::search(int k, Workspace &work) {
+    const viFrame::cam_t &cam = nextFrame_->getCam();
+    const int level = fts_[k]->level;
+    const double scale = 1.0 / (1 << level);
+    const std::vector<Eigen::Vector2i> &model = trackModel();
+    const int P = int(model.size()) + 1;
+    const int S = options_.searchSteps;
+    const Eigen::Vector3d ray(rayX_[k], rayY_[k], 1.0);
+    const double logRange = std::log(options_.searchRange);
+
+    // slot 0 holds the reference pattern, the hypotheses follow
+    work.u.resize((S + 1) * P);
+    work.v.resize((S + 1) * P);
+    work.I.resize((S + 1) * P);
+    for (int s = 0; s <= S; ++s) {
+        Eigen::Vector2d uv(refU_[k], refV_[k]);
+        if (s > 0) {
+            const double d = depth_[k] * std::exp(logRange * (2.0 * (s - 1) / std::max(S - 1, 1) - 1.0));
+            const Eigen::Vector3d P3 = T_SN_ * (d * ray);
+            uv = P3(2) > 0.00000001 ? Eigen::Vector2d(cam->world2cam(P3) * scale) : Eigen::Vector2d(-1.0, -1.0);
+        }
+        float *u = &work.u[s * P], *v = &work.v[s * P];
+        u[0] = float(uv(0));
+        v[0] = float(uv(1));
+        for (int p = 1; p < P; ++p) {
+            u[p] = float(uv(0) + model[p - 1](0));
+            v[p] = float(uv(1) + model[p - 1](1));
+        }
+    }
+    direct_tracker::sampleIntensity(keyFrame_->getCVFrame()->intensityLevel(level),
+                                    work.u.data(), work.v.data(), P, work.I.data());
+    direct_tracker::sampleIntensity(nextFrame_->getCVFrame()->intensityLevel(level),
+                                    work.u.data() + P, work.v.data() + P, S * P, work.I.data() + P);
+
+    const float *ref = work.I.data();
+    double bestCost = std::numeric_limits<double>::max();
+    double best = depth_[k];
+    for (int s = 1; s <= S; ++s) {
+        const float *I = &work.I[s * P];
+        double cost = 0.0;
+        int p = 0;
+        for (; p < P; ++p) {
+            if (I[p] < 0 || ref[p] < 0)
+                break;
+            cost += std::abs(I[p] - ref[p]);
+        }
+        if (p == P && cost < bestCost) {
+            bestCost = cost;
+            best = depth_[k] * std::exp(logRange * (2.0 * (s - 1) / std::max(S - 1, 1) - 1.0));
+        }
+    }
+    return best;
+}
+
+bool DepthFilter::refine(int k, double &depth) {
+    const Feature &ft = *fts_[k];
+    const viFrame::cam_t &cam = nextFrame_->getCam();
+    const std::shared_ptr<cvFrame> &frame = nextFrame_->getCVFrame();
+    const int width = frame->getWidth();
+    const int height = frame->getHeight();
+    const double fx = cam->fx(ft.level), fy = cam->fy(ft.level);
+    const Eigen::Vector3d ray = T_SN_.so3() * Eigen::Vector3d(rayX_[k], rayY_[k], 1.0);
+    const double I_k = refI_[k];
+
+    auto evaluate = [&](double d, double &r, double &J) -> bool {
+        Eigen::Vector3d P = d * ray + T_SN_.translation();
+        if (P(2) < 0.00000001)
+            return false;
+        Eigen::Vector2d uv = cam->world2cam(P);
+        if (uv(0) < 0 || uv(0) >= width || uv(1) < 0 || uv(1) >= height)
+            return false;
+        for (int i = 0; i < ft.level; ++i)
+            uv /= 2.0;
+
+        r = frame->getIntensityBilinear(uv(0), uv(1), ft.level) - I_k;
+        Eigen::Vector2d grad = frame->getGradBilinear(uv(0), uv(1), ft.level);
+        double Ix = grad(0), Iy = grad(1);
+        if (ft.type == Feature::EDGELET) {
+            double proj = ft.grad(0) * grad(0) + ft.grad(1) * grad(1);
+            Ix = ft.grad(0) * proj;
+            Iy = ft.grad(1) * proj;
+        }
+        J = (Ix * fx * (ray(0) * P(2) - P(0) * ray(2)) + Iy * fy * (ray(1) * P(2) - P(1) * ray(2))) / (P(2) * P(2));
+        return true;
+    };
+
+    double r, J;
+    if (!evaluate(depth, r, J))
+        return false;
+    double cost = 0.5 * r * r;
+    for (int it = 0; it < iterations_; ++it) {
+        if (std::abs(J) < 1e-10 || cost < 1e-12)
+            return true;
+        const double step = -r / J;
+        double alpha = 1.0, r_try, J_try, cost_try;
+        bool accepted = false;
+        for (; alpha >= 0.001; alpha *= 0.5) {
+            if (evaluate(depth + alpha * step, r_try, J_try) && (cost_try = 0.5 * r_try * r_try) < cost) {
+                accepted = true;
+                break;
+            }
+        }
+        if (!accepted)
+            return false;
+
+        depth += alpha * step;
+        const bool converged = std::abs(alpha * step) <= 1e-8 * std::abs(depth) || cost - cost_try <= 1e-6 * cost;
+        r = r_try;
+        J = J_try;
+        cost = cost_try;
+        if (converged)
+            return true;
+    }
+    return false;
+}
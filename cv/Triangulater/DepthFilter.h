@@ -0,0 +1,84 @@
+#ifndef SIMPLE_VIO_DEPTHFILTER_H
+#define SIMPLE_VIO_DEPTHFILTER_H
+
+#include <memory>
+#include <vector>
+
+#include "ThirdParty/sophus/se3.hpp"
+#include "util/setting.h"
+#include "DataStructure/cv/PointStore.h"
+
+class viFrame;
+struct Feature;
+class ThreadReduce;
+
+/// depth states of all keyframe features, kept as flat arrays and updated against a new frame in one batch.
+/// points without a depth yet get an epipolar search first, then every state is refined along its ray and
+/// fused into its Point as a gaussian. the per-feature work runs on a ThreadReduce pool and only reads the
+/// frames, everything touching the map is done serially in the order of the keyframe features.
+class DepthFilter {
+public:
+    struct Options {
+        Options() : searchSteps(33), searchRange(4.0), maxIterations(50), chunk(64) {}
+        int    searchSteps;     //!< depth hypotheses on the epipolar segment, log-uniform
+        double searchRange;     //!< the segment covers [d / searchRange, d * searchRange] around the prior
+        int    maxIterations;   //!< per refinement
+        int    chunk;           //!< features per task
+    };
+
+public:
+    DepthFilter(const Options& options = Options());
+    ~DepthFilter();
+
+    /// update the keyFrame features with nextFrame, T_kn and its information come from tracking.
+    /// features that can't be kept are removed from keyFrame, returns the number of fused depths.
+    int update(std::shared_ptr<viFrame>& keyFrame, std::shared_ptr<viFrame>& nextFrame,
+               const Sophus::SE3d& T_kn, const Eigen::Matrix<double, 6, 6>& information, int maxIterations = 0);
+
+    int removed() const { return removed_; }
+
+private:
+    struct Workspace {
+        std::vector<float>  u, v, I;
+    };
+
+    void load(const Sophus::SE3d& T_kn);
+    void process(int first, int last, int thread);
+    double search(int k, Workspace& work);
+    bool refine(int k, double& depth);
+
+private:
+    enum State : unsigned char {
+        STATE_SKIP,             //!< nothing to fuse, dropped unless reprojected before
+        STATE_PENDING,          //!< waits for search / refinement
+        STATE_FUSE              //!< depth_ and info_ hold a measurement
+    };
+
+    Options                                 options_;
+    std::shared_ptr<ThreadReduce>           threadReduce_;
+    std::vector<Workspace>                  work_;          //!< one per worker
+
+    // inputs of the running update
+    std::shared_ptr<viFrame>                keyFrame_;
+    std::shared_ptr<viFrame>                nextFrame_;
+    Sophus::SE3d                            T_SN_;          //!< world -> camera of nextFrame
+    Eigen::Matrix<double, 6, 6>             covariance_;
+    int                                     iterations_;
+
+    // one entry per keyframe feature
+    std::vector<std::shared_ptr<Feature>>   fts_;
+    std::vector<PointStore::Handle>         handles_;       //!< of the feature points
+    std::vector<Eigen::Vector3d>            pos_;           //!< the points as load read them
+    std::vector<double>                     rayX_, rayY_;   //!< normalised point, z = 1
+    std::vector<double>                     depth_;
+    std::vector<double>                     info_;
+    std::vector<float>                      refU_, refV_;   //!< feature position on its level in keyFrame
+    std::vector<float>                      refI_;
+    std::vector<unsigned char>              search_;
+    std::vector<unsigned char>              state_;
+    std::vector<unsigned char>              erase_;
+
+    int                                     removed_;
+};
+
+#endif //SIMPLE_VIO_DEPTHFILTER_H
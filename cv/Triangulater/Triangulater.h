@@ -6,6 +6,7 @@
 
 class cvFrame;
 class viFrame;
+class DepthFilter;
 
 #define epilolineThreshold 10
 
@@ -18,6 +19,9 @@ public:
     int triangulate(std::shared_ptr<viFrame>&keyFrame,
                     std::shared_ptr<viFrame>&nextFrame, const Sophus::SE3d &T_kn,
                     Eigen::Matrix<double, 6, 6>&infomation,int iter = 0);
+
+private:
+    std::shared_ptr<DepthFilter> depthFilter;
 };
 
 
@@ -5,6 +5,7 @@
 #include "IO/camera/CameraIO.h"
 #include "cv/FeatureDetector/Detector.h"
 #include "DataStructure/cv/Feature.h"
+#include "util/util.h"
 
 #include "opencv2/ts/ts.hpp"
 
@@ -43,8 +44,22 @@ TEST(Triangulate, Triangulate)
 
     printf("pre Tracking was finished! Now begin Triangulate: \n\n");
 
+    // the filter works on level coordinates, the features keep theirs in level 0
+    std::vector<Eigen::Vector2d> px;
+    for(auto &ft : fts)
+        px.push_back(ft->px);
+
     Triangulater triangula;
-    int count = triangula.triangulate(viframe_i,viframe_j,Tij,info, 30);
+    int count;
+    {
+        printf("%lu keyframe features:\n", viframe_i->getCVFrame()->getMeasure().fts_.size());
+        TimeUse time(__FUNCTION__, __LINE__);
+        count = triangula.triangulate(viframe_i,viframe_j,Tij,info, 30);
+    }
     printf("add %d points' depth!\n",count);
 
+    size_t k = 0;
+    for(auto &ft : fts)
+        EXPECT_EQ(ft->px, px[k++]);
+
 }
@@ -0,0 +1,50 @@
+#include <cstdio>
+#include <algorithm>
+
+#include "LatencyHistogram.h"
+
+LatencyHistogram::LatencyHistogram(const std::string &name) : name_(name) {
+    clear();
+}
+
+void LatencyHistogram::add(const clock_t::time_point &start, const clock_t::time_point &end) {
+    add(std::chrono::duration<double, std::micro>(end - start).count());
+}
+
+void LatencyHistogram::add(double us) {
+    int bucket = 0;
+    for(double edge = 1.0; us >= edge && bucket < BucketNum - 1; edge *= 2.0)
+        bucket++;
+    buckets_[bucket]++;
+    count_++;
+    sum_ += us;
+    max_ = std::max(max_, us);
+}
+
+void LatencyHistogram::clear() {
+    std::fill(buckets_, buckets_ + BucketNum, 0);
+    count_ = 0;
+    sum_ = 0.0;
+    max_ = 0.0;
+}
+
+double LatencyHistogram::quantileUs(double q) const {
+    const long rank = long(q * count_);
+    long seen = 0;
+    for(int i = 0; i < BucketNum; ++i) {
+        seen += buckets_[i];
+        if(seen > rank)
+            return double(1L << i);
+    }
+    return max_;
+}
+
+void LatencyHistogram::print() const {
+    printf("%s: %ld samples, mean %.1f us, p50 < %.0f us, p99 < %.0f us, max %.1f us\n", name_.c_str(), count_,
+           meanUs(), quantileUs(0.5), quantileUs(0.99), max_);
+    for(int i = 0; i < BucketNum; ++i) {
+        if(!buckets_[i])
+            continue;
+        printf("  [%8ld, %8ld) us %8ld\n", i ? 1L << (i - 1) : 0L, 1L << i, buckets_[i]);
+    }
+}
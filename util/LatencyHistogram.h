@@ -0,0 +1,37 @@
+#ifndef SIMPLE_VIO_LATENCYHISTOGRAM_H
+#define SIMPLE_VIO_LATENCYHISTOGRAM_H
+
+#include <chrono>
+#include <string>
+
+/// latencies in power-of-two microsecond buckets, [0,1) [1,2) [2,4) ... up to about 67 s.
+/// written by one thread, read once it has stopped.
+class LatencyHistogram {
+public:
+    typedef std::chrono::steady_clock clock_t;
+    static const int BucketNum = 27;
+
+public:
+    explicit LatencyHistogram(const std::string &name);
+
+    void add(const clock_t::time_point &start, const clock_t::time_point &end = clock_t::now());
+    void add(double us);
+    void clear();
+
+    long count() const { return count_; }
+    double maxUs() const { return max_; }
+    double meanUs() const { return count_ ? sum_ / count_ : 0.0; }
+    /// upper edge of the bucket holding the q-quantile
+    double quantileUs(double q) const;
+    void print() const;
+
+private:
+    std::string name_;
+    long        buckets_[BucketNum];
+    long        count_;
+    double      sum_;
+    double      max_;
+};
+
+
+#endif //SIMPLE_VIO_LATENCYHISTOGRAM_H
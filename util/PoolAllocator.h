@@ -0,0 +1,175 @@
+#ifndef SIMPLE_VIO_POOLALLOCATOR_H
+#define SIMPLE_VIO_POOLALLOCATOR_H
+
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <cstddef>
+#include <algorithm>
+
+/// chunks every pool took from the heap so far, it stays put once the pools cover the steady state
+inline std::atomic<size_t>& poolChunks() {
+    static std::atomic<size_t> chunks(0);
+    return chunks;
+}
+
+/// blocks of one size carved out of chunks that never go back to the heap, a freed block is pushed
+/// on a free list and handed out again. one pool per block size shared by every thread, so a block may be
+/// freed on another thread than the one which took it (features released by the BA thread).
+/// every thread keeps a small cache of free blocks and only takes the mutex to move a batch between its cache
+/// and the shared list. the cache has no destructor: the few blocks a thread holds when it exits stay out of the pool.
+template<size_t Size>
+class FixedPool {
+public:
+    static const size_t Alignment = 16;
+    static const size_t BlockSize = (Size + Alignment - 1) / Alignment * Alignment;
+    static const size_t Batch = 32;
+
+    /// never destroyed, blocks may still come back from static destructors
+    static FixedPool& instance() {
+        static FixedPool* pool = new FixedPool;
+        return *pool;
+    }
+
+    void* allocate() {
+        Cache& cache = localCache();
+        if(!cache.head)
+            refill(cache);
+        Block* block = cache.head;
+        cache.head = block->next;
+        cache.size--;
+        used_.fetch_add(1, std::memory_order_relaxed);
+        return block;
+    }
+
+    void deallocate(void* p) {
+        Cache& cache = localCache();
+        Block* block = static_cast<Block*>(p);
+        block->next = cache.head;
+        cache.head = block;
+        if(++cache.size > 2 * Batch)
+            flush(cache);
+        used_.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    /// blocks taken from the heap so far and blocks handed out now
+    size_t capacity() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return capacity_;
+    }
+    size_t used() {
+        return used_.load();
+    }
+
+private:
+    union Block {
+        Block* next;
+        alignas(Alignment) char data[BlockSize];
+    };
+
+    struct Cache {
+        Block* head;
+        size_t size;
+    };
+
+    FixedPool() : free_(nullptr), capacity_(0), used_(0) {}
+
+    static Cache& localCache() {
+        static thread_local Cache cache = {nullptr, 0};
+        return cache;
+    }
+
+    void refill(Cache& cache) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if(!free_)
+            grow();
+        for(size_t i = 0; i < Batch && free_; ++i) {
+            Block* block = free_;
+            free_ = block->next;
+            block->next = cache.head;
+            cache.head = block;
+            cache.size++;
+        }
+    }
+
+    void flush(Cache& cache) {
+        Block* first = cache.head;
+        Block* last = first;
+        for(size_t i = 1; i < Batch; ++i)
+            last = last->next;
+        cache.head = last->next;
+        cache.size -= Batch;
+        std::lock_guard<std::mutex> lock(mutex_);
+        last->next = free_;
+        free_ = first;
+    }
+
+    // chunks grow with the pool, a long sequence ends up with few of them
+    void grow() {
+        const size_t n = std::max<size_t>(256, capacity_ / 2);
+        chunks_.push_back(std::unique_ptr<Block[]>(new Block[n]));
+        Block* chunk = chunks_.back().get();
+        for(size_t i = 0; i < n; ++i) {
+            chunk[i].next = free_;
+            free_ = chunk + i;
+        }
+        capacity_ += n;
+        poolChunks()++;
+    }
+
+private:
+    std::mutex                            mutex_;
+    Block*                                free_;
+    std::vector<std::unique_ptr<Block[]>> chunks_;
+    size_t                                capacity_;
+    std::atomic<size_t>                   used_;
+};
+
+/// STL allocator on FixedPool for node containers and std::allocate_shared, arrays go to the heap.
+template<typename T>
+class PoolAllocator {
+public:
+    typedef T              value_type;
+    typedef T*             pointer;
+    typedef const T*       const_pointer;
+    typedef T&             reference;
+    typedef const T&       const_reference;
+    typedef size_t         size_type;
+    typedef std::ptrdiff_t difference_type;
+
+    template<typename U>
+    struct rebind {
+        typedef PoolAllocator<U> other;
+    };
+
+    typedef FixedPool<sizeof(T)> pool_t;
+    static_assert(alignof(T) <= pool_t::Alignment, "over-aligned type");
+
+public:
+    PoolAllocator() {}
+    template<typename U>
+    PoolAllocator(const PoolAllocator<U>&) {}
+
+    T* allocate(size_t n) {
+        if(n == 1)
+            return static_cast<T*>(pool_t::instance().allocate());
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+
+    void deallocate(T* p, size_t n) {
+        if(n == 1)
+            pool_t::instance().deallocate(p);
+        else
+            ::operator delete(p);
+    }
+};
+
+template<typename T, typename U>
+inline bool operator==(const PoolAllocator<T>&, const PoolAllocator<U>&) { return true; }
+
+template<typename T, typename U>
+inline bool operator!=(const PoolAllocator<T>&, const PoolAllocator<U>&) { return false; }
+
+
+#endif //SIMPLE_VIO_POOLALLOCATOR_H
@@ -0,0 +1,76 @@
+#ifndef SIMPLE_VIO_SPSCQUEUE_H
+#define SIMPLE_VIO_SPSCQUEUE_H
+
+#include <atomic>
+#include <vector>
+#include <cstddef>
+
+/// bounded lock-free queue between exactly one producer thread and one consumer thread.
+/// the ring holds a power of two slots, head_ is only written by the consumer and tail_ by the producer,
+/// each on its own cache line. neither side ever waits: push() fails when full, pop() when empty.
+template<typename T>
+class SPSCQueue {
+public:
+    explicit SPSCQueue(size_t capacity) : head_(0), tail_(0) {
+        size_t size = 2;
+        while(size < capacity)
+            size <<= 1;
+        ring_.resize(size);
+        mask_ = size - 1;
+    }
+
+    /// producer side
+    bool push(T &&value) {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        if(tail - headCache_ > mask_) {
+            headCache_ = head_.load(std::memory_order_acquire);
+            if(tail - headCache_ > mask_)
+                return false;
+        }
+        ring_[tail & mask_] = std::move(value);
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool push(const T &value) {
+        T copy(value);
+        return push(std::move(copy));
+    }
+
+    /// consumer side, the slot is moved out so it doesn't keep anything alive
+    bool pop(T &value) {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        if(head == tailCache_) {
+            tailCache_ = tail_.load(std::memory_order_acquire);
+            if(head == tailCache_)
+                return false;
+        }
+        value = std::move(ring_[head & mask_]);
+        ring_[head & mask_] = T();
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// exact from either side about its own end, a snapshot about the other one
+    bool empty() const {
+        return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+    }
+
+    size_t capacity() const { return mask_ + 1; }
+
+private:
+    static const size_t CacheLine = 64;
+
+    std::vector<T>      ring_;
+    size_t              mask_;
+    char                pad0_[CacheLine];
+    std::atomic<size_t> head_;             //!< next slot to pop
+    size_t              tailCache_ = 0;    //!< consumer's last view of tail_
+    char                pad1_[CacheLine];
+    std::atomic<size_t> tail_;             //!< next slot to push
+    size_t              headCache_ = 0;    //!< producer's last view of head_
+    char                pad2_[CacheLine];
+};
+
+
+#endif //SIMPLE_VIO_SPSCQUEUE_H
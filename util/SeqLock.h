@@ -0,0 +1,125 @@
+#ifndef SIMPLE_VIO_SEQLOCK_H
+#define SIMPLE_VIO_SEQLOCK_H
+
+#include <atomic>
+#include <thread>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+/// a small value read far more often than written. readers never write shared memory: they copy the value
+/// and retry if the sequence number moved or was odd (a write in progress), so many readers don't bounce a
+/// cache line between cores the way a shared_mutex does. writers take the sequence to odd with a CAS,
+/// they may come from any thread but should be short and rare.
+/// the payload lives in relaxed atomic words so a torn copy is a retry and not a data race.
+template<typename T>
+class SeqLock {
+    static_assert(std::is_trivially_copyable<T>::value, "SeqLock copies the value bytewise");
+
+public:
+    SeqLock() : seq_(0) {
+        store(T());
+    }
+    explicit SeqLock(const T &value) : seq_(0) {
+        store(value);
+    }
+
+    T load() const {
+        unsigned version;
+        return load(version);
+    }
+
+    /// the value and the number of writes it is the result of
+    T load(unsigned &version) const {
+        T value;
+        for(;;) {
+            const unsigned seq = seq_.load(std::memory_order_acquire);
+            if(seq & 1) {
+                std::this_thread::yield();
+                continue;
+            }
+            copyOut(value);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if(seq_.load(std::memory_order_relaxed) == seq) {
+                version = seq >> 1;
+                return value;
+            }
+        }
+    }
+
+    void store(const T &value) {
+        const unsigned seq = lockWriter();
+        copyIn(value);
+        seq_.store(seq + 2, std::memory_order_release);
+    }
+
+    /// read-modify-write as one write, f gets the current value by reference. returns the new value
+    template<typename F>
+    T update(F f) {
+        const unsigned seq = lockWriter();
+        T value;
+        copyOut(value);
+        f(value);
+        copyIn(value);
+        seq_.store(seq + 2, std::memory_order_release);
+        return value;
+    }
+
+    /// update only if nothing was written since load returned version, false otherwise
+    template<typename F>
+    bool updateIf(unsigned version, F f) {
+        const unsigned seq = lockWriter();
+        if((seq >> 1) != version) {
+            seq_.store(seq, std::memory_order_release);
+            return false;
+        }
+        T value;
+        copyOut(value);
+        f(value);
+        copyIn(value);
+        seq_.store(seq + 2, std::memory_order_release);
+        return true;
+    }
+
+    /// number of writes so far
+    unsigned version() const { return seq_.load(std::memory_order_acquire) >> 1; }
+
+private:
+    static const size_t WordNum = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+    unsigned lockWriter() {
+        unsigned seq = seq_.load(std::memory_order_relaxed);
+        for(;;) {
+            if(seq & 1) {
+                std::this_thread::yield();
+                seq = seq_.load(std::memory_order_relaxed);
+            }
+            else if(seq_.compare_exchange_weak(seq, seq + 1, std::memory_order_acquire, std::memory_order_relaxed))
+                break;
+        }
+        // the payload stores must not become visible before the odd sequence
+        std::atomic_thread_fence(std::memory_order_release);
+        return seq;
+    }
+
+    void copyOut(T &value) const {
+        uint64_t buf[WordNum];
+        for(size_t i = 0; i < WordNum; ++i)
+            buf[i] = words_[i].load(std::memory_order_relaxed);
+        std::memcpy(&value, buf, sizeof(T));
+    }
+
+    void copyIn(const T &value) {
+        uint64_t buf[WordNum] = {};
+        std::memcpy(buf, &value, sizeof(T));
+        for(size_t i = 0; i < WordNum; ++i)
+            words_[i].store(buf[i], std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<unsigned> seq_;
+    std::atomic<uint64_t> words_[WordNum];
+};
+
+
+#endif //SIMPLE_VIO_SEQLOCK_H
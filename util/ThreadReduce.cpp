@@ -3,3 +3,79 @@
 //
 
 #include "ThreadReduce.h"
+#include "Trace.h"
+
+ThreadReduce::ThreadReduce() : running(true), nextIndex(0), maxIndex(0), stepSize(1) {
+    for (int i = 0; i < ThreadNum; ++i) {
+        isDone[i] = false;
+        threads[i] = boost::thread(&ThreadReduce::workerLoop, this, i);
+    }
+
+    boost::unique_lock<boost::mutex> lock(exMutex);
+    while (!allDone())
+        done_signal.wait(lock);
+}
+
+ThreadReduce::~ThreadReduce() {
+    exMutex.lock();
+    running = false;
+    todo_signal.notify_all();
+    exMutex.unlock();
+
+    for (int i = 0; i < ThreadNum; ++i)
+        threads[i].join();
+}
+
+void ThreadReduce::reduce(const callback_t &callback, int first, int last, int stepSize) {
+    if (last <= first)
+        return;
+    if (stepSize <= 0)
+        stepSize = std::max(1, (last - first + ThreadNum - 1) / ThreadNum);
+
+    boost::unique_lock<boost::mutex> lock(exMutex);
+    this->callback = callback;
+    this->nextIndex = first;
+    this->maxIndex = last;
+    this->stepSize = stepSize;
+    for (int i = 0; i < ThreadNum; ++i)
+        isDone[i] = false;
+
+    todo_signal.notify_all();
+    while (!allDone())
+        done_signal.wait(lock);
+
+    this->callback = callback_t();
+    this->nextIndex = 0;
+    this->maxIndex = 0;
+}
+
+bool ThreadReduce::allDone() {
+    for (int i = 0; i < ThreadNum; ++i)
+        if (!isDone[i])
+            return false;
+    return true;
+}
+
+void ThreadReduce::workerLoop(int idx) {
+    TRACE_THREAD("pool");
+    boost::unique_lock<boost::mutex> lock(exMutex);
+
+    while (running) {
+        if (nextIndex < maxIndex) {
+            int first = nextIndex;
+            int last = std::min(nextIndex + stepSize, maxIndex);
+            nextIndex = last;
+
+            lock.unlock();
+            callback(first, last, idx);
+            lock.lock();
+        }
+        else {
+            if (!isDone[idx]) {
+                isDone[idx] = true;
+                done_signal.notify_all();
+            }
+            todo_signal.wait(lock);
+        }
+    }
+}
@@ -5,19 +5,41 @@
 #ifndef SIMPLE_VIO_THREADREDUCE_H
 #define SIMPLE_VIO_THREADREDUCE_H
 
+#include <functional>
+
 #include "setting.h"
 #include "boost/thread.hpp"
 
+/// a fixed pool of ThreadNum workers splitting an index range into chunks.
+/// reduce() blocks until every chunk is done, the callback gets [first, last) and the worker id.
 class ThreadReduce {
+public:
+    typedef std::function<void(int, int, int)> callback_t;
+
 public:
     ThreadReduce();
+    ~ThreadReduce();
 
+    /// stepSize = 0 splits the range evenly over the workers.
+    void reduce(const callback_t& callback, int first, int last, int stepSize = 0);
 
 private:
-
+    void workerLoop(int idx);
+    bool allDone();
 
 private:
-    boost::thread threads[ThreadNum];
+    boost::thread               threads[ThreadNum];
+    bool                        isDone[ThreadNum];
+    bool                        running;
+
+    boost::mutex                exMutex;
+    boost::condition_variable   todo_signal;
+    boost::condition_variable   done_signal;
+
+    callback_t                  callback;
+    int                         nextIndex;
+    int                         maxIndex;
+    int                         stepSize;
 };
 
 
@@ -0,0 +1,176 @@
+#include <cstdio>
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "Trace.h"
+
+namespace trace {
+
+    std::atomic_bool recording(false);
+
+    namespace {
+        static_assert((TraceRingSize & (TraceRingSize - 1)) == 0, "TraceRingSize has to be a power of two");
+
+        /// written by its thread only, it outlives the thread so the events can be written out at the end
+        struct Ring {
+            explicit Ring(const char* name) : events(TraceRingSize), head(0), name(name) {}
+            std::vector<Event>    events;
+            std::atomic<uint64_t> head;     //!< events ever recorded
+            const char*           name;
+        };
+
+        std::mutex                          registryMutex;
+        std::vector<std::shared_ptr<Ring>>  registry;       //!< the index is the tid in the trace
+        thread_local Ring*                  localRing = nullptr;
+        thread_local const char*            localName = nullptr;
+
+        Ring* ring() {
+            if(!localRing) {
+                std::shared_ptr<Ring> r = std::make_shared<Ring>(localName);
+                std::lock_guard<std::mutex> lock(registryMutex);
+                registry.push_back(r);
+                localRing = r.get();
+            }
+            return localRing;
+        }
+
+        /// the events of every ring oldest first, the ring index alongside
+        void collect(std::vector<std::pair<int, Event>> &events, std::vector<const char*> &names) {
+            std::lock_guard<std::mutex> lock(registryMutex);
+            for(size_t k = 0; k < registry.size(); ++k) {
+                const Ring &r = *registry[k];
+                const uint64_t head = r.head.load(std::memory_order_acquire);
+                const uint64_t n = std::min<uint64_t>(head, TraceRingSize);
+                for(uint64_t i = head - n; i < head; ++i)
+                    events.push_back(std::make_pair(int(k), r.events[i & (TraceRingSize - 1)]));
+                names.push_back(r.name);
+            }
+            std::stable_sort(events.begin(), events.end(),
+                             [](const std::pair<int, Event> &a, const std::pair<int, Event> &b) {
+                                 return a.second.begin < b.second.begin;
+                             });
+        }
+
+        void writeString(FILE* file, const char* s) {
+            fputc('"', file);
+            for(; s && *s; ++s) {
+                if(*s == '"' || *s == '\\')
+                    fputc('\\', file);
+                fputc(*s, file);
+            }
+            fputc('"', file);
+        }
+    }
+
+    void enable(bool on) {
+        recording.store(on, std::memory_order_relaxed);
+    }
+
+    void record(const Event &e) {
+        Ring* r = ring();
+        const uint64_t head = r->head.load(std::memory_order_relaxed);
+        r->events[head & (TraceRingSize - 1)] = e;
+        r->head.store(head + 1, std::memory_order_release);
+    }
+
+    void setThreadName(const char* name) {
+        localName = name;
+        if(localRing) {
+            std::lock_guard<std::mutex> lock(registryMutex);
+            localRing->name = name;
+        }
+    }
+
+    bool writeChrome(const std::string &file) {
+        std::vector<std::pair<int, Event>> events;
+        std::vector<const char*> names;
+        collect(events, names);
+        FILE* out = fopen(file.c_str(), "w");
+        if(!out)
+            return false;
+
+        const int64_t origin = events.empty() ? 0 : events.front().second.begin;
+
+        fprintf(out, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+        bool first = true;
+        for(size_t k = 0; k < names.size(); ++k) {
+            fprintf(out, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":",
+                    first ? "" : ",\n", int(k));
+            if(names[k])
+                writeString(out, names[k]);
+            else
+                fprintf(out, "\"thread %d\"", int(k));
+            fprintf(out, "}}");
+            first = false;
+        }
+        for(auto &p : events) {
+            const Event &e = p.second;
+            fprintf(out, "%s{\"name\":", first ? "" : ",\n");
+            writeString(out, e.name);
+            if(e.type == 'X')
+                fprintf(out, ",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}", p.first,
+                        (e.begin - origin) * 1e-3, (e.end - e.begin) * 1e-3);
+            else
+                fprintf(out, ",\"ph\":\"C\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"args\":{\"value\":%.17g}}", p.first,
+                        (e.begin - origin) * 1e-3, e.value);
+            first = false;
+        }
+        fprintf(out, "\n]}\n");
+        const bool good = !ferror(out);
+        fclose(out);
+        return good;
+    }
+
+    void printSummary() {
+        std::vector<std::pair<int, Event>> events;
+        std::vector<const char*> names;
+        collect(events, names);
+
+        // by name, the pointers of the same literal may differ between translation units
+        std::map<std::string, std::vector<double>> scopes;
+        std::map<std::string, std::vector<double>> values;
+        for(auto &p : events) {
+            const Event &e = p.second;
+            if(e.type == 'X')
+                scopes[e.name].push_back((e.end - e.begin) * 1e-3);
+            else
+                values[e.name].push_back(e.value);
+        }
+
+        std::vector<std::pair<double, std::string>> order;
+        for(auto &s : scopes) {
+            double total = 0.0;
+            for(double us : s.second)
+                total += us;
+            order.push_back(std::make_pair(-total, s.first));
+        }
+        std::sort(order.begin(), order.end());
+
+        printf("%-24s %8s %10s %9s %9s %9s %9s %9s\n", "stage [us]", "count", "total ms", "mean", "p50", "p90",
+               "p99", "max");
+        for(auto &o : order) {
+            std::vector<double> &us = scopes[o.second];
+            std::sort(us.begin(), us.end());
+            auto quantile = [&](double q) { return us[std::min(us.size() - 1, size_t(q * us.size()))]; };
+            printf("%-24s %8lu %10.1f %9.1f %9.1f %9.1f %9.1f %9.1f\n", o.second.c_str(), us.size(), -o.first * 1e-3,
+                   -o.first / us.size(), quantile(0.5), quantile(0.9), quantile(0.99), us.back());
+        }
+        if(values.empty())
+            return;
+        printf("%-24s %8s %12s %12s %12s\n", "counter / gauge", "count", "last", "min", "max");
+        for(auto &v : values) {
+            const std::vector<double> &x = v.second;
+            printf("%-24s %8lu %12.6g %12.6g %12.6g\n", v.first.c_str(), x.size(), x.back(),
+                   *std::min_element(x.begin(), x.end()), *std::max_element(x.begin(), x.end()));
+        }
+    }
+
+    void clear() {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        for(auto &r : registry)
+            r->head.store(0, std::memory_order_release);
+    }
+}
@@ -0,0 +1,106 @@
+#ifndef SIMPLE_VIO_TRACE_H
+#define SIMPLE_VIO_TRACE_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+#include <boost/noncopyable.hpp>
+
+#include "setting.h"
+
+/// timings of the pipeline stages, counters and gauges, recorded into a ring per thread. written out as a chrome
+/// trace (chrome://tracing or ui.perfetto.dev) and summarised per stage. with Tracing 0 the macros compile to
+/// nothing, while recording is switched off a trace point costs one relaxed load.
+namespace trace {
+
+    struct Event {
+        const char* name;       //!< a literal, only the pointer is kept
+        int64_t     begin;      //!< [ns] steady clock
+        int64_t     end;        //!< = begin for counters and gauges
+        double      value;
+        char        type;       //!< 'X' scope, 'C' counter or gauge
+    };
+
+    extern std::atomic_bool recording;
+
+    inline bool enabled() { return recording.load(std::memory_order_relaxed); }
+    void enable(bool on);
+
+    inline int64_t now() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    /// into the ring of the calling thread, the oldest events are overwritten once it holds TraceRingSize
+    void record(const Event &e);
+    /// the calling thread's name in the trace, a literal
+    void setThreadName(const char* name);
+
+    class Scope : boost::noncopyable {
+    public:
+        explicit Scope(const char* name) : name_(name), begin_(enabled() ? now() : -1) {}
+        ~Scope() {
+            if(begin_ < 0)
+                return;
+            const Event e = {name_, begin_, now(), 0.0, 'X'};
+            record(e);
+        }
+
+    private:
+        const char* name_;
+        int64_t     begin_;
+    };
+
+    /// a running total over all threads, every change is recorded with the new total
+    class Counter : boost::noncopyable {
+    public:
+        explicit Counter(const char* name) : name_(name), total_(0) {}
+        void add(long n = 1) {
+            const long total = total_.fetch_add(n, std::memory_order_relaxed) + n;
+            if(!enabled())
+                return;
+            const int64_t t = now();
+            const Event e = {name_, t, t, double(total), 'C'};
+            record(e);
+        }
+
+    private:
+        const char*      name_;
+        std::atomic_long total_;
+    };
+
+    inline void gauge(const char* name, double value) {
+        if(!enabled())
+            return;
+        const int64_t t = now();
+        const Event e = {name, t, t, value, 'C'};
+        record(e);
+    }
+
+    /// the events of all threads as chrome json. read after the traced threads stopped, a ring
+    /// written meanwhile may give a few torn events
+    bool writeChrome(const std::string &file);
+    /// scopes: count, mean and percentiles per name. counters and gauges: count, last, min and max
+    void printSummary();
+    /// drops the recorded events, while no thread records
+    void clear();
+}
+
+#if Tracing
+#define TRACE_CONCAT_(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_(a, b)
+#define TRACE_SCOPE(name)        trace::Scope TRACE_CONCAT(traceScope_, __LINE__)(name)
+#define TRACE_COUNT(name, n)     do { static trace::Counter counter_(name); counter_.add(n); } while(0)
+#define TRACE_GAUGE(name, value) trace::gauge(name, value)
+#define TRACE_THREAD(name)       trace::setThreadName(name)
+#else
+#define TRACE_SCOPE(name)
+#define TRACE_COUNT(name, n)
+#define TRACE_GAUGE(name, value)
+#define TRACE_THREAD(name)
+#endif
+
+
+#endif //SIMPLE_VIO_TRACE_H
@@ -20,11 +20,22 @@
 #define IuminanceErr      30
 #define initDepthInfo     0.4
 #define KeyFrameTranslateThreadThold2  0.5625
+#define ImagePrefetchDepth               8
+#define ImagePrefetchThreads             2
+#define RectifyInPyramid                 0       //!< hand raw images to the frames and rectify while building level 0
+#define ImuLogCache                      1       //!< keep a binary log next to the IMU csv and map it on the next start
+#define GyroBiasSigma                    0.05    //!< [rad/s] the gyro bias the rotation prior allows for, the front end integrates without bias
+#define RotationPriorWeight              1.0     //!< scales the sqrt information of the rotation prior against the photometric residuals
+#define PrefilterRadius                  2.0     //!< [px] the pattern pre-filter only runs on projections predicted this well
+#define Tracing                          1       //!< compile the trace points in, trace::enable() starts recording
+#define TraceRingSize                    (1 << 16)   //!< events kept per thread, a power of two
+#define TraceFile                        "vio_trace.json"
 
 const std::vector<Eigen::Vector2i>& trackModel(int mode = 0);
 extern int widowSize;
 extern double initVar;
 
 #define SIMPLE_BA         0x000000001
+#define SCHUR_BA          0x000000002
 
 #endif // SETTING_H
@@ -0,0 +1,44 @@
+#ifndef SIMPLE_VIO_SIMD_H
+#define SIMPLE_VIO_SIMD_H
+
+/// x86 SIMD kernels are compiled per function with __attribute__((target)) and picked at runtime,
+/// so the binary keeps running on machines without AVX2/SSE4.
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SIMPLE_VIO_X86_SIMD       1
+#include <immintrin.h>
+#define SIMD_TARGET_SSE4          __attribute__((target("sse4.1")))
+#define SIMD_TARGET_AVX2          __attribute__((target("avx2")))
+#else
+#define SIMPLE_VIO_X86_SIMD       0
+#endif
+
+namespace simd {
+
+    enum InstructionSet {
+        SCALAR = 0,
+        SSE4   = 1,
+        AVX2   = 2
+    };
+
+    /// best instruction set supported by the running cpu
+    inline InstructionSet detect() {
+#if SIMPLE_VIO_X86_SIMD
+        static const InstructionSet best = __builtin_cpu_supports("avx2")   ? AVX2
+                                         : __builtin_cpu_supports("sse4.1") ? SSE4
+                                         : SCALAR;
+        return best;
+#else
+        return SCALAR;
+#endif
+    }
+
+    inline const char* name(InstructionSet set) {
+        switch (set) {
+            case AVX2: return "AVX2";
+            case SSE4: return "SSE4";
+            default:   return "scalar";
+        }
+    }
+}
+
+#endif //SIMPLE_VIO_SIMD_H
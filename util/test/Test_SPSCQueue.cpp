@@ -0,0 +1,62 @@
+#include <thread>
+#include <memory>
+#include <chrono>
+
+#include "opencv2/ts/ts.hpp"
+#include "util/SPSCQueue.h"
+#include "util/LatencyHistogram.h"
+
+namespace {
+    struct Item {
+        long                                  seq;
+        std::shared_ptr<std::vector<long>>    payload;
+        std::chrono::steady_clock::time_point published;
+    };
+}
+
+TEST(SPSCQueue, stress) {
+    // a producer which never waits against a consumer which sleeps from time to time, as the front end against BA
+    const long itemNum = 2000000;
+    SPSCQueue<Item> queue(64);
+    LatencyHistogram latency("hand-off");
+    long full = 0;
+
+    std::thread producer([&] {
+        long seq = 0;
+        Item item;
+        while(seq < itemNum) {
+            if(!item.payload) {
+                item.seq = seq;
+                item.payload = std::make_shared<std::vector<long>>(4, seq);
+                item.published = std::chrono::steady_clock::now();
+            }
+            if(queue.push(std::move(item)))
+                seq++;
+            else {
+                full++;
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    long expected = 0, errors = 0;
+    Item item;
+    while(expected < itemNum) {
+        if(!queue.pop(item)) {
+            std::this_thread::yield();
+            continue;
+        }
+        latency.add(item.published);
+        errors += item.seq != expected || !item.payload || (*item.payload)[3] != expected;
+        item.payload.reset();
+        if(++expected % 100000 == 0)
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+    }
+    producer.join();
+
+    printf("%ld items, producer found the queue full %ld times\n", itemNum, full);
+    latency.print();
+    EXPECT_EQ(errors, 0);
+    EXPECT_TRUE(queue.empty());
+    EXPECT_EQ(latency.count(), itemNum);
+}
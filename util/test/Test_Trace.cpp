@@ -0,0 +1,104 @@
+#include <cstdio>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "opencv2/ts/ts.hpp"
+#include "util/Trace.h"
+
+namespace {
+    volatile double sink = 0.0;
+
+    // a stage of a few hundred ns, in the range of the cheapest traced stages
+    void work(int n) {
+        double s = 0.0;
+        for(int i = 0; i < n; ++i)
+            s += i * 0.5;
+        sink = s;
+    }
+
+    // ns per traced call of work
+    double perScope(long n) {
+        const std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+        for(long i = 0; i < n; ++i) {
+            trace::Scope scope("bench");
+            work(16);
+        }
+        return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count() / n;
+    }
+
+    size_t occurrences(const std::string &text, const std::string &what) {
+        size_t n = 0;
+        for(size_t pos = text.find(what); pos != std::string::npos; pos = text.find(what, pos + what.size()))
+            n++;
+        return n;
+    }
+}
+
+// a few threads trace nested stages and a shared counter, every event shows up in the chrome trace
+TEST(Trace, threads) {
+    const int threadNum = 4, frameNum = 200;
+    trace::clear();
+    trace::enable(true);
+    std::vector<std::thread> threads;
+    for(int k = 0; k < threadNum; ++k)
+        threads.push_back(std::thread([&] {
+            trace::setThreadName("worker");
+            for(int i = 0; i < frameNum; ++i) {
+                trace::Scope frame("test frame");
+                {
+                    trace::Scope stage("test stage");
+                    work(100);
+                }
+                TRACE_COUNT("test counter", 1);
+                trace::gauge("test gauge", i);
+            }
+        }));
+    for(auto &t : threads)
+        t.join();
+    trace::enable(false);
+    trace::Scope off("test off");
+
+    const std::string file("trace_test.json");
+    GTEST_ASSERT_EQ(trace::writeChrome(file), true);
+    std::ifstream in(file);
+    std::stringstream text;
+    text << in.rdbuf();
+    const std::string json = text.str();
+    remove(file.c_str());
+
+    const std::string head("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+    GTEST_ASSERT_EQ(json.compare(0, head.size(), head), 0);
+    GTEST_ASSERT_EQ(occurrences(json, "\"name\":\"test frame\",\"ph\":\"X\""), size_t(threadNum * frameNum));
+    GTEST_ASSERT_EQ(occurrences(json, "\"name\":\"test stage\",\"ph\":\"X\""), size_t(threadNum * frameNum));
+    GTEST_ASSERT_EQ(occurrences(json, "\"name\":\"test counter\",\"ph\":\"C\""), size_t(threadNum * frameNum));
+    GTEST_ASSERT_EQ(occurrences(json, "\"name\":\"test gauge\",\"ph\":\"C\""), size_t(threadNum * frameNum));
+    GTEST_ASSERT_EQ(occurrences(json, "\"test off\""), size_t(0));
+    GTEST_ASSERT_GE(occurrences(json, "\"args\":{\"name\":\"worker\"}"), size_t(threadNum));
+    // the counter is shared, its last value is the total of all threads
+    GTEST_ASSERT_NE(json.find("\"args\":{\"value\":" + std::to_string(threadNum * frameNum) + "}"), std::string::npos);
+    trace::printSummary();
+    trace::clear();
+}
+
+// what a trace point costs on the hot path, switched off and recording. only printed, a wall clock bound flakes on a loaded machine
+TEST(Trace, overhead) {
+    const long n = 2000000;
+    trace::clear();
+    trace::enable(false);
+    perScope(n / 10);
+    const double off = perScope(n);
+    trace::enable(true);
+    const double on = perScope(n);
+    trace::enable(false);
+    trace::clear();
+
+    const std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+    for(long i = 0; i < n; ++i)
+        work(16);
+    const double bare = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count() / n;
+    printf("work %.1f ns, traced switched off %.1f ns, recording %.1f ns\n", bare, off, on);
+}
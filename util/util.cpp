@@ -3,6 +3,7 @@
 #include "util.h"
 
 #include "DataStructure/cv/Camera/AbstractCamera.h"
+#include "DataStructure/cv/ImgPyr.h"
 
 const double EPS = 0.0000000001;
 const double PI = 3.14159265;
@@ -26,9 +27,8 @@ Eigen::Matrix3d rightJacobian(const Eigen::Vector3d &PhiVec) {
     return retMat;
 }
 
-double shiTomasiScore(const std::vector<Eigen::Matrix<double, 3, 1>>& img,
-                      int width, int height, int u, int v) {
-    typedef const std::vector<Eigen::Matrix<double, 3, 1>> VecImg;
+double shiTomasiScore(const ImgLevel& img, int u, int v) {
+    // accumulate in Q8 units, the sums stay exact in double and are rescaled once at the end
     double dXX = 0.0;
     double dYY = 0.0;
     double dXY = 0.0;
@@ -41,20 +41,20 @@ double shiTomasiScore(const std::vector<Eigen::Matrix<double, 3, 1>>& img,
     const int y_min = v-halfbox_size;
     const int y_max = v+halfbox_size;
 
-    if(x_min < 1 || x_max >= width - 1 || y_min < 1 || y_max >= height - 1)
+    if(x_min < 1 || x_max >= img.width - 1 || y_min < 1 || y_max >= img.height - 1)
         return 0.0; // patch is too close to the boundary
 
-    const int stride = width;
+    const int stride = img.stride;
     for( int y=y_min; y<y_max; ++y )
     {
-        VecImg::const_iterator ptr_left   = img.begin() + stride*y + x_min - 1;
-        VecImg::const_iterator ptr_right  = img.begin()+ stride*y + x_min + 1;
-        VecImg::const_iterator ptr_top    = img.begin() + stride*(y-1) + x_min;
-        VecImg::const_iterator ptr_bottom = img.begin() + stride*(y+1) + x_min;
+        const uint16_t* ptr_left   = img.row(y) + x_min - 1;
+        const uint16_t* ptr_right  = img.row(y) + x_min + 1;
+        const uint16_t* ptr_top    = img.row(y) - stride + x_min;
+        const uint16_t* ptr_bottom = img.row(y) + stride + x_min;
         for(int x = 0; x < box_size; ++x, ++ptr_left, ++ptr_right, ++ptr_top, ++ptr_bottom)
         {
-            double dx = (*ptr_right)(0) - (*ptr_left)(0);
-            double dy = (*ptr_bottom)(0) - (*ptr_top)(0);
+            double dx = int(*ptr_right) - int(*ptr_left);
+            double dy = int(*ptr_bottom) - int(*ptr_top);
             dXX += dx*dx;
             dYY += dy*dy;
             dXY += dx*dy;
@@ -62,9 +62,10 @@ double shiTomasiScore(const std::vector<Eigen::Matrix<double, 3, 1>>& img,
     }
 
     // Find and return smaller eigenvalue:
-    dXX = dXX / (2.0 * box_area);
-    dYY = dYY / (2.0 * box_area);
-    dXY = dXY / (2.0 * box_area);
+    const double norm = 2.0 * box_area * PYR_ONE * PYR_ONE;
+    dXX = dXX / norm;
+    dYY = dYY / norm;
+    dXY = dXY / norm;
     return 0.5 * (dXX + dYY - sqrt( (dXX + dYY) * (dXX + dYY) - 4 * (dXX * dYY - dXY * dXY) ));
 
 }
@@ -111,20 +112,10 @@ float shiTomasiScore(const cv::Mat& img, int u, int v) {
 }
 
 
+// through the camera's cached remap tables, cv::undistort would rebuild them for every image
 cv::Mat Undistort(const cv::Mat& src, std::shared_ptr<AbstractCamera> cam) {
     cv::Mat dst;
-    const Eigen::Matrix<double, 3, 3> &K_ = cam->K();
-    cv::Mat K(3, 3, CV_64FC1);
-    for(int i = 0; i < 3; ++i) {
-        for(int j = 0; j < 3; ++j)
-            K.at<double>(i, j) = K_(i, j);
-    }
-    cv::Mat distCoeffs(4, 1, CV_64FC1);
-    for(int i = 0; i < 4; ++i)
-        distCoeffs.at<double>(i, 0) = cam->d(i);
-
-    cv::undistort(src, dst, K, distCoeffs);
-
+    cam->undistortImage(src, dst);
     return dst;
 }
 
@@ -5,17 +5,55 @@
 #include "util/setting.h"
 #include "BundleAdjustemt.h"
 #include "./Implement/SimpleBA.h"
+#include "./Implement/SchurBA.h"
+#include "DataStructure/cv/cvFrame.h"
+#include "DataStructure/cv/Point.h"
+#include "util/Trace.h"
 
 BundleAdjustemt::BundleAdjustemt(int type) {
 	switch (type) {
 		case SIMPLE_BA :
 			impl = std::make_shared<SimpleBA>();
 			break;
+		case SCHUR_BA :
+			impl = std::make_shared<SchurBA>();
+			break;
 	}
 }
 
 bool BundleAdjustemt::run(std::vector<std::shared_ptr<viFrame>> &viframes,
-                          BundleAdjustemt::obsModeType &obsModes,
-                          std::vector<std::shared_ptr<imuFactor>> &imufactors, int iter_) {
-	return impl->run(viframes, obsModes, imufactors, iter_);
-}
\ No newline at end of file
+                          ObsGraph &graph,
+                          std::vector<std::shared_ptr<imuFactor>> &imufactors, int iter_, BAUpdate *update) {
+	TRACE_SCOPE("BA");
+	TRACE_GAUGE("BA window", viframes.size());
+	if(update)
+		update->clear();
+	return impl->run(viframes, graph, imufactors, iter_, update);
+}
+
+bool BundleAdjustemt::marginalize(std::vector<std::shared_ptr<viFrame>> &viframes,
+                                  ObsGraph &graph,
+                                  std::vector<std::shared_ptr<imuFactor>> &imufactors) {
+	TRACE_SCOPE("marginalization");
+	return impl->marginalize(viframes, graph, imufactors);
+}
+
+void BAUpdate::clear() {
+	frames.clear();
+	poses.clear();
+	points.clear();
+	positions.clear();
+	versions.clear();
+}
+
+size_t BAUpdate::apply() {
+	for(size_t i = 0; i < frames.size(); ++i)
+		frames[i]->setPose(poses[i]);
+
+	size_t stale = 0;
+	for(size_t i = 0; i < points.size(); ++i)
+		if(!points[i]->setPos(positions[i], versions[i]))
+			stale++;
+	TRACE_COUNT("stale BA points", stale);
+	return stale;
+}
@@ -7,25 +7,48 @@
 
 #include <memory>
 #include <vector>
-#include <map>
-#include <list>
+#include <chrono>
+#include <Eigen/Dense>
+#include <Eigen/StdVector>
+#include <sophus/se3.hpp>
+
+#include "ObsGraph.h"
 
 class BABase;
 class viFrame;
+class cvFrame;
 class imuFactor;
 class Point;
-class Feature;
 
-class BundleAdjustemt {
-public:
-	typedef std::map<std::shared_ptr<Point>, std::list<std::shared_ptr<Feature>>> obsModeType;
+/// the estimate of one run as plain values, for a caller that applies it between two frames instead of
+/// the backend writing into frames and points the front end is reading. speed and bias are only used by
+/// the BA, the backend still writes them into the viFrames.
+/// a point the front end wrote after the BA read it (a fused depth) keeps that value, the next run starts from it.
+struct BAUpdate {
+	BAUpdate() : version(0) {}
+	void clear();
+	/// poses and point positions, each under its own lock. returns the number of stale positions skipped
+	size_t apply();
+
+	unsigned long                                                  version;
+	std::chrono::steady_clock::time_point                          published;
+	std::vector<std::shared_ptr<cvFrame>>                          frames;
+	std::vector<Sophus::SE3d, Eigen::aligned_allocator<Sophus::SE3d>> poses;
+	std::vector<std::shared_ptr<Point>>                            points;
+	std::vector<Eigen::Vector3d>                                   positions;
+	std::vector<unsigned>                                          versions;    //!< Point::getPos(version) the run started from
+};
 
+class BundleAdjustemt {
 public:
 	BundleAdjustemt(int type);
 	~BundleAdjustemt() {}
 	bool run(std::vector<std::shared_ptr<viFrame>> &viframes,
-	         obsModeType &obsModes,
-	         std::vector<std::shared_ptr<imuFactor>> &imufactors, int iter_ = 50);
+	         ObsGraph &graph,
+	         std::vector<std::shared_ptr<imuFactor>> &imufactors, int iter_ = 50, BAUpdate *update = nullptr);
+	bool marginalize(std::vector<std::shared_ptr<viFrame>> &viframes,
+	                 ObsGraph &graph,
+	                 std::vector<std::shared_ptr<imuFactor>> &imufactors);
 
 private:
 	std::shared_ptr<BABase> impl;
@@ -17,9 +17,16 @@ class BABase {
 public:
 	BABase() {}
 	virtual ~BABase() {}
+	/// with an update the poses and points of the result go there, the frames and points are left untouched
 	virtual  bool run(std::vector<std::shared_ptr<viFrame>> &viframes,
-	                  typename BundleAdjustemt::obsModeType &obsModes,
-	                  std::vector<std::shared_ptr<imuFactor>> &imufactors, int iter_) = 0;
+	                  ObsGraph &graph,
+	                  std::vector<std::shared_ptr<imuFactor>> &imufactors, int iter_, BAUpdate *update) = 0;
+
+	/// fold viframes[0], imufactors[0] and the points seen by viframes[0] into a prior on the other poses,
+	/// the caller drops them from the window afterwards. a backend without prior returns false.
+	virtual  bool marginalize(std::vector<std::shared_ptr<viFrame>> &viframes,
+	                          ObsGraph &graph,
+	                          std::vector<std::shared_ptr<imuFactor>> &imufactors) { return false; }
 
 };
 
@@ -0,0 +1,57 @@
+#ifndef SIMPLE_VIO_BAERROR_H
+#define SIMPLE_VIO_BAERROR_H
+
+#include <memory>
+#include <ceres/ceres.h>
+#include <sophus/se3.hpp>
+
+class viFrame;
+class imuFactor;
+class Feature;
+
+/// residual models of the sliding window, shared by the BA backends.
+/// a pose block holds 15 doubles: so3 log, translation, speed and bias.
+
+class CERES_EXPORT VioPose : public ceres::LocalParameterization {
+public:
+	virtual ~VioPose() {}
+	virtual bool Plus(const double* x,
+	                  const double* delta,
+	                  double* x_plus_delta) const;
+	virtual bool ComputeJacobian(const double* x,
+	                             double* jacobian) const;
+	virtual int GlobalSize() const { return 15; }
+	virtual int LocalSize() const { return 15; }
+};
+
+class IMUErr : public ceres::SizedCostFunction<9, 15, 15> {
+public:
+	IMUErr(std::shared_ptr<imuFactor> &imufactor,
+	       std::shared_ptr<viFrame> &viframe_i,
+	       std::shared_ptr<viFrame> &viframe_j);
+
+	virtual bool Evaluate(double const* const* parameters,
+	                      double* residuals,
+	                      double** jacobians) const;
+
+private:
+	std::shared_ptr<imuFactor> imufactor;
+	std::shared_ptr<viFrame> viframe_i;
+	std::shared_ptr<viFrame> viframe_j;
+};
+
+class PnPErr : public ceres::SizedCostFunction<2, 15, 3> {
+public:
+	PnPErr(std::shared_ptr<viFrame> &viframe, const Eigen::Vector2d &px);
+
+	virtual bool Evaluate(double const* const* parameters,
+	                      double* residuals,
+	                      double** jacobians) const;
+private:
+	std::shared_ptr<viFrame> viframe;
+	Eigen::Matrix<double, 2, 1, Eigen::DontAlign> px;   //!< the observation, level 0
+	Sophus::SE3d T_SB;
+};
+
+
+#endif //SIMPLE_VIO_BAERROR_H
@@ -0,0 +1,443 @@
+#include <unordered_map>
+#include <cmath>
+#include <algorithm>
+
+#include "SchurBA.h"
+#include "BAError.h"
+#include "DataStructure/cv/cvFrame.h"
+#include "DataStructure/viFrame.h"
+#include "DataStructure/imu/imuFactor.h"
+#include "DataStructure/cv/Point.h"
+#include "DataStructure/cv/Feature.h"
+#include "util/setting.h"
+
+SchurBA::SchurBA(const Options &options) : options_(options), initialCost_(0.0), cost_(0.0), iterations_(0) {
+
+}
+
+SchurBA::~SchurBA() {}
+
+bool SchurBA::run(std::vector<std::shared_ptr<viFrame>> &viframes,
+                  ObsGraph &graph,
+                  std::vector<std::shared_ptr<imuFactor>> &imufactors, int iter_, BAUpdate *update) {
+	size_t poseNum = viframes.size();
+	if(poseNum < widowSize)
+		return false;
+
+	pointCache_.clear();
+	load(viframes, graph, imufactors);
+
+	double lambda = options_.initialLambda;
+	double nu = 2.0;
+	initialCost_ = cost_ = evaluate(x_, false, true);
+	iterations_ = 0;
+	bool converged = false;
+	while(iterations_ < iter_ && !converged) {
+		iterations_++;
+		double gradient = bp_.lpNorm<Eigen::Infinity>();
+		for(auto &lm : landmarks_)
+			gradient = std::max(gradient, lm.bl.lpNorm<Eigen::Infinity>());
+		if(gradient <= options_.gradientTolerance) {
+			converged = true;
+			break;
+		}
+
+		if(solve(lambda)) {
+			double newCost = evaluate(xNew_, true, false);
+			if(newCost < cost_) {
+				converged = cost_ - newCost <= options_.functionTolerance * cost_
+				            || dx_.norm() <= options_.parameterTolerance * (x_.norm() + options_.parameterTolerance);
+				x_.swap(xNew_);
+				for(auto &lm : landmarks_)
+					lm.pos += lm.update;
+				cost_ = converged ? newCost : evaluate(x_, false, true);
+				lambda = std::max(lambda / 3.0, options_.minLambda);
+				nu = 2.0;
+				continue;
+			}
+		}
+
+		lambda *= nu;
+		nu *= 2.0;
+		if(lambda > options_.maxLambda)
+			converged = true;
+	}
+
+	if(converged) {
+		for(size_t i = 0; i < poseNum; ++i) {
+			Sophus::SO3d R = Sophus::SO3d::exp(x_.segment<3>(i * 15));
+			Sophus::SE3d T(R, x_.segment<3>(i * 15 + 3));
+			viframes[i]->getSpeedAndBias() = x_.segment<9>(i * 15 + 6);
+			if(update) {
+				update->frames.push_back(viframes[i]->getCVFrame());
+				update->poses.push_back(T);
+				CachedPose &cached = poseCache_[viframes[i]->getCVFrame()->getID()];
+				cached.phi = x_.segment<3>(i * 15);
+				cached.trans = x_.segment<3>(i * 15 + 3);
+			}
+			else
+				viframes[i]->getCVFrame()->setPose(T);
+		}
+
+		for(auto &lm : landmarks_) {
+			if(update) {
+				update->points.push_back(lm.point);
+				update->positions.push_back(lm.pos);
+				update->versions.push_back(lm.version);
+				CachedPoint &cached = pointCache_[lm.point->id_];
+				cached.pos = lm.pos;
+				cached.version = lm.version;
+			}
+			else {
+				lm.point->setPos(lm.pos);
+			}
+		}
+	}
+
+	release();
+	return converged;
+}
+
+// largest eigenvalues only, the marginalised blocks are rank deficient along the gauge
+static Eigen::MatrixXd pseudoInverse(const Eigen::MatrixXd &H, double eps = 1e-8) {
+	Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> eig(0.5 * (H + H.transpose()));
+	const Eigen::VectorXd &S = eig.eigenvalues();
+	Eigen::VectorXd Sinv = Eigen::VectorXd::Zero(S.size());
+	for(int i = 0; i < S.size(); ++i)
+		if(S(i) > eps * std::max(S(S.size() - 1), 1.0))
+			Sinv(i) = 1.0 / S(i);
+	return eig.eigenvectors() * Sinv.asDiagonal() * eig.eigenvectors().transpose();
+}
+
+bool SchurBA::marginalize(std::vector<std::shared_ptr<viFrame>> &viframes,
+                          ObsGraph &graph,
+                          std::vector<std::shared_ptr<imuFactor>> &imufactors) {
+	const int poseNum = int(viframes.size());
+	if(poseNum < 2)
+		return false;
+
+	load(viframes, graph, imufactors);
+	const int n = 15 * poseNum;
+	const int r = n - 15;
+
+	// everything touching pose 0: the old prior, the first imu factor and the points pose 0 sees
+	Eigen::MatrixXd H = Eigen::MatrixXd::Zero(n, n);
+	Eigen::VectorXd b = Eigen::VectorXd::Zero(n);
+	priorTerm(x_, &H, &b);
+	if(!imuErrs_.empty())
+		imuTerm(0, x_, &H, &b);
+
+	// a point pose 0 sees goes into the prior with all its observations, it couples the poses seeing it there.
+	// later runs skip these observations, dropping only the one in pose 0 would throw their information away
+	for(auto &lm : landmarks_) {
+		bool seen = false;
+		for(int k = lm.first; k < lm.last; ++k)
+			seen |= obs_[k].pose == 0;
+		if(!seen)
+			continue;
+
+		landmarkTerm(lm, x_, lm.pos, &H, &b);
+		const Eigen::Matrix3d HllInv = pseudoInverse(lm.Hll);
+		for(int a = lm.first; a < lm.last; ++a) {
+			const Eigen::Matrix<double, 6, 3> HplHllInv = obs_[a].Hpl * HllInv;
+			const int pa = obs_[a].pose * 15;
+			b.segment<6>(pa) -= HplHllInv * lm.bl;
+			for(int c = lm.first; c < lm.last; ++c)
+				H.block<6, 6>(pa, obs_[c].pose * 15) -= HplHllInv * obs_[c].Hpl.transpose();
+		}
+		std::vector<int> &folded = marginalized_[lm.point->id_];
+		for(int a = lm.first; a < lm.last; ++a)
+			folded.push_back(viframes[obs_[a].pose]->getCVFrame()->getID());
+	}
+
+	// then pose 0 itself
+	const Eigen::MatrixXd HmmInv = pseudoInverse(H.topLeftCorner(15, 15));
+	const Eigen::MatrixXd Hrm = H.bottomLeftCorner(r, 15);
+	const Eigen::MatrixXd Hp = H.bottomRightCorner(r, r) - Hrm * HmmInv * Hrm.transpose();
+	const Eigen::VectorXd bp = b.tail(r) - Hrm * HmmInv * b.head(15);
+
+	// kept as a residual so the cost stays a sum of squares: J^T J = Hp, J^T e = -bp
+	Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> eig(0.5 * (Hp + Hp.transpose()));
+	const Eigen::VectorXd &S = eig.eigenvalues();
+	Eigen::VectorXd sqrtS = Eigen::VectorXd::Zero(r), sqrtSinv = Eigen::VectorXd::Zero(r);
+	for(int i = 0; i < r; ++i) {
+		if(S(i) > 1e-8 * std::max(S(r - 1), 1.0)) {
+			sqrtS(i) = std::sqrt(S(i));
+			sqrtSinv(i) = 1.0 / sqrtS(i);
+		}
+	}
+	priorJ_ = sqrtS.asDiagonal() * eig.eigenvectors().transpose();
+	priorE_ = -(sqrtSinv.asDiagonal() * eig.eigenvectors().transpose() * bp);
+	priorH_ = priorJ_.transpose() * priorJ_;
+	priorX_ = x_.tail(r);
+	priorDx_.resize(r);
+	priorFrames_.assign(viframes.begin() + 1, viframes.end());
+
+	release();
+	return true;
+}
+
+void SchurBA::release() {
+	// the buffers keep their capacity, the frames and points are released
+	imuErrs_.clear();
+	obs_.clear();
+	landmarks_.clear();
+}
+
+void SchurBA::load(std::vector<std::shared_ptr<viFrame>> &viframes,
+                   ObsGraph &graph,
+                   std::vector<std::shared_ptr<imuFactor>> &imufactors) {
+	const int poseNum = int(viframes.size());
+	const int n = 15 * poseNum;
+	if(x_.size() != n) {
+		x_.resize(n);
+		xNew_.resize(n);
+		Hpp_.resize(n, n);
+		S_.resize(n, n);
+		bp_.resize(n);
+		bs_.resize(n);
+		dx_.resize(n);
+		ldlt_ = Eigen::LDLT<Eigen::MatrixXd>(n);
+	}
+
+	// a run that handed its poses over as a BAUpdate starts from them, whether the front end applied them or not
+	std::unordered_map<int, int> memTabel;
+	for(int i = 0; i < poseNum; ++i) {
+		const int id = viframes[i]->getCVFrame()->getID();
+		auto cached = poseCache_.find(id);
+		if(cached != poseCache_.end()) {
+			x_.segment<3>(i * 15) = cached->second.phi;
+			x_.segment<3>(i * 15 + 3) = cached->second.trans;
+		}
+		else {
+			auto pose = viframes[i]->getCVFrame()->getPose();
+			x_.segment<3>(i * 15) = pose.so3().log();
+			x_.segment<3>(i * 15 + 3) = pose.translation();
+		}
+		x_.segment<9>(i * 15 + 6) = viframes[i]->getSpeedAndBias();
+		memTabel.insert(std::make_pair(id, i));
+	}
+	for(auto it = poseCache_.begin(); it != poseCache_.end();) {
+		if(memTabel.count(it->first))
+			++it;
+		else
+			it = poseCache_.erase(it);
+	}
+
+	priorIndex_.clear();
+	for(auto &frame : priorFrames_) {
+		auto it = std::find(viframes.begin(), viframes.end(), frame);
+		if(it == viframes.end()) {
+			// the window moved on without marginalising, the prior doesn't describe it any more
+			priorIndex_.clear();
+			priorFrames_.clear();
+			break;
+		}
+		priorIndex_.push_back(int(it - viframes.begin()));
+	}
+
+	for(size_t i = 0; i < imufactors.size() && i + 1 < viframes.size(); ++i)
+		imuErrs_.push_back(std::make_shared<IMUErr>(imufactors[i], viframes[i], viframes[i + 1]));
+
+	std::unordered_map<int, std::vector<int>> stillSeen;
+	for(auto &track : graph.tracks()) {
+		if(!track.point)
+			continue;
+		const std::vector<int> *folded = nullptr;
+		auto marginalized = marginalized_.find(track.point->id_);
+		if(marginalized != marginalized_.end())
+			folded = &(stillSeen[track.point->id_] = std::move(marginalized->second));
+		if(track.obs.size() < 3)
+			continue;
+
+		Landmark lm;
+		lm.point = track.point;
+		lm.pos = lm.point->getPos(lm.version);
+		auto cached = pointCache_.find(track.point->id_);
+		if(cached != pointCache_.end() && cached->second.version == lm.version)
+			lm.pos = cached->second.pos;
+		lm.update.setZero();
+		lm.valid = false;
+		lm.first = int(obs_.size());
+		for(auto &ob : track.obs) {
+			auto frame = memTabel.find(ob.frame);
+			if(frame == memTabel.end())
+				continue;
+			if(folded && std::find(folded->begin(), folded->end(), ob.frame) != folded->end())
+				continue;
+			Observation obs;
+			obs.pose = frame->second;
+			obs.err = std::make_shared<PnPErr>(viframes[obs.pose], ob.px);
+			obs_.push_back(obs);
+		}
+		lm.last = int(obs_.size());
+		// what the keyframes since the prior saw of a marginalised point, refined once as many of them see it as any new point needs
+		if(folded && lm.last - lm.first < 3) {
+			obs_.erase(obs_.begin() + lm.first, obs_.end());
+			continue;
+		}
+		landmarks_.push_back(lm);
+	}
+	marginalized_.swap(stillSeen);
+}
+
+double SchurBA::robustWeight(double s, double &rho) const {
+	const double d2 = options_.huberDelta * options_.huberDelta;
+	if(s <= d2) {
+		rho = s;
+		return 1.0;
+	}
+
+	const double r = std::sqrt(s);
+	rho = 2.0 * options_.huberDelta * r - d2;
+	return options_.huberDelta / r;
+}
+
+double SchurBA::evaluate(const Eigen::VectorXd &x, bool useUpdate, bool linearize) {
+	Eigen::MatrixXd *H = linearize ? &Hpp_ : nullptr;
+	Eigen::VectorXd *b = linearize ? &bp_ : nullptr;
+	if(linearize) {
+		Hpp_.setZero();
+		bp_.setZero();
+	}
+
+	double cost = priorTerm(x, H, b);
+	for(size_t i = 0; i < imuErrs_.size(); ++i)
+		cost += imuTerm(i, x, H, b);
+	for(auto &lm : landmarks_)
+		cost += landmarkTerm(lm, x, useUpdate ? Eigen::Vector3d(lm.pos + lm.update) : lm.pos, H, b);
+	return cost;
+}
+
+double SchurBA::priorTerm(const Eigen::VectorXd &x, Eigen::MatrixXd *H, Eigen::VectorXd *b) {
+	const int m = int(priorIndex_.size());
+	if(m == 0)
+		return 0.0;
+
+	for(int k = 0; k < m; ++k) {
+		const int p = priorIndex_[k] * 15;
+		priorDx_.segment<3>(k * 15) = (Sophus::SO3d::exp(priorX_.segment<3>(k * 15)).inverse()
+		                               * Sophus::SO3d::exp(x.segment<3>(p))).log();
+		priorDx_.segment<12>(k * 15 + 3) = x.segment<12>(p + 3) - priorX_.segment<12>(k * 15 + 3);
+	}
+	priorR_.noalias() = priorJ_ * priorDx_;
+	priorR_ += priorE_;
+	if(H) {
+		for(int k = 0; k < m; ++k) {
+			const int p = priorIndex_[k] * 15;
+			for(int l = 0; l < m; ++l)
+				H->block<15, 15>(p, priorIndex_[l] * 15) += priorH_.block<15, 15>(k * 15, l * 15);
+			b->segment<15>(p).noalias() -= priorJ_.middleCols<15>(k * 15).transpose() * priorR_;
+		}
+	}
+	return 0.5 * priorR_.squaredNorm();
+}
+
+double SchurBA::imuTerm(size_t i, const Eigen::VectorXd &x, Eigen::MatrixXd *H, Eigen::VectorXd *b) {
+	Eigen::Matrix<double, 9, 1> r;
+	Eigen::Matrix<double, 9, 15, Eigen::RowMajor> Ji, Jj;
+	const double *parameters[2] = {x.data() + i * 15, x.data() + i * 15 + 15};
+	double *jacobians[2] = {Ji.data(), Jj.data()};
+	imuErrs_[i]->Evaluate(parameters, r.data(), H ? jacobians : nullptr);
+	double rho;
+	const double w = robustWeight(r.squaredNorm(), rho);
+	if(!H)
+		return 0.5 * rho;
+
+	const int pi = int(i) * 15, pj = pi + 15;
+	H->block<15, 15>(pi, pi) += w * Ji.transpose() * Ji;
+	H->block<15, 15>(pi, pj) += w * Ji.transpose() * Jj;
+	H->block<15, 15>(pj, pi) += w * Jj.transpose() * Ji;
+	H->block<15, 15>(pj, pj) += w * Jj.transpose() * Jj;
+	b->segment<15>(pi) -= w * Ji.transpose() * r;
+	b->segment<15>(pj) -= w * Jj.transpose() * r;
+	return 0.5 * rho;
+}
+
+double SchurBA::landmarkTerm(Landmark &lm, const Eigen::VectorXd &x, const Eigen::Vector3d &pos,
+                             Eigen::MatrixXd *H, Eigen::VectorXd *b) {
+	double cost = 0.0, rho;
+	Eigen::Vector2d r;
+	Eigen::Matrix<double, 2, 15, Eigen::RowMajor> Jp;
+	Eigen::Matrix<double, 2, 3, Eigen::RowMajor> Jl;
+	if(H) {
+		lm.Hll.setZero();
+		lm.bl.setZero();
+	}
+
+	for(int k = lm.first; k < lm.last; ++k) {
+		Observation &obs = obs_[k];
+		const double *parameters[2] = {x.data() + obs.pose * 15, pos.data()};
+		double *jacobians[2] = {Jp.data(), Jl.data()};
+		obs.err->Evaluate(parameters, r.data(), H ? jacobians : nullptr);
+		const double w = robustWeight(r.squaredNorm(), rho);
+		cost += 0.5 * rho;
+		if(!H)
+			continue;
+
+		const Eigen::Matrix<double, 2, 6> Jpose = Jp.leftCols<6>();
+		const int p = obs.pose * 15;
+		H->block<6, 6>(p, p) += w * Jpose.transpose() * Jpose;
+		b->segment<6>(p) -= w * Jpose.transpose() * r;
+		lm.Hll += w * Jl.transpose() * Jl;
+		lm.bl -= w * Jl.transpose() * r;
+		obs.Hpl = w * Jpose.transpose() * Jl;
+	}
+	return cost;
+}
+
+bool SchurBA::solve(double lambda) {
+	const int n = int(x_.size());
+	S_ = Hpp_;
+	bs_ = bp_;
+	for(int i = 0; i < n; ++i)
+		S_(i, i) += lambda * std::max(Hpp_(i, i), 1e-6);
+
+	// eliminate the points, every pair of poses seeing a point gets coupled.
+	// the LDLT only reads the lower triangle, the blocks above the diagonal are skipped
+	for(auto &lm : landmarks_) {
+		Eigen::Matrix3d H = lm.Hll;
+		for(int d = 0; d < 3; ++d)
+			H(d, d) += lambda * std::max(lm.Hll(d, d), 1e-6);
+		double det;
+		H.computeInverseAndDetWithCheck(lm.HllInv, det, lm.valid);
+		lm.update.setZero();
+		if(!lm.valid)
+			continue;
+
+		for(int a = lm.first; a < lm.last; ++a) {
+			const Eigen::Matrix<double, 6, 3> HplHllInv = obs_[a].Hpl * lm.HllInv;
+			const int pa = obs_[a].pose * 15;
+			bs_.segment<6>(pa) -= HplHllInv * lm.bl;
+			for(int b = lm.first; b < lm.last; ++b) {
+				if(obs_[b].pose <= obs_[a].pose)
+					S_.block<6, 6>(pa, obs_[b].pose * 15) -= HplHllInv * obs_[b].Hpl.transpose();
+			}
+		}
+	}
+
+	ldlt_.compute(S_);
+	if(ldlt_.info() != Eigen::Success)
+		return false;
+	dx_ = ldlt_.solve(bs_);
+	if(!dx_.allFinite())
+		return false;
+
+	// back substitution of the points
+	for(auto &lm : landmarks_) {
+		if(!lm.valid)
+			continue;
+		Eigen::Vector3d b = lm.bl;
+		for(int a = lm.first; a < lm.last; ++a)
+			b -= obs_[a].Hpl.transpose() * dx_.segment<6>(obs_[a].pose * 15);
+		lm.update = lm.HllInv * b;
+	}
+
+	// rotation on the right like VioPose::Plus, the rest is additive
+	xNew_ = x_ + dx_;
+	for(int i = 0; i < n / 15; ++i) {
+		Sophus::SO3d R = Sophus::SO3d::exp(x_.segment<3>(i * 15)) * Sophus::SO3d::exp(dx_.segment<3>(i * 15));
+		xNew_.segment<3>(i * 15) = R.log();
+	}
+	return true;
+}
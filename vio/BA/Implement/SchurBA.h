@@ -0,0 +1,123 @@
+#ifndef SIMPLE_VIO_SCHURBA_H
+#define SIMPLE_VIO_SCHURBA_H
+
+#include <unordered_map>
+#include <Eigen/Dense>
+#include <Eigen/StdVector>
+#include "BABase.h"
+
+class IMUErr;
+class PnPErr;
+
+/// Levenberg-Marquardt on the window with the structure spelled out: the 3x3 point blocks are
+/// eliminated by Schur complement into a dense system over the 15-dim poses, solved by an LDLT.
+/// the residual models and their Huber(0.5) loss are the ones of SimpleBA, every buffer is kept
+/// between runs so a window of fixed size doesn't allocate its linear algebra again.
+/// keyframes leaving the window are marginalised together with the points they see into a dense gaussian
+/// prior on the remaining poses, which enters the following runs as one more residual, so a run costs the same however long the sequence.
+class SchurBA : public BABase {
+public:
+	struct Options {
+		Options() : huberDelta(0.5), initialLambda(1e-4), minLambda(1e-12), maxLambda(1e12),
+		            functionTolerance(1e-6), parameterTolerance(1e-8), gradientTolerance(1e-10) {}
+		double huberDelta;
+		double initialLambda;       //!< relative to the diagonal
+		double minLambda;
+		double maxLambda;           //!< no step can be taken any more, counted as converged
+		double functionTolerance;   //!< converged when the relative cost decrease drops below it
+		double parameterTolerance;  //!< or when the step is this small relative to the state
+		double gradientTolerance;   //!< or when no gradient entry is larger
+	};
+
+public:
+	SchurBA(const Options &options = Options());
+	~SchurBA();
+	bool run(std::vector<std::shared_ptr<viFrame>> &viframes,
+	         ObsGraph &graph,
+	         std::vector<std::shared_ptr<imuFactor>> &imufactors, int iter_, BAUpdate *update = nullptr);
+	bool marginalize(std::vector<std::shared_ptr<viFrame>> &viframes,
+	                 ObsGraph &graph,
+	                 std::vector<std::shared_ptr<imuFactor>> &imufactors);
+
+	bool hasPrior() const { return !priorFrames_.empty(); }
+	double initialCost() const { return initialCost_; }
+	double finalCost() const { return cost_; }
+	int iterations() const { return iterations_; }
+
+private:
+	struct Landmark {
+		std::shared_ptr<Point> point;
+		Eigen::Vector3d        pos;
+		unsigned               version;    //!< of the point when pos was read
+		Eigen::Vector3d        update;
+		Eigen::Matrix3d        Hll;
+		Eigen::Matrix3d        HllInv;     //!< damped
+		Eigen::Vector3d        bl;
+		int                    first, last; //!< its observations in obs_
+		bool                   valid;
+	};
+
+	struct CachedPose {
+		Eigen::Vector3d phi, trans;
+	};
+
+	struct CachedPoint {
+		Eigen::Vector3d pos;
+		unsigned        version;    //!< of the point when the run read it
+	};
+
+	struct Observation {
+		EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+		int                     pose;
+		std::shared_ptr<PnPErr> err;
+		Eigen::Matrix<double, 6, 3> Hpl;   //!< a reprojection only touches rotation and translation
+	};
+
+	void load(std::vector<std::shared_ptr<viFrame>> &viframes,
+	          ObsGraph &graph,
+	          std::vector<std::shared_ptr<imuFactor>> &imufactors);
+	void release();
+	double evaluate(const Eigen::VectorXd &x, bool useUpdate, bool linearize);
+	double priorTerm(const Eigen::VectorXd &x, Eigen::MatrixXd *H, Eigen::VectorXd *b);
+	double imuTerm(size_t i, const Eigen::VectorXd &x, Eigen::MatrixXd *H, Eigen::VectorXd *b);
+	double landmarkTerm(Landmark &lm, const Eigen::VectorXd &x, const Eigen::Vector3d &pos,
+	                    Eigen::MatrixXd *H, Eigen::VectorXd *b);
+	bool solve(double lambda);
+	double robustWeight(double s, double &rho) const;
+
+private:
+	Options                                 options_;
+
+	std::vector<std::shared_ptr<IMUErr>>    imuErrs_;       //!< between pose i and i + 1
+	std::vector<Observation, Eigen::aligned_allocator<Observation>> obs_;
+	std::vector<Landmark>                   landmarks_;
+
+	Eigen::VectorXd                         x_, xNew_;      //!< 15 per pose
+	Eigen::MatrixXd                         Hpp_, S_;
+	Eigen::VectorXd                         bp_, bs_, dx_;
+	Eigen::LDLT<Eigen::MatrixXd>            ldlt_;
+
+	// prior of the marginalised keyframes, a residual priorJ_ * (x - priorX_) + priorE_ on the poses of priorFrames_
+	std::vector<std::shared_ptr<viFrame>>   priorFrames_;
+	std::vector<int>                        priorIndex_;    //!< window index of every prior pose in the running problem
+	Eigen::VectorXd                         priorX_;
+	Eigen::MatrixXd                         priorJ_;
+	Eigen::VectorXd                         priorE_;
+	Eigen::MatrixXd                         priorH_;        //!< priorJ_^T * priorJ_
+	Eigen::VectorXd                         priorDx_, priorR_;
+	std::unordered_map<int, std::vector<int>> marginalized_; //!< Point::id_ -> keyframes whose observations of it are in the prior
+
+	// the last poses handed over as a BAUpdate, by cvFrame id. a run starts its points from Point::getPos, which has
+	// the depths the front end fused since
+	std::unordered_map<int, CachedPose>     poseCache_;
+	// the points of that BAUpdate, by Point::id_. marginalize linearises at them with the poses, unless the front end
+	// wrote the point since the run read it
+	std::unordered_map<int, CachedPoint>    pointCache_;
+
+	double                                  initialCost_;
+	double                                  cost_;
+	int                                     iterations_;
+};
+
+
+#endif //SIMPLE_VIO_SCHURBA_H
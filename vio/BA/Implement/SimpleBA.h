@@ -8,6 +8,7 @@
 
 #include <Eigen/Dense>
 #include "BABase.h"
+#include "DataStructure/cv/PointStore.h"
 
 
 class SimpleBA : public BABase {
@@ -15,13 +16,14 @@ public:
 	SimpleBA();
 	~SimpleBA();
 	bool run(std::vector<std::shared_ptr<viFrame>> &viframes,
-	         typename BundleAdjustemt::obsModeType &obsModes,
-	         std::vector<std::shared_ptr<imuFactor>> &imufactors, int iter_);
+	         ObsGraph &graph,
+	         std::vector<std::shared_ptr<imuFactor>> &imufactors, int iter_, BAUpdate *update = nullptr);
 
 private:
 	struct CopyPoint {
-		std::shared_ptr<Point> point;
+		PointStore::Handle handle;
 		Eigen::Vector3d pos_;
+		unsigned version;
 	};
 
 };
@@ -0,0 +1,326 @@
+#include <random>
+#include <algorithm>
+
+#include "opencv2/ts/ts.hpp"
+#include "IO/camera/CameraIO.h"
+#include "DataStructure/viFrame.h"
+#include "DataStructure/cv/cvFrame.h"
+#include "DataStructure/cv/Point.h"
+#include "DataStructure/cv/Feature.h"
+#include "DataStructure/imu/imuFactor.h"
+#include "vio/BA/BundleAdjustemt.h"
+#include "vio/BA/Implement/SchurBA.h"
+#include "util/setting.h"
+#include "util/util.h"
+
+namespace {
+	struct Window {
+		std::vector<std::shared_ptr<viFrame>>   viframes;
+		std::vector<std::shared_ptr<imuFactor>> imufactors;
+		ObsGraph                                graph;
+		std::vector<Sophus::SE3d>               truth;
+	};
+
+	// a window of known poses seeing random points with pixel noise, every pose but the first one perturbed
+	void makeWindow(const std::shared_ptr<AbstractCamera> &cam, int poseNum, int pointNum, Window &window) {
+		std::mt19937 rng(7);
+		std::normal_distribution<double> noise(0.0, 1.0);
+		std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+		auto imuParam = std::make_shared<ImuParameters>();
+		// the factors come straight from the true poses, without gravity. the default constructor leaves g as it finds it
+		imuParam->g.setZero();
+		cv::Mat pic(480, 752, CV_8UC1, cv::Scalar(0));
+
+		for(int i = 0; i < poseNum; ++i) {
+			Sophus::SE3d T(Sophus::SO3d::exp(Eigen::Vector3d(0.01 * i, 0.02 * i, -0.01 * i)),
+			               Eigen::Vector3d(0.1 * i, 0.02 * i, 0.03 * i));
+			std::shared_ptr<cvFrame> frame = std::make_shared<cvFrame>(cam, pic, okvis::Time(1.0 + 0.1 * i));
+			frame->setPose(T);
+			window.truth.push_back(T);
+			window.viframes.push_back(std::make_shared<viFrame>(i, frame, imuParam));
+		}
+
+		for(int i = 0; i + 1 < poseNum; ++i) {
+			IMUMeasure::covariance_t var = IMUMeasure::covariance_t::Identity(9, 9) * 1e-2;
+			imuFactor::FacJBias_t jbias = imuFactor::FacJBias_t::Zero();
+			window.imufactors.push_back(std::make_shared<imuFactor>(window.truth[i].inverse() * window.truth[i + 1],
+			                                                        jbias, Eigen::Vector3d::Zero(), var));
+		}
+
+		const Sophus::SE3d T_SB = cam->getT_BS().inverse();
+		for(int k = 0; k < pointNum; ++k) {
+			Eigen::Vector3d pc(uniform(rng) * 2.0, uniform(rng) * 1.5, 3.0 + 2.0 * uniform(rng));
+			Eigen::Vector3d pw = window.truth[0].inverse() * (T_SB.inverse() * pc);
+			auto point = std::make_shared<Point>(pw + 0.05 * Eigen::Vector3d(noise(rng), noise(rng), noise(rng)));
+			for(int i = 0; i < poseNum; ++i) {
+				Eigen::Vector3d p = T_SB * (window.truth[i] * pw);
+				if(p(2) < 0.1)
+					continue;
+				Eigen::Vector2d px = cam->world2cam(p);
+				if(px(0) < 0 || px(1) < 0 || px(0) >= pic.cols || px(1) >= pic.rows)
+					continue;
+				px += 0.3 * Eigen::Vector2d(noise(rng), noise(rng));
+				window.graph.addObservation(std::make_shared<Feature>(window.viframes[i]->getCVFrame(), point, px, p.normalized(), 0));
+			}
+		}
+
+		for(int i = 1; i < poseNum; ++i) {
+			Eigen::Matrix<double, 6, 1> delta;
+			delta << 0.005 * noise(rng), 0.005 * noise(rng), 0.005 * noise(rng),
+			         0.02 * noise(rng), 0.02 * noise(rng), 0.02 * noise(rng);
+			Sophus::SE3d T = window.truth[i] * Sophus::SE3d::exp(delta);
+			window.viframes[i]->getCVFrame()->setPose(T);
+		}
+	}
+
+	// largest error of the poses relative to the first one, free of the gauge
+	double relativePoseError(Window &window) {
+		double err = 0.0;
+		Sophus::SE3d T0 = window.viframes[0]->getCVFrame()->getPose();
+		for(size_t i = 1; i < window.viframes.size(); ++i) {
+			Sophus::SE3d T = T0.inverse() * window.viframes[i]->getCVFrame()->getPose();
+			err = std::max(err, ((window.truth[0].inverse() * window.truth[i]).inverse() * T).log().norm());
+		}
+		return err;
+	}
+
+	// largest difference between the frame to frame motions of two solutions of the same poses,
+	// T_i * T_0^-1 doesn't change with the world frame so the two gauges needn't agree
+	double solutionDifference(const std::vector<std::shared_ptr<viFrame>> &a,
+	                          const std::vector<std::shared_ptr<viFrame>> &b) {
+		double diff = 0.0;
+		Sophus::SE3d A0 = a[0]->getCVFrame()->getPose(), B0 = b[0]->getCVFrame()->getPose();
+		for(size_t i = 1; i < a.size(); ++i) {
+			Sophus::SE3d A = a[i]->getCVFrame()->getPose() * A0.inverse();
+			Sophus::SE3d B = b[i]->getCVFrame()->getPose() * B0.inverse();
+			diff = std::max(diff, (A.inverse() * B).log().norm());
+		}
+		return diff;
+	}
+
+	double solutionDifference(Window &a, Window &b) {
+		return solutionDifference(a.viframes, b.viframes);
+	}
+}
+
+TEST(SchurBA, synthetic) {
+	std::string camDatafile = "../testData/mav0/cam1/data.csv";
+	std::string camParamfile ="../testData/mav0/cam1/sensor.yaml";
+	CameraIO camTest(camDatafile,camParamfile);
+	const CameraIO::pCamereParam cam = camTest.getCamera();
+
+	for(int poseNum : {widowSize, 2 * widowSize}) {
+		Window ceresWindow, schurWindow;
+		makeWindow(cam, poseNum, 500, ceresWindow);
+		makeWindow(cam, poseNum, 500, schurWindow);
+		const double initialError = relativePoseError(schurWindow);
+
+		BundleAdjustemt ceresBA(SIMPLE_BA);
+		bool ceresRes;
+		{
+			printf("ceres, %d poses:\n", poseNum);
+			TimeUse time(__FUNCTION__, __LINE__);
+			ceresRes = ceresBA.run(ceresWindow.viframes, ceresWindow.graph, ceresWindow.imufactors);
+		}
+
+		SchurBA schurBA;
+		bool schurRes;
+		{
+			printf("schur, %d poses:\n", poseNum);
+			TimeUse time(__FUNCTION__, __LINE__);
+			schurRes = schurBA.run(schurWindow.viframes, schurWindow.graph, schurWindow.imufactors, 50);
+		}
+
+		printf("schur: %d iterations, cost %f -> %f\n", schurBA.iterations(), schurBA.initialCost(), schurBA.finalCost());
+		const double difference = solutionDifference(ceresWindow, schurWindow);
+		printf("relative pose error: initial %f, ceres %f (%d), schur %f, between the two %g\n", initialError,
+		       relativePoseError(ceresWindow), ceresRes, relativePoseError(schurWindow), difference);
+		ASSERT_TRUE(ceresRes);
+		ASSERT_TRUE(schurRes);
+		EXPECT_LT(schurBA.finalCost(), schurBA.initialCost());
+		EXPECT_LT(relativePoseError(schurWindow), initialError);
+		// the same problem, both converge to the same minimum
+		EXPECT_LT(difference, 1e-3);
+	}
+}
+
+TEST(SchurBA, marginalize) {
+	std::string camDatafile = "../testData/mav0/cam1/data.csv";
+	std::string camParamfile ="../testData/mav0/cam1/sensor.yaml";
+	CameraIO camTest(camDatafile,camParamfile);
+	const CameraIO::pCamereParam cam = camTest.getCamera();
+
+	// slide a window of widowSize over twice as many keyframes, the oldest one marginalised at every step
+	Window window;
+	makeWindow(cam, 2 * widowSize, 500, window);
+	std::vector<std::shared_ptr<viFrame>> viframes(window.viframes.begin(), window.viframes.begin() + widowSize);
+	std::vector<std::shared_ptr<imuFactor>> imufactors(window.imufactors.begin(), window.imufactors.begin() + widowSize - 1);
+
+	SchurBA schurBA;
+	for(int next = widowSize; ; ++next) {
+		{
+			printf("window %d..%d:\n", viframes.front()->getID(), viframes.back()->getID());
+			TimeUse time(__FUNCTION__, __LINE__);
+			schurBA.run(viframes, window.graph, imufactors, 50);
+		}
+		printf("%d iterations, cost %f -> %f\n", schurBA.iterations(), schurBA.initialCost(), schurBA.finalCost());
+		EXPECT_LE(schurBA.finalCost(), schurBA.initialCost());
+		if(next == 2 * widowSize)
+			break;
+
+		ASSERT_TRUE(schurBA.marginalize(viframes, window.graph, imufactors));
+		EXPECT_TRUE(schurBA.hasPrior());
+		window.graph.removeKeyframe(viframes.front()->getCVFrame()->getID());
+		viframes.erase(viframes.begin());
+		imufactors.erase(imufactors.begin());
+		viframes.push_back(window.viframes[next]);
+		imufactors.push_back(window.imufactors[next - 1]);
+		ASSERT_EQ(viframes.size(), size_t(widowSize));
+	}
+}
+
+// the front end fuses a depth into a point while the BA runs: applying the result keeps the fused depth,
+// the next run starts from it
+TEST(SchurBA, staleUpdate) {
+	std::string camDatafile = "../testData/mav0/cam1/data.csv";
+	std::string camParamfile ="../testData/mav0/cam1/sensor.yaml";
+	CameraIO camTest(camDatafile,camParamfile);
+	const CameraIO::pCamereParam cam = camTest.getCamera();
+
+	Window window;
+	makeWindow(cam, widowSize, 500, window);
+	SchurBA schurBA;
+	BAUpdate update;
+	ASSERT_TRUE(schurBA.run(window.viframes, window.graph, window.imufactors, 50, &update));
+	ASSERT_FALSE(update.points.empty());
+	ASSERT_EQ(update.versions.size(), update.points.size());
+
+	std::shared_ptr<Point> fused = update.points.front();
+	fused->updateDepth(fused->getPos()(2) * 1.1, 1.0);
+	const Eigen::Vector3d fusedPos = fused->getPos();
+	EXPECT_EQ(update.apply(), size_t(1));
+	EXPECT_EQ(fused->getPos(), fusedPos);
+	for(size_t i = 1; i < update.points.size(); ++i)
+		EXPECT_EQ(update.points[i]->getPos(), update.positions[i]);
+
+	// applied once, a second apply of the same result is stale everywhere
+	EXPECT_EQ(update.apply(), update.points.size());
+
+	BAUpdate next;
+	ASSERT_TRUE(schurBA.run(window.viframes, window.graph, window.imufactors, 50, &next));
+	EXPECT_EQ(next.apply(), size_t(0));
+}
+
+// marginalising pose 0 at the optimum of the window keeps the optimum: the run over the remaining poses with
+// the prior has to stay at the full-batch solution. dropping pose 0 instead loses what its observations said
+TEST(SchurBA, marginalizeAgainstBatch) {
+	std::string camDatafile = "../testData/mav0/cam1/data.csv";
+	std::string camParamfile ="../testData/mav0/cam1/sensor.yaml";
+	CameraIO camTest(camDatafile,camParamfile);
+	const CameraIO::pCamereParam cam = camTest.getCamera();
+
+	Window batch, windowed, dropped;
+	// one pose more than a window, what is left after marginalising is a full one
+	makeWindow(cam, widowSize + 1, 500, batch);
+	makeWindow(cam, widowSize + 1, 500, windowed);
+	makeWindow(cam, widowSize + 1, 500, dropped);
+	SchurBA batchBA, windowedBA, droppedBA;
+	ASSERT_TRUE(batchBA.run(batch.viframes, batch.graph, batch.imufactors, 50));
+	ASSERT_TRUE(windowedBA.run(windowed.viframes, windowed.graph, windowed.imufactors, 50));
+	ASSERT_TRUE(droppedBA.run(dropped.viframes, dropped.graph, dropped.imufactors, 50));
+
+	ASSERT_TRUE(windowedBA.marginalize(windowed.viframes, windowed.graph, windowed.imufactors));
+	for(Window *w : {&windowed, &dropped}) {
+		w->graph.removeKeyframe(w->viframes.front()->getCVFrame()->getID());
+		w->viframes.erase(w->viframes.begin());
+		w->imufactors.erase(w->imufactors.begin());
+	}
+	{
+		printf("windowed, %lu poses with the prior:\n", windowed.viframes.size());
+		TimeUse time(__FUNCTION__, __LINE__);
+		ASSERT_TRUE(windowedBA.run(windowed.viframes, windowed.graph, windowed.imufactors, 50));
+	}
+	printf("%d iterations, cost %f -> %f\n", windowedBA.iterations(), windowedBA.initialCost(), windowedBA.finalCost());
+	ASSERT_TRUE(droppedBA.run(dropped.viframes, dropped.graph, dropped.imufactors, 50));
+
+	const std::vector<std::shared_ptr<viFrame>> rest(batch.viframes.begin() + 1, batch.viframes.end());
+	const double windowedDifference = solutionDifference(rest, windowed.viframes);
+	const double droppedDifference = solutionDifference(rest, dropped.viframes);
+	printf("from the batch solution: marginalised %g, dropped %g\n", windowedDifference, droppedDifference);
+	EXPECT_TRUE(windowedBA.hasPrior());
+	EXPECT_LT(windowedDifference, 1e-4);
+	EXPECT_LT(windowedDifference, droppedDifference);
+}
+
+// the system marginalises right after a run which handed its result over as a BAUpdate, before the front end
+// applied it: the prior has to be linearised at that result, the points included
+TEST(SchurBA, marginalizeAfterUpdate) {
+	std::string camDatafile = "../testData/mav0/cam1/data.csv";
+	std::string camParamfile ="../testData/mav0/cam1/sensor.yaml";
+	CameraIO camTest(camDatafile,camParamfile);
+	const CameraIO::pCamereParam cam = camTest.getCamera();
+
+	Window batch, windowed;
+	makeWindow(cam, widowSize + 1, 500, batch);
+	makeWindow(cam, widowSize + 1, 500, windowed);
+	SchurBA batchBA, windowedBA;
+	ASSERT_TRUE(batchBA.run(batch.viframes, batch.graph, batch.imufactors, 50));
+	BAUpdate update;
+	ASSERT_TRUE(windowedBA.run(windowed.viframes, windowed.graph, windowed.imufactors, 50, &update));
+
+	ASSERT_TRUE(windowedBA.marginalize(windowed.viframes, windowed.graph, windowed.imufactors));
+	update.apply();
+	windowed.graph.removeKeyframe(windowed.viframes.front()->getCVFrame()->getID());
+	windowed.viframes.erase(windowed.viframes.begin());
+	windowed.imufactors.erase(windowed.imufactors.begin());
+	ASSERT_TRUE(windowedBA.run(windowed.viframes, windowed.graph, windowed.imufactors, 50));
+
+	const std::vector<std::shared_ptr<viFrame>> rest(batch.viframes.begin() + 1, batch.viframes.end());
+	const double difference = solutionDifference(rest, windowed.viframes);
+	printf("from the batch solution: %g\n", difference);
+	EXPECT_LT(difference, 1e-4);
+}
+
+// a point in the prior seen by the keyframes which entered the window since is refined on their observations
+TEST(SchurBA, marginalizedPointSeenAgain) {
+	std::string camDatafile = "../testData/mav0/cam1/data.csv";
+	std::string camParamfile ="../testData/mav0/cam1/sensor.yaml";
+	CameraIO camTest(camDatafile,camParamfile);
+	const CameraIO::pCamereParam cam = camTest.getCamera();
+
+	const int slides = 3;
+	Window window;
+	makeWindow(cam, widowSize + slides, 500, window);
+	std::vector<std::shared_ptr<viFrame>> viframes(window.viframes.begin(), window.viframes.begin() + widowSize);
+	std::vector<std::shared_ptr<imuFactor>> imufactors(window.imufactors.begin(), window.imufactors.begin() + widowSize - 1);
+
+	// seen by the first keyframe, it goes into the prior, and by all the keyframes coming after the first window
+	std::shared_ptr<Point> point;
+	for(auto &track : window.graph.tracks()) {
+		int seen = 0;
+		for(auto &ob : track.obs)
+			seen += ob.frame == window.viframes[0]->getCVFrame()->getID()
+			        || ob.frame >= window.viframes[widowSize]->getCVFrame()->getID();
+		if(track.point && seen == 1 + slides) {
+			point = track.point;
+			break;
+		}
+	}
+	ASSERT_TRUE(point != nullptr);
+
+	SchurBA schurBA;
+	for(int next = widowSize; next < widowSize + slides; ++next) {
+		schurBA.run(viframes, window.graph, imufactors, 50);
+		EXPECT_LE(schurBA.finalCost(), schurBA.initialCost());
+		ASSERT_TRUE(schurBA.marginalize(viframes, window.graph, imufactors));
+		window.graph.removeKeyframe(viframes.front()->getCVFrame()->getID());
+		viframes.erase(viframes.begin());
+		imufactors.erase(imufactors.begin());
+		viframes.push_back(window.viframes[next]);
+		imufactors.push_back(window.imufactors[next - 1]);
+	}
+
+	BAUpdate update;
+	ASSERT_TRUE(schurBA.run(viframes, window.graph, imufactors, 50, &update));
+	EXPECT_NE(std::find(update.points.begin(), update.points.end(), point), update.points.end());
+}
@@ -28,9 +28,8 @@ public:
 	drPoint(std::shared_ptr<Point>& point_) : point(point_) {}
 	void draw() {
 		glColor3d(0.3, 0.6, 0.9);
-		point->pos_mutex.lock_shared();
-		glVertex3d(point->pos_[0] * 100, point->pos_[1] * 100, point->pos_[2] * 100);
-		point->pos_mutex.unlock_shared();
+		const Eigen::Vector3d pos = point->getPos();
+		glVertex3d(pos[0] * 100, pos[1] * 100, pos[2] * 100);
 	}
 
 private:
@@ -136,22 +135,10 @@ void testBA(int argc, char **argv) {
 	std::vector<std::shared_ptr<viFrame>> viframes = initer.getInitialViframe();
 	std::vector<std::shared_ptr<imuFactor>> imufactors = initer.getInitialImuFactor();
 	BundleAdjustemt BA(SIMPLE_BA);
-	BundleAdjustemt::obsModeType obsModes;
-	for(auto &keyframe : viframes) {
-		for(auto &ft : keyframe->getCVFrame()->getMeasure().fts_) {
-			auto it = obsModes.find(ft->point);
-			if(it != obsModes.end())
-				it->second.push_back(ft);
-			else {
-				std::list<std::shared_ptr<Feature>> fl;
-				fl.push_back(ft);
-				obsModes.insert(std::make_pair<std::shared_ptr<Point>,
-						std::list<std::shared_ptr<Feature>> >(std::shared_ptr<Point>(ft->point),
-				                                              std::move(fl)));
-			}
-		}
-	}
-	BA.run(viframes, obsModes, imufactors);
+	ObsGraph graph;
+	for(auto &keyframe : viframes)
+		graph.insertKeyframe(keyframe);
+	BA.run(viframes, graph, imufactors);
 	for(auto &viframe : viframes) {
 		viewer.pushPose(viframe);
 		const cvMeasure::features_t &fts = viframe->getCVFrame()->getMeasure().fts_;
@@ -0,0 +1,93 @@
+#include <algorithm>
+
+#include "ObsGraph.h"
+#include "DataStructure/viFrame.h"
+#include "DataStructure/cv/cvFrame.h"
+#include "DataStructure/cv/Feature.h"
+#include "DataStructure/cv/Point.h"
+
+void ObsGraph::insertKeyframe(const std::shared_ptr<viFrame> &keyframe) {
+	auto &fts = keyframe->getCVFrame()->getMeasure().fts_;
+	frameSlots_[keyframe->getCVFrame()->getID()].reserve(fts.size());
+	for(auto &ft : fts)
+		addObservation(ft);
+}
+
+bool ObsGraph::measure(const Feature &ft, Measurement &m) {
+	if(!ft.point)
+		return false;
+	m.point = ft.point;
+	m.ob.frame = ft.frame->getID();
+	m.ob.px = ft.px;
+	return true;
+}
+
+void ObsGraph::addObservation(const std::shared_ptr<Feature> &ft) {
+	Measurement m;
+	if(measure(*ft, m))
+		addObservation(m);
+}
+
+void ObsGraph::addObservation(const Measurement &m) {
+	int slot;
+	auto it = pointSlot_.find(m.point->id_);
+	if(it != pointSlot_.end())
+		slot = it->second;
+	else {
+		if(freeSlots_.empty()) {
+			slot = int(tracks_.size());
+			tracks_.push_back(Track());
+		}
+		else {
+			slot = freeSlots_.back();
+			freeSlots_.pop_back();
+		}
+		tracks_[slot].point = m.point;
+		pointSlot_.insert(std::make_pair(m.point->id_, slot));
+	}
+
+	tracks_[slot].obs.push_back(m.ob);
+	frameSlots_[m.ob.frame].push_back(slot);
+	++observationNum_;
+}
+
+void ObsGraph::removeKeyframe(int frame) {
+	auto it = frameSlots_.find(frame);
+	if(it == frameSlots_.end())
+		return;
+
+	for(int slot : it->second) {
+		Track &track = tracks_[slot];
+		if(!track.point)
+			continue;
+		auto end = std::remove_if(track.obs.begin(), track.obs.end(),
+		                          [frame](const Observation &ob) { return ob.frame == frame; });
+		observationNum_ -= track.obs.end() - end;
+		track.obs.erase(end, track.obs.end());
+		if(track.obs.empty()) {
+			// the vector keeps its capacity for the next point in this slot
+			pointSlot_.erase(track.point->id_);
+			track.point.reset();
+			freeSlots_.push_back(slot);
+		}
+	}
+	frameSlots_.erase(it);
+}
+
+void ObsGraph::clear() {
+	for(size_t i = 0; i < tracks_.size(); ++i) {
+		if(!tracks_[i].point)
+			continue;
+		tracks_[i].point.reset();
+		tracks_[i].obs.clear();
+		freeSlots_.push_back(int(i));
+	}
+	pointSlot_.clear();
+	frameSlots_.clear();
+	observationNum_ = 0;
+}
+
+const ObsGraph::Track *ObsGraph::find(int pointId) const {
+	auto it = pointSlot_.find(pointId);
+	return it == pointSlot_.end() ? nullptr : &tracks_[it->second];
+}
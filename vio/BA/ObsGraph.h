@@ -0,0 +1,66 @@
+#ifndef SIMPLE_VIO_OBSGRAPH_H
+#define SIMPLE_VIO_OBSGRAPH_H
+
+#include <memory>
+#include <vector>
+#include <unordered_map>
+#include <Eigen/Dense>
+
+class viFrame;
+class Point;
+class Feature;
+
+/// observations of the keyframe window, updated as keyframes enter and leave it instead of being
+/// rebuilt for every BA. points are keyed by Point::id_ and keyframes by cvFrame::getID(), every point
+/// owns a track in one flat array whose slots are reused, so a keyframe going out only touches the
+/// tracks it observed and the steady state allocates nothing.
+/// observations are copies, the BA thread never reads a Feature the front end may still change.
+class ObsGraph {
+public:
+	struct Observation {
+		int                                          frame;   //!< cvFrame id
+		Eigen::Matrix<double, 2, 1, Eigen::DontAlign> px;      //!< level 0
+	};
+
+	/// what a feature with a point contributes, copied where the feature is owned
+	struct Measurement {
+		std::shared_ptr<Point> point;
+		Observation            ob;
+	};
+
+	struct Track {
+		std::shared_ptr<Point>   point;   //!< empty for a free slot
+		std::vector<Observation> obs;     //!< in insertion order
+	};
+
+public:
+	ObsGraph() : observationNum_(0) {}
+	~ObsGraph() {}
+
+	/// every feature of the keyframe which has a point
+	void insertKeyframe(const std::shared_ptr<viFrame> &keyframe);
+	void addObservation(const std::shared_ptr<Feature> &ft);
+	void addObservation(const Measurement &m);
+	/// false for a feature without point
+	static bool measure(const Feature &ft, Measurement &m);
+	/// drops the observations of the keyframe, a point left without one is dropped as well
+	void removeKeyframe(int frame);
+	void clear();
+
+	/// slots, skip the ones without point
+	const std::vector<Track> &tracks() const { return tracks_; }
+	size_t pointNum() const { return pointSlot_.size(); }
+	size_t keyframeNum() const { return frameSlots_.size(); }
+	size_t observationNum() const { return observationNum_; }
+	const Track *find(int pointId) const;
+
+private:
+	std::vector<Track>                        tracks_;
+	std::vector<int>                          freeSlots_;
+	std::unordered_map<int, int>              pointSlot_;    //!< Point::id_ -> slot
+	std::unordered_map<int, std::vector<int>> frameSlots_;   //!< cvFrame id -> slots it observes
+	size_t                                    observationNum_;
+};
+
+
+#endif //SIMPLE_VIO_OBSGRAPH_H
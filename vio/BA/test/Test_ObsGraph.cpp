@@ -0,0 +1,76 @@
+#include <chrono>
+#include <map>
+#include <list>
+#include <random>
+
+#include "opencv2/ts/ts.hpp"
+#include "IO/camera/CameraIO.h"
+#include "DataStructure/viFrame.h"
+#include "DataStructure/cv/cvFrame.h"
+#include "DataStructure/cv/Point.h"
+#include "DataStructure/cv/Feature.h"
+#include "vio/BA/ObsGraph.h"
+#include "util/setting.h"
+#include "util/util.h"
+
+TEST(ObsGraph, slidingWindow) {
+	std::string camDatafile = "../testData/mav0/cam1/data.csv";
+	std::string camParamfile ="../testData/mav0/cam1/sensor.yaml";
+	CameraIO camTest(camDatafile,camParamfile);
+	const CameraIO::pCamereParam cam = camTest.getCamera();
+	auto imuParam = std::make_shared<ImuParameters>();
+	cv::Mat pic(480, 752, CV_8UC1, cv::Scalar(0));
+
+	// every keyframe sees 300 points of its own and 300 of the previous one
+	const int frameNum = 50, pointNum = 300;
+	std::mt19937 rng(3);
+	std::uniform_real_distribution<double> uniform(0.0, 1.0);
+	std::vector<std::shared_ptr<viFrame>> frames;
+	std::vector<std::shared_ptr<Point>> points;
+	for(int i = 0; i < frameNum; ++i) {
+		std::shared_ptr<cvFrame> frame = std::make_shared<cvFrame>(cam, pic, okvis::Time(1.0 + 0.1 * i));
+		for(int k = 0; k < pointNum; ++k)
+			points.push_back(std::make_shared<Point>(Eigen::Vector3d(uniform(rng), uniform(rng), 4.0)));
+		for(int k = std::max(0, i - 1) * pointNum; k < (i + 1) * pointNum; ++k) {
+			Eigen::Vector2d px(uniform(rng) * 752, uniform(rng) * 480);
+			frame->addFeature(std::make_shared<Feature>(frame, points[k], px, cam->cam2world(px), 0));
+		}
+		frames.push_back(std::make_shared<viFrame>(i, frame, imuParam));
+	}
+
+	ObsGraph graph;
+	double rebuildTime = 0.0, updateTime = 0.0;
+	for(int i = 0; i < frameNum; ++i) {
+		std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+		graph.insertKeyframe(frames[i]);
+		if(i >= widowSize)
+			graph.removeKeyframe(frames[i - widowSize]->getCVFrame()->getID());
+		std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now();
+
+		// what runBA did before, for every run
+		std::map<std::shared_ptr<Point>, std::list<std::shared_ptr<Feature>>> obsModes;
+		for(int j = std::max(0, i - widowSize + 1); j <= i; ++j)
+			for(auto &ft : frames[j]->getCVFrame()->getMeasure().fts_)
+				obsModes[ft->point].push_back(ft);
+		std::chrono::steady_clock::time_point t2 = std::chrono::steady_clock::now();
+		updateTime += std::chrono::duration<double, std::milli>(t1 - t0).count();
+		rebuildTime += std::chrono::duration<double, std::milli>(t2 - t1).count();
+
+		ASSERT_EQ(graph.pointNum(), obsModes.size());
+		size_t observationNum = 0;
+		for(auto &it : obsModes) {
+			const ObsGraph::Track *track = graph.find(it.first->id_);
+			ASSERT_TRUE(track != nullptr);
+			ASSERT_EQ(track->obs.size(), it.second.size());
+			auto ft = it.second.begin();
+			for(auto &ob : track->obs) {
+				EXPECT_EQ(ob.frame, (*ft)->frame->getID());
+				EXPECT_EQ(Eigen::Vector2d(ob.px), (*ft)->px);
+				++ft;
+			}
+			observationNum += it.second.size();
+		}
+		EXPECT_EQ(graph.observationNum(), observationNum);
+	}
+	printf("%d keyframes, map rebuilt per run %f ms, graph updated %f ms\n", frameNum, rebuildTime, updateTime);
+}
@@ -245,8 +245,8 @@ bool InitialImpl::init(std::vector<std::shared_ptr<viFrame>> &VecFrames,
 					auto &obs = ft->point->obs_;
 
 				}
-				//std::cout << ft->point->pos_[2] << std::endl;
-				ft->point->pos_ = scale * ft->point->pos_;
+				//std::cout << ft->point->getPos()[2] << std::endl;
+				ft->point->setPos(scale * ft->point->getPos());
 
 			}
 		}
@@ -2,8 +2,11 @@
 // Created by lancelot on 4/12/17.
 //
 
+#include <future>
+
 #include "system.h"
 #include "IMU/IMU.h"
+#include "IMU/Preintegrator.h"
 #include "IO/imu/IMUIO.h"
 #include "IO/camera/CameraIO.h"
 #include "IO/image/ImageIO.h"
@@ -18,6 +21,7 @@
 #include "cv/Tracker/Tracker.h"
 #include "util/util.h"
 #include "util/setting.h"
+#include "util/Trace.h"
 #include "./BA/BundleAdjustemt.h"
 
 namespace vio {
@@ -25,32 +29,80 @@ namespace vio {
 
 
 system::system(std::string &imuDatafile, std::string &imuParamfile, std::string &camDatafile, std::string &camParamfile,
-               std::string &imageFile, std::string &dataDirectory,  const int img_width, const int img_height) {
+               std::string &imageFile, std::string &dataDirectory,  const int img_width, const int img_height) :
+        keyframeQueue(64), updateQueue(16), appliedVersion(0), updateLatency("BA update -> front end"),
+        BAVersion(0), keyframeLatency("keyframe -> BA") {
+    TRACE_THREAD("front end");
+    trace::enable(true);
+    // the imu log is the largest file, it loads while the camera and image list are read
+    std::future<std::shared_ptr<IMUIO>> imuLoad = std::async(std::launch::async, [&] {
+        return std::make_shared<IMUIO>(imuDatafile, imuParamfile);
+    });
     std::shared_ptr<CameraIO> camIO = std::make_shared<CameraIO>(camDatafile, camParamfile);
     cam = camIO->getCamera();
-    BARunning = false;
+    quit = false;
     BAResult = true;
+#if RectifyInPyramid
+    imgIO = std::make_shared<ImageIO>(imageFile, dataDirectory);
+#else
     imgIO = std::make_shared<ImageIO>(imageFile, dataDirectory, cam);
-    imuIO = std::make_shared<IMUIO>(imuDatafile, imuParamfile);
+#endif
+    imgIO->startPrefetch(ImagePrefetchDepth, ImagePrefetchThreads);
+    imuIO = imuLoad.get();
     imuParam  = imuIO->getImuParam();
     detector = std::make_shared<feature_detection::Detector>(img_width, img_width, 25, IMG_LEVEL);
     tracker = std::make_shared<direct_tracker::Tracker>();
+    tracker->setRotationPrior(true);
+    tracker->setPrefilterType(direct_tracker::Tracker::PREFILTER_PREDICTED);
     triangulater = std::make_shared<Triangulater>();
     imu = std::make_shared<IMU>();
     initialier = std::make_shared<Initialize>(detector, tracker, triangulater, imu);
-    BA = std::make_shared<BundleAdjustemt>(SIMPLE_BA);
+    BA = std::make_shared<BundleAdjustemt>(SCHUR_BA);
     BAThread = std::thread(&system::workLoop, this);
     id = -1;
+    trackedFrames = lostFrames = trackingIterations = 0;
+}
+
+system::~system() {
+    quit = true;
+    callBA.notify_all();
+    BAThread.join();
+    keyframeLatency.print();
+    updateLatency.print();
+    imgIO->printStats();
+    printf("tracking: %ld frames, %ld lost, %.1f iterations per frame\n", trackedFrames + lostFrames, lostFrames,
+           trackedFrames + lostFrames ? double(trackingIterations) / (trackedFrames + lostFrames) : 0.0);
+#if Tracing
+    trace::enable(false);
+    if(!trace::writeChrome(TraceFile))
+        printf("can't write the trace to %s\n", TraceFile);
+    trace::printSummary();
+#endif
 }
 
 void system::workLoop() {
-    std::unique_lock<std::mutex> lock(BAMutex);
-    while(true) {
-        if(BARunning == false)
-            callBA.wait(lock);
+    TRACE_THREAD("BA");
+    while(!quit) {
+        KeyframeSnapshot snapshot;
+        bool received = false;
+        while(keyframeQueue.pop(snapshot)) {
+            keyframeLatency.add(snapshot.published);
+            keyFrames.push_back(snapshot.keyframe);
+            if(snapshot.factor)
+                imuFactors.push_back(snapshot.factor);
+            for(auto &m : snapshot.obs)
+                obsGraph.addObservation(m);
+            received = true;
+        }
 
-        BAResult = runBA();
-        BARunning = false;
+        if(received)
+            BAResult = runBA();
+        else {
+            // the producer notifies without the mutex, the timeout covers a wakeup lost in between
+            std::unique_lock<std::mutex> lock(BAMutex);
+            callBA.wait_for(lock, std::chrono::milliseconds(10),
+                            [this] { return quit || !keyframeQueue.empty(); });
+        }
     }
 }
 
@@ -59,23 +111,101 @@ bool system::runBA() {
         return false;
 
     assert(keyFrames.size() == imuFactors.size() + 1);
-    BundleAdjustemt::obsModeType obsModes;
-    for(auto &keyframe : keyFrames) {
-        for(auto &ft : keyframe->getCVFrame()->getMeasure().fts_) {
-            auto it = obsModes.find(ft->point);
-            if(it != obsModes.end())
-                it->second.push_back(ft);
-            else {
-                std::list<std::shared_ptr<Feature>> fl;
-                fl.push_back(ft);
-                obsModes.insert(std::make_pair<std::shared_ptr<Point>,
-                                std::list<std::shared_ptr<Feature>> >(std::shared_ptr<Point>(ft->point),
-                                                                      std::move(fl)));
-            }
-        }
+    std::shared_ptr<BAUpdate> update = std::make_shared<BAUpdate>();
+    bool res = BA->run(keyFrames, obsGraph, imuFactors, 50, update.get());
+    if(res) {
+        update->version = ++BAVersion;
+        update->published = std::chrono::steady_clock::now();
+        if(!updateQueue.push(std::move(update)))
+            printf("front end is %lu BA results behind, dropping one\n", updateQueue.capacity());
+    }
+
+    // the window stays bounded, the oldest keyframes go into the prior of the next runs
+    while(keyFrames.size() > widowSize) {
+        BA->marginalize(keyFrames, obsGraph, imuFactors);
+        obsGraph.removeKeyframe(keyFrames.front()->getCVFrame()->getID());
+        keyFrames.erase(keyFrames.begin());
+        imuFactors.erase(imuFactors.begin());
     }
+    return res;
+}
+
+bool system::integrateImu(const okvis::Time &time, direct_tracker::MotionPrior &prior) {
+    TRACE_SCOPE("IMU integration");
+    okvis::Time start = keyframeImu->time(), end = time;
+    for(const ImuRecord &r : imuIO->range(start, end))
+        keyframeImu->add(r.time(), Eigen::Vector3d(r.gyr[0], r.gyr[1], r.gyr[2]),
+                         Eigen::Vector3d(r.acc[0], r.acc[1], r.acc[2]), end);
+    if(!(curframeTime < end) || keyframeImu->time() != end)
+        return false;
 
-    return BA->run(keyFrames, obsModes, imuFactors);
+    // from curframe, not from the last integrated frame: a lost frame or the one after a keyframe doesn't move it.
+    // the keyframe integration runs without bias, the prior allows for one
+    prior = direct_tracker::MotionPrior::between(curframeR, keyframeImu->deltaR(), (end - curframeTime).toSec(),
+                                                 imuParam->sigma_g_c);
+    return true;
+}
+
+void system::insertKeyframe(std::shared_ptr<viFrame> &keyframe, okvis::Time &time) {
+    Sophus::SE3d T;
+    IMUMeasure::SpeedAndBias spbs = IMUMeasure::SpeedAndBias::Zero();
+    IMUMeasure::covariance_t var;
+    IMUMeasure::jacobian_t jac;
+    keyframeImu->get(T, spbs, &var, &jac);
+    std::shared_ptr<imuFactor> imufact = std::make_shared<imuFactor>(T, jac, spbs.block<3, 1>(0, 0), var);
+    keyFrameTime = time;
+    keyframeImu->reset(keyFrameTime, Eigen::Vector3d::Zero(), Eigen::Vector3d::Zero());
+    imuIO->release(keyFrameTime);
+    // the features of curframe are still erased while frames are tracked against it, the BA gets it once it is done
+    publishPending();
+    pendingKeyframe = keyframe;
+    pendingFactor = imufact;
+}
+
+void system::publishKeyframe(const std::shared_ptr<viFrame> &keyframe, const std::shared_ptr<imuFactor> &factor) {
+    KeyframeSnapshot snapshot;
+    snapshot.keyframe = keyframe;
+    snapshot.factor = factor;
+    auto &fts = keyframe->getCVFrame()->getMeasure().fts_;
+    snapshot.obs.reserve(fts.size());
+    ObsGraph::Measurement m;
+    for(auto &ft : fts)
+        if(ObsGraph::measure(*ft, m))
+            snapshot.obs.push_back(m);
+    snapshot.published = std::chrono::steady_clock::now();
+    unpublished.push_back(std::move(snapshot));
+
+    // in order, what doesn't fit waits for the next keyframe
+    while(!unpublished.empty() && keyframeQueue.push(std::move(unpublished.front())))
+        unpublished.pop_front();
+    callBA.notify_one();
+}
+
+void system::publishPending() {
+    if(!pendingKeyframe)
+        return;
+    publishKeyframe(pendingKeyframe, pendingFactor);
+    pendingKeyframe.reset();
+    pendingFactor.reset();
+}
+
+void system::setCurframe(const std::shared_ptr<viFrame> &frame, const okvis::Time &time) {
+    if(frame != pendingKeyframe)
+        publishPending();
+    curframe = frame;
+    // identity right after insertKeyframe reset the integration
+    curframeR = keyframeImu->deltaR();
+    curframeTime = time;
+}
+
+void system::applyBAUpdates() {
+    std::shared_ptr<BAUpdate> update;
+    while(updateQueue.pop(update)) {
+        assert(update->version > appliedVersion);
+        update->apply();
+        appliedVersion = update->version;
+        updateLatency.add(update->published);
+    }
 }
 
 bool system::isInsertKeyframe(int num, Sophus::SE3d T)
@@ -93,8 +223,10 @@ void system::run() {
     int lost = 0;
     while(!imgIO->isEmpty()) {
         id++;
+        TRACE_SCOPE("frame");
+        applyBAUpdates();
         auto tImg = imgIO->popImageAndTimestamp();
-        std::shared_ptr<cvFrame> frame = std::make_shared<cvFrame>(cam, tImg.second, tImg.first);
+        std::shared_ptr<cvFrame> frame = std::make_shared<cvFrame>(cam, tImg.second, tImg.first, RectifyInPyramid);
 
         if(id < 7) {
             if(id == 0) {
@@ -103,27 +235,36 @@ void system::run() {
             }
 
             else {
-                std::shared_ptr<cvFrame> frame = std::make_shared<cvFrame>(cam, tImg.second, tImg.first);
-                auto imuMeasure = imuIO->pop(tImg.first, pre_time);
+                std::shared_ptr<cvFrame> frame = std::make_shared<cvFrame>(cam, tImg.second, tImg.first, RectifyInPyramid);
+                Preintegrator frameImu(*imuParam, pre_time, Eigen::Vector3d::Zero(), Eigen::Vector3d::Zero());
+                for(const ImuRecord &r : imuIO->range(pre_time, tImg.first))
+                    frameImu.add(r.time(), Eigen::Vector3d(r.gyr[0], r.gyr[1], r.gyr[2]),
+                                 Eigen::Vector3d(r.acc[0], r.acc[1], r.acc[2]), tImg.first);
                 Sophus::SE3d T;
                 IMUMeasure::SpeedAndBias spbs = IMUMeasure::SpeedAndBias::Zero();
-                IMUMeasure::covariance_t var(9, 9);
-                IMUMeasure::jacobian_t jac(15, 3);
-                imu->propagation(imuMeasure, *imuParam, T, spbs, pre_time, tImg.first, &var, &jac);
+                IMUMeasure::covariance_t var;
+                IMUMeasure::jacobian_t jac;
+                frameImu.get(T, spbs, &var, &jac);
                 pre_time = tImg.first;
                 std::shared_ptr<imuFactor> imufact = std::make_shared<imuFactor>(T, jac, spbs.block<3, 1>(0, 0), var);
                 initialier->pushcvFrame(frame, imufact, imuParam);
 
                 if(id == 6) {
                     initialier->init(imuParam);
-                    std::swap(initialier->getInitialViframe(), keyFrames);
-                    std::swap(initialier->getInitialImuFactor(), imuFactors);
-                    BARunning = true;
-                    callBA.notify_all();
                     auto &Viframes = initialier->getInitialViframe();
+                    auto &factors = initialier->getInitialImuFactor();
+                    keyFrameTime = tImg.first;
+                    keyframeImu = std::make_shared<Preintegrator>(*imuParam, keyFrameTime, Eigen::Vector3d::Zero(),
+                                                                  Eigen::Vector3d::Zero());
+                    imuIO->release(keyFrameTime);
+                    for(size_t i = 0; i + 1 < Viframes.size(); ++i)
+                        publishKeyframe(Viframes[i], i ? factors[i - 1] : std::shared_ptr<imuFactor>());
+                    // the last one is curframe, it waits like every keyframe
+                    pendingKeyframe = Viframes.back();
+                    pendingFactor = Viframes.size() > 1 ? factors[Viframes.size() - 2] : std::shared_ptr<imuFactor>();
                     for(auto &f : Viframes)
                         QueKeyFrames.push_back(f);
-                    curframe = QueKeyFrames.back();
+                    setCurframe(QueKeyFrames.back(), tImg.first);
                     isInsert = false;
                 }
             }
@@ -134,22 +275,29 @@ void system::run() {
             Eigen::Matrix<double, 6, 6> info;
 //            std::shared_ptr<viFrame> curViKF = std::make_shared<viFrame>(curframe,imuParam);
             std::shared_ptr<viFrame> newKF = std::make_shared<viFrame>(id,frame,imuParam);
-
-            if(!tracker->Tracking(curframe, newKF, T, info)) {
-                printf("lost!\n");
+            direct_tracker::MotionPrior prior;
+            const bool predicted = integrateImu(tImg.first, prior);
+            const bool tracked = predicted ? tracker->Tracking(curframe, newKF, prior, T, info)
+                                           : tracker->Tracking(curframe, newKF, T, info);
+            trackingIterations += tracker->iterations();
+            if(!tracked) {
+                TRACE_COUNT("lost frames", 1);
+                lostFrames++;
                 lost++;
                 if(lost > 5) {
+                    // returns rather than exits, the destructor still writes the trace and the statistics
                     printf("system has lost!!!\n");
-                    exit(0);
+                    return;
                 }
                 continue;
             }
+            trackedFrames++;
 
             if(isInsert) {
                 isInsert = false;
                 //! triangula
                 int count = triangulater->triangulate(curframe, newKF, T, info);
-                printf("triangulate %d's points!\n",count);
+                TRACE_COUNT("triangulated points", count);
             }
             else {
                 int cellnum = tracker->reProject(curframe, newKF, T, info);
@@ -161,9 +309,9 @@ void system::run() {
 
                     QueKeyFrames.push_back(newKF);
                     isInsert = true;
-                    callBA.notify_all();
+                    insertKeyframe(newKF, tImg.first);
                 }
-                curframe = newKF;
+                setCurframe(newKF, tImg.first);
             }
         }
     }
@@ -10,17 +10,36 @@
 #include <thread>
 #include <condition_variable>
 #include <atomic>
+#include <chrono>
+#include <deque>
 
 #include "Initialize.h"
+#include "BA/ObsGraph.h"
+#include "util/SPSCQueue.h"
+#include "util/LatencyHistogram.h"
 
 class Point;
+class Feature;
+struct BAUpdate;
 class ImageIO;
 class IMUIO;
 class AbstractCamera;
 class BundleAdjustemt;
+class Preintegrator;
+
+namespace direct_tracker {
+	struct MotionPrior;
+}
 
 namespace vio {
 
+/// what the front end hands over to the BA thread for one keyframe, it keeps no reference to the copy
+struct KeyframeSnapshot {
+	std::shared_ptr<viFrame>              keyframe;    //!< the BA reads its camera and its pose under the lock, speed and bias are the BA's from here
+	std::shared_ptr<imuFactor>            factor;      //!< from the previous keyframe, empty for the first one
+	std::vector<ObsGraph::Measurement>    obs;         //!< copied from its features when it was published, final by then
+	std::chrono::steady_clock::time_point published;
+};
 
 class system {
 public:
@@ -33,12 +52,22 @@ public:
 	       const int img_width,
 	       const int img_height);
 
+	~system();
 	void run();
 
 private:
 	void workLoop();
 	bool runBA();
     bool isInsertKeyframe(int num,Sophus::SE3d T);
+	/// false if the IMU doesn't reach time, prior is the rotation since curframe otherwise
+	bool integrateImu(const okvis::Time &time, direct_tracker::MotionPrior &prior);
+	void insertKeyframe(std::shared_ptr<viFrame> &keyframe, okvis::Time &time);
+	void publishKeyframe(const std::shared_ptr<viFrame> &keyframe, const std::shared_ptr<imuFactor> &factor);
+	/// publishes the held back keyframe, tracking, triangulate and reProject no longer erase its features
+	void publishPending();
+	void applyBAUpdates();
+	/// the frame the next ones are tracked against, the IMU prior runs from where keyframeImu was at its time
+	void setCurframe(const std::shared_ptr<viFrame> &frame, const okvis::Time &time);
 
 
 private:
@@ -53,16 +82,38 @@ private:
 	std::shared_ptr<IMUIO> imuIO;
 	std::shared_ptr<AbstractCamera> cam;
 	std::shared_ptr<ImuParameters> imuParam;
+	okvis::Time keyFrameTime;                               //!< timestamp of the last keyframe
+	std::shared_ptr<Preintegrator> keyframeImu;             //!< the IMU since keyFrameTime, integrated frame by frame
+
+	// front end -> BA thread, the front end never waits on the BA
+	SPSCQueue<KeyframeSnapshot> keyframeQueue;
+	std::deque<KeyframeSnapshot> unpublished;               //!< waiting for room in keyframeQueue
+	std::shared_ptr<viFrame> pendingKeyframe;               //!< held back while it is curframe
+	std::shared_ptr<imuFactor> pendingFactor;
+	SPSCQueue<std::shared_ptr<BAUpdate>> updateQueue;       //!< BA thread -> front end, applied between two frames
+	unsigned long appliedVersion;
+	LatencyHistogram updateLatency;                         //!< from the end of a BA run until the front end applied it
+
+	// owned by the BA thread
 	std::vector<std::shared_ptr<viFrame>> keyFrames;
 	std::vector<std::shared_ptr<imuFactor>> imuFactors;
+	ObsGraph obsGraph;                                      //!< observations of keyFrames
+	unsigned long BAVersion;
+	LatencyHistogram keyframeLatency;                       //!< from publishing a keyframe until the BA thread took it
+
 	std::thread BAThread;
-	std::mutex BAMutex;
+	std::mutex BAMutex;                                     //!< only to sleep on callBA, never held while working
 	std::condition_variable callBA;
-	std::atomic_bool BARunning;
+	std::atomic_bool quit;
 	std::atomic_bool BAResult;
     std::deque<std::shared_ptr<viFrame>> QueKeyFrames;
     bool      isInsert;
     std::shared_ptr<viFrame>   curframe;
+	Sophus::SO3d curframeR;                                 //!< keyframeImu->deltaR() when curframe was taken
+	okvis::Time curframeTime;
+	long trackedFrames;
+	long lostFrames;
+	long trackingIterations;
 };
 }
 
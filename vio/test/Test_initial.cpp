@@ -20,14 +20,13 @@
 class drPoint {
 public:
 	drPoint(std::shared_ptr<Point>& point_) : point(point_) {
-		//std::cout << point->pos_ << std::endl << std::endl;
+		//std::cout << point->getPos() << std::endl << std::endl;
 	}
 	void draw() {
 		glColor3d(0.3, 0.6, 0.9);
-		point->pos_mutex.lock_shared();
-		//std::cout << point->pos_[2] << std::endl;
-		glVertex3d(point->pos_[0] * 100, point->pos_[1] * 100, point->pos_[2] * 100);
-		point->pos_mutex.unlock_shared();
+		//std::cout << point->getPos()[2] << std::endl;
+		const Eigen::Vector3d pos = point->getPos();
+		glVertex3d(pos[0] * 100, pos[1] * 100, pos[2] * 100);
 	}
 
 private: